@@ -76,6 +76,8 @@ type EndpointMapping = {
   "storage.remove": "storage.remove";
   "storage.clear": "storage.clear";
   "storage.list": "storage.list";
+  "storage.getMany": "storage.getMany";
+  "storage.setMany": "storage.setMany";
 
   "oauth.authorize": "oauth.authorize";
 
@@ -24,6 +24,25 @@ export class LocalStorage {
     await bus.turboRequest("storage.set", { key, value });
   }
 
+  /**
+   * Fetch several items in a single round trip. Keys that are not set are
+   * omitted from the returned object.
+   */
+  static async getItems(keys: string[]): Promise<LocalStorage.Values> {
+    const res = await bus.turboRequest("storage.getMany", { keys });
+
+    if (!res.ok) return {};
+
+    return res.value.values;
+  }
+
+  /**
+   * Set several items in a single round trip.
+   */
+  static async setItems(values: LocalStorage.Values): Promise<void> {
+    await bus.turboRequest("storage.setMany", { values });
+  }
+
   static async removeItem(key: string): Promise<void> {
     await bus.turboRequest("storage.remove", { key });
   }
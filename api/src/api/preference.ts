@@ -1,12 +1,21 @@
-import { workerData } from "worker_threads";
 import { bus } from "./bus";
 
+let preferenceValues: Record<string, any> = {};
+
+/**
+ * Set by the extension runtime with the preference values of the command being launched, before the
+ * command code is loaded. Not meant to be called by extensions.
+ *
+ * @internal
+ */
+export const setPreferenceValues = (values: Record<string, any>) => {
+  preferenceValues = values ?? {};
+};
+
 export const getPreferenceValues = <
   T = { [preferenceName: string]: any },
 >(): T => {
-  const { preferenceValues = {} } = workerData;
-
-  return preferenceValues;
+  return preferenceValues as T;
 };
 
 export const openExtensionPreferences = async (): Promise<void> => {
@@ -15,31 +15,1211 @@ export interface UrlRequest {
   url: string;
 }
 
+export interface StartupTraceRequest {}
+
+export interface StartupPhase {
+  name: string;
+  thread: string;
+  startMs: number;
+  durationMs: number;
+}
+
+export interface StartupTraceResponse {
+  phases: StartupPhase[];
+}
+
+export interface ToggleLatencyRequest {}
+
+export interface ToggleLatencyResponse {
+  samples: number;
+  lastMs: number;
+  minMs: number;
+  medianMs: number;
+  p95Ms: number;
+  maxMs: number;
+}
+
+export interface StatsRequest {}
+
+export interface TimingStats {
+  name: string;
+  count: number;
+  meanMs: number;
+  p50Ms: number;
+  p90Ms: number;
+  p99Ms: number;
+  maxMs: number;
+}
+
+export interface CounterStats {
+  name: string;
+  value: number;
+}
+
+export interface StatsResponse {
+  timings: TimingStats[];
+  counters: CounterStats[];
+}
+
+export interface TraceControlRequest {
+  enabled: boolean;
+}
+
+export interface TraceControlResponse {
+  enabled: boolean;
+}
+
+export interface TraceDumpRequest {}
+
+export interface TraceDumpResponse {
+  json: string;
+  eventCount: number;
+}
+
 export interface Request {
   url?: UrlRequest | undefined;
+  startupTrace?: StartupTraceRequest | undefined;
+  toggleLatency?: ToggleLatencyRequest | undefined;
+  stats?: StatsRequest | undefined;
+  traceControl?: TraceControlRequest | undefined;
+  traceDump?: TraceDumpRequest | undefined;
+}
+
+export interface Response {
+  url?: UrlResponse | undefined;
+  startupTrace?: StartupTraceResponse | undefined;
+  toggleLatency?: ToggleLatencyResponse | undefined;
+  stats?: StatsResponse | undefined;
+  traceControl?: TraceControlResponse | undefined;
+  traceDump?: TraceDumpResponse | undefined;
+}
+
+function createBaseUrlResponse(): UrlResponse {
+  return {};
+}
+
+export const UrlResponse: MessageFns<UrlResponse> = {
+  encode(
+    _: UrlResponse,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    return writer;
+  },
+
+  decode(input: BinaryReader | Uint8Array, length?: number): UrlResponse {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseUrlResponse();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(_: any): UrlResponse {
+    return {};
+  },
+
+  toJSON(_: UrlResponse): unknown {
+    const obj: any = {};
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<UrlResponse>, I>>(base?: I): UrlResponse {
+    return UrlResponse.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<UrlResponse>, I>>(_: I): UrlResponse {
+    const message = createBaseUrlResponse();
+    return message;
+  },
+};
+
+function createBaseUrlRequest(): UrlRequest {
+  return { url: "" };
+}
+
+export const UrlRequest: MessageFns<UrlRequest> = {
+  encode(
+    message: UrlRequest,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    if (message.url !== "") {
+      writer.uint32(10).string(message.url);
+    }
+    return writer;
+  },
+
+  decode(input: BinaryReader | Uint8Array, length?: number): UrlRequest {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseUrlRequest();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+        case 1: {
+          if (tag !== 10) {
+            break;
+          }
+
+          message.url = reader.string();
+          continue;
+        }
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(object: any): UrlRequest {
+    return { url: isSet(object.url) ? globalThis.String(object.url) : "" };
+  },
+
+  toJSON(message: UrlRequest): unknown {
+    const obj: any = {};
+    if (message.url !== "") {
+      obj.url = message.url;
+    }
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<UrlRequest>, I>>(base?: I): UrlRequest {
+    return UrlRequest.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<UrlRequest>, I>>(
+    object: I,
+  ): UrlRequest {
+    const message = createBaseUrlRequest();
+    message.url = object.url ?? "";
+    return message;
+  },
+};
+
+function createBaseStartupTraceRequest(): StartupTraceRequest {
+  return {};
+}
+
+export const StartupTraceRequest: MessageFns<StartupTraceRequest> = {
+  encode(
+    _: StartupTraceRequest,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    return writer;
+  },
+
+  decode(
+    input: BinaryReader | Uint8Array,
+    length?: number,
+  ): StartupTraceRequest {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseStartupTraceRequest();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(_: any): StartupTraceRequest {
+    return {};
+  },
+
+  toJSON(_: StartupTraceRequest): unknown {
+    const obj: any = {};
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<StartupTraceRequest>, I>>(
+    base?: I,
+  ): StartupTraceRequest {
+    return StartupTraceRequest.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<StartupTraceRequest>, I>>(
+    _: I,
+  ): StartupTraceRequest {
+    const message = createBaseStartupTraceRequest();
+    return message;
+  },
+};
+
+function createBaseStartupPhase(): StartupPhase {
+  return { name: "", thread: "", startMs: 0, durationMs: 0 };
+}
+
+export const StartupPhase: MessageFns<StartupPhase> = {
+  encode(
+    message: StartupPhase,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    if (message.name !== "") {
+      writer.uint32(10).string(message.name);
+    }
+    if (message.thread !== "") {
+      writer.uint32(18).string(message.thread);
+    }
+    if (message.startMs !== 0) {
+      writer.uint32(25).double(message.startMs);
+    }
+    if (message.durationMs !== 0) {
+      writer.uint32(33).double(message.durationMs);
+    }
+    return writer;
+  },
+
+  decode(input: BinaryReader | Uint8Array, length?: number): StartupPhase {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseStartupPhase();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+        case 1: {
+          if (tag !== 10) {
+            break;
+          }
+
+          message.name = reader.string();
+          continue;
+        }
+        case 2: {
+          if (tag !== 18) {
+            break;
+          }
+
+          message.thread = reader.string();
+          continue;
+        }
+        case 3: {
+          if (tag !== 25) {
+            break;
+          }
+
+          message.startMs = reader.double();
+          continue;
+        }
+        case 4: {
+          if (tag !== 33) {
+            break;
+          }
+
+          message.durationMs = reader.double();
+          continue;
+        }
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(object: any): StartupPhase {
+    return {
+      name: isSet(object.name) ? globalThis.String(object.name) : "",
+      thread: isSet(object.thread) ? globalThis.String(object.thread) : "",
+      startMs: isSet(object.startMs) ? globalThis.Number(object.startMs) : 0,
+      durationMs: isSet(object.durationMs)
+        ? globalThis.Number(object.durationMs)
+        : 0,
+    };
+  },
+
+  toJSON(message: StartupPhase): unknown {
+    const obj: any = {};
+    if (message.name !== "") {
+      obj.name = message.name;
+    }
+    if (message.thread !== "") {
+      obj.thread = message.thread;
+    }
+    if (message.startMs !== 0) {
+      obj.startMs = message.startMs;
+    }
+    if (message.durationMs !== 0) {
+      obj.durationMs = message.durationMs;
+    }
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<StartupPhase>, I>>(
+    base?: I,
+  ): StartupPhase {
+    return StartupPhase.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<StartupPhase>, I>>(
+    object: I,
+  ): StartupPhase {
+    const message = createBaseStartupPhase();
+    message.name = object.name ?? "";
+    message.thread = object.thread ?? "";
+    message.startMs = object.startMs ?? 0;
+    message.durationMs = object.durationMs ?? 0;
+    return message;
+  },
+};
+
+function createBaseStartupTraceResponse(): StartupTraceResponse {
+  return { phases: [] };
+}
+
+export const StartupTraceResponse: MessageFns<StartupTraceResponse> = {
+  encode(
+    message: StartupTraceResponse,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    for (const v of message.phases) {
+      StartupPhase.encode(v!, writer.uint32(10).fork()).join();
+    }
+    return writer;
+  },
+
+  decode(
+    input: BinaryReader | Uint8Array,
+    length?: number,
+  ): StartupTraceResponse {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseStartupTraceResponse();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+        case 1: {
+          if (tag !== 10) {
+            break;
+          }
+
+          message.phases.push(StartupPhase.decode(reader, reader.uint32()));
+          continue;
+        }
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(object: any): StartupTraceResponse {
+    return {
+      phases: globalThis.Array.isArray(object?.phases)
+        ? object.phases.map((e: any) => StartupPhase.fromJSON(e))
+        : [],
+    };
+  },
+
+  toJSON(message: StartupTraceResponse): unknown {
+    const obj: any = {};
+    if (message.phases?.length) {
+      obj.phases = message.phases.map((e) => StartupPhase.toJSON(e));
+    }
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<StartupTraceResponse>, I>>(
+    base?: I,
+  ): StartupTraceResponse {
+    return StartupTraceResponse.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<StartupTraceResponse>, I>>(
+    object: I,
+  ): StartupTraceResponse {
+    const message = createBaseStartupTraceResponse();
+    message.phases =
+      object.phases?.map((e) => StartupPhase.fromPartial(e)) || [];
+    return message;
+  },
+};
+
+function createBaseToggleLatencyRequest(): ToggleLatencyRequest {
+  return {};
+}
+
+export const ToggleLatencyRequest: MessageFns<ToggleLatencyRequest> = {
+  encode(
+    _: ToggleLatencyRequest,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    return writer;
+  },
+
+  decode(
+    input: BinaryReader | Uint8Array,
+    length?: number,
+  ): ToggleLatencyRequest {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseToggleLatencyRequest();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(_: any): ToggleLatencyRequest {
+    return {};
+  },
+
+  toJSON(_: ToggleLatencyRequest): unknown {
+    const obj: any = {};
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<ToggleLatencyRequest>, I>>(
+    base?: I,
+  ): ToggleLatencyRequest {
+    return ToggleLatencyRequest.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<ToggleLatencyRequest>, I>>(
+    _: I,
+  ): ToggleLatencyRequest {
+    const message = createBaseToggleLatencyRequest();
+    return message;
+  },
+};
+
+function createBaseToggleLatencyResponse(): ToggleLatencyResponse {
+  return { samples: 0, lastMs: 0, minMs: 0, medianMs: 0, p95Ms: 0, maxMs: 0 };
+}
+
+export const ToggleLatencyResponse: MessageFns<ToggleLatencyResponse> = {
+  encode(
+    message: ToggleLatencyResponse,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    if (message.samples !== 0) {
+      writer.uint32(8).uint32(message.samples);
+    }
+    if (message.lastMs !== 0) {
+      writer.uint32(17).double(message.lastMs);
+    }
+    if (message.minMs !== 0) {
+      writer.uint32(25).double(message.minMs);
+    }
+    if (message.medianMs !== 0) {
+      writer.uint32(33).double(message.medianMs);
+    }
+    if (message.p95Ms !== 0) {
+      writer.uint32(41).double(message.p95Ms);
+    }
+    if (message.maxMs !== 0) {
+      writer.uint32(49).double(message.maxMs);
+    }
+    return writer;
+  },
+
+  decode(
+    input: BinaryReader | Uint8Array,
+    length?: number,
+  ): ToggleLatencyResponse {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseToggleLatencyResponse();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+        case 1: {
+          if (tag !== 8) {
+            break;
+          }
+
+          message.samples = reader.uint32();
+          continue;
+        }
+        case 2: {
+          if (tag !== 17) {
+            break;
+          }
+
+          message.lastMs = reader.double();
+          continue;
+        }
+        case 3: {
+          if (tag !== 25) {
+            break;
+          }
+
+          message.minMs = reader.double();
+          continue;
+        }
+        case 4: {
+          if (tag !== 33) {
+            break;
+          }
+
+          message.medianMs = reader.double();
+          continue;
+        }
+        case 5: {
+          if (tag !== 41) {
+            break;
+          }
+
+          message.p95Ms = reader.double();
+          continue;
+        }
+        case 6: {
+          if (tag !== 49) {
+            break;
+          }
+
+          message.maxMs = reader.double();
+          continue;
+        }
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(object: any): ToggleLatencyResponse {
+    return {
+      samples: isSet(object.samples) ? globalThis.Number(object.samples) : 0,
+      lastMs: isSet(object.lastMs) ? globalThis.Number(object.lastMs) : 0,
+      minMs: isSet(object.minMs) ? globalThis.Number(object.minMs) : 0,
+      medianMs: isSet(object.medianMs) ? globalThis.Number(object.medianMs) : 0,
+      p95Ms: isSet(object.p95Ms) ? globalThis.Number(object.p95Ms) : 0,
+      maxMs: isSet(object.maxMs) ? globalThis.Number(object.maxMs) : 0,
+    };
+  },
+
+  toJSON(message: ToggleLatencyResponse): unknown {
+    const obj: any = {};
+    if (message.samples !== 0) {
+      obj.samples = message.samples;
+    }
+    if (message.lastMs !== 0) {
+      obj.lastMs = message.lastMs;
+    }
+    if (message.minMs !== 0) {
+      obj.minMs = message.minMs;
+    }
+    if (message.medianMs !== 0) {
+      obj.medianMs = message.medianMs;
+    }
+    if (message.p95Ms !== 0) {
+      obj.p95Ms = message.p95Ms;
+    }
+    if (message.maxMs !== 0) {
+      obj.maxMs = message.maxMs;
+    }
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<ToggleLatencyResponse>, I>>(
+    base?: I,
+  ): ToggleLatencyResponse {
+    return ToggleLatencyResponse.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<ToggleLatencyResponse>, I>>(
+    object: I,
+  ): ToggleLatencyResponse {
+    const message = createBaseToggleLatencyResponse();
+    message.samples = object.samples ?? 0;
+    message.lastMs = object.lastMs ?? 0;
+    message.minMs = object.minMs ?? 0;
+    message.medianMs = object.medianMs ?? 0;
+    message.p95Ms = object.p95Ms ?? 0;
+    message.maxMs = object.maxMs ?? 0;
+    return message;
+  },
+};
+
+function createBaseStatsRequest(): StatsRequest {
+  return {};
+}
+
+export const StatsRequest: MessageFns<StatsRequest> = {
+  encode(
+    _: StatsRequest,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    return writer;
+  },
+
+  decode(
+    input: BinaryReader | Uint8Array,
+    length?: number,
+  ): StatsRequest {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseStatsRequest();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(_: any): StatsRequest {
+    return {};
+  },
+
+  toJSON(_: StatsRequest): unknown {
+    const obj: any = {};
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<StatsRequest>, I>>(
+    base?: I,
+  ): StatsRequest {
+    return StatsRequest.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<StatsRequest>, I>>(
+    _: I,
+  ): StatsRequest {
+    const message = createBaseStatsRequest();
+    return message;
+  },
+};
+
+function createBaseTimingStats(): TimingStats {
+  return {
+    name: "",
+    count: 0,
+    meanMs: 0,
+    p50Ms: 0,
+    p90Ms: 0,
+    p99Ms: 0,
+    maxMs: 0,
+  };
+}
+
+export const TimingStats: MessageFns<TimingStats> = {
+  encode(
+    message: TimingStats,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    if (message.name !== "") {
+      writer.uint32(10).string(message.name);
+    }
+    if (message.count !== 0) {
+      writer.uint32(16).uint32(message.count);
+    }
+    if (message.meanMs !== 0) {
+      writer.uint32(25).double(message.meanMs);
+    }
+    if (message.p50Ms !== 0) {
+      writer.uint32(33).double(message.p50Ms);
+    }
+    if (message.p90Ms !== 0) {
+      writer.uint32(41).double(message.p90Ms);
+    }
+    if (message.p99Ms !== 0) {
+      writer.uint32(49).double(message.p99Ms);
+    }
+    if (message.maxMs !== 0) {
+      writer.uint32(57).double(message.maxMs);
+    }
+    return writer;
+  },
+
+  decode(input: BinaryReader | Uint8Array, length?: number): TimingStats {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseTimingStats();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+        case 1: {
+          if (tag !== 10) {
+            break;
+          }
+
+          message.name = reader.string();
+          continue;
+        }
+        case 2: {
+          if (tag !== 16) {
+            break;
+          }
+
+          message.count = reader.uint32();
+          continue;
+        }
+        case 3: {
+          if (tag !== 25) {
+            break;
+          }
+
+          message.meanMs = reader.double();
+          continue;
+        }
+        case 4: {
+          if (tag !== 33) {
+            break;
+          }
+
+          message.p50Ms = reader.double();
+          continue;
+        }
+        case 5: {
+          if (tag !== 41) {
+            break;
+          }
+
+          message.p90Ms = reader.double();
+          continue;
+        }
+        case 6: {
+          if (tag !== 49) {
+            break;
+          }
+
+          message.p99Ms = reader.double();
+          continue;
+        }
+        case 7: {
+          if (tag !== 57) {
+            break;
+          }
+
+          message.maxMs = reader.double();
+          continue;
+        }
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(object: any): TimingStats {
+    return {
+      name: isSet(object.name) ? globalThis.String(object.name) : "",
+      count: isSet(object.count) ? globalThis.Number(object.count) : 0,
+      meanMs: isSet(object.meanMs) ? globalThis.Number(object.meanMs) : 0,
+      p50Ms: isSet(object.p50Ms) ? globalThis.Number(object.p50Ms) : 0,
+      p90Ms: isSet(object.p90Ms) ? globalThis.Number(object.p90Ms) : 0,
+      p99Ms: isSet(object.p99Ms) ? globalThis.Number(object.p99Ms) : 0,
+      maxMs: isSet(object.maxMs) ? globalThis.Number(object.maxMs) : 0,
+    };
+  },
+
+  toJSON(message: TimingStats): unknown {
+    const obj: any = {};
+    if (message.name !== "") {
+      obj.name = message.name;
+    }
+    if (message.count !== 0) {
+      obj.count = message.count;
+    }
+    if (message.meanMs !== 0) {
+      obj.meanMs = message.meanMs;
+    }
+    if (message.p50Ms !== 0) {
+      obj.p50Ms = message.p50Ms;
+    }
+    if (message.p90Ms !== 0) {
+      obj.p90Ms = message.p90Ms;
+    }
+    if (message.p99Ms !== 0) {
+      obj.p99Ms = message.p99Ms;
+    }
+    if (message.maxMs !== 0) {
+      obj.maxMs = message.maxMs;
+    }
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<TimingStats>, I>>(base?: I): TimingStats {
+    return TimingStats.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<TimingStats>, I>>(
+    object: I,
+  ): TimingStats {
+    const message = createBaseTimingStats();
+    message.name = object.name ?? "";
+    message.count = object.count ?? 0;
+    message.meanMs = object.meanMs ?? 0;
+    message.p50Ms = object.p50Ms ?? 0;
+    message.p90Ms = object.p90Ms ?? 0;
+    message.p99Ms = object.p99Ms ?? 0;
+    message.maxMs = object.maxMs ?? 0;
+    return message;
+  },
+};
+
+function createBaseCounterStats(): CounterStats {
+  return { name: "", value: 0 };
+}
+
+export const CounterStats: MessageFns<CounterStats> = {
+  encode(
+    message: CounterStats,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    if (message.name !== "") {
+      writer.uint32(10).string(message.name);
+    }
+    if (message.value !== 0) {
+      writer.uint32(16).uint32(message.value);
+    }
+    return writer;
+  },
+
+  decode(input: BinaryReader | Uint8Array, length?: number): CounterStats {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseCounterStats();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+        case 1: {
+          if (tag !== 10) {
+            break;
+          }
+
+          message.name = reader.string();
+          continue;
+        }
+        case 2: {
+          if (tag !== 16) {
+            break;
+          }
+
+          message.value = reader.uint32();
+          continue;
+        }
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(object: any): CounterStats {
+    return {
+      name: isSet(object.name) ? globalThis.String(object.name) : "",
+      value: isSet(object.value) ? globalThis.Number(object.value) : 0,
+    };
+  },
+
+  toJSON(message: CounterStats): unknown {
+    const obj: any = {};
+    if (message.name !== "") {
+      obj.name = message.name;
+    }
+    if (message.value !== 0) {
+      obj.value = message.value;
+    }
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<CounterStats>, I>>(
+    base?: I,
+  ): CounterStats {
+    return CounterStats.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<CounterStats>, I>>(
+    object: I,
+  ): CounterStats {
+    const message = createBaseCounterStats();
+    message.name = object.name ?? "";
+    message.value = object.value ?? 0;
+    return message;
+  },
+};
+
+function createBaseStatsResponse(): StatsResponse {
+  return { timings: [], counters: [] };
+}
+
+export const StatsResponse: MessageFns<StatsResponse> = {
+  encode(
+    message: StatsResponse,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    for (const v of message.timings) {
+      TimingStats.encode(v!, writer.uint32(10).fork()).join();
+    }
+    for (const v of message.counters) {
+      CounterStats.encode(v!, writer.uint32(18).fork()).join();
+    }
+    return writer;
+  },
+
+  decode(input: BinaryReader | Uint8Array, length?: number): StatsResponse {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseStatsResponse();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+        case 1: {
+          if (tag !== 10) {
+            break;
+          }
+
+          message.timings.push(TimingStats.decode(reader, reader.uint32()));
+          continue;
+        }
+        case 2: {
+          if (tag !== 18) {
+            break;
+          }
+
+          message.counters.push(CounterStats.decode(reader, reader.uint32()));
+          continue;
+        }
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(object: any): StatsResponse {
+    return {
+      timings: globalThis.Array.isArray(object?.timings)
+        ? object.timings.map((e: any) => TimingStats.fromJSON(e))
+        : [],
+      counters: globalThis.Array.isArray(object?.counters)
+        ? object.counters.map((e: any) => CounterStats.fromJSON(e))
+        : [],
+    };
+  },
+
+  toJSON(message: StatsResponse): unknown {
+    const obj: any = {};
+    if (message.timings?.length) {
+      obj.timings = message.timings.map((e) => TimingStats.toJSON(e));
+    }
+    if (message.counters?.length) {
+      obj.counters = message.counters.map((e) => CounterStats.toJSON(e));
+    }
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<StatsResponse>, I>>(
+    base?: I,
+  ): StatsResponse {
+    return StatsResponse.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<StatsResponse>, I>>(
+    object: I,
+  ): StatsResponse {
+    const message = createBaseStatsResponse();
+    message.timings =
+      object.timings?.map((e) => TimingStats.fromPartial(e)) || [];
+    message.counters =
+      object.counters?.map((e) => CounterStats.fromPartial(e)) || [];
+    return message;
+  },
+};
+
+function createBaseTraceControlRequest(): TraceControlRequest {
+  return { enabled: false };
 }
 
-export interface Response {
-  url?: UrlResponse | undefined;
+export const TraceControlRequest: MessageFns<TraceControlRequest> = {
+  encode(
+    message: TraceControlRequest,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    if (message.enabled !== false) {
+      writer.uint32(8).bool(message.enabled);
+    }
+    return writer;
+  },
+
+  decode(
+    input: BinaryReader | Uint8Array,
+    length?: number,
+  ): TraceControlRequest {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseTraceControlRequest();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+        case 1: {
+          if (tag !== 8) {
+            break;
+          }
+
+          message.enabled = reader.bool();
+          continue;
+        }
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(object: any): TraceControlRequest {
+    return {
+      enabled: isSet(object.enabled)
+        ? globalThis.Boolean(object.enabled)
+        : false,
+    };
+  },
+
+  toJSON(message: TraceControlRequest): unknown {
+    const obj: any = {};
+    if (message.enabled !== false) {
+      obj.enabled = message.enabled;
+    }
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<TraceControlRequest>, I>>(
+    base?: I,
+  ): TraceControlRequest {
+    return TraceControlRequest.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<TraceControlRequest>, I>>(
+    object: I,
+  ): TraceControlRequest {
+    const message = createBaseTraceControlRequest();
+    message.enabled = object.enabled ?? false;
+    return message;
+  },
+};
+
+function createBaseTraceControlResponse(): TraceControlResponse {
+  return { enabled: false };
 }
 
-function createBaseUrlResponse(): UrlResponse {
+export const TraceControlResponse: MessageFns<TraceControlResponse> = {
+  encode(
+    message: TraceControlResponse,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    if (message.enabled !== false) {
+      writer.uint32(8).bool(message.enabled);
+    }
+    return writer;
+  },
+
+  decode(
+    input: BinaryReader | Uint8Array,
+    length?: number,
+  ): TraceControlResponse {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseTraceControlResponse();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+        case 1: {
+          if (tag !== 8) {
+            break;
+          }
+
+          message.enabled = reader.bool();
+          continue;
+        }
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(object: any): TraceControlResponse {
+    return {
+      enabled: isSet(object.enabled)
+        ? globalThis.Boolean(object.enabled)
+        : false,
+    };
+  },
+
+  toJSON(message: TraceControlResponse): unknown {
+    const obj: any = {};
+    if (message.enabled !== false) {
+      obj.enabled = message.enabled;
+    }
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<TraceControlResponse>, I>>(
+    base?: I,
+  ): TraceControlResponse {
+    return TraceControlResponse.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<TraceControlResponse>, I>>(
+    object: I,
+  ): TraceControlResponse {
+    const message = createBaseTraceControlResponse();
+    message.enabled = object.enabled ?? false;
+    return message;
+  },
+};
+
+function createBaseTraceDumpRequest(): TraceDumpRequest {
   return {};
 }
 
-export const UrlResponse: MessageFns<UrlResponse> = {
+export const TraceDumpRequest: MessageFns<TraceDumpRequest> = {
   encode(
-    _: UrlResponse,
+    _: TraceDumpRequest,
     writer: BinaryWriter = new BinaryWriter(),
   ): BinaryWriter {
     return writer;
   },
 
-  decode(input: BinaryReader | Uint8Array, length?: number): UrlResponse {
+  decode(
+    input: BinaryReader | Uint8Array,
+    length?: number,
+  ): TraceDumpRequest {
     const reader =
       input instanceof BinaryReader ? input : new BinaryReader(input);
     const end = length === undefined ? reader.len : reader.pos + length;
-    const message = createBaseUrlResponse();
+    const message = createBaseTraceDumpRequest();
     while (reader.pos < end) {
       const tag = reader.uint32();
       switch (tag >>> 3) {
@@ -52,44 +1232,51 @@ export const UrlResponse: MessageFns<UrlResponse> = {
     return message;
   },
 
-  fromJSON(_: any): UrlResponse {
+  fromJSON(_: any): TraceDumpRequest {
     return {};
   },
 
-  toJSON(_: UrlResponse): unknown {
+  toJSON(_: TraceDumpRequest): unknown {
     const obj: any = {};
     return obj;
   },
 
-  create<I extends Exact<DeepPartial<UrlResponse>, I>>(base?: I): UrlResponse {
-    return UrlResponse.fromPartial(base ?? ({} as any));
+  create<I extends Exact<DeepPartial<TraceDumpRequest>, I>>(
+    base?: I,
+  ): TraceDumpRequest {
+    return TraceDumpRequest.fromPartial(base ?? ({} as any));
   },
-  fromPartial<I extends Exact<DeepPartial<UrlResponse>, I>>(_: I): UrlResponse {
-    const message = createBaseUrlResponse();
+  fromPartial<I extends Exact<DeepPartial<TraceDumpRequest>, I>>(
+    _: I,
+  ): TraceDumpRequest {
+    const message = createBaseTraceDumpRequest();
     return message;
   },
 };
 
-function createBaseUrlRequest(): UrlRequest {
-  return { url: "" };
+function createBaseTraceDumpResponse(): TraceDumpResponse {
+  return { json: "", eventCount: 0 };
 }
 
-export const UrlRequest: MessageFns<UrlRequest> = {
+export const TraceDumpResponse: MessageFns<TraceDumpResponse> = {
   encode(
-    message: UrlRequest,
+    message: TraceDumpResponse,
     writer: BinaryWriter = new BinaryWriter(),
   ): BinaryWriter {
-    if (message.url !== "") {
-      writer.uint32(10).string(message.url);
+    if (message.json !== "") {
+      writer.uint32(10).string(message.json);
+    }
+    if (message.eventCount !== 0) {
+      writer.uint32(16).uint32(message.eventCount);
     }
     return writer;
   },
 
-  decode(input: BinaryReader | Uint8Array, length?: number): UrlRequest {
+  decode(input: BinaryReader | Uint8Array, length?: number): TraceDumpResponse {
     const reader =
       input instanceof BinaryReader ? input : new BinaryReader(input);
     const end = length === undefined ? reader.len : reader.pos + length;
-    const message = createBaseUrlRequest();
+    const message = createBaseTraceDumpResponse();
     while (reader.pos < end) {
       const tag = reader.uint32();
       switch (tag >>> 3) {
@@ -98,7 +1285,15 @@ export const UrlRequest: MessageFns<UrlRequest> = {
             break;
           }
 
-          message.url = reader.string();
+          message.json = reader.string();
+          continue;
+        }
+        case 2: {
+          if (tag !== 16) {
+            break;
+          }
+
+          message.eventCount = reader.uint32();
           continue;
         }
       }
@@ -110,32 +1305,50 @@ export const UrlRequest: MessageFns<UrlRequest> = {
     return message;
   },
 
-  fromJSON(object: any): UrlRequest {
-    return { url: isSet(object.url) ? globalThis.String(object.url) : "" };
+  fromJSON(object: any): TraceDumpResponse {
+    return {
+      json: isSet(object.json) ? globalThis.String(object.json) : "",
+      eventCount: isSet(object.eventCount)
+        ? globalThis.Number(object.eventCount)
+        : 0,
+    };
   },
 
-  toJSON(message: UrlRequest): unknown {
+  toJSON(message: TraceDumpResponse): unknown {
     const obj: any = {};
-    if (message.url !== "") {
-      obj.url = message.url;
+    if (message.json !== "") {
+      obj.json = message.json;
+    }
+    if (message.eventCount !== 0) {
+      obj.eventCount = message.eventCount;
     }
     return obj;
   },
 
-  create<I extends Exact<DeepPartial<UrlRequest>, I>>(base?: I): UrlRequest {
-    return UrlRequest.fromPartial(base ?? ({} as any));
+  create<I extends Exact<DeepPartial<TraceDumpResponse>, I>>(
+    base?: I,
+  ): TraceDumpResponse {
+    return TraceDumpResponse.fromPartial(base ?? ({} as any));
   },
-  fromPartial<I extends Exact<DeepPartial<UrlRequest>, I>>(
+  fromPartial<I extends Exact<DeepPartial<TraceDumpResponse>, I>>(
     object: I,
-  ): UrlRequest {
-    const message = createBaseUrlRequest();
-    message.url = object.url ?? "";
+  ): TraceDumpResponse {
+    const message = createBaseTraceDumpResponse();
+    message.json = object.json ?? "";
+    message.eventCount = object.eventCount ?? 0;
     return message;
   },
 };
 
 function createBaseRequest(): Request {
-  return { url: undefined };
+  return {
+    url: undefined,
+    startupTrace: undefined,
+    toggleLatency: undefined,
+    stats: undefined,
+    traceControl: undefined,
+    traceDump: undefined,
+  };
 }
 
 export const Request: MessageFns<Request> = {
@@ -146,6 +1359,33 @@ export const Request: MessageFns<Request> = {
     if (message.url !== undefined) {
       UrlRequest.encode(message.url, writer.uint32(10).fork()).join();
     }
+    if (message.startupTrace !== undefined) {
+      StartupTraceRequest.encode(
+        message.startupTrace,
+        writer.uint32(18).fork(),
+      ).join();
+    }
+    if (message.toggleLatency !== undefined) {
+      ToggleLatencyRequest.encode(
+        message.toggleLatency,
+        writer.uint32(26).fork(),
+      ).join();
+    }
+    if (message.stats !== undefined) {
+      StatsRequest.encode(message.stats, writer.uint32(34).fork()).join();
+    }
+    if (message.traceControl !== undefined) {
+      TraceControlRequest.encode(
+        message.traceControl,
+        writer.uint32(42).fork(),
+      ).join();
+    }
+    if (message.traceDump !== undefined) {
+      TraceDumpRequest.encode(
+        message.traceDump,
+        writer.uint32(50).fork(),
+      ).join();
+    }
     return writer;
   },
 
@@ -165,6 +1405,55 @@ export const Request: MessageFns<Request> = {
           message.url = UrlRequest.decode(reader, reader.uint32());
           continue;
         }
+        case 2: {
+          if (tag !== 18) {
+            break;
+          }
+
+          message.startupTrace = StartupTraceRequest.decode(
+            reader,
+            reader.uint32(),
+          );
+          continue;
+        }
+        case 3: {
+          if (tag !== 26) {
+            break;
+          }
+
+          message.toggleLatency = ToggleLatencyRequest.decode(
+            reader,
+            reader.uint32(),
+          );
+          continue;
+        }
+        case 4: {
+          if (tag !== 34) {
+            break;
+          }
+
+          message.stats = StatsRequest.decode(reader, reader.uint32());
+          continue;
+        }
+        case 5: {
+          if (tag !== 42) {
+            break;
+          }
+
+          message.traceControl = TraceControlRequest.decode(
+            reader,
+            reader.uint32(),
+          );
+          continue;
+        }
+        case 6: {
+          if (tag !== 50) {
+            break;
+          }
+
+          message.traceDump = TraceDumpRequest.decode(reader, reader.uint32());
+          continue;
+        }
       }
       if ((tag & 7) === 4 || tag === 0) {
         break;
@@ -177,6 +1466,21 @@ export const Request: MessageFns<Request> = {
   fromJSON(object: any): Request {
     return {
       url: isSet(object.url) ? UrlRequest.fromJSON(object.url) : undefined,
+      startupTrace: isSet(object.startupTrace)
+        ? StartupTraceRequest.fromJSON(object.startupTrace)
+        : undefined,
+      toggleLatency: isSet(object.toggleLatency)
+        ? ToggleLatencyRequest.fromJSON(object.toggleLatency)
+        : undefined,
+      stats: isSet(object.stats)
+        ? StatsRequest.fromJSON(object.stats)
+        : undefined,
+      traceControl: isSet(object.traceControl)
+        ? TraceControlRequest.fromJSON(object.traceControl)
+        : undefined,
+      traceDump: isSet(object.traceDump)
+        ? TraceDumpRequest.fromJSON(object.traceDump)
+        : undefined,
     };
   },
 
@@ -185,6 +1489,21 @@ export const Request: MessageFns<Request> = {
     if (message.url !== undefined) {
       obj.url = UrlRequest.toJSON(message.url);
     }
+    if (message.startupTrace !== undefined) {
+      obj.startupTrace = StartupTraceRequest.toJSON(message.startupTrace);
+    }
+    if (message.toggleLatency !== undefined) {
+      obj.toggleLatency = ToggleLatencyRequest.toJSON(message.toggleLatency);
+    }
+    if (message.stats !== undefined) {
+      obj.stats = StatsRequest.toJSON(message.stats);
+    }
+    if (message.traceControl !== undefined) {
+      obj.traceControl = TraceControlRequest.toJSON(message.traceControl);
+    }
+    if (message.traceDump !== undefined) {
+      obj.traceDump = TraceDumpRequest.toJSON(message.traceDump);
+    }
     return obj;
   },
 
@@ -197,12 +1516,39 @@ export const Request: MessageFns<Request> = {
       object.url !== undefined && object.url !== null
         ? UrlRequest.fromPartial(object.url)
         : undefined;
+    message.startupTrace =
+      object.startupTrace !== undefined && object.startupTrace !== null
+        ? StartupTraceRequest.fromPartial(object.startupTrace)
+        : undefined;
+    message.toggleLatency =
+      object.toggleLatency !== undefined && object.toggleLatency !== null
+        ? ToggleLatencyRequest.fromPartial(object.toggleLatency)
+        : undefined;
+    message.stats =
+      object.stats !== undefined && object.stats !== null
+        ? StatsRequest.fromPartial(object.stats)
+        : undefined;
+    message.traceControl =
+      object.traceControl !== undefined && object.traceControl !== null
+        ? TraceControlRequest.fromPartial(object.traceControl)
+        : undefined;
+    message.traceDump =
+      object.traceDump !== undefined && object.traceDump !== null
+        ? TraceDumpRequest.fromPartial(object.traceDump)
+        : undefined;
     return message;
   },
 };
 
 function createBaseResponse(): Response {
-  return { url: undefined };
+  return {
+    url: undefined,
+    startupTrace: undefined,
+    toggleLatency: undefined,
+    stats: undefined,
+    traceControl: undefined,
+    traceDump: undefined,
+  };
 }
 
 export const Response: MessageFns<Response> = {
@@ -213,6 +1559,33 @@ export const Response: MessageFns<Response> = {
     if (message.url !== undefined) {
       UrlResponse.encode(message.url, writer.uint32(10).fork()).join();
     }
+    if (message.startupTrace !== undefined) {
+      StartupTraceResponse.encode(
+        message.startupTrace,
+        writer.uint32(18).fork(),
+      ).join();
+    }
+    if (message.toggleLatency !== undefined) {
+      ToggleLatencyResponse.encode(
+        message.toggleLatency,
+        writer.uint32(26).fork(),
+      ).join();
+    }
+    if (message.stats !== undefined) {
+      StatsResponse.encode(message.stats, writer.uint32(34).fork()).join();
+    }
+    if (message.traceControl !== undefined) {
+      TraceControlResponse.encode(
+        message.traceControl,
+        writer.uint32(42).fork(),
+      ).join();
+    }
+    if (message.traceDump !== undefined) {
+      TraceDumpResponse.encode(
+        message.traceDump,
+        writer.uint32(50).fork(),
+      ).join();
+    }
     return writer;
   },
 
@@ -232,6 +1605,55 @@ export const Response: MessageFns<Response> = {
           message.url = UrlResponse.decode(reader, reader.uint32());
           continue;
         }
+        case 2: {
+          if (tag !== 18) {
+            break;
+          }
+
+          message.startupTrace = StartupTraceResponse.decode(
+            reader,
+            reader.uint32(),
+          );
+          continue;
+        }
+        case 3: {
+          if (tag !== 26) {
+            break;
+          }
+
+          message.toggleLatency = ToggleLatencyResponse.decode(
+            reader,
+            reader.uint32(),
+          );
+          continue;
+        }
+        case 4: {
+          if (tag !== 34) {
+            break;
+          }
+
+          message.stats = StatsResponse.decode(reader, reader.uint32());
+          continue;
+        }
+        case 5: {
+          if (tag !== 42) {
+            break;
+          }
+
+          message.traceControl = TraceControlResponse.decode(
+            reader,
+            reader.uint32(),
+          );
+          continue;
+        }
+        case 6: {
+          if (tag !== 50) {
+            break;
+          }
+
+          message.traceDump = TraceDumpResponse.decode(reader, reader.uint32());
+          continue;
+        }
       }
       if ((tag & 7) === 4 || tag === 0) {
         break;
@@ -244,6 +1666,21 @@ export const Response: MessageFns<Response> = {
   fromJSON(object: any): Response {
     return {
       url: isSet(object.url) ? UrlResponse.fromJSON(object.url) : undefined,
+      startupTrace: isSet(object.startupTrace)
+        ? StartupTraceResponse.fromJSON(object.startupTrace)
+        : undefined,
+      toggleLatency: isSet(object.toggleLatency)
+        ? ToggleLatencyResponse.fromJSON(object.toggleLatency)
+        : undefined,
+      stats: isSet(object.stats)
+        ? StatsResponse.fromJSON(object.stats)
+        : undefined,
+      traceControl: isSet(object.traceControl)
+        ? TraceControlResponse.fromJSON(object.traceControl)
+        : undefined,
+      traceDump: isSet(object.traceDump)
+        ? TraceDumpResponse.fromJSON(object.traceDump)
+        : undefined,
     };
   },
 
@@ -252,6 +1689,21 @@ export const Response: MessageFns<Response> = {
     if (message.url !== undefined) {
       obj.url = UrlResponse.toJSON(message.url);
     }
+    if (message.startupTrace !== undefined) {
+      obj.startupTrace = StartupTraceResponse.toJSON(message.startupTrace);
+    }
+    if (message.toggleLatency !== undefined) {
+      obj.toggleLatency = ToggleLatencyResponse.toJSON(message.toggleLatency);
+    }
+    if (message.stats !== undefined) {
+      obj.stats = StatsResponse.toJSON(message.stats);
+    }
+    if (message.traceControl !== undefined) {
+      obj.traceControl = TraceControlResponse.toJSON(message.traceControl);
+    }
+    if (message.traceDump !== undefined) {
+      obj.traceDump = TraceDumpResponse.toJSON(message.traceDump);
+    }
     return obj;
   },
 
@@ -264,6 +1716,26 @@ export const Response: MessageFns<Response> = {
       object.url !== undefined && object.url !== null
         ? UrlResponse.fromPartial(object.url)
         : undefined;
+    message.startupTrace =
+      object.startupTrace !== undefined && object.startupTrace !== null
+        ? StartupTraceResponse.fromPartial(object.startupTrace)
+        : undefined;
+    message.toggleLatency =
+      object.toggleLatency !== undefined && object.toggleLatency !== null
+        ? ToggleLatencyResponse.fromPartial(object.toggleLatency)
+        : undefined;
+    message.stats =
+      object.stats !== undefined && object.stats !== null
+        ? StatsResponse.fromPartial(object.stats)
+        : undefined;
+    message.traceControl =
+      object.traceControl !== undefined && object.traceControl !== null
+        ? TraceControlResponse.fromPartial(object.traceControl)
+        : undefined;
+    message.traceDump =
+      object.traceDump !== undefined && object.traceDump !== null
+        ? TraceDumpResponse.fromPartial(object.traceDump)
+        : undefined;
     return message;
   },
 };
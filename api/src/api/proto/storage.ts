@@ -46,12 +46,38 @@ export interface ListResponse_ValuesEntry {
   value: any | undefined;
 }
 
+export interface GetManyRequest {
+  keys: string[];
+}
+
+export interface GetManyResponse {
+  values: { [key: string]: any | undefined };
+}
+
+export interface GetManyResponse_ValuesEntry {
+  key: string;
+  value: any | undefined;
+}
+
+export interface SetManyRequest {
+  values: { [key: string]: any | undefined };
+}
+
+export interface SetManyRequest_ValuesEntry {
+  key: string;
+  value: any | undefined;
+}
+
+export interface SetManyResponse {}
+
 export interface Request {
   get?: GetRequest | undefined;
   set?: SetRequest | undefined;
   remove?: RemoveRequest | undefined;
   clear?: ClearRequest | undefined;
   list?: ListRequest | undefined;
+  getMany?: GetManyRequest | undefined;
+  setMany?: SetManyRequest | undefined;
 }
 
 export interface Response {
@@ -60,6 +86,8 @@ export interface Response {
   remove?: RemoveResponse | undefined;
   clear?: ClearResponse | undefined;
   list?: ListResponse | undefined;
+  getMany?: GetManyResponse | undefined;
+  setMany?: SetManyResponse | undefined;
 }
 
 function createBaseClearRequest(): ClearRequest {
@@ -771,6 +799,507 @@ export const ListResponse_ValuesEntry: MessageFns<ListResponse_ValuesEntry> = {
   },
 };
 
+function createBaseGetManyRequest(): GetManyRequest {
+  return { keys: [] };
+}
+
+export const GetManyRequest: MessageFns<GetManyRequest> = {
+  encode(
+    message: GetManyRequest,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    for (const v of message.keys) {
+      writer.uint32(10).string(v!);
+    }
+    return writer;
+  },
+
+  decode(input: BinaryReader | Uint8Array, length?: number): GetManyRequest {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseGetManyRequest();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+        case 1: {
+          if (tag !== 10) {
+            break;
+          }
+
+          message.keys.push(reader.string());
+          continue;
+        }
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(object: any): GetManyRequest {
+    return {
+      keys: globalThis.Array.isArray(object?.keys)
+        ? object.keys.map((e: any) => globalThis.String(e))
+        : [],
+    };
+  },
+
+  toJSON(message: GetManyRequest): unknown {
+    const obj: any = {};
+    if (message.keys?.length) {
+      obj.keys = message.keys;
+    }
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<GetManyRequest>, I>>(
+    base?: I,
+  ): GetManyRequest {
+    return GetManyRequest.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<GetManyRequest>, I>>(
+    object: I,
+  ): GetManyRequest {
+    const message = createBaseGetManyRequest();
+    message.keys = object.keys?.map((e) => e) || [];
+    return message;
+  },
+};
+
+function createBaseGetManyResponse(): GetManyResponse {
+  return { values: {} };
+}
+
+export const GetManyResponse: MessageFns<GetManyResponse> = {
+  encode(
+    message: GetManyResponse,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    Object.entries(message.values).forEach(([key, value]) => {
+      if (value !== undefined) {
+        GetManyResponse_ValuesEntry.encode(
+          { key: key as any, value },
+          writer.uint32(10).fork(),
+        ).join();
+      }
+    });
+    return writer;
+  },
+
+  decode(input: BinaryReader | Uint8Array, length?: number): GetManyResponse {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseGetManyResponse();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+        case 1: {
+          if (tag !== 10) {
+            break;
+          }
+
+          const entry1 = GetManyResponse_ValuesEntry.decode(
+            reader,
+            reader.uint32(),
+          );
+          if (entry1.value !== undefined) {
+            message.values[entry1.key] = entry1.value;
+          }
+          continue;
+        }
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(object: any): GetManyResponse {
+    return {
+      values: isObject(object.values)
+        ? Object.entries(object.values).reduce<{
+            [key: string]: any | undefined;
+          }>((acc, [key, value]) => {
+            acc[key] = value as any | undefined;
+            return acc;
+          }, {})
+        : {},
+    };
+  },
+
+  toJSON(message: GetManyResponse): unknown {
+    const obj: any = {};
+    if (message.values) {
+      const entries = Object.entries(message.values);
+      if (entries.length > 0) {
+        obj.values = {};
+        entries.forEach(([k, v]) => {
+          obj.values[k] = v;
+        });
+      }
+    }
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<GetManyResponse>, I>>(
+    base?: I,
+  ): GetManyResponse {
+    return GetManyResponse.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<GetManyResponse>, I>>(
+    object: I,
+  ): GetManyResponse {
+    const message = createBaseGetManyResponse();
+    message.values = Object.entries(object.values ?? {}).reduce<{
+      [key: string]: any | undefined;
+    }>((acc, [key, value]) => {
+      if (value !== undefined) {
+        acc[key] = value;
+      }
+      return acc;
+    }, {});
+    return message;
+  },
+};
+
+function createBaseGetManyResponse_ValuesEntry(): GetManyResponse_ValuesEntry {
+  return { key: "", value: undefined };
+}
+
+export const GetManyResponse_ValuesEntry: MessageFns<GetManyResponse_ValuesEntry> =
+  {
+    encode(
+      message: GetManyResponse_ValuesEntry,
+      writer: BinaryWriter = new BinaryWriter(),
+    ): BinaryWriter {
+      if (message.key !== "") {
+        writer.uint32(10).string(message.key);
+      }
+      if (message.value !== undefined) {
+        Value.encode(
+          Value.wrap(message.value),
+          writer.uint32(18).fork(),
+        ).join();
+      }
+      return writer;
+    },
+
+    decode(
+      input: BinaryReader | Uint8Array,
+      length?: number,
+    ): GetManyResponse_ValuesEntry {
+      const reader =
+        input instanceof BinaryReader ? input : new BinaryReader(input);
+      const end = length === undefined ? reader.len : reader.pos + length;
+      const message = createBaseGetManyResponse_ValuesEntry();
+      while (reader.pos < end) {
+        const tag = reader.uint32();
+        switch (tag >>> 3) {
+          case 1: {
+            if (tag !== 10) {
+              break;
+            }
+
+            message.key = reader.string();
+            continue;
+          }
+          case 2: {
+            if (tag !== 18) {
+              break;
+            }
+
+            message.value = Value.unwrap(Value.decode(reader, reader.uint32()));
+            continue;
+          }
+        }
+        if ((tag & 7) === 4 || tag === 0) {
+          break;
+        }
+        reader.skip(tag & 7);
+      }
+      return message;
+    },
+
+    fromJSON(object: any): GetManyResponse_ValuesEntry {
+      return {
+        key: isSet(object.key) ? globalThis.String(object.key) : "",
+        value: isSet(object?.value) ? object.value : undefined,
+      };
+    },
+
+    toJSON(message: GetManyResponse_ValuesEntry): unknown {
+      const obj: any = {};
+      if (message.key !== "") {
+        obj.key = message.key;
+      }
+      if (message.value !== undefined) {
+        obj.value = message.value;
+      }
+      return obj;
+    },
+
+    create<I extends Exact<DeepPartial<GetManyResponse_ValuesEntry>, I>>(
+      base?: I,
+    ): GetManyResponse_ValuesEntry {
+      return GetManyResponse_ValuesEntry.fromPartial(base ?? ({} as any));
+    },
+    fromPartial<I extends Exact<DeepPartial<GetManyResponse_ValuesEntry>, I>>(
+      object: I,
+    ): GetManyResponse_ValuesEntry {
+      const message = createBaseGetManyResponse_ValuesEntry();
+      message.key = object.key ?? "";
+      message.value = object.value ?? undefined;
+      return message;
+    },
+  };
+
+function createBaseSetManyRequest(): SetManyRequest {
+  return { values: {} };
+}
+
+export const SetManyRequest: MessageFns<SetManyRequest> = {
+  encode(
+    message: SetManyRequest,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    Object.entries(message.values).forEach(([key, value]) => {
+      if (value !== undefined) {
+        SetManyRequest_ValuesEntry.encode(
+          { key: key as any, value },
+          writer.uint32(10).fork(),
+        ).join();
+      }
+    });
+    return writer;
+  },
+
+  decode(input: BinaryReader | Uint8Array, length?: number): SetManyRequest {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseSetManyRequest();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+        case 1: {
+          if (tag !== 10) {
+            break;
+          }
+
+          const entry1 = SetManyRequest_ValuesEntry.decode(
+            reader,
+            reader.uint32(),
+          );
+          if (entry1.value !== undefined) {
+            message.values[entry1.key] = entry1.value;
+          }
+          continue;
+        }
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(object: any): SetManyRequest {
+    return {
+      values: isObject(object.values)
+        ? Object.entries(object.values).reduce<{
+            [key: string]: any | undefined;
+          }>((acc, [key, value]) => {
+            acc[key] = value as any | undefined;
+            return acc;
+          }, {})
+        : {},
+    };
+  },
+
+  toJSON(message: SetManyRequest): unknown {
+    const obj: any = {};
+    if (message.values) {
+      const entries = Object.entries(message.values);
+      if (entries.length > 0) {
+        obj.values = {};
+        entries.forEach(([k, v]) => {
+          obj.values[k] = v;
+        });
+      }
+    }
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<SetManyRequest>, I>>(
+    base?: I,
+  ): SetManyRequest {
+    return SetManyRequest.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<SetManyRequest>, I>>(
+    object: I,
+  ): SetManyRequest {
+    const message = createBaseSetManyRequest();
+    message.values = Object.entries(object.values ?? {}).reduce<{
+      [key: string]: any | undefined;
+    }>((acc, [key, value]) => {
+      if (value !== undefined) {
+        acc[key] = value;
+      }
+      return acc;
+    }, {});
+    return message;
+  },
+};
+
+function createBaseSetManyRequest_ValuesEntry(): SetManyRequest_ValuesEntry {
+  return { key: "", value: undefined };
+}
+
+export const SetManyRequest_ValuesEntry: MessageFns<SetManyRequest_ValuesEntry> =
+  {
+    encode(
+      message: SetManyRequest_ValuesEntry,
+      writer: BinaryWriter = new BinaryWriter(),
+    ): BinaryWriter {
+      if (message.key !== "") {
+        writer.uint32(10).string(message.key);
+      }
+      if (message.value !== undefined) {
+        Value.encode(
+          Value.wrap(message.value),
+          writer.uint32(18).fork(),
+        ).join();
+      }
+      return writer;
+    },
+
+    decode(
+      input: BinaryReader | Uint8Array,
+      length?: number,
+    ): SetManyRequest_ValuesEntry {
+      const reader =
+        input instanceof BinaryReader ? input : new BinaryReader(input);
+      const end = length === undefined ? reader.len : reader.pos + length;
+      const message = createBaseSetManyRequest_ValuesEntry();
+      while (reader.pos < end) {
+        const tag = reader.uint32();
+        switch (tag >>> 3) {
+          case 1: {
+            if (tag !== 10) {
+              break;
+            }
+
+            message.key = reader.string();
+            continue;
+          }
+          case 2: {
+            if (tag !== 18) {
+              break;
+            }
+
+            message.value = Value.unwrap(Value.decode(reader, reader.uint32()));
+            continue;
+          }
+        }
+        if ((tag & 7) === 4 || tag === 0) {
+          break;
+        }
+        reader.skip(tag & 7);
+      }
+      return message;
+    },
+
+    fromJSON(object: any): SetManyRequest_ValuesEntry {
+      return {
+        key: isSet(object.key) ? globalThis.String(object.key) : "",
+        value: isSet(object?.value) ? object.value : undefined,
+      };
+    },
+
+    toJSON(message: SetManyRequest_ValuesEntry): unknown {
+      const obj: any = {};
+      if (message.key !== "") {
+        obj.key = message.key;
+      }
+      if (message.value !== undefined) {
+        obj.value = message.value;
+      }
+      return obj;
+    },
+
+    create<I extends Exact<DeepPartial<SetManyRequest_ValuesEntry>, I>>(
+      base?: I,
+    ): SetManyRequest_ValuesEntry {
+      return SetManyRequest_ValuesEntry.fromPartial(base ?? ({} as any));
+    },
+    fromPartial<I extends Exact<DeepPartial<SetManyRequest_ValuesEntry>, I>>(
+      object: I,
+    ): SetManyRequest_ValuesEntry {
+      const message = createBaseSetManyRequest_ValuesEntry();
+      message.key = object.key ?? "";
+      message.value = object.value ?? undefined;
+      return message;
+    },
+  };
+
+function createBaseSetManyResponse(): SetManyResponse {
+  return {};
+}
+
+export const SetManyResponse: MessageFns<SetManyResponse> = {
+  encode(
+    _: SetManyResponse,
+    writer: BinaryWriter = new BinaryWriter(),
+  ): BinaryWriter {
+    return writer;
+  },
+
+  decode(input: BinaryReader | Uint8Array, length?: number): SetManyResponse {
+    const reader =
+      input instanceof BinaryReader ? input : new BinaryReader(input);
+    const end = length === undefined ? reader.len : reader.pos + length;
+    const message = createBaseSetManyResponse();
+    while (reader.pos < end) {
+      const tag = reader.uint32();
+      switch (tag >>> 3) {
+      }
+      if ((tag & 7) === 4 || tag === 0) {
+        break;
+      }
+      reader.skip(tag & 7);
+    }
+    return message;
+  },
+
+  fromJSON(_: any): SetManyResponse {
+    return {};
+  },
+
+  toJSON(_: SetManyResponse): unknown {
+    const obj: any = {};
+    return obj;
+  },
+
+  create<I extends Exact<DeepPartial<SetManyResponse>, I>>(
+    base?: I,
+  ): SetManyResponse {
+    return SetManyResponse.fromPartial(base ?? ({} as any));
+  },
+  fromPartial<I extends Exact<DeepPartial<SetManyResponse>, I>>(
+    _: I,
+  ): SetManyResponse {
+    const message = createBaseSetManyResponse();
+    return message;
+  },
+};
+
 function createBaseRequest(): Request {
   return {
     get: undefined,
@@ -778,6 +1307,8 @@ function createBaseRequest(): Request {
     remove: undefined,
     clear: undefined,
     list: undefined,
+    getMany: undefined,
+    setMany: undefined,
   };
 }
 
@@ -801,6 +1332,12 @@ export const Request: MessageFns<Request> = {
     if (message.list !== undefined) {
       ListRequest.encode(message.list, writer.uint32(42).fork()).join();
     }
+    if (message.getMany !== undefined) {
+      GetManyRequest.encode(message.getMany, writer.uint32(50).fork()).join();
+    }
+    if (message.setMany !== undefined) {
+      SetManyRequest.encode(message.setMany, writer.uint32(58).fork()).join();
+    }
     return writer;
   },
 
@@ -852,6 +1389,22 @@ export const Request: MessageFns<Request> = {
           message.list = ListRequest.decode(reader, reader.uint32());
           continue;
         }
+        case 6: {
+          if (tag !== 50) {
+            break;
+          }
+
+          message.getMany = GetManyRequest.decode(reader, reader.uint32());
+          continue;
+        }
+        case 7: {
+          if (tag !== 58) {
+            break;
+          }
+
+          message.setMany = SetManyRequest.decode(reader, reader.uint32());
+          continue;
+        }
       }
       if ((tag & 7) === 4 || tag === 0) {
         break;
@@ -872,6 +1425,12 @@ export const Request: MessageFns<Request> = {
         ? ClearRequest.fromJSON(object.clear)
         : undefined,
       list: isSet(object.list) ? ListRequest.fromJSON(object.list) : undefined,
+      getMany: isSet(object.getMany)
+        ? GetManyRequest.fromJSON(object.getMany)
+        : undefined,
+      setMany: isSet(object.setMany)
+        ? SetManyRequest.fromJSON(object.setMany)
+        : undefined,
     };
   },
 
@@ -892,6 +1451,12 @@ export const Request: MessageFns<Request> = {
     if (message.list !== undefined) {
       obj.list = ListRequest.toJSON(message.list);
     }
+    if (message.getMany !== undefined) {
+      obj.getMany = GetManyRequest.toJSON(message.getMany);
+    }
+    if (message.setMany !== undefined) {
+      obj.setMany = SetManyRequest.toJSON(message.setMany);
+    }
     return obj;
   },
 
@@ -920,6 +1485,14 @@ export const Request: MessageFns<Request> = {
       object.list !== undefined && object.list !== null
         ? ListRequest.fromPartial(object.list)
         : undefined;
+    message.getMany =
+      object.getMany !== undefined && object.getMany !== null
+        ? GetManyRequest.fromPartial(object.getMany)
+        : undefined;
+    message.setMany =
+      object.setMany !== undefined && object.setMany !== null
+        ? SetManyRequest.fromPartial(object.setMany)
+        : undefined;
     return message;
   },
 };
@@ -931,6 +1504,8 @@ function createBaseResponse(): Response {
     remove: undefined,
     clear: undefined,
     list: undefined,
+    getMany: undefined,
+    setMany: undefined,
   };
 }
 
@@ -954,6 +1529,12 @@ export const Response: MessageFns<Response> = {
     if (message.list !== undefined) {
       ListResponse.encode(message.list, writer.uint32(42).fork()).join();
     }
+    if (message.getMany !== undefined) {
+      GetManyResponse.encode(message.getMany, writer.uint32(50).fork()).join();
+    }
+    if (message.setMany !== undefined) {
+      SetManyResponse.encode(message.setMany, writer.uint32(58).fork()).join();
+    }
     return writer;
   },
 
@@ -1005,6 +1586,22 @@ export const Response: MessageFns<Response> = {
           message.list = ListResponse.decode(reader, reader.uint32());
           continue;
         }
+        case 6: {
+          if (tag !== 50) {
+            break;
+          }
+
+          message.getMany = GetManyResponse.decode(reader, reader.uint32());
+          continue;
+        }
+        case 7: {
+          if (tag !== 58) {
+            break;
+          }
+
+          message.setMany = SetManyResponse.decode(reader, reader.uint32());
+          continue;
+        }
       }
       if ((tag & 7) === 4 || tag === 0) {
         break;
@@ -1025,6 +1622,12 @@ export const Response: MessageFns<Response> = {
         ? ClearResponse.fromJSON(object.clear)
         : undefined,
       list: isSet(object.list) ? ListResponse.fromJSON(object.list) : undefined,
+      getMany: isSet(object.getMany)
+        ? GetManyResponse.fromJSON(object.getMany)
+        : undefined,
+      setMany: isSet(object.setMany)
+        ? SetManyResponse.fromJSON(object.setMany)
+        : undefined,
     };
   },
 
@@ -1045,6 +1648,12 @@ export const Response: MessageFns<Response> = {
     if (message.list !== undefined) {
       obj.list = ListResponse.toJSON(message.list);
     }
+    if (message.getMany !== undefined) {
+      obj.getMany = GetManyResponse.toJSON(message.getMany);
+    }
+    if (message.setMany !== undefined) {
+      obj.setMany = SetManyResponse.toJSON(message.setMany);
+    }
     return obj;
   },
 
@@ -1073,6 +1682,14 @@ export const Response: MessageFns<Response> = {
       object.list !== undefined && object.list !== null
         ? ListResponse.fromPartial(object.list)
         : undefined;
+    message.getMany =
+      object.getMany !== undefined && object.getMany !== null
+        ? GetManyResponse.fromPartial(object.getMany)
+        : undefined;
+    message.setMany =
+      object.setMany !== undefined && object.setMany !== null
+        ? SetManyResponse.fromPartial(object.setMany)
+        : undefined;
     return message;
   },
 };
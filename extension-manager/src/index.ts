@@ -1,5 +1,5 @@
 import { randomUUID } from 'crypto';
-import { isMainThread, Worker } from "worker_threads";
+import { isMainThread, MessageChannel, MessagePort, Worker } from "worker_threads";
 import { main as workerMain } from './worker';
 import { isatty } from "tty";
 
@@ -11,7 +11,72 @@ import { existsSync, mkdirSync } from 'fs';
 import { appendFile, mkdir } from 'fs/promises';
 import { join } from 'path';
 
+const workerEnv = (env: manager.CommandEnv) => ({
+	'NODE_ENV': env == manager.CommandEnv.Development ? 'development' : 'production',
+	'RECONCILER_TRACE': process.env.RECONCILER_TRACE,
+	'VICINAE_COMPILE_CACHE': process.env.VICINAE_COMPILE_CACHE,
+});
+
+type PooledWorker = {
+	worker: Worker;
+	// used to send the launch data, the parent port being reserved to the extension bus
+	control: MessagePort;
+	// only listens while the worker is idle, the session installs its own handler once it is taken
+	onIdleError: (error: Error) => void;
+};
+
+/**
+ * Production workers started ahead of time, so that launching a command doesn't have to wait
+ * for a new thread to boot and evaluate the whole runtime.
+ * Development workers are not pooled, as the environment decides which React build gets loaded.
+ */
+class WorkerPool {
+	private readonly idle: PooledWorker[] = [];
+
+	private spawn() {
+		const { port1, port2 } = new MessageChannel();
+		const worker = new Worker(__filename, {
+			workerData: { control: port2 },
+			transferList: [port2],
+			stdout: true,
+			env: workerEnv(manager.CommandEnv.Production),
+		});
+		const onIdleError = (error: Error) => {
+			// an unhandled 'error' event would take the whole manager down
+			console.error(`pooled worker failed before being used`, error);
+		};
+		const pooled = { worker, control: port1, onIdleError };
+
+		worker.on('error', onIdleError);
+		worker.once('exit', () => {
+			const idx = this.idle.indexOf(pooled);
+			if (idx !== -1) this.idle.splice(idx, 1);
+		});
+
+		this.idle.push(pooled);
+	}
+
+	fill() {
+		while (this.idle.length < this.size) this.spawn();
+	}
+
+	/**
+	 * Take an idle worker out of the pool, if any. The pool is refilled in the background.
+	 */
+	take(): PooledWorker | undefined {
+		const pooled = this.idle.shift();
+
+		pooled?.worker.off('error', pooled.onIdleError);
+		setImmediate(() => this.fill());
+
+		return pooled;
+	}
+
+	constructor(private readonly size: number) {}
+};
+
 class Vicinae {
+	private readonly pool = new WorkerPool(2);
 	private readonly workerMap = new Map<string, Worker>;
 	private readonly requestMap = new Map<string, Worker>;
 	private currentMessage: { data: Buffer }= {
@@ -59,27 +124,32 @@ class Vicinae {
 				mkdir(assetsPath, { recursive: true })
 			]);
 
-			const worker = new Worker(__filename, {
-				workerData: {
-					// the transpiled JS file to execute
-					entrypoint: load.entrypoint,
-					preferenceValues: load.preferenceValues,
-					launchProps: { arguments: load.argumentValues },
-					commandMode: load.mode == manager.CommandMode.View ? "view" : "no-view",
-					supportPath,
-					assetsPath,
-					vicinaeVersion: {
-						tag: process.env.VICINAE_VERSION ?? 'unknown',
-						commit: process.env.VICINAE_COMMIT ?? 'unknown',
-					}
-				},
-
-				stdout: true,
-				env: {
-					'NODE_ENV': load.env == manager.CommandEnv.Development ? 'development' : 'production',
-					'RECONCILER_TRACE': process.env.RECONCILER_TRACE,
+			const launchData = {
+				// the transpiled JS file to execute
+				entrypoint: load.entrypoint,
+				preferenceValues: load.preferenceValues,
+				launchProps: { arguments: load.argumentValues },
+				commandMode: load.mode == manager.CommandMode.View ? "view" : "no-view",
+				supportPath,
+				assetsPath,
+				vicinaeVersion: {
+					tag: process.env.VICINAE_VERSION ?? 'unknown',
+					commit: process.env.VICINAE_COMMIT ?? 'unknown',
 				}
-			});
+			};
+			const pooled = load.env === manager.CommandEnv.Production ? this.pool.take() : undefined;
+			let worker: Worker;
+
+			if (pooled) {
+				worker = pooled.worker;
+				pooled.control.postMessage(launchData);
+			} else {
+				worker = new Worker(__filename, {
+					workerData: launchData,
+					stdout: true,
+					env: workerEnv(load.env),
+				});
+			}
 
 			this.workerMap.set(sessionId, worker);
 			
@@ -223,6 +293,7 @@ class Vicinae {
 	}
 
 	constructor() {
+		this.pool.fill();
 		process.stdin.on('error', (error) => {
 			throw new Error(`${error}`);
 		});
@@ -231,7 +302,8 @@ class Vicinae {
 };
 
 const main = async () => {
-	if (!isMainThread) workerMain();
+	// workers evaluate this same bundle
+	if (!isMainThread) return workerMain();
 
 	if (isatty(process.stdout.fd)) {
 		console.error('Running the extension manager from a TTY is not supported.');
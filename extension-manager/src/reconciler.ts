@@ -113,10 +113,16 @@ type InstanceType = string;
 type InstanceProps = Record<string, any>;
 type Instance = {
 	id: Symbol,
+	// numeric id used to address this node in render patches sent to the host
+	nodeId: number;
 	type: InstanceType,
 	props: InstanceProps;
 	dirty: boolean;
 	propsDirty: boolean;
+	// whether the host knows about this node, i.e it was part of a previous render
+	mounted: boolean;
+	// node ids of the children as last sent to the host
+	sentChildren: number[];
 	parent?: Instance;
 	children: Instance[];
 };
@@ -134,6 +140,8 @@ type NoTimeout = number;
 const ctx: HostContext = {
 };
 
+let nextNodeId = 1;
+
 const emitDirty = (instance?: Instance) => {
 	let current: Instance | undefined = instance;
 
@@ -195,11 +203,14 @@ const createHostConfig = (hostCtx: HostContext, callback: () => void) => {
 
 			return {
 				id: Symbol(type),
+				nodeId: nextNodeId++,
 				type,
 				props: sanitizeProps(rest),
 				children: [],
 				dirty: true,
 				propsDirty: true,
+				mounted: false,
+				sentChildren: [],
 			}
 		},
 
@@ -384,6 +395,7 @@ const createHostConfig = (hostCtx: HostContext, callback: () => void) => {
 
 		clearContainer(container) {
 			container.children = [];
+			emitDirty(container);
 		},
 	};
 
@@ -394,13 +406,30 @@ export type ViewData = {
 	root: SerializedInstance;
 };
 
+/**
+ * A single mutation of the render tree, addressed by node id.
+ * The root container always has node id 0.
+ */
+export type RenderPatch =
+	| { op: 'insert', parent: number, index: number, node: SerializedInstance }
+	| { op: 'remove', parent: number, id: number }
+	| { op: 'move', parent: number, id: number, index: number }
+	| { op: 'update', id: number, props: InstanceProps };
+
+/**
+ * The first render ships the full tree, subsequent renders only
+ * ship the patches required to bring the host copy up to date.
+ */
+export type RenderUpdate = { views: ViewData[] } | { patches: RenderPatch[] };
+
 export type RendererConfig = {
 	maxRendersPerSecond?: number,
 	onInitialRender: (views: ViewData[]) => void
-	onUpdate?: (views: ViewData[]) => void;
+	onUpdate?: (update: RenderUpdate) => void;
 };
 
 type SerializedInstance = {
+	id: number;
 	props: InstanceProps;
 	type: string;
 	dirty: boolean;
@@ -410,6 +439,7 @@ type SerializedInstance = {
 
 const serializeInstance = (instance: Instance): SerializedInstance => {
 	const obj: SerializedInstance = {
+		id: instance.nodeId,
 		props: instance.props,
 		type: instance.type,
 		dirty: instance.dirty,
@@ -419,22 +449,83 @@ const serializeInstance = (instance: Instance): SerializedInstance => {
 
 	instance.dirty = false;
 	instance.propsDirty = false;
+	instance.mounted = true;
+	instance.sentChildren = new Array<number>(instance.children.length);
 
 	let i = 0;
 
 	for (const child of instance.children) {
+		instance.sentChildren[i] = child.nodeId;
 		obj.children[i++] = serializeInstance(child);
 	}
 	
 	return obj;
 }
 
+/**
+ * Walk the dirty part of the tree and compute the patches needed to transform
+ * what the host last received into the current tree.
+ */
+const collectPatches = (instance: Instance, patches: RenderPatch[]) => {
+	if (instance.propsDirty) {
+		patches.push({ op: 'update', id: instance.nodeId, props: instance.props });
+		instance.propsDirty = false;
+	}
+
+	if (!instance.dirty) return ;
+
+	instance.dirty = false;
+
+	const parent = instance.nodeId;
+	const nextIds = new Set<number>();
+
+	for (const child of instance.children) nextIds.add(child.nodeId);
+
+	const working: number[] = [];
+
+	for (const id of instance.sentChildren) {
+		if (nextIds.has(id)) {
+			working.push(id);
+		} else {
+			patches.push({ op: 'remove', parent, id });
+		}
+	}
+
+	for (let i = 0; i != instance.children.length; ++i) {
+		const child = instance.children[i];
+
+		if (working[i] === child.nodeId) continue ;
+
+		if (!child.mounted) {
+			patches.push({ op: 'insert', parent, index: i, node: serializeInstance(child) });
+			working.splice(i, 0, child.nodeId);
+			continue ;
+		}
+
+		const from = working.indexOf(child.nodeId, i);
+
+		working.splice(from, 1);
+		working.splice(i, 0, child.nodeId);
+		patches.push({ op: 'move', parent, id: child.nodeId, index: i });
+	}
+
+	instance.sentChildren = working;
+
+	// freshly inserted children were serialized with clean flags, so this is a no-op for them
+	for (const child of instance.children) {
+		collectPatches(child, patches);
+	}
+}
+
 const createContainer = (): Container => {
 	return {
 		id: Symbol('root'),
+		nodeId: 0,
 		type: 'root',
 		dirty: true,
 		propsDirty: false,
+		mounted: false,
+		sentChildren: [],
 		props: {},
 		children: []
 	}
@@ -455,22 +546,23 @@ export const createRenderer = (config: RendererConfig) => {
 				debounce = null;
 
 				const start = performance.now();
-				const views: ViewData[] = [];
-				const root = serializeInstance(container);
-
 
-				//writeFileSync('/tmp/render.txt', `${inspect(root, { depth: null, colors: true })}`);
-				//appendFileSync('/tmp/render.txt', JSON.stringify(root, null, 2));
+				//writeFileSync('/tmp/render.txt', `${inspect(container, { depth: null, colors: true })}`);
 
-				for (let i = 0; i != root.children.length; ++i) {
-					const view = root.children[i];
+				if (!container.mounted) {
+					const root = serializeInstance(container);
+					const views: ViewData[] = root.children.map((view) => ({ root: view }));
 
-					views.push({ root: view });
-				}
+					config.onUpdate?.({ views });
+				} else {
+					const patches: RenderPatch[] = [];
 
-				//console.error(JSON.stringify({ views }, null, 2));
+					collectPatches(container, patches);
 
-				config.onUpdate?.(views)
+					if (patches.length > 0) {
+						config.onUpdate?.({ patches });
+					}
+				}
 
 				const end = performance.now();
 
@@ -491,6 +583,15 @@ export const createRenderer = (config: RendererConfig) => {
 			}
 
 			reconciler.updateContainer(element, container._root, null, renderImpl);
+		},
+
+		/**
+		 * Ship the full tree on the next render, for when the host could not apply our patches
+		 * and dropped its copy of the tree.
+		 */
+		resync() {
+			container.mounted = false;
+			renderImpl();
 		}
 	}
 }
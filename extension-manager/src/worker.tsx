@@ -1,6 +1,7 @@
-import { parentPort, workerData } from "worker_threads";
+import { MessagePort, parentPort, workerData } from "worker_threads";
+import Module from "module";
 import { createRenderer } from './reconciler';
-import { LaunchType, NavigationProvider, bus, environment } from '@vicinae/api';
+import { LaunchType, NavigationProvider, bus, environment, setPreferenceValues } from '@vicinae/api';
 import { ComponentType, ReactNode, Suspense } from "react";
 import * as React from 'react';
 import { patchRequire } from "./patch-require";
@@ -37,8 +38,18 @@ const App: React.FC<{ component: ComponentType, launchProps: any }> = ({ compone
 	)
 }
 
-const loadEnviron = () => {
-	const { supportPath, assetsPath, commandMode, vicinaeVersion } = workerData;
+type LaunchData = {
+	entrypoint: string;
+	preferenceValues: Record<string, any>;
+	launchProps: any;
+	commandMode: 'view' | 'no-view';
+	supportPath: string;
+	assetsPath: string;
+	vicinaeVersion: { tag: string, commit: string };
+};
+
+const loadEnviron = (data: LaunchData) => {
+	const { supportPath, assetsPath, commandMode, vicinaeVersion } = data;
 
 	environment.textSize = 'medium';
 	environment.appearance = 'dark';
@@ -50,10 +61,13 @@ const loadEnviron = () => {
 	environment.raycastVersion = '1.0.0'; // provided for compatibility only, not meaningful
 	environment.launchType = LaunchType.UserInitiated;
 	environment.vicinaeVersion = vicinaeVersion;
+
+	// pooled workers get their launch data after they started, so `workerData` can't be relied upon
+	setPreferenceValues(data.preferenceValues);
 }
 
-const loadView = async () => {
-	const module = await import(workerData.entrypoint);
+const loadView = async (data: LaunchData) => {
+	const module = await import(data.entrypoint);
 	const Component = module.default.default;
 
 	process.on('uncaughtException', (error) => {
@@ -66,44 +80,71 @@ const loadView = async () => {
 		onInitialRender: (views) => {
 			bus.turboRequest('ui.render', { json: JSON.stringify({ views }) });
 		},
-		onUpdate: (views) => {
+		onUpdate: (update) => {
 			const now = performance.now();
 			lastRender = now;
-			bus.turboRequest('ui.render', { json: JSON.stringify({ views }) });
+			bus.turboRequest('ui.render', { json: JSON.stringify(update) });
 		}
 	});
 
-	renderer.render(<App launchProps={workerData.launchProps} component={Component} />);
+	bus.subscribe('render-resync', () => renderer.resync());
+	renderer.render(<App launchProps={data.launchProps} component={Component} />);
 }
 
-const loadNoView = async () => {
-	const module = await import(workerData.entrypoint);
+const loadNoView = async (data: LaunchData) => {
+	const module = await import(data.entrypoint);
 	const entrypoint = module.default.default;
 
 	if (typeof entrypoint !== 'function') {
 		throw new Error(`no-view command does not export a function as its default export`);
 	}
 
-	await entrypoint(workerData.launchProps);
+	await entrypoint(data.launchProps);
+}
+
+/**
+ * Cache the V8 bytecode of the extension code on disk, so that it doesn't need to be compiled again
+ * on the next launch. Only available starting with Node 22.1, ignored otherwise.
+ */
+const enableCompileCache = () => {
+	const directory = process.env.VICINAE_COMPILE_CACHE;
+	const enable = (Module as any).enableCompileCache;
+
+	if (directory && typeof enable === 'function') enable(directory);
 }
 
+/**
+ * Pooled workers are started before we know what command they are going to run: the launch data
+ * is sent later through a dedicated port.
+ */
+const waitForLaunch = (control: MessagePort) => new Promise<LaunchData>((resolve) => {
+	control.once('message', (data: LaunchData) => {
+		control.close();
+		resolve(data);
+	});
+});
+
 export const main = async () => {
 	if (!parentPort) {
 		console.error(`Unable to get workerData. Is this code running inside a NodeJS worker? Manually invoking this runtime is not supported.`)
 		return ;
 	}
 
+	enableCompileCache();
 	patchRequire();
-	loadEnviron();
+
+	const data: LaunchData = workerData.control ? await waitForLaunch(workerData.control) : workerData;
+
+	loadEnviron(data);
 
 	(process as any).noDeprecation = !environment.isDevelopment;
 
 	if (environment.commandMode == 'view') {
-		await loadView();
+		await loadView(data);
 	}
 
 	else if (environment.commandMode == 'no-view') {
-		await loadNoView();
+		await loadNoView(data);
 	}
 
 	bus.emit('exit', {});
@@ -0,0 +1,57 @@
+#include "datasets.hpp"
+#include "services/clipboard/clipboard-db.hpp"
+#include <benchmark/benchmark.h>
+
+static constexpr size_t CLIPBOARD_ENTRY_COUNT = 50'000;
+
+/**
+ * Clipboard history with fifty thousand text selections, built once for all the benchmarks.
+ */
+static ClipboardDatabase &populatedDatabase() {
+  static ClipboardDatabase *db = []() {
+    auto db = new ClipboardDatabase;
+    auto rng = Datasets::generator();
+
+    db->runMigrations();
+    db->transaction([&](ClipboardDatabase &tx) {
+      for (size_t i = 0; i < CLIPBOARD_ENTRY_COUNT; ++i) {
+        QString selectionId = QString("selection-%1").arg(i);
+        QString text = Datasets::words(rng, 1, 24);
+
+        tx.insertSelection({.id = selectionId,
+                            .offerCount = 1,
+                            .hash = QString::number(i),
+                            .preferredMimeType = "text/plain",
+                            .kind = ClipboardOfferKind::Text});
+        tx.insertOffer({.id = QString("offer-%1").arg(i),
+                        .selectionId = selectionId,
+                        .mimeType = "text/plain",
+                        .textPreview = text,
+                        .md5sum = QString::number(i),
+                        .encryption = ClipboardEncryptionType::None,
+                        .kind = ClipboardOfferKind::Text,
+                        .size = static_cast<quint64>(text.size())});
+        tx.indexSelectionContent(selectionId, text);
+      }
+
+      return true;
+    });
+
+    return db;
+  }();
+
+  return *db;
+}
+
+static void BM_ClipboardListAll(benchmark::State &state, const QString &query) {
+  auto &db = populatedDatabase();
+  ClipboardListSettings opts{.query = query};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(db.listAll(100, 0, opts));
+  }
+}
+
+BENCHMARK_CAPTURE(BM_ClipboardListAll, no_query, QString())->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ClipboardListAll, word, QString("invoice"))->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_ClipboardListAll, prefix, QString("scr"))->Unit(benchmark::kMillisecond);
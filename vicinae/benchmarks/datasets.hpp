@@ -0,0 +1,66 @@
+#pragma once
+#include <QString>
+#include <array>
+#include <filesystem>
+#include <random>
+#include <string_view>
+#include <vector>
+
+/**
+ * Synthetic but realistic looking data, generated deterministically so that results can be compared
+ * from one run to another.
+ */
+namespace Datasets {
+
+static constexpr std::array<std::string_view, 48> WORDS = {
+    "firefox", "visual",   "studio",  "code",    "terminal", "settings", "calculator", "files",
+    "music",   "player",   "system",  "monitor", "image",    "viewer",   "text",       "editor",
+    "network", "manager",  "disk",    "usage",   "clock",    "weather",  "calendar",   "mail",
+    "chat",    "document", "project", "report",  "invoice",  "notes",    "backup",     "config",
+    "build",   "release",  "photo",   "video",   "archive",  "download", "screenshot", "theme",
+    "kitty",   "spotify",  "discord", "obsidian", "blender", "gimp",     "inkscape",   "steam"};
+
+inline std::mt19937 generator() { return std::mt19937(42); }
+
+inline QString words(std::mt19937 &rng, int min, int max) {
+  std::uniform_int_distribution<size_t> word(0, WORDS.size() - 1);
+  std::uniform_int_distribution<int> count(min, max);
+  QString text;
+
+  for (int i = count(rng); i > 0; --i) {
+    if (!text.isEmpty()) text += ' ';
+    text += QLatin1StringView(WORDS[word(rng)]);
+  }
+
+  return text;
+}
+
+/**
+ * File paths spread over a tree of nested directories, the way a home directory usually looks.
+ */
+inline std::vector<std::filesystem::path> filePaths(size_t count, size_t offset = 0) {
+  static constexpr std::array<std::string_view, 6> EXTENSIONS = {".txt", ".png", ".pdf",
+                                                                 ".cpp", ".md",  ".json"};
+  auto rng = generator();
+  std::uniform_int_distribution<size_t> word(0, WORDS.size() - 1);
+  std::uniform_int_distribution<size_t> ext(0, EXTENSIONS.size() - 1);
+  std::uniform_int_distribution<int> depth(1, 6);
+  std::vector<std::filesystem::path> paths;
+
+  paths.reserve(count);
+
+  for (size_t i = offset; i < offset + count; ++i) {
+    std::filesystem::path path = "/home/benchmark";
+
+    for (int d = depth(rng); d > 0; --d) {
+      path /= WORDS[word(rng)];
+    }
+
+    path /= std::string(WORDS[word(rng)]) + "-" + std::to_string(i) + std::string(EXTENSIONS[ext(rng)]);
+    paths.emplace_back(std::move(path));
+  }
+
+  return paths;
+}
+
+} // namespace Datasets
@@ -0,0 +1,61 @@
+#include "datasets.hpp"
+#include "services/files-service/file-indexer/file-indexer-db.hpp"
+#include <benchmark/benchmark.h>
+
+static constexpr size_t INDEXED_FILE_COUNT = 1'000'000;
+static constexpr size_t INDEX_BATCH_SIZE = 10'000;
+
+/**
+ * Database holding an index of a million files, built once for all the search benchmarks.
+ */
+static FileIndexerDatabase &populatedDatabase() {
+  static FileIndexerDatabase *db = []() {
+    auto db = new FileIndexerDatabase;
+
+    db->runMigrations();
+
+    for (size_t offset = 0; offset < INDEXED_FILE_COUNT; offset += INDEX_BATCH_SIZE) {
+      db->indexFiles(Datasets::filePaths(INDEX_BATCH_SIZE, offset));
+    }
+
+    return db;
+  }();
+
+  return *db;
+}
+
+static void BM_FileIndexerIndexFiles(benchmark::State &state) {
+  FileIndexerDatabase db;
+  size_t batchSize = state.range(0);
+  // the paths indexed by previous iterations must not be updated in place
+  size_t offset = INDEXED_FILE_COUNT;
+
+  db.runMigrations();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto paths = Datasets::filePaths(batchSize, offset);
+    offset += batchSize;
+    state.ResumeTiming();
+
+    db.indexFiles(paths);
+  }
+
+  state.SetItemsProcessed(state.iterations() * batchSize);
+}
+
+BENCHMARK(BM_FileIndexerIndexFiles)->Arg(1'000)->Arg(INDEX_BATCH_SIZE)->Unit(benchmark::kMillisecond);
+
+static void BM_FileIndexerSearch(benchmark::State &state, std::string_view query) {
+  auto &db = populatedDatabase();
+  AbstractFileIndexer::QueryParams params;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(db.search(query, params));
+  }
+}
+
+BENCHMARK_CAPTURE(BM_FileIndexerSearch, prefix, std::string_view("scr"))->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FileIndexerSearch, word, std::string_view("screenshot"))->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FileIndexerSearch, two_words, std::string_view("project report"))
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,95 @@
+#include "extension/manager/extension-manager.hpp"
+#include <QtEndian>
+#include <benchmark/benchmark.h>
+#include <qiodevice.h>
+
+/**
+ * In-memory device feeding the bus with pre-encoded data, as if it came from the extension manager.
+ */
+class FrameSource : public QIODevice {
+  QByteArray m_data;
+  qsizetype m_pos = 0;
+
+protected:
+  qint64 readData(char *data, qint64 maxSize) override {
+    qint64 size = std::min<qint64>(maxSize, m_data.size() - m_pos);
+
+    std::memcpy(data, m_data.constData() + m_pos, size);
+    m_pos += size;
+
+    return size;
+  }
+
+  qint64 writeData(const char *, qint64 size) override { return size; }
+
+public:
+  bool isSequential() const override { return true; }
+  qint64 bytesAvailable() const override { return m_data.size() - m_pos; }
+
+  void feed(const QByteArray &data) {
+    m_data = data;
+    m_pos = 0;
+    emit readyRead();
+  }
+
+  FrameSource() { open(QIODevice::ReadWrite | QIODevice::Unbuffered); }
+};
+
+/**
+ * A length prefixed render request, carrying a list of `itemCount` items.
+ */
+static QByteArray renderFrame(size_t itemCount) {
+  QJsonArray items;
+
+  for (size_t i = 0; i < itemCount; ++i) {
+    items.append(QJsonObject{{"type", "list-item"},
+                             {"props", QJsonObject{{"id", QString::number(i)},
+                                                   {"title", QString("Item %1").arg(i)},
+                                                   {"subtitle", "Some subtitle"}}}});
+  }
+
+  QJsonObject root{{"type", "list"}, {"props", QJsonObject{}}, {"children", items}};
+  QJsonArray views{QJsonObject{{"root", root}}};
+  QJsonObject tree{{"views", views}};
+
+  proto::ext::IpcMessage message;
+  auto qualified = message.mutable_extension_request();
+
+  qualified->set_session_id("benchmark");
+  qualified->mutable_request()->set_request_id("request");
+  qualified->mutable_request()->mutable_data()->mutable_ui()->mutable_render()->set_json(
+      QJsonDocument(tree).toJson(QJsonDocument::Compact).toStdString());
+
+  std::string data = message.SerializeAsString();
+  QByteArray frame(sizeof(uint32_t), Qt::Uninitialized);
+
+  qToBigEndian<uint32_t>(data.size(), frame.data());
+  frame.append(QByteArray::fromStdString(data));
+
+  return frame;
+}
+
+/**
+ * Decode a hundred frames, delivered in chunks of `state.range(1)` bytes as a socket would.
+ */
+static void BM_BusDecodeFrames(benchmark::State &state) {
+  static constexpr size_t FRAME_COUNT = 100;
+  FrameSource source;
+  Bus bus(&source);
+  QByteArray stream = renderFrame(state.range(0)).repeated(FRAME_COUNT);
+  qsizetype chunkSize = state.range(1);
+
+  for (auto _ : state) {
+    for (qsizetype offset = 0; offset < stream.size(); offset += chunkSize) {
+      source.feed(stream.sliced(offset, std::min(chunkSize, stream.size() - offset)));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * FRAME_COUNT);
+  state.SetBytesProcessed(state.iterations() * stream.size());
+}
+
+BENCHMARK(BM_BusDecodeFrames)
+    ->ArgsProduct({{10, 1'000}, {4'096, 65'536}})
+    ->ArgNames({"items", "chunk"})
+    ->Unit(benchmark::kMillisecond);
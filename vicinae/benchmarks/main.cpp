@@ -0,0 +1,30 @@
+#include "vicinae.hpp"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <qapplication.h>
+#include <qstandardpaths.h>
+
+int main(int argc, char **argv) {
+  // widgets are laid out but never shown, no need for a display
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  QApplication app(argc, argv);
+
+  QApplication::setApplicationName("vicinae-benchmarks");
+  // databases are created in a throwaway location, never in the user's data directory
+  QStandardPaths::setTestModeEnabled(true);
+
+  std::error_code ec;
+
+  std::filesystem::remove_all(Omnicast::dataDir(), ec);
+  std::filesystem::create_directories(Omnicast::dataDir(), ec);
+
+  benchmark::Initialize(&argc, argv);
+
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  return 0;
+}
@@ -0,0 +1,143 @@
+#include "datasets.hpp"
+#include "extend/model-parser.hpp"
+#include "ui/omni-list/omni-list.hpp"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <qpixmap.h>
+#include <qscrollbar.h>
+
+/**
+ * A list render tree as sent by an extension, made of sections of fifty items each.
+ */
+static QJsonArray listRenderTree(size_t itemCount) {
+  auto rng = Datasets::generator();
+  QJsonArray sections;
+  QJsonArray items;
+
+  for (size_t i = 0; i < itemCount; ++i) {
+    QJsonObject props{{"id", QString::number(i)},
+                      {"title", Datasets::words(rng, 1, 4)},
+                      {"subtitle", Datasets::words(rng, 0, 3)},
+                      {"icon", QJsonObject{{"source", "app-window"}}},
+                      {"keywords", QJsonArray{Datasets::words(rng, 1, 1)}},
+                      {"accessories", QJsonArray{QJsonObject{{"text", Datasets::words(rng, 1, 1)}}}}};
+
+    items.append(QJsonObject{{"type", "list-item"}, {"props", props}, {"children", QJsonArray{}}});
+
+    if (items.size() == 50 || i == itemCount - 1) {
+      sections.append(QJsonObject{{"type", "list-section"},
+                                  {"props", QJsonObject{{"title", Datasets::words(rng, 1, 2)}}},
+                                  {"children", std::exchange(items, {})}});
+    }
+  }
+
+  QJsonObject root{{"type", "list"}, {"props", QJsonObject{}}, {"children", sections}};
+
+  return QJsonArray{QJsonObject{{"root", root}}};
+}
+
+static void BM_ModelParserParse(benchmark::State &state) {
+  auto tree = listRenderTree(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ModelParser().parse(tree));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ModelParserParse)->Arg(100)->Arg(1'000)->Arg(10'000)->Unit(benchmark::kMillisecond);
+
+class BenchmarkListItem : public AbstractDefaultListItem {
+  QString m_id;
+  QString m_name;
+
+  QString generateId() const override { return m_id; }
+  ItemData data() const override { return {.name = m_name}; }
+
+public:
+  BenchmarkListItem(const QString &id, const QString &name) : m_id(id), m_name(name) {}
+};
+
+/**
+ * Reset the model of a list, which lays out every item again.
+ */
+static void BM_OmniListResetModel(benchmark::State &state) {
+  auto rng = Datasets::generator();
+  std::vector<std::shared_ptr<BenchmarkListItem>> items;
+  OmniList list;
+
+  list.resize(800, 600);
+
+  for (int i = 0; i < state.range(0); ++i) {
+    items.emplace_back(std::make_shared<BenchmarkListItem>(QString::number(i), Datasets::words(rng, 1, 4)));
+  }
+
+  for (auto _ : state) {
+    list.updateModel([&]() {
+      auto &section = list.addSection("Benchmark");
+
+      for (const auto &item : items) {
+        section.addItem(item);
+      }
+    });
+  }
+
+  state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+BENCHMARK(BM_OmniListResetModel)->Arg(100)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
+
+/**
+ * Scroll a list the way a mouse wheel does, three rows at a time, laying out and painting the visible
+ * rows at each step: the time of an iteration is the time of a frame. Wraps around once the bottom of
+ * the list is reached.
+ */
+static void BM_OmniListScroll(benchmark::State &state) {
+  auto rng = Datasets::generator();
+  OmniList list;
+
+  list.resize(800, 600);
+  list.updateModel([&]() {
+    auto &section = list.addSection("Benchmark");
+
+    for (int i = 0; i < state.range(0); ++i) {
+      section.addItem(std::make_shared<BenchmarkListItem>(QString::number(i), Datasets::words(rng, 1, 4)));
+    }
+  });
+
+  using Clock = std::chrono::steady_clock;
+
+  auto scrollBar = list.findChild<QScrollBar *>(Qt::FindDirectChildrenOnly);
+  QPixmap frame(list.size());
+  Clock::duration layout{0};
+  Clock::duration paint{0};
+
+  for (auto _ : state) {
+    int value = scrollBar->value() + scrollBar->singleStep() * 3;
+    auto start = Clock::now();
+
+    // releasing the slider lays out the visible rows right away, wheel events are throttled
+    scrollBar->setSliderDown(true);
+    scrollBar->setValue(value > scrollBar->maximum() ? 0 : value);
+    scrollBar->setSliderDown(false);
+
+    auto laidOut = Clock::now();
+
+    list.render(&frame);
+    layout += laidOut - start;
+    paint += Clock::now() - laidOut;
+  }
+
+  // average time spent in each phase of a frame, in microseconds
+  auto perFrame = [&](Clock::duration total) {
+    return benchmark::Counter(std::chrono::duration<double, std::micro>(total).count(),
+                              benchmark::Counter::kAvgIterations);
+  };
+
+  state.counters["layout_us"] = perFrame(layout);
+  state.counters["paint_us"] = perFrame(paint);
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_OmniListScroll)->Arg(1'000)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,97 @@
+#include "datasets.hpp"
+#include "root-search.hpp"
+#include "services/root-item-manager/root-item-manager.hpp"
+#include "trie.hpp"
+#include <benchmark/benchmark.h>
+
+static constexpr size_t ROOT_ITEM_COUNT = 10'000;
+
+class BenchmarkRootItem : public RootItem {
+  QString m_id;
+  QString m_name;
+  QString m_subtitle;
+  std::vector<QString> m_keywords;
+
+public:
+  QString providerId() const override { return "benchmark"; }
+  QString uniqueId() const override { return m_id; }
+  QString displayName() const override { return m_name; }
+  QString subtitle() const override { return m_subtitle; }
+  QString typeDisplayName() const override { return "Benchmark"; }
+  ImageURL iconUrl() const override { return ImageURL::builtin("app-window"); }
+  std::vector<QString> keywords() const override { return m_keywords; }
+
+  BenchmarkRootItem(const QString &id, const QString &name, const QString &subtitle,
+                    std::vector<QString> keywords)
+      : m_id(id), m_name(name), m_subtitle(subtitle), m_keywords(std::move(keywords)) {}
+};
+
+static const std::vector<std::shared_ptr<RootItem>> &rootItems() {
+  static std::vector<std::shared_ptr<RootItem>> items = []() {
+    auto rng = Datasets::generator();
+    std::vector<std::shared_ptr<RootItem>> items;
+
+    items.reserve(ROOT_ITEM_COUNT);
+
+    for (size_t i = 0; i < ROOT_ITEM_COUNT; ++i) {
+      items.emplace_back(std::make_shared<BenchmarkRootItem>(
+          QString("benchmark.%1").arg(i), Datasets::words(rng, 1, 3), Datasets::words(rng, 0, 2),
+          std::vector<QString>{Datasets::words(rng, 1, 1), Datasets::words(rng, 1, 1)}));
+    }
+
+    return items;
+  }();
+
+  return items;
+}
+
+static void BM_RootSearch(benchmark::State &state, const QString &query) {
+  std::unordered_map<QString, RootItemMetadata> metadata;
+  RootSearcher searcher(metadata);
+  auto &items = rootItems();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(searcher.search(items, query));
+  }
+
+  state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+BENCHMARK_CAPTURE(BM_RootSearch, single_char, QString("f"))->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RootSearch, word, QString("firefox"))->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_RootSearch, two_words, QString("visual studio"))->Unit(benchmark::kMillisecond);
+
+static void BM_TrieIndex(benchmark::State &state) {
+  auto &items = rootItems();
+
+  for (auto _ : state) {
+    Trie<size_t> trie;
+
+    for (size_t i = 0; i < items.size(); ++i) {
+      trie.indexLatinText(items[i]->displayName().toStdString(), i);
+    }
+
+    benchmark::DoNotOptimize(trie);
+  }
+
+  state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+BENCHMARK(BM_TrieIndex)->Unit(benchmark::kMillisecond);
+
+static void BM_TriePrefixSearch(benchmark::State &state, std::string_view prefix) {
+  auto &items = rootItems();
+  Trie<size_t> trie;
+
+  for (size_t i = 0; i < items.size(); ++i) {
+    trie.indexLatinText(items[i]->displayName().toStdString(), i);
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(trie.prefixSearch(prefix));
+  }
+}
+
+BENCHMARK_CAPTURE(BM_TriePrefixSearch, single_char, std::string_view("f"));
+BENCHMARK_CAPTURE(BM_TriePrefixSearch, word, std::string_view("firefox"));
+BENCHMARK_CAPTURE(BM_TriePrefixSearch, no_match, std::string_view("zzz"));
@@ -43,6 +43,8 @@ class PasteToFocusedWindowAction : public AbstractAction {
     auto window = wm->getFocusedWindow();
     QString name;
 
+    if (!window) return _title;
+
     if (auto app = appDb->find(window->wmClass())) {
       name = QString("Paste to %1").arg(app->name());
     } else {
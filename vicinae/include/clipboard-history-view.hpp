@@ -21,6 +21,7 @@
 #include "service-registry.hpp"
 #include "ui/icon-button/icon-button.hpp"
 #include "ui/image/image.hpp"
+#include "ui/image/thumbnail-cache.hpp"
 #include "ui/omni-list/omni-list.hpp"
 #include "ui/split-detail/split-detail.hpp"
 #include "ui/toast/toast.hpp"
@@ -46,6 +47,7 @@
 #include "text-file-viewer.hpp"
 #include "ui/typography/typography.hpp"
 #include "utils/utils.hpp"
+#include "utils/cancellation-token/cancellation-token.hpp"
 
 class TextContainer : public QWidget {
   QVBoxLayout *_layout;
@@ -106,7 +108,7 @@ class ClipboardHistoryItemWidget : public SelectableOmniListWidget {
   ImageWidget *m_icon = new ImageWidget;
   ImageWidget *m_pinIcon = new ImageWidget;
 
-  ImageURL getLinkIcon(const std::optional<QString> &urlHost) const {
+  static ImageURL getLinkIcon(const std::optional<QString> &urlHost) {
     auto dflt = ImageURL::builtin("link");
 
     if (urlHost) return ImageURL::favicon(*urlHost).withFallback(dflt);
@@ -114,10 +116,14 @@ class ClipboardHistoryItemWidget : public SelectableOmniListWidget {
     return dflt;
   }
 
-  ImageURL iconForMime(const ClipboardHistoryEntry &entry) const {
+public:
+  static ImageURL iconForMime(const ClipboardHistoryEntry &entry) {
     switch (entry.kind) {
-    case ClipboardOfferKind::Image:
-      return ImageURL::builtin("image");
+    case ClipboardOfferKind::Image: {
+      // generated by the clipboard service when the selection is saved
+      auto thumbnail = ThumbnailCache::contentThumbnailPath(entry.md5sum, ThumbnailCache::Flavor::Normal);
+      return ImageURL::local(thumbnail).withFallback(ImageURL::builtin("image"));
+    }
     case ClipboardOfferKind::Link:
       return getLinkIcon(entry.urlHost);
     case ClipboardOfferKind::Text:
@@ -128,6 +134,7 @@ class ClipboardHistoryItemWidget : public SelectableOmniListWidget {
     return ImageURL::builtin("question-mark-circle");
   }
 
+private:
   void setupUI() {
     m_pinIcon->setUrl(ImageURL::builtin("pin").setFill(SemanticColor::Red));
     m_pinIcon->setFixedSize(16, 16);
@@ -515,6 +522,8 @@ class ClipboardHistoryView : public SimpleView {
   PreferenceDropdown *m_filterInput = new PreferenceDropdown(this);
   using Watcher = QFutureWatcher<PaginatedResponse<ClipboardHistoryEntry>>;
   Watcher m_watcher;
+  // one token per search, so that a search that is superseded stops running
+  CancellationSource m_searchCancellation;
   std::optional<ClipboardOfferKind> m_kindFilter;
 
   void reloadCurrentSearch() { startSearch({.query = searchText(), .kind = m_kindFilter}); }
@@ -654,7 +663,7 @@ class ClipboardHistoryView : public SimpleView {
 
     if (m_watcher.isRunning()) { m_watcher.cancel(); }
 
-    m_watcher.setFuture(clipman->listAll(1000, 0, opts));
+    m_watcher.setFuture(clipman->listAll(1000, 0, opts, m_searchCancellation.next()));
   }
 
   void handleFilterChange(const SelectorInput::AbstractItem &item) {
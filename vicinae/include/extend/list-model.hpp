@@ -8,7 +8,8 @@
 #include <qjsonobject.h>
 
 struct ListItemViewModel {
-  bool changed;
+  // whether the item or one of its descendants changed since the last render
+  bool changed = true;
   QString id;
   QString title;
   QString subtitle;
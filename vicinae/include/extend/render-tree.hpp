@@ -0,0 +1,63 @@
+#pragma once
+#include <qjsonarray.h>
+#include <qjsonobject.h>
+#include <qstring.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Host-side copy of the render tree maintained by the extension reconciler.
+ *
+ * The first render ships the full tree, subsequent renders only ship patches
+ * (insert, remove, move, update) addressed by node id that are applied in place.
+ * Dirty flags are accumulated until `clearDirty` is called, so that a render
+ * that got cancelled before being consumed doesn't lose track of what changed.
+ */
+class RenderTree {
+public:
+  static constexpr int ROOT_ID = 0;
+
+  /**
+   * Replace the whole tree with the provided views, as serialized by the reconciler.
+   */
+  void reset(const QJsonArray &views);
+
+  /**
+   * Apply a list of patches in order. Returns false if one of the patches could not be applied,
+   * in which case the tree is left in a partially updated state.
+   */
+  bool applyPatches(const QJsonArray &patches);
+
+  /**
+   * Serialize the tree in the format expected by `ModelParser::parse`.
+   * This does not modify the tree and can be called from another thread as long as
+   * no patch is applied concurrently.
+   */
+  QJsonArray views() const;
+
+  void clearDirty();
+
+  size_t size() const { return m_nodes.size(); }
+
+private:
+  struct Node {
+    QString type;
+    QJsonObject props;
+    std::vector<int> children;
+    int parent = -1;
+    bool dirty = true;
+    bool propsDirty = true;
+  };
+
+  std::unordered_map<int, Node> m_nodes;
+
+  int insertNode(const QJsonObject &obj, int parent);
+  void removeNode(int id);
+  void markDirty(int id);
+  QJsonObject serialize(int id) const;
+
+  bool applyInsert(const QJsonObject &patch);
+  bool applyRemove(const QJsonObject &patch);
+  bool applyMove(const QJsonObject &patch);
+  bool applyUpdate(const QJsonObject &patch);
+};
@@ -35,6 +35,7 @@ class ExtensionListItem : public AbstractDefaultListItem {
 
 public:
   const ListItemViewModel &model() const { return _item; }
+  void setModel(const ListItemViewModel &model) { _item = model; }
 
   ExtensionListItem(const ListItemViewModel &model) : _item(model) {}
 };
@@ -44,6 +45,8 @@ class ExtensionList : public QWidget {
 
   OmniList *m_list = new OmniList;
   std::vector<ListChild> m_model;
+  // shape of the list as it was last rendered, used to detect renders that can be applied in place
+  std::vector<QString> m_layoutKeys;
   QString m_filter;
 
   bool matchesFilter(const ListItemViewModel &item, const QString &query) {
@@ -52,7 +55,55 @@ class ExtensionList : public QWidget {
            item.subtitle.contains(query, Qt::CaseInsensitive);
   }
 
+  /**
+   * Ordered keys describing the sections and items that are shown once the current filter
+   * is applied. Two models with the same keys produce the exact same list layout.
+   */
+  std::vector<QString> layoutKeys(const std::vector<ListChild> &model) {
+    auto matches = [&](const ListItemViewModel &item) { return matchesFilter(item, m_filter); };
+    std::vector<QString> keys;
+
+    keys.reserve(model.size());
+
+    for (const auto &item : model) {
+      if (auto listItem = std::get_if<ListItemViewModel>(&item)) {
+        if (matches(*listItem)) keys.emplace_back(listItem->id);
+      } else if (auto section = std::get_if<ListSectionModel>(&item)) {
+        keys.emplace_back(QString("section:%1:%2").arg(section->title).arg(section->subtitle));
+
+        for (const auto &child : section->children) {
+          if (matches(child)) keys.emplace_back(child.id);
+        }
+      }
+    }
+
+    return keys;
+  }
+
+  /**
+   * Refresh the items that changed since the last render, without touching the list layout.
+   */
+  void updateChangedItems() {
+    auto update = [&](const ListItemViewModel &model) {
+      if (!model.changed) return;
+
+      m_list->updateItem(model.id, [&](OmniList::AbstractVirtualItem *item) {
+        static_cast<ExtensionListItem *>(item)->setModel(model);
+      });
+    };
+
+    for (const auto &item : m_model) {
+      if (auto listItem = std::get_if<ListItemViewModel>(&item)) {
+        update(*listItem);
+      } else if (auto section = std::get_if<ListSectionModel>(&item)) {
+        std::ranges::for_each(section->children, update);
+      }
+    }
+  }
+
   void render(OmniList::SelectionPolicy selectionPolicy) {
+    m_layoutKeys = layoutKeys(m_model);
+
     auto matches = [&](const ListItemViewModel &item) { return matchesFilter(item, m_filter); };
     std::vector<std::shared_ptr<OmniList::AbstractVirtualItem>> currentSectionItems;
     auto appendSectionLess = [&]() {
@@ -140,8 +191,18 @@ public:
 
   void setModel(const std::vector<ListChild> &model,
                 OmniList::SelectionPolicy selection = OmniList::SelectFirst) {
+    bool sameLayout = layoutKeys(model) == m_layoutKeys;
+
     m_model = model;
-    render(selection);
+
+    if (!sameLayout) {
+      render(selection);
+      return;
+    }
+
+    updateChangedItems();
+
+    if (selection == OmniList::SelectFirst) { m_list->selectFirst(); }
   }
   void setFilter(const QString &query) {
     if (m_filter == query) return;
@@ -164,12 +225,14 @@ class ExtensionListComponent : public ExtensionSimpleView {
   bool _shouldResetSelection;
   QTimer *_debounce;
   QTimer *m_dropdownDebounce = new QTimer(this);
+  QString m_pendingDropdownSearchText;
   bool m_dropdownShouldResetSelection = false;
   int m_renderCount = 0;
 
   void renderDropdown(const DropdownModel &dropdown);
   void handleDropdownSelectionChanged(const SelectorInput::AbstractItem &item);
   void handleDropdownSearchChanged(const QString &text);
+  void handleDebouncedDropdownSearchNotification();
 
   QWidget *searchBarAccessory() const override { return m_selector; }
 
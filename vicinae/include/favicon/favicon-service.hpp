@@ -1,8 +1,11 @@
 #pragma once
 #include "ui/image/url.hpp"
+#include "utils/sql-write-queue/sql-write-queue.hpp"
 #include <QSqlError>
 #include <cassert>
 #include <expected>
+#include <list>
+#include <memory>
 #include <qbuffer.h>
 #include <qdir.h>
 #include <qfileinfo.h>
@@ -11,14 +14,17 @@
 #include <qobject.h>
 #include <qpixmap.h>
 #include <qpixmapcache.h>
+#include <qpromise.h>
 #include <qsqldatabase.h>
 #include <qsqlquery.h>
 #include <qstringview.h>
 #include <unordered_map>
 
 class FaviconService : public QObject {
-  // TODO: limit cache based on storage size not number of elements
-  static constexpr size_t maxCacheCount = 50;
+  // favicons are small, this is enough to hold several hundreds of them
+  static constexpr size_t maxCacheSize = 16 * 1024 * 1024;
+  // how often `last_used_at` is bumped for a given favicon, at most
+  static constexpr qint64 touchInterval = 5 * 60;
 
 public:
   using FaviconResponse = std::expected<QPixmap, QString>;
@@ -35,13 +41,34 @@ private:
   inline static FaviconService *_instance = nullptr;
 
   QSqlDatabase _db;
+  // every access bumps `last_used_at`, which must not cost a synchronous write each time
+  std::unique_ptr<SqlWriteQueue> m_writeQueue;
   RequesterType _requesterType;
   QDir _dataDir;
-  std::unordered_map<QString, QPixmap> _cache;
+
+  struct CacheEntry {
+    QPixmap pixmap;
+    size_t size = 0;
+    std::list<QString>::iterator lru;
+  };
+
+  std::unordered_map<QString, CacheEntry> _cache;
+  std::list<QString> _lru;
+  size_t _cacheSize = 0;
+
+  /**
+   * Requests waiting on the same domain, which is only loaded from disk or fetched once.
+   */
+  std::unordered_map<QString, std::vector<std::shared_ptr<QPromise<FaviconResponse>>>> m_pending;
+  std::unordered_map<QString, qint64> m_lastTouched;
 
   void handleFetchedFavicon(const QString &domain, const QPixmap &favicon);
+  void handleDiskLoad(const QString &domain, const QImage &image);
+  void fetchFavicon(const QString &domain);
+  void resolvePending(const QString &domain, const FaviconResponse &response);
   void insertCache(const QString &key, const QPixmap &favicon);
-  QPixmap retrieveFromCache(const QString &domain);
+  const QPixmap *retrieveFromCache(const QString &domain);
+  void touch(const QString &domain);
 
 public:
   static std::vector<FaviconServiceData> providers();
@@ -51,6 +78,11 @@ public:
   void setService(RequesterType type);
   void setService(const QString &id);
 
-  QFuture<FaviconResponse> makeRequest(const QString &domain, QObject *parent = nullptr);
+  /**
+   * The load is shared by every request for the same domain and owned by the service, so that it runs
+   * to completion even if the caller that started it goes away. Callers that may be destroyed first
+   * should watch the returned future through a watcher they own.
+   */
+  QFuture<FaviconResponse> makeRequest(const QString &domain);
   FaviconService(const std::filesystem::path &path, QObject *parent = nullptr);
 };
@@ -1,18 +1,28 @@
 #pragma once
 #include "utils/migration-manager/migration-manager.hpp"
+#include "utils/sql-write-queue/sql-write-queue.hpp"
 #include <qlogging.h>
 #include <qsqldatabase.h>
 #include <qsqlquery.h>
 #include <filesystem>
+#include <memory>
 
-static const std::vector<QString> pragmas = {"PRAGMA foreign_keys = ON;"};
+// executed on every connection, including the one owned by the write queue
+static const std::vector<QString> pragmas = {"PRAGMA foreign_keys = ON;", "PRAGMA synchronous = normal;"};
 
 class OmniDatabase {
   QSqlDatabase _db;
+  std::unique_ptr<SqlWriteQueue> m_writeQueue;
 
 public:
   QSqlDatabase &db() { return _db; }
 
+  /**
+   * Frequent writes that don't need to be read back right away should go through this queue
+   * instead of being executed on the main connection.
+   */
+  SqlWriteQueue &writeQueue() { return *m_writeQueue; }
+
   QSqlQuery createQuery() { return QSqlQuery(_db); }
 
   OmniDatabase(const std::filesystem::path &path) : _db(QSqlDatabase::addDatabase("QSQLITE", "omni")) {
@@ -27,8 +37,13 @@ public:
 
     auto query = createQuery();
 
+    // WAL lets the main thread keep reading while the write queue commits. This is persisted in the file.
+    query.exec("PRAGMA journal_mode = WAL;");
+
     for (const auto &pragma : pragmas) {
       query.exec(pragma);
     }
+
+    m_writeQueue = std::make_unique<SqlWriteQueue>(_db, pragmas);
   }
 };
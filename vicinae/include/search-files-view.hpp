@@ -147,6 +147,7 @@ public:
 class SearchFilesView : public ListView {
   using Watcher = QFutureWatcher<std::vector<IndexerFileResult>>;
   Watcher m_pendingFileResults;
+  CancellationSource m_searchCancellation;
   QString m_lastSearchText;
 
   QString currentQuery;
@@ -172,9 +173,9 @@ class SearchFilesView : public ListView {
     auto fileService = context()->services->fileService();
 
     currentQuery = query;
-    if (m_pendingFileResults.isRunning()) { m_pendingFileResults.cancel(); }
     m_lastSearchText = query;
-    m_pendingFileResults.setFuture(fileService->queryAsync(query.toStdString()));
+    m_pendingFileResults.setFuture(
+        fileService->queryAsync(query.toStdString(), {.cancellation = m_searchCancellation.next()}));
   }
 
   void textChanged(const QString &query) override {
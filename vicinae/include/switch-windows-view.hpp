@@ -111,34 +111,14 @@ public:
 };
 
 class SwitchWindowsView : public ListView {
-  AbstractWindowManager::WindowList windows;
-  std::chrono::time_point<std::chrono::high_resolution_clock> m_lastWindowFetch =
-      std::chrono::high_resolution_clock::now();
-
 public:
-  void refreshWindowsList() {
-    // Force a refresh by clearing the cache
-    windows.clear();
-    m_lastWindowFetch = std::chrono::time_point<std::chrono::high_resolution_clock>{};
-    textChanged(searchText());
-  }
-
-  // Method to refresh with a delay (for after window operations)
-  // Uses a small delay to ensure the window manager has processed the close operation
-  void refreshWindowsListDelayed() {
-    QTimer::singleShot(100, this, [this]() { refreshWindowsList(); });
-  }
+  void refreshWindowsList() { textChanged(searchText()); }
 
   void textChanged(const QString &s) override {
     auto wm = ServiceRegistry::instance()->windowManager();
     auto appDb = ServiceRegistry::instance()->appDb();
-    auto now = std::chrono::high_resolution_clock::now();
-    auto elapsedSeconds = std::chrono::duration_cast<std::chrono::seconds>(now - m_lastWindowFetch).count();
-
-    if (windows.empty() || elapsedSeconds > 1) {
-      windows = wm->listWindowsSync();
-      m_lastWindowFetch = now;
-    }
+    // served from the window manager's own state, cheap enough to do on every keystroke
+    auto windows = wm->listWindowsSync();
 
     m_list->beginResetModel();
 
@@ -163,7 +143,7 @@ public:
     auto wm = context()->services->windowManager();
 
     connect(wm->provider(), &AbstractWindowManager::windowsChanged, this,
-            &SwitchWindowsView::refreshWindowsListDelayed);
+            &SwitchWindowsView::refreshWindowsList);
 
     setSearchPlaceholderText("Search open window...");
     textChanged("");
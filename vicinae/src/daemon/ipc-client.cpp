@@ -1,5 +1,7 @@
 #include "ipc-client.hpp"
 #include "vicinae.hpp"
+#include <arpa/inet.h>
+#include <qlogging.h>
 
 void DaemonIpcClient::writeRequest(const proto::ext::daemon::Request &req) {
   std::string data;
@@ -12,6 +14,96 @@ void DaemonIpcClient::writeRequest(const proto::ext::daemon::Request &req) {
   m_conn.waitForBytesWritten(1000);
 }
 
+std::optional<proto::ext::daemon::Response> DaemonIpcClient::readResponse() {
+  QByteArray data;
+  uint32_t length = 0;
+
+  while (data.size() < sizeof(length) || data.size() - sizeof(length) < length) {
+    if (m_conn.bytesAvailable() == 0 && !m_conn.waitForReadyRead(RESPONSE_TIMEOUT_MS)) {
+      qCritical() << "Failed to read response from server" << m_conn.errorString();
+      return std::nullopt;
+    }
+
+    data.append(m_conn.readAll());
+
+    if (data.size() >= sizeof(length)) { length = ntohl(*reinterpret_cast<const uint32_t *>(data.data())); }
+  }
+
+  proto::ext::daemon::Response res;
+
+  if (!res.ParseFromArray(data.data() + sizeof(length), length)) {
+    qCritical() << "Failed to parse response from server";
+    return std::nullopt;
+  }
+
+  return res;
+}
+
+std::optional<proto::ext::daemon::StartupTraceResponse> DaemonIpcClient::startupTrace() {
+  proto::ext::daemon::Request req;
+
+  req.mutable_startup_trace();
+  writeRequest(req);
+
+  auto res = readResponse();
+
+  if (!res || !res->has_startup_trace()) return std::nullopt;
+
+  return res->startup_trace();
+}
+
+std::optional<proto::ext::daemon::ToggleLatencyResponse> DaemonIpcClient::toggleLatency() {
+  proto::ext::daemon::Request req;
+
+  req.mutable_toggle_latency();
+  writeRequest(req);
+
+  auto res = readResponse();
+
+  if (!res || !res->has_toggle_latency()) return std::nullopt;
+
+  return res->toggle_latency();
+}
+
+std::optional<proto::ext::daemon::StatsResponse> DaemonIpcClient::stats() {
+  proto::ext::daemon::Request req;
+
+  req.mutable_stats();
+  writeRequest(req);
+
+  auto res = readResponse();
+
+  if (!res || !res->has_stats()) return std::nullopt;
+
+  return res->stats();
+}
+
+std::optional<proto::ext::daemon::TraceControlResponse> DaemonIpcClient::setTracing(bool enabled) {
+  proto::ext::daemon::Request req;
+
+  req.mutable_trace_control()->set_enabled(enabled);
+  writeRequest(req);
+
+  auto res = readResponse();
+
+  if (!res || !res->has_trace_control()) return std::nullopt;
+
+  return res->trace_control();
+}
+
+std::optional<proto::ext::daemon::TraceDumpResponse> DaemonIpcClient::traceDump() {
+  proto::ext::daemon::Request req;
+
+  req.mutable_trace_dump();
+  writeRequest(req);
+
+  auto res = readResponse();
+
+  if (!res || !res->has_trace_dump()) return std::nullopt;
+
+  return res->trace_dump();
+}
+
 void DaemonIpcClient::toggle() {
   QUrl url;
 
@@ -10,15 +10,40 @@
 #include <qobject.h>
 #include <qstringview.h>
 #include <QIODevice>
+#include <optional>
 
 class DaemonIpcClient {
+  static constexpr int RESPONSE_TIMEOUT_MS = 5000;
+
   QLocalSocket m_conn;
 
   void writeRequest(const proto::ext::daemon::Request &req);
+  std::optional<proto::ext::daemon::Response> readResponse();
 
 public:
   void toggle();
   void passUrl(const QUrl &url);
+
+  /**
+   * Timings of the daemon startup phases, as recorded by `StartupProfiler`.
+   */
+  std::optional<proto::ext::daemon::StartupTraceResponse> startupTrace();
+
+  /**
+   * Latencies between toggle requests and the first frame painted by the window.
+   */
+  std::optional<proto::ext::daemon::ToggleLatencyResponse> toggleLatency();
+
+  /**
+   * Timings and counters recorded around the hot paths of the daemon, as recorded by `PerfMetrics`.
+   */
+  std::optional<proto::ext::daemon::StatsResponse> stats();
+
+  /**
+   * Start or stop recording trace events, see `TraceRecorder`.
+   */
+  std::optional<proto::ext::daemon::TraceControlResponse> setTracing(bool enabled);
+  std::optional<proto::ext::daemon::TraceDumpResponse> traceDump();
   bool connect();
 
   DaemonIpcClient();
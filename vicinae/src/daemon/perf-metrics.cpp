@@ -0,0 +1,131 @@
+#include "perf-metrics.hpp"
+#include "daemon/trace-recorder.hpp"
+#include <algorithm>
+#include <bit>
+#include <ranges>
+
+using namespace std::chrono;
+
+void PerfMetrics::Timer::finish() {
+  if (!m_histogram) return;
+
+  auto end = Clock::now();
+
+  m_histogram->record(duration_cast<microseconds>(end - m_start));
+
+  // a span that ends on another thread than the one it started on can't be nested properly in a trace
+  if (m_thread == std::this_thread::get_id()) {
+    TraceRecorder::instance()->record(m_histogram->name().c_str(), m_start, end);
+  }
+
+  m_histogram = nullptr;
+}
+
+size_t PerfMetrics::Histogram::bucketFor(uint64_t us) {
+  return std::min<size_t>(std::bit_width(us), BUCKET_COUNT - 1);
+}
+
+void PerfMetrics::Histogram::record(microseconds duration) {
+  uint64_t us = std::max<int64_t>(duration.count(), 0);
+  uint64_t max = m_max.load(std::memory_order_relaxed);
+
+  m_buckets[bucketFor(us)].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  m_sum.fetch_add(us, std::memory_order_relaxed);
+
+  while (us > max && !m_max.compare_exchange_weak(max, us, std::memory_order_relaxed)) {}
+}
+
+PerfMetrics::HistogramStats PerfMetrics::Histogram::stats() const {
+  std::array<uint64_t, BUCKET_COUNT> buckets;
+  HistogramStats stats{.name = m_name};
+
+  // samples recorded while we are reading are either fully counted or not at all, which is good enough
+  // for an estimation
+  for (size_t i = 0; i != BUCKET_COUNT; ++i) {
+    buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    stats.count += buckets[i];
+  }
+
+  if (stats.count == 0) return stats;
+
+  uint64_t max = m_max.load(std::memory_order_relaxed);
+
+  auto percentile = [&](double p) {
+    double rank = p * stats.count;
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i != BUCKET_COUNT; ++i) {
+      if (buckets[i] == 0 || seen + buckets[i] < rank) {
+        seen += buckets[i];
+        continue;
+      }
+
+      // assume samples are evenly spread across the bucket
+      double lower = i == 0 ? 0 : uint64_t(1) << (i - 1);
+      // max is read separately from the buckets and may lag behind them, keep the bounds ordered
+      double upper = std::max(lower, i == BUCKET_COUNT - 1 ? max : std::min<double>(uint64_t(1) << i, max));
+      double value = lower + (upper - lower) * (rank - seen) / buckets[i];
+
+      return microseconds(static_cast<int64_t>(std::clamp<double>(value, lower, upper)));
+    }
+
+    return microseconds(max);
+  };
+
+  stats.mean = microseconds(m_sum.load(std::memory_order_relaxed) / stats.count);
+  stats.p50 = percentile(0.5);
+  stats.p90 = percentile(0.9);
+  stats.p99 = percentile(0.99);
+  stats.max = microseconds(max);
+
+  return stats;
+}
+
+PerfMetrics *PerfMetrics::instance() {
+  static PerfMetrics metrics;
+
+  return &metrics;
+}
+
+PerfMetrics::Histogram &PerfMetrics::histogram(std::string_view name) {
+  std::lock_guard lock(m_mutex);
+
+  if (auto it = m_histograms.find(name); it != m_histograms.end()) return *it->second;
+
+  return *m_histograms.emplace(std::string(name), std::make_unique<Histogram>(name)).first->second;
+}
+
+PerfMetrics::Counter &PerfMetrics::counter(std::string_view name) {
+  std::lock_guard lock(m_mutex);
+
+  if (auto it = m_counters.find(name); it != m_counters.end()) return *it->second;
+
+  return *m_counters.emplace(std::string(name), std::make_unique<Counter>(name)).first->second;
+}
+
+std::vector<PerfMetrics::HistogramStats> PerfMetrics::histograms() const {
+  std::lock_guard lock(m_mutex);
+  std::vector<HistogramStats> stats;
+
+  stats.reserve(m_histograms.size());
+
+  for (const auto &histogram : m_histograms | std::views::values) {
+    if (auto s = histogram->stats(); s.count > 0) stats.emplace_back(std::move(s));
+  }
+
+  return stats;
+}
+
+std::vector<PerfMetrics::CounterStats> PerfMetrics::counters() const {
+  std::lock_guard lock(m_mutex);
+  std::vector<CounterStats> stats;
+
+  stats.reserve(m_counters.size());
+
+  for (const auto &counter : m_counters | std::views::values) {
+    stats.emplace_back(CounterStats{.name = counter->name(), .value = counter->value()});
+  }
+
+  return stats;
+}
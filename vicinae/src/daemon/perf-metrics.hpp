@@ -0,0 +1,132 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * Always-on, low overhead metrics about the hot paths of the app (root search, file queries, extension
+ * rendering...), so that performance can be looked at on real workloads without attaching a profiler.
+ *
+ * Durations are recorded into fixed histogram buckets with a handful of relaxed atomic operations,
+ * percentiles being estimated from the buckets when a snapshot is taken.
+ *
+ * Timers also show up as events in the traces recorded by `TraceRecorder`, when it is enabled.
+ *
+ * Metrics can be obtained from a running daemon with `vicinae stats`.
+ */
+class PerfMetrics {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct HistogramStats {
+    std::string name;
+    uint64_t count = 0;
+    std::chrono::microseconds mean;
+    std::chrono::microseconds p50;
+    std::chrono::microseconds p90;
+    std::chrono::microseconds p99;
+    std::chrono::microseconds max;
+  };
+
+  struct CounterStats {
+    std::string name;
+    uint64_t value = 0;
+  };
+
+  class Histogram;
+
+  /**
+   * Records the time elapsed between its creation and its destruction, unless it was cancelled.
+   */
+  class Timer {
+    Histogram *m_histogram;
+    Clock::time_point m_start = Clock::now();
+    std::thread::id m_thread = std::this_thread::get_id();
+
+  public:
+    /**
+     * Record the elapsed time now rather than on destruction.
+     */
+    void finish();
+
+    /**
+     * Do not record anything, typically because the operation did not run to completion.
+     */
+    void cancel() { m_histogram = nullptr; }
+
+    Timer(Histogram &histogram) : m_histogram(&histogram) {}
+    Timer(const Timer &) = delete;
+    Timer(Timer &&other) : m_histogram(other.m_histogram), m_start(other.m_start), m_thread(other.m_thread) {
+      other.cancel();
+    }
+    ~Timer() { finish(); }
+  };
+
+  class Histogram {
+    // bucket `i` holds durations in [2^(i - 1), 2^i) microseconds, the last one holding everything
+    // above ~17 minutes
+    static constexpr size_t BUCKET_COUNT = 32;
+
+    std::string m_name;
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_buckets{};
+    std::atomic<uint64_t> m_count = 0;
+    std::atomic<uint64_t> m_sum = 0;
+    std::atomic<uint64_t> m_max = 0;
+
+    static size_t bucketFor(uint64_t us);
+
+  public:
+    const std::string &name() const { return m_name; }
+
+    void record(std::chrono::microseconds duration);
+    [[nodiscard]] Timer time() { return Timer(*this); }
+    HistogramStats stats() const;
+
+    Histogram(std::string_view name) : m_name(name) {}
+  };
+
+  class Counter {
+    std::string m_name;
+    std::atomic<uint64_t> m_value = 0;
+
+  public:
+    const std::string &name() const { return m_name; }
+    void increment(uint64_t n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const { return m_value.load(std::memory_order_relaxed); }
+
+    Counter(std::string_view name) : m_name(name) {}
+  };
+
+  static PerfMetrics *instance();
+
+  /**
+   * Get the histogram with the given name, creating it on first use. The returned reference is valid
+   * for the lifetime of the program: call sites are expected to look it up once and keep it around,
+   * typically in a function-local static, so that recording never has to take a lock.
+   */
+  Histogram &histogram(std::string_view name);
+
+  /**
+   * Same as `histogram`, for counters.
+   */
+  Counter &counter(std::string_view name);
+
+  /**
+   * Stats of the histograms that recorded at least one sample, sorted by name.
+   */
+  std::vector<HistogramStats> histograms() const;
+  std::vector<CounterStats> counters() const;
+
+private:
+  mutable std::mutex m_mutex;
+  std::map<std::string, std::unique_ptr<Histogram>, std::less<>> m_histograms;
+  std::map<std::string, std::unique_ptr<Counter>, std::less<>> m_counters;
+};
@@ -0,0 +1,65 @@
+#include "startup-profiler.hpp"
+#include "utils/utils.hpp"
+#include <algorithm>
+#include <qlogging.h>
+
+using namespace std::chrono;
+
+StartupProfiler::Scope::Scope(StartupProfiler &profiler, const QString &name)
+    : m_profiler(profiler), m_name(name), m_start(Clock::now()) {}
+
+void StartupProfiler::Scope::finish() {
+  if (m_finished) return;
+
+  m_finished = true;
+  m_profiler.record(m_name, m_start, Clock::now());
+}
+
+StartupProfiler::Scope::~Scope() { finish(); }
+
+StartupProfiler *StartupProfiler::instance() {
+  static StartupProfiler profiler;
+
+  return &profiler;
+}
+
+void StartupProfiler::record(const QString &name, Clock::time_point start, Clock::time_point end) {
+  Phase phase{.name = name,
+              .thread = currentThreadName(),
+              .start = duration_cast<microseconds>(start - m_origin),
+              .duration = duration_cast<microseconds>(end - start)};
+  std::lock_guard lock(m_mutex);
+
+  m_phases.emplace_back(phase);
+}
+
+void StartupProfiler::mark(const QString &name) {
+  auto now = Clock::now();
+
+  record(name, now, now);
+}
+
+std::vector<StartupProfiler::Phase> StartupProfiler::phases() const {
+  std::vector<Phase> phases;
+
+  {
+    std::lock_guard lock(m_mutex);
+    phases = m_phases;
+  }
+
+  std::ranges::sort(phases, [](const Phase &a, const Phase &b) { return a.start < b.start; });
+
+  return phases;
+}
+
+void StartupProfiler::dump() const {
+  for (const auto &phase : phases()) {
+    qInfo().noquote() << QString("[startup] %1 +%2ms (%3ms) on %4")
+                             .arg(phase.name)
+                             .arg(phase.start.count() / 1000.0, 0, 'f', 1)
+                             .arg(phase.duration.count() / 1000.0, 0, 'f', 1)
+                             .arg(phase.thread);
+  }
+}
+
+StartupProfiler::StartupProfiler() : m_origin(Clock::now()) {}
@@ -0,0 +1,62 @@
+#pragma once
+#include <chrono>
+#include <mutex>
+#include <qstring.h>
+#include <vector>
+
+/**
+ * Records how long each phase of the daemon startup takes, so that cold start regressions can be
+ * tracked down without attaching a profiler. Phases can be recorded from any thread, which makes
+ * it possible to see what ran concurrently.
+ *
+ * The recorded trace can be obtained from a running daemon with `vicinae startup-trace`.
+ */
+class StartupProfiler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Phase {
+    QString name;
+    QString thread;
+    // relative to the creation of the profiler, which happens as early as possible during startup
+    std::chrono::microseconds start;
+    std::chrono::microseconds duration;
+  };
+
+  /**
+   * Records the enclosing phase when it goes out of scope, unless `finish` was called before.
+   */
+  class Scope {
+    StartupProfiler &m_profiler;
+    QString m_name;
+    Clock::time_point m_start;
+    bool m_finished = false;
+
+  public:
+    void finish();
+
+    Scope(StartupProfiler &profiler, const QString &name);
+    Scope(const Scope &) = delete;
+    ~Scope();
+  };
+
+  static StartupProfiler *instance();
+
+  [[nodiscard]] Scope phase(const QString &name) { return Scope(*this, name); }
+  void record(const QString &name, Clock::time_point start, Clock::time_point end);
+
+  /**
+   * Record a zero length phase, used to mark milestones such as the window becoming interactive.
+   */
+  void mark(const QString &name);
+
+  std::vector<Phase> phases() const;
+  void dump() const;
+
+  StartupProfiler();
+
+private:
+  Clock::time_point m_origin;
+  mutable std::mutex m_mutex;
+  std::vector<Phase> m_phases;
+};
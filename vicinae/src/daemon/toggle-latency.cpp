@@ -0,0 +1,55 @@
+#include "toggle-latency.hpp"
+#include <algorithm>
+
+using namespace std::chrono;
+
+ToggleLatencyTracker *ToggleLatencyTracker::instance() {
+  static ToggleLatencyTracker tracker;
+
+  return &tracker;
+}
+
+void ToggleLatencyTracker::frameReceived() { m_lastReceivedAt = Clock::now(); }
+
+void ToggleLatencyTracker::frameHandled() { m_lastReceivedAt.reset(); }
+
+void ToggleLatencyTracker::windowShown() {
+  // the window can also be shown from within the app, which we don't measure
+  if (!m_lastReceivedAt) return;
+
+  m_pendingSince = m_lastReceivedAt;
+  m_lastReceivedAt.reset();
+}
+
+void ToggleLatencyTracker::framePainted() {
+  if (!m_pendingSince) return;
+
+  auto latency = duration_cast<microseconds>(Clock::now() - *m_pendingSince);
+
+  m_pendingSince.reset();
+  m_lastSample = latency;
+
+  if (m_samples.size() < MAX_SAMPLES) {
+    m_samples.emplace_back(latency);
+  } else {
+    m_samples[m_nextSample] = latency;
+    m_nextSample = (m_nextSample + 1) % MAX_SAMPLES;
+  }
+}
+
+std::optional<ToggleLatencyTracker::Stats> ToggleLatencyTracker::stats() const {
+  if (m_samples.empty()) return std::nullopt;
+
+  auto sorted = m_samples;
+
+  std::ranges::sort(sorted);
+
+  auto percentile = [&](double p) { return sorted[static_cast<size_t>(p * (sorted.size() - 1))]; };
+
+  return Stats{.samples = sorted.size(),
+               .last = m_lastSample,
+               .min = sorted.front(),
+               .median = percentile(0.5),
+               .p95 = percentile(0.95),
+               .max = sorted.back()};
+}
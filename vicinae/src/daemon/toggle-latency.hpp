@@ -0,0 +1,64 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+/**
+ * Measures how long it takes for the launcher window to paint its first frame after a toggle request
+ * was received on the IPC socket. This is the latency users actually perceive when they hit their
+ * launcher keybind, so it is what the pre-warmed root view is optimized for.
+ *
+ * Statistics about the latest samples can be obtained from a running daemon with
+ * `vicinae toggle-latency`.
+ */
+class ToggleLatencyTracker {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Stats {
+    size_t samples = 0;
+    std::chrono::microseconds last;
+    std::chrono::microseconds min;
+    std::chrono::microseconds median;
+    std::chrono::microseconds p95;
+    std::chrono::microseconds max;
+  };
+
+  static ToggleLatencyTracker *instance();
+
+  /**
+   * Called by the IPC server as soon as a request frame was read from the socket.
+   */
+  void frameReceived();
+
+  /**
+   * Called once the request was fully handled. Frames are handled synchronously, so a window shown
+   * in between was shown as a result of the request.
+   */
+  void frameHandled();
+
+  /**
+   * Called when the window becomes visible. If that happened while handling a request, the next
+   * painted frame completes the measurement.
+   */
+  void windowShown();
+
+  /**
+   * Called once the window finished painting a frame.
+   */
+  void framePainted();
+
+  bool isMeasuring() const { return m_pendingSince.has_value(); }
+
+  std::optional<Stats> stats() const;
+
+private:
+  static constexpr size_t MAX_SAMPLES = 128;
+
+  std::optional<Clock::time_point> m_lastReceivedAt;
+  std::optional<Clock::time_point> m_pendingSince;
+  std::vector<std::chrono::microseconds> m_samples;
+  size_t m_nextSample = 0;
+  std::chrono::microseconds m_lastSample;
+};
@@ -0,0 +1,145 @@
+#include "trace-recorder.hpp"
+#include "utils/utils.hpp"
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonobject.h>
+#include <qlogging.h>
+#include <unistd.h>
+
+using namespace std::chrono;
+
+/**
+ * Hands the buffer back to the recorder when the thread exits. Threads of a pool come and go, so
+ * buffers need to be reused for their number to stay bounded.
+ */
+struct ThreadBufferHandle {
+  TraceRecorder::ThreadBuffer *buffer = nullptr;
+
+  ~ThreadBufferHandle() {
+    if (buffer) buffer->retired.store(true, std::memory_order_release);
+  }
+};
+
+static thread_local ThreadBufferHandle threadBuffer;
+
+TraceRecorder::Scope::Scope(const char *name) {
+  if (!TraceRecorder::instance()->isEnabled()) return;
+
+  m_name = name;
+  m_start = Clock::now();
+}
+
+TraceRecorder::Scope::~Scope() {
+  if (m_name) TraceRecorder::instance()->record(m_name, m_start, Clock::now());
+}
+
+TraceRecorder *TraceRecorder::instance() {
+  static TraceRecorder recorder;
+
+  return &recorder;
+}
+
+TraceRecorder::TraceRecorder() { m_enabled = qEnvironmentVariableIsSet("VICINAE_TRACE"); }
+
+void TraceRecorder::setEnabled(bool value) {
+  m_enabled.store(value, std::memory_order_relaxed);
+  qInfo() << "Tracing" << (value ? "enabled" : "disabled");
+}
+
+TraceRecorder::ThreadBuffer *TraceRecorder::acquireBuffer() {
+  std::lock_guard lock(m_mutex);
+  ThreadBuffer *buffer = nullptr;
+
+  // events of exited threads are dropped in favor of those of the new thread
+  for (const auto &candidate : m_buffers) {
+    if (candidate->retired.load(std::memory_order_acquire)) {
+      buffer = candidate.get();
+      break;
+    }
+  }
+
+  if (!buffer) buffer = m_buffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+
+  buffer->tid = gettid();
+  buffer->threadName = currentThreadName();
+  buffer->head.store(0, std::memory_order_relaxed);
+  buffer->retired.store(false, std::memory_order_relaxed);
+
+  return buffer;
+}
+
+void TraceRecorder::record(const char *name, Clock::time_point start, Clock::time_point end) {
+  if (!isEnabled()) return;
+
+  if (!threadBuffer.buffer) threadBuffer.buffer = acquireBuffer();
+
+  auto buffer = threadBuffer.buffer;
+  uint64_t head = buffer->head.load(std::memory_order_relaxed);
+  auto &event = buffer->events[head % BUFFER_CAPACITY];
+
+  // pairs with the acquire fence in `toChromeTrace`: a reader that sees any of the writes below also
+  // sees the head that was published before, and knows the slot is being overwritten
+  std::atomic_thread_fence(std::memory_order_release);
+  event.name.store(name, std::memory_order_relaxed);
+  event.start.store(duration_cast<nanoseconds>(start - m_origin).count(), std::memory_order_relaxed);
+  event.duration.store(duration_cast<nanoseconds>(end - start).count(), std::memory_order_relaxed);
+  buffer->head.store(head + 1, std::memory_order_release);
+}
+
+QByteArray TraceRecorder::toChromeTrace(size_t *eventCount) const {
+  struct Snapshot {
+    const char *name;
+    int64_t start;
+    int64_t duration;
+  };
+
+  std::lock_guard lock(m_mutex);
+  QJsonArray events;
+  qint64 pid = getpid();
+  size_t count = 0;
+
+  for (const auto &buffer : m_buffers) {
+    uint64_t head = buffer->head.load(std::memory_order_acquire);
+    uint64_t first = head > BUFFER_CAPACITY ? head - BUFFER_CAPACITY : 0;
+    std::vector<Snapshot> snapshots;
+
+    snapshots.reserve(head - first);
+
+    for (uint64_t i = first; i != head; ++i) {
+      auto &event = buffer->events[i % BUFFER_CAPACITY];
+
+      snapshots.emplace_back(Snapshot{.name = event.name.load(std::memory_order_relaxed),
+                                      .start = event.start.load(std::memory_order_relaxed),
+                                      .duration = event.duration.load(std::memory_order_relaxed)});
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // the owning thread kept recording while we were reading, the oldest slots may have been overwritten
+    uint64_t newHead = buffer->head.load(std::memory_order_relaxed);
+    uint64_t skipped = newHead >= BUFFER_CAPACITY ? std::min(newHead - BUFFER_CAPACITY + 1, head) : 0;
+
+    events.append(QJsonObject{{"name", "thread_name"},
+                              {"ph", "M"},
+                              {"pid", pid},
+                              {"tid", buffer->tid},
+                              {"args", QJsonObject{{"name", buffer->threadName}}}});
+
+    for (uint64_t i = std::max(first, skipped); i != head; ++i) {
+      const auto &snapshot = snapshots[i - first];
+
+      events.append(QJsonObject{{"name", snapshot.name},
+                                {"ph", "X"},
+                                {"pid", pid},
+                                {"tid", buffer->tid},
+                                {"ts", snapshot.start / 1000.0},
+                                {"dur", snapshot.duration / 1000.0}});
+      ++count;
+    }
+  }
+
+  if (eventCount) *eventCount = count;
+
+  return QJsonDocument(QJsonObject{{"traceEvents", events}, {"displayTimeUnit", "ms"}})
+      .toJson(QJsonDocument::Compact);
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <qbytearray.h>
+#include <qstring.h>
+#include <vector>
+
+/**
+ * Opt-in recorder of timed events, to find out why a specific interaction was slow when the aggregated
+ * `PerfMetrics` are not enough. Recorded events are exported in the Chrome trace event format, which
+ * can be loaded in https://ui.perfetto.dev or chrome://tracing.
+ *
+ * Each thread records into its own fixed-size ring buffer, so that recording never locks nor allocates:
+ * once a buffer is full, the oldest events of that thread are overwritten. While tracing is disabled,
+ * which is the default, a scope costs a single relaxed atomic load.
+ *
+ * Tracing is enabled by setting VICINAE_TRACE in the environment of the daemon or at runtime with
+ * `vicinae trace start`, and the recorded events are obtained with `vicinae trace dump`.
+ */
+class TraceRecorder {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * Records an event spanning its lifetime, if tracing was enabled when it was created.
+   * `name` is not copied and must outlive the recorder, which string literals do.
+   */
+  class Scope {
+    const char *m_name = nullptr;
+    Clock::time_point m_start;
+
+  public:
+    Scope(const char *name);
+    Scope(const Scope &) = delete;
+    ~Scope();
+  };
+
+  static TraceRecorder *instance();
+
+  bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+  void setEnabled(bool value);
+
+  /**
+   * Record an event on the calling thread. Does nothing while tracing is disabled.
+   */
+  void record(const char *name, Clock::time_point start, Clock::time_point end);
+
+  /**
+   * Serialize the events currently held by every thread buffer as a Chrome trace JSON document.
+   * Can be called while other threads keep recording.
+   */
+  QByteArray toChromeTrace(size_t *eventCount = nullptr) const;
+
+  TraceRecorder();
+
+private:
+  static constexpr size_t BUFFER_CAPACITY = 8192;
+
+  // fields are written by the owning thread and read by whoever dumps the buffer, relaxed atomics are
+  // only there to make that well defined
+  struct Event {
+    std::atomic<const char *> name = nullptr;
+    std::atomic<int64_t> start = 0;
+    std::atomic<int64_t> duration = 0;
+  };
+
+  struct ThreadBuffer {
+    int tid = 0;
+    QString threadName;
+    // set once the owning thread exits, after which the buffer can be handed to a new thread
+    std::atomic<bool> retired = false;
+    // total number of events ever written, the next slot being `head % BUFFER_CAPACITY`
+    std::atomic<uint64_t> head = 0;
+    std::array<Event, BUFFER_CAPACITY> events;
+  };
+
+  friend struct ThreadBufferHandle;
+
+  ThreadBuffer *acquireBuffer();
+
+  std::atomic<bool> m_enabled = false;
+  Clock::time_point m_origin = Clock::now();
+  mutable std::mutex m_mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+};
@@ -13,6 +13,7 @@ ListItemViewModel ListModelParser::parseListItem(const QJsonObject &instance, si
   auto props = instance.value("props").toObject();
   auto children = instance.value("children").toArray();
 
+  model.changed = instance.value("dirty").toBool(true) || instance.value("propsDirty").toBool(true);
   model.id = props["id"].toString(QString::number(index));
   model.title = props["title"].toString();
   model.subtitle = props["subtitle"].toString();
@@ -0,0 +1,193 @@
+#include "extend/render-tree.hpp"
+#include <algorithm>
+#include <qlogging.h>
+
+int RenderTree::insertNode(const QJsonObject &obj, int parent) {
+  int id = obj.value("id").toInt(-1);
+  Node node;
+
+  node.type = obj.value("type").toString();
+  node.props = obj.value("props").toObject();
+  node.parent = parent;
+  node.dirty = obj.value("dirty").toBool(true);
+  node.propsDirty = obj.value("propsDirty").toBool(true);
+
+  auto children = obj.value("children").toArray();
+
+  node.children.reserve(children.size());
+
+  for (const auto &child : children) {
+    node.children.emplace_back(insertNode(child.toObject(), id));
+  }
+
+  m_nodes[id] = std::move(node);
+
+  return id;
+}
+
+void RenderTree::removeNode(int id) {
+  auto it = m_nodes.find(id);
+
+  if (it == m_nodes.end()) return;
+
+  auto children = std::move(it->second.children);
+
+  m_nodes.erase(it);
+
+  for (int child : children) {
+    removeNode(child);
+  }
+}
+
+void RenderTree::markDirty(int id) {
+  auto it = m_nodes.find(id);
+
+  while (it != m_nodes.end()) {
+    it->second.dirty = true;
+    it = m_nodes.find(it->second.parent);
+  }
+}
+
+QJsonObject RenderTree::serialize(int id) const {
+  auto &node = m_nodes.at(id);
+  QJsonObject obj;
+  QJsonArray children;
+
+  for (int child : node.children) {
+    children.append(serialize(child));
+  }
+
+  obj["type"] = node.type;
+  obj["props"] = node.props;
+  obj["dirty"] = node.dirty;
+  obj["propsDirty"] = node.propsDirty;
+  obj["children"] = children;
+
+  return obj;
+}
+
+void RenderTree::reset(const QJsonArray &views) {
+  Node root{.type = "root", .dirty = true, .propsDirty = false};
+
+  m_nodes.clear();
+  root.children.reserve(views.size());
+
+  for (const auto &view : views) {
+    root.children.emplace_back(insertNode(view.toObject().value("root").toObject(), ROOT_ID));
+  }
+
+  m_nodes[ROOT_ID] = std::move(root);
+}
+
+bool RenderTree::applyInsert(const QJsonObject &patch) {
+  auto parent = m_nodes.find(patch.value("parent").toInt(-1));
+
+  if (parent == m_nodes.end()) return false;
+
+  auto &children = parent->second.children;
+  size_t index = std::clamp<qsizetype>(patch.value("index").toInt(), 0, children.size());
+  int id = insertNode(patch.value("node").toObject(), parent->first);
+
+  children.insert(children.begin() + index, id);
+  markDirty(parent->first);
+
+  return true;
+}
+
+bool RenderTree::applyRemove(const QJsonObject &patch) {
+  auto parent = m_nodes.find(patch.value("parent").toInt(-1));
+
+  if (parent == m_nodes.end()) return false;
+
+  int id = patch.value("id").toInt(-1);
+  auto &children = parent->second.children;
+  auto it = std::ranges::find(children, id);
+
+  if (it == children.end()) return false;
+
+  children.erase(it);
+  markDirty(parent->first);
+  removeNode(id);
+
+  return true;
+}
+
+bool RenderTree::applyMove(const QJsonObject &patch) {
+  auto parent = m_nodes.find(patch.value("parent").toInt(-1));
+
+  if (parent == m_nodes.end()) return false;
+
+  int id = patch.value("id").toInt(-1);
+  auto &children = parent->second.children;
+  auto it = std::ranges::find(children, id);
+
+  if (it == children.end()) return false;
+
+  children.erase(it);
+
+  size_t index = std::clamp<qsizetype>(patch.value("index").toInt(), 0, children.size());
+
+  children.insert(children.begin() + index, id);
+  markDirty(parent->first);
+
+  return true;
+}
+
+bool RenderTree::applyUpdate(const QJsonObject &patch) {
+  auto it = m_nodes.find(patch.value("id").toInt(-1));
+
+  if (it == m_nodes.end()) return false;
+
+  it->second.props = patch.value("props").toObject();
+  it->second.propsDirty = true;
+  markDirty(it->second.parent);
+
+  return true;
+}
+
+bool RenderTree::applyPatches(const QJsonArray &patches) {
+  for (const auto &value : patches) {
+    auto patch = value.toObject();
+    auto op = patch.value("op").toString();
+    bool ok = false;
+
+    if (op == "insert") {
+      ok = applyInsert(patch);
+    } else if (op == "remove") {
+      ok = applyRemove(patch);
+    } else if (op == "move") {
+      ok = applyMove(patch);
+    } else if (op == "update") {
+      ok = applyUpdate(patch);
+    }
+
+    if (!ok) {
+      qCritical() << "Failed to apply render patch" << op;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+QJsonArray RenderTree::views() const {
+  QJsonArray views;
+
+  if (auto it = m_nodes.find(ROOT_ID); it != m_nodes.end()) {
+    for (int id : it->second.children) {
+      QJsonObject view;
+
+      view["root"] = serialize(id);
+      views.append(view);
+    }
+  }
+
+  return views;
+}
+
+void RenderTree::clearDirty() {
+  for (auto &[_, node] : m_nodes) {
+    node.dirty = false;
+    node.propsDirty = false;
+  }
+}
@@ -13,6 +13,7 @@
 #include "services/asset-resolver/asset-resolver.hpp"
 #include "ui/oauth-view.hpp"
 #include <QString>
+#include <qpointer.h>
 #include "services/root-item-manager/root-item-manager.hpp"
 #include "overlay-controller/overlay-controller.hpp"
 #include "utils/utils.hpp"
@@ -77,9 +78,32 @@ proto::ext::extension::Response *ExtensionCommandRuntime::dispatchRequest(Extens
   return makeErrorResponse("Unhandled top level request");
 }
 
+std::chrono::microseconds ExtensionCommandRuntime::elapsedSinceLaunch() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                               m_launchStart);
+}
+
+void ExtensionCommandRuntime::recordLaunch() {
+  if (std::exchange(m_launchRecorded, true)) return;
+
+  context()->services->extensionManager()->recordLaunch(m_launchTimings);
+}
+
 void ExtensionCommandRuntime::handleRequest(ExtensionRequest *request) {
   if (request->sessionId() != m_sessionId) return;
 
+  auto &data = request->requestData();
+
+  if (!m_launchTimings.firstRender && data.has_ui() && data.ui().has_render()) {
+    m_launchTimings.firstRender = elapsedSinceLaunch();
+    m_uiRouter->setNextPaintHandler([self = QPointer(this)]() {
+      if (!self) return;
+
+      self->m_launchTimings.firstPaint = self->elapsedSinceLaunch();
+      self->recordLaunch();
+    });
+  }
+
   if (auto res = dispatchRequest(request)) {
     request->respond(res);
     delete request;
@@ -170,17 +194,25 @@ void ExtensionCommandRuntime::load(const LaunchProps &props) {
 
   payload->set_allocated_load(load);
 
+  m_launchTimings = {.command = m_command->uniqueId(), .launchedAt = QDateTime::currentDateTime()};
+  m_launchStart = std::chrono::steady_clock::now();
+
   auto loadRequest = manager->requestManager(payload);
 
   connect(loadRequest, &ManagerRequest::finished, this,
           [this, loadRequest](const proto::ext::manager::ResponseData &data) {
             m_sessionId = QString::fromStdString(data.load().session_id());
             m_navigation->setSessionId(m_sessionId);
+            m_launchTimings.workerReady = elapsedSinceLaunch();
+            // there is nothing more to wait for
+            if (m_command->mode() != CommandModeView) recordLaunch();
             loadRequest->deleteLater();
           });
 }
 
 void ExtensionCommandRuntime::unload() {
+  // closed before the first paint, still worth knowing how far it got
+  recordLaunch();
   RelativeAssetResolver::instance()->removePath(m_command->assetPath());
 
   auto manager = context()->services->extensionManager();
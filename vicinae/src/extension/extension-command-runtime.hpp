@@ -1,6 +1,8 @@
 #pragma once
 #include "command.hpp"
+#include "extension/manager/extension-manager.hpp"
 #include "proto/extension.pb.h"
+#include <chrono>
 
 class ExtensionCommand;
 class StorageRequestRouter;
@@ -24,6 +26,13 @@ class ExtensionCommandRuntime : public CommandContext {
 
   QString m_sessionId;
 
+  std::chrono::steady_clock::time_point m_launchStart;
+  LaunchTimings m_launchTimings;
+  bool m_launchRecorded = false;
+
+  std::chrono::microseconds elapsedSinceLaunch() const;
+  void recordLaunch();
+
   proto::ext::extension::Response *makeErrorResponse(const QString &errorText);
   proto::ext::extension::Response *dispatchRequest(ExtensionRequest *request);
   void handleRequest(ExtensionRequest *request);
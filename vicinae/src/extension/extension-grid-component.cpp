@@ -114,7 +114,14 @@ void ExtensionGridComponent::onSelectionChanged(const GridItemViewModel *next) {
   if (auto handler = _model.onSelectionChanged) { notify(*handler, {next->id}); }
 }
 
-void ExtensionGridComponent::handleDebouncedSearchNotification() { auto text = searchText(); }
+void ExtensionGridComponent::handleDebouncedSearchNotification() {
+  if (auto handler = _model.onSearchTextChange) {
+    // flag next render to reset the search selection
+    _shouldResetSelection = !_model.filtering;
+
+    notify(*handler, {searchText()});
+  }
+}
 
 void ExtensionGridComponent::onItemActivated(const GridItemViewModel &item) { executePrimaryAction(); }
 
@@ -125,12 +132,8 @@ void ExtensionGridComponent::textChanged(const QString &text) {
     m_list->setFilter("");
   }
 
-  if (auto handler = _model.onSearchTextChange) {
-    // flag next render to reset the search selection
-    _shouldResetSelection = !_model.filtering;
-
-    notify(*handler, {text});
-  }
+  // same as for lists, only the text the user settled on is sent to the extension
+  if (_model.onSearchTextChange) _debounce->start();
 }
 
 ExtensionGridComponent::ExtensionGridComponent() : _debounce(new QTimer(this)), _shouldResetSelection(true) {
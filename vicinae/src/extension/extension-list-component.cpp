@@ -183,33 +183,28 @@ void ExtensionListComponent::handleDropdownSelectionChanged(const SelectorInput:
 }
 
 void ExtensionListComponent::handleDropdownSearchChanged(const QString &text) {
+  m_pendingDropdownSearchText = text;
+  m_dropdownDebounce->start();
+}
 
+void ExtensionListComponent::handleDebouncedDropdownSearchNotification() {
   if (auto accessory = _model.searchBarAccessory) {
     if (auto dropdown = std::get_if<DropdownModel>(&*accessory)) {
       m_dropdownShouldResetSelection = !dropdown->filtering.enabled;
 
-      if (auto onChange = dropdown->onSearchTextChange) { emit notify(*onChange, {text}); }
+      if (auto onChange = dropdown->onSearchTextChange) {
+        emit notify(*onChange, {m_pendingDropdownSearchText});
+      }
     }
   }
 }
 
 void ExtensionListComponent::handleDebouncedSearchNotification() {
-  auto text = searchText();
-  auto itemMatches = [&](const ListItemViewModel &model) -> bool {
-    return model.title.contains(searchText(), Qt::CaseInsensitive);
-  };
-
-  if (_model.filtering) {
-    m_list->setFilter(searchText());
-  } else {
-    m_list->setFilter("");
-  }
-
   if (auto handler = _model.onSearchTextChange) {
     // flag next render to reset the search selection
     _shouldResetSelection = !_model.filtering;
 
-    notify(*handler, {text});
+    notify(*handler, {searchText()});
   }
 }
 
@@ -226,13 +221,9 @@ void ExtensionListComponent::textChanged(const QString &text) {
     m_list->setFilter("");
   }
 
-  if (auto handler = _model.onSearchTextChange) {
-    // flag next render to reset the search selection
-    _shouldResetSelection = !_model.filtering;
-    notify(*handler, {text});
-  }
-
-  //_debounce->start();
+  // handlers can't be interrupted once they run, so keystrokes are coalesced before they reach the
+  // extension instead: only the text the user settled on is sent (see `throttle`)
+  if (_model.onSearchTextChange) _debounce->start();
 }
 
 ExtensionListComponent::ExtensionListComponent() : _debounce(new QTimer(this)), _shouldResetSelection(true) {
@@ -246,7 +237,10 @@ ExtensionListComponent::ExtensionListComponent() : _debounce(new QTimer(this)),
   setupUI(m_split);
 
   _debounce->setSingleShot(true);
+  m_dropdownDebounce->setSingleShot(true);
   connect(_debounce, &QTimer::timeout, this, &ExtensionListComponent::handleDebouncedSearchNotification);
+  connect(m_dropdownDebounce, &QTimer::timeout, this,
+          &ExtensionListComponent::handleDebouncedDropdownSearchNotification);
   connect(m_list, &ExtensionList::selectionChanged, this, &ExtensionListComponent::onSelectionChanged);
   connect(m_list, &ExtensionList::itemActivated, this, &ExtensionListComponent::onItemActivated);
   connect(m_selector, &SelectorInput::selectionChanged, this,
@@ -1,8 +1,10 @@
 #include "extension/manager/extension-manager.hpp"
+#include "daemon/perf-metrics.hpp"
 #include <QtConcurrent/qtconcurrentrun.h>
 #include <absl/strings/internal/str_format/extension.h>
 #include <qfuturewatcher.h>
 #include <qlogging.h>
+#include <qstandardpaths.h>
 #include <qstringview.h>
 #include <string>
 #include <unordered_map>
@@ -126,6 +128,9 @@ ExtensionManager::ExtensionManager(OmniCommandDatabase &commandDb) : commandDb(c
 
   env.insert("VICINAE_VERSION", VICINAE_GIT_TAG);
   env.insert("VICINAE_COMMIT", VICINAE_GIT_COMMIT_HASH);
+  // where compiled extension code is cached, if the node version supports it
+  env.insert("VICINAE_COMPILE_CACHE", QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+                                          QLatin1StringView("/extension-compile-cache"));
   process.setProcessEnvironment(env);
 
   connect(&process, &QProcess::readyReadStandardError, this, &ExtensionManager::readError);
@@ -198,6 +203,31 @@ bool ExtensionManager::hasDevelopmentSession(const QString &id) const {
   return std::ranges::contains(m_developmentSessions, id);
 }
 
+void ExtensionManager::recordLaunch(const LaunchTimings &timings) {
+  auto format = [](const std::optional<std::chrono::microseconds> &duration) -> QString {
+    if (!duration) return "-";
+    return QString("%1ms").arg(duration->count() / 1000.0, 0, 'f', 1);
+  };
+
+  qInfo().noquote() << QString("[launch] %1: worker ready %2, first render %3, first paint %4")
+                           .arg(timings.command)
+                           .arg(format(timings.workerReady))
+                           .arg(format(timings.firstRender))
+                           .arg(format(timings.firstPaint));
+
+  static auto &workerReady = PerfMetrics::instance()->histogram("extension-launch-worker-ready");
+  static auto &firstRender = PerfMetrics::instance()->histogram("extension-launch-first-render");
+  static auto &firstPaint = PerfMetrics::instance()->histogram("extension-launch-first-paint");
+
+  if (timings.workerReady) workerReady.record(*timings.workerReady);
+  if (timings.firstRender) firstRender.record(*timings.firstRender);
+  if (timings.firstPaint) firstPaint.record(*timings.firstPaint);
+
+  m_launchTimings.emplace_back(timings);
+
+  if (m_launchTimings.size() > MAX_LAUNCH_TIMINGS) m_launchTimings.pop_front();
+}
+
 void ExtensionManager::emitGenericExtensionEvent(const QString &sessionId, const QString &handlerId,
                                                  const QJsonArray &args) {
   auto qualified = new proto::ext::QualifiedExtensionEvent;
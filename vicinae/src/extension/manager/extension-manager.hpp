@@ -4,7 +4,9 @@
 #include <QString>
 #include <QUuid>
 #include <QtCore>
+#include <chrono>
 #include <cstdint>
+#include <deque>
 #include "common.hpp"
 #include "extension/extension.hpp"
 #include "omni-command-db.hpp"
@@ -13,6 +15,8 @@
 #include "proto/ipc.pb.h"
 #include "proto/manager.pb.h"
 #include <netinet/in.h>
+#include <optional>
+#include <qdatetime.h>
 #include <qdebug.h>
 #include <qdir.h>
 #include <qfuturewatcher.h>
@@ -122,6 +126,22 @@ public:
   ExtensionEvent(const proto::ext::QualifiedExtensionEvent &event) : m_event(event) {}
 };
 
+/**
+ * How long each phase of a command launch took, counted from the moment the load request was sent
+ * to the extension manager. Phases that were not reached (e.g no-view commands never render) are
+ * left empty.
+ */
+struct LaunchTimings {
+  QString command;
+  QDateTime launchedAt;
+  // the command was assigned a worker and is about to start running
+  std::optional<std::chrono::microseconds> workerReady;
+  // the first render tree was received from the extension
+  std::optional<std::chrono::microseconds> firstRender;
+  // the view rendered from the first render tree was painted on screen
+  std::optional<std::chrono::microseconds> firstPaint;
+};
+
 struct PendingManagerRequestInfo {
   QString sessionId;
 };
@@ -134,6 +154,9 @@ class ExtensionManager : public QObject {
   std::vector<std::shared_ptr<Extension>> loadedExtensions;
   OmniCommandDatabase &commandDb;
   std::unordered_set<QString> m_developmentSessions;
+  std::deque<LaunchTimings> m_launchTimings;
+
+  static constexpr size_t MAX_LAUNCH_TIMINGS = 50;
 
 public:
   ExtensionManager(OmniCommandDatabase &commandDb);
@@ -149,6 +172,12 @@ public:
   void removeDevelopmentSession(const QString &id);
   bool hasDevelopmentSession(const QString &id) const;
 
+  /**
+   * Keep track of how long a command took to launch, only the most recent launches are kept.
+   */
+  void recordLaunch(const LaunchTimings &timings);
+  const std::deque<LaunchTimings> &launchTimings() const { return m_launchTimings; }
+
   void processStarted();
   static QJsonObject serializeLaunchProps(const LaunchProps &props);
 
@@ -52,6 +52,38 @@ storage::ListResponse *StorageRequestRouter::handleListStorage(const storage::Li
   return res;
 }
 
+storage::GetManyResponse *StorageRequestRouter::handleGetManyStorage(const storage::GetManyRequest &req) {
+  auto res = new storage::GetManyResponse;
+  auto values = res->mutable_values();
+  QStringList keys;
+
+  keys.reserve(req.keys_size());
+
+  for (const auto &key : req.keys()) {
+    keys << QString::fromStdString(key);
+  }
+
+  auto jsonValues = m_storage->getItems(m_namespaceId, keys);
+
+  for (auto it = jsonValues.begin(); it != jsonValues.end(); ++it) {
+    values->insert({it.key().toStdString(), transformJsonValueToProto(it.value())});
+  }
+
+  return res;
+}
+
+storage::SetManyResponse *StorageRequestRouter::handleSetManyStorage(const storage::SetManyRequest &req) {
+  QJsonObject values;
+
+  for (const auto &[key, value] : req.values()) {
+    values[QString::fromStdString(key)] = protoToJsonValue(value);
+  }
+
+  m_storage->setItems(m_namespaceId, values);
+
+  return new storage::SetManyResponse;
+}
+
 proto::ext::extension::Response *StorageRequestRouter::route(const storage::Request &req) {
   namespace storage = storage;
   auto storageRes = new storage::Response();
@@ -72,6 +104,12 @@ proto::ext::extension::Response *StorageRequestRouter::route(const storage::Requ
   case storage::Request::kList:
     storageRes->set_allocated_list(handleListStorage(req.list()));
     break;
+  case storage::Request::kGetMany:
+    storageRes->set_allocated_get_many(handleGetManyStorage(req.get_many()));
+    break;
+  case storage::Request::kSetMany:
+    storageRes->set_allocated_set_many(handleSetManyStorage(req.set_many()));
+    break;
   default: {
     delete storageRes;
     return makeErrorResponse("Unhandled storage response");
@@ -86,3 +124,11 @@ proto::ext::extension::Response *StorageRequestRouter::route(const storage::Requ
 
   return response;
 }
+
+StorageRequestRouter::StorageRequestRouter(LocalStorageService *storage, const QString &namespaceId)
+    : m_storage(storage), m_namespaceId(namespaceId) {
+  // the namespace stays in memory for as long as the extension runs
+  m_storage->acquireNamespace(m_namespaceId);
+}
+
+StorageRequestRouter::~StorageRequestRouter() { m_storage->releaseNamespace(m_namespaceId); }
@@ -24,10 +24,12 @@ class StorageRequestRouter {
   proto::ext::storage::ClearResponse *handleClearStorage(const proto::ext::storage::ClearRequest &req);
   proto::ext::storage::RemoveResponse *handleRemoveStorage(const proto::ext::storage::RemoveRequest &req);
   proto::ext::storage::ListResponse *handleListStorage(const proto::ext::storage::ListRequest &req);
+  proto::ext::storage::GetManyResponse *handleGetManyStorage(const proto::ext::storage::GetManyRequest &req);
+  proto::ext::storage::SetManyResponse *handleSetManyStorage(const proto::ext::storage::SetManyRequest &req);
 
 public:
-  StorageRequestRouter(LocalStorageService *storage, const QString &namespaceId)
-      : m_storage(storage), m_namespaceId(namespaceId) {}
+  StorageRequestRouter(LocalStorageService *storage, const QString &namespaceId);
+  ~StorageRequestRouter();
 
   proto::ext::extension::Response *route(const proto::ext::storage::Request &req);
 };
@@ -1,10 +1,11 @@
 #include "ui-request-router.hpp"
+#include "daemon/perf-metrics.hpp"
 #include "proto/ui.pb.h"
-#include "timer.hpp"
 #include "ui/alert/alert.hpp"
 #include "ui/toast/toast.hpp"
 #include <QtConcurrent/QtConcurrent>
 #include <QClipboard>
+#include <qevent.h>
 #include <unordered_map>
 
 namespace ui = proto::ext::ui;
@@ -15,6 +16,30 @@ static const std::unordered_map<ui::ToastStyle, ToastPriority> toastMap = {
     {ui::ToastStyle::Dynamic, ToastPriority::Dynamic},
 };
 
+/**
+ * Calls its handler the next time the watched widget gets painted, then goes away.
+ */
+class PaintObserver : public QObject {
+  std::function<void()> m_handler;
+
+  bool eventFilter(QObject *watched, QEvent *event) override {
+    if (event->type() == QEvent::Paint && m_handler) {
+      std::exchange(m_handler, {})();
+      deleteLater();
+    }
+
+    return false;
+  }
+
+public:
+  PaintObserver(QWidget *widget, std::function<void()> handler)
+      : QObject(widget), m_handler(std::move(handler)) {
+    widget->installEventFilter(this);
+    // the render may only have invalidated child widgets
+    widget->update();
+  }
+};
+
 ToastPriority UIRequestRouter::parseProtoToastStyle(ui::ToastStyle style) {
   if (auto it = toastMap.find(style); it != toastMap.end()) return it->second;
 
@@ -24,9 +49,16 @@ ToastPriority UIRequestRouter::parseProtoToastStyle(ui::ToastStyle style) {
 void UIRequestRouter::modelCreated() {
   if (m_modelWatcher.isCanceled()) return;
 
+  static auto &applyLatency = PerfMetrics::instance()->histogram("extension-render-apply");
+  auto timer = applyLatency.time();
   auto views = m_navigation->views();
   auto models = m_modelWatcher.result();
+
+  // everything that changed up to this point is about to be rendered
+  m_renderTree->clearDirty();
+
   auto items = models.items | std::views::take(views.size()) | std::views::enumerate;
+  ExtensionViewWrapper *lastRendered = nullptr;
 
   for (const auto &[n, model] : items) {
     auto view = views.at(n);
@@ -35,6 +67,11 @@ void UIRequestRouter::modelCreated() {
     if (shouldSkipRender) { continue; }
 
     view->render(model.root);
+    lastRendered = view;
+  }
+
+  if (lastRendered && m_nextPaintHandler) {
+    new PaintObserver(lastRendered, std::exchange(m_nextPaintHandler, {}));
   }
 }
 
@@ -195,7 +232,11 @@ proto::ext::ui::Response *UIRequestRouter::handleRender(const proto::ext::ui::Re
   /**
    * For now, we still process the render tree as JSON. Maybe later we can move that to protobuf as well,
    * but that will require writing more serialization code in the reconciler.
+   * The first render carries the full tree under `views`, subsequent ones only carry `patches`
+   * that are applied to our copy of the tree.
    */
+  static auto &patchLatency = PerfMetrics::instance()->histogram("extension-render-patch");
+  auto timer = patchLatency.time();
   QJsonParseError parseError;
   auto doc = QJsonDocument::fromJson(request.json().c_str(), &parseError);
 
@@ -204,25 +245,44 @@ proto::ext::ui::Response *UIRequestRouter::handleRender(const proto::ext::ui::Re
     return {};
   }
 
-  auto views = doc.object().value("views").toArray();
+  auto obj = doc.object();
+  auto ack = []() {
+    auto response = new proto::ext::ui::Response;
+    response->set_allocated_render(new proto::ext::common::AckResponse);
+    return response;
+  };
 
+  // the tree is read from the parsing thread, so it can't be patched while a parse is running
   if (m_modelWatcher.isRunning()) {
     m_modelWatcher.cancel();
     m_modelWatcher.waitForFinished();
   }
 
-  m_modelWatcher.setFuture(QtConcurrent::run([views]() {
-    Timer timer;
-    auto model = ModelParser().parse(views);
+  if (obj.contains("patches")) {
+    // patches sent before the extension processed our resync request target a tree we no longer have
+    if (m_awaitingFullRender) return ack();
+
+    if (!m_renderTree->applyPatches(obj.value("patches").toArray())) {
+      qCritical() << "Render tree is out of sync with the extension, requesting a full render";
+      m_renderTree->reset({});
+      m_awaitingFullRender = true;
+      m_navigation->controller()->notify("render-resync", {});
+      return ack();
+    }
+  } else {
+    m_renderTree->reset(obj.value("views").toArray());
+    m_awaitingFullRender = false;
+  }
 
-    // timer.time("Model parsed");
-    return model;
-  }));
+  timer.finish();
 
-  auto response = new proto::ext::ui::Response;
+  m_modelWatcher.setFuture(QtConcurrent::run([tree = m_renderTree]() {
+    static auto &parseLatency = PerfMetrics::instance()->histogram("extension-render-parse");
+    auto timer = parseLatency.time();
 
-  response->set_allocated_render(new proto::ext::common::AckResponse);
+    return ModelParser().parse(tree->views());
+  }));
 
   // render queued
-  return response;
+  return ack();
 }
@@ -1,5 +1,7 @@
 #pragma once
 #include "extension/extension-navigation-controller.hpp"
+#include "extend/render-tree.hpp"
+#include <functional>
 #include <qjsonarray.h>
 #include <qjsonobject.h>
 #include <qobject.h>
@@ -9,8 +11,12 @@
 
 class UIRequestRouter : public QObject {
   QFutureWatcher<ParsedRenderData> m_modelWatcher;
+  std::shared_ptr<RenderTree> m_renderTree = std::make_shared<RenderTree>();
   ExtensionNavigationController *m_navigation = nullptr;
   ToastService &m_toast;
+  std::function<void()> m_nextPaintHandler;
+  // set when a patch could not be applied, until the extension sends the full tree again
+  bool m_awaitingFullRender = false;
 
   ToastPriority parseProtoToastStyle(proto::ext::ui::ToastStyle style);
 
@@ -32,6 +38,11 @@ class UIRequestRouter : public QObject {
 public:
   proto::ext::extension::Response *route(const proto::ext::ui::Request &req);
 
+  /**
+   * Call `handler` once, after the view rendered from the next render tree was painted on screen.
+   */
+  void setNextPaintHandler(std::function<void()> handler) { m_nextPaintHandler = std::move(handler); }
+
   UIRequestRouter(ExtensionNavigationController *navigation, ToastService &toast)
       : m_navigation(navigation), m_toast(toast) {
     connect(&m_modelWatcher, &QFutureWatcher<RenderModel>::finished, this, &UIRequestRouter::modelCreated);
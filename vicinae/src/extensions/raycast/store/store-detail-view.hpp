@@ -242,20 +242,51 @@ class RaycastStoreDetailView : public BaseView {
     auto install = new StaticAction(
         "Install extension", m_ext.themedIcon(), [ext = m_ext](const ApplicationContext *ctx) {
           using Watcher = QFutureWatcher<Raycast::DownloadExtensionResult>;
+          using InstallWatcher = QFutureWatcher<bool>;
           auto store = ctx->services->raycastStore();
+          auto toastService = ctx->services->toastService();
           auto watcher = new Watcher;
-          ctx->services->toastService()->setToast("Downloading extension...");
+          auto toast = new Toast("Downloading extension...", ToastPriority::Dynamic);
 
-          QObject::connect(watcher, &Watcher::finished, [ctx, ext, watcher]() {
+          toastService->registerToast(toast);
+
+          QObject::connect(watcher, &Watcher::progressValueChanged, toast, [toast](int progress) {
+            toast->setTitle(QString("Downloading extension... %1%").arg(progress));
+          });
+
+          QObject::connect(watcher, &Watcher::finished, [ctx, ext, watcher, toast]() {
             auto result = watcher->result();
+            auto toastService = ctx->services->toastService();
 
             watcher->deleteLater();
 
-            if (!result) { ctx->services->toastService()->setToast("Failed to download extension"); }
+            if (!result) {
+              toast->deleteLater();
+              toastService->failure("Failed to download extension");
+              return;
+            }
+
+            auto install = new InstallWatcher;
+
+            toast->setTitle("Installing extension...");
+
+            QObject::connect(install, &InstallWatcher::progressValueChanged, toast, [toast](int progress) {
+              toast->setTitle(QString("Installing extension... %1%").arg(progress));
+            });
+
+            QObject::connect(install, &InstallWatcher::finished, [toastService, install, toast]() {
+              toast->deleteLater();
+              install->deleteLater();
+
+              if (!install->result()) {
+                toastService->failure("Failed to install extension");
+                return;
+              }
+
+              toastService->success("Extension installed");
+            });
 
-            ctx->services->extensionRegistry()->installFromZip(ext.id,
-                                                               std::string_view(result->toStdString()));
-            ctx->services->toastService()->setToast("Extension downloaded");
+            install->setFuture(ctx->services->extensionRegistry()->installFromZip(ext.id, *result));
           });
 
           auto downloadResult = store->downloadExtension(ext.download_url);
@@ -119,18 +119,22 @@ class RaycastStoreListingView : public ListView {
   QFutureWatcher<Raycast::ListResult> m_queryResultWatcher;
   QString lastQueryText;
   QTimer m_debounce;
+  CancellationSource m_searchCancellation;
 
   void handleDebounce() {
     if (searchText().isEmpty()) return;
 
     setLoading(true);
     lastQueryText = searchText();
-    auto result = m_store->search(lastQueryText);
+    auto result = m_store->search(lastQueryText, m_searchCancellation.next());
 
     m_queryResultWatcher.setFuture(result);
   }
 
   void textChanged(const QString &text) override {
+    // the request for the previous text is not wanted anymore, even if the new one is only sent later
+    m_searchCancellation.cancel();
+
     if (text.isEmpty()) {
       setLoading(true);
       auto result = m_store->fetchExtensions();
@@ -143,7 +147,7 @@ class RaycastStoreListingView : public ListView {
   }
 
   void handleFinishedQuery() {
-    if (searchText() != lastQueryText) return;
+    if (m_searchCancellation.token().isCancelled() || searchText() != lastQueryText) return;
 
     auto result = m_queryResultWatcher.result();
 
@@ -3,7 +3,13 @@
 #include "favicon/dummy-favicon-request.hpp"
 #include "favicon/google-favicon-request.hpp"
 #include "favicon/twenty-favicon-request.hpp"
+#include <QtConcurrent/QtConcurrent>
+#include <qdatetime.h>
+#include <qfuturewatcher.h>
+#include <qimagereader.h>
 #include <qlogging.h>
+#include <qsavefile.h>
+#include <qthreadpool.h>
 
 static const std::vector<FaviconService::FaviconServiceData> faviconProviders = {
     {.id = "google", .name = "Google", .icon = ImageURL::builtin("google"), .type = FaviconService::Google},
@@ -18,53 +24,138 @@ FaviconService *FaviconService::instance() {
 }
 
 void FaviconService::insertCache(const QString &key, const QPixmap &favicon) {
-  if (_cache.size() > maxCacheCount) { _cache.erase(_cache.begin()); }
+  size_t size = static_cast<size_t>(favicon.width()) * favicon.height() * std::max(1, favicon.depth() / 8);
 
-  _cache.insert({key, favicon});
+  if (auto it = _cache.find(key); it != _cache.end()) {
+    _cacheSize -= it->second.size;
+    _lru.erase(it->second.lru);
+    _cache.erase(it);
+  }
+
+  _lru.push_front(key);
+  _cache[key] = CacheEntry{.pixmap = favicon, .size = size, .lru = _lru.begin()};
+  _cacheSize += size;
+
+  while (_cacheSize > maxCacheSize && _lru.size() > 1) {
+    auto it = _cache.find(_lru.back());
+
+    _cacheSize -= it->second.size;
+    _cache.erase(it);
+    _lru.pop_back();
+  }
+}
+
+const QPixmap *FaviconService::retrieveFromCache(const QString &domain) {
+  auto it = _cache.find(domain);
+
+  if (it == _cache.end()) return nullptr;
+
+  _lru.splice(_lru.begin(), _lru, it->second.lru);
+
+  return &it->second.pixmap;
+}
+
+void FaviconService::touch(const QString &domain) {
+  qint64 now = QDateTime::currentSecsSinceEpoch();
+  auto [it, inserted] = m_lastTouched.try_emplace(domain, now);
+
+  if (!inserted) {
+    if (now - it->second < touchInterval) return;
+    it->second = now;
+  }
+
+  if (!m_writeQueue) return;
+
+  m_writeQueue->enqueue({.sql = "UPDATE favicon SET last_used_at = unixepoch() WHERE id = :domain;",
+                         .bindings = {{":domain", domain}}},
+                        "last_used_at:" + domain);
 }
 
 void FaviconService::handleFetchedFavicon(const QString &domain, const QPixmap &favicon) {
+  if (favicon.isNull()) return;
+
   insertCache(domain, favicon);
+  m_lastTouched[domain] = QDateTime::currentSecsSinceEpoch();
 
-  if (!favicon.save(_dataDir.filePath(domain), "PNG")) {
-    qDebug() << "Failed to save favicon on disk";
-    return;
-  }
+  QString path = _dataDir.filePath(domain);
 
-  QSqlQuery query(_db);
+  // encoding is done off the GUI thread, and the file is renamed in place once written so that
+  // concurrent disk loads never see a partial favicon
+  QThreadPool::globalInstance()->start([path, image = favicon.toImage()]() {
+    QSaveFile file(path);
+
+    if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit()) {
+      qDebug() << "Failed to save favicon on disk" << path;
+    }
+  });
+
+  if (!m_writeQueue) return;
 
-  query.prepare(R"(
+  m_writeQueue->enqueue({.sql = R"(
 		INSERT INTO favicon (id, size)
 		VALUES (:id, :size)
-	)");
-  query.bindValue(":id", domain);
-  query.bindValue(":size", favicon.width());
+		ON CONFLICT (id) DO UPDATE SET size = :size, updated_at = unixepoch()
+	)",
+                         .bindings = {{":id", domain}, {":size", favicon.width()}}});
+}
 
-  if (!query.exec()) {
-    qDebug() << "Favicon DB: failed to insert favicon: " << query.lastError();
-    return;
+void FaviconService::resolvePending(const QString &domain, const FaviconResponse &response) {
+  auto it = m_pending.find(domain);
+
+  if (it == m_pending.end()) return;
+
+  auto promises = std::move(it->second);
+
+  m_pending.erase(it);
+
+  for (const auto &promise : promises) {
+    promise->addResult(response);
+    promise->finish();
   }
 }
 
-QPixmap FaviconService::retrieveFromCache(const QString &domain) {
-  if (auto it = _cache.find(domain); it != _cache.end()) { return it->second; }
-
-  QPixmap pm;
-  QSqlQuery query(_db);
+void FaviconService::handleDiskLoad(const QString &domain, const QImage &image) {
+  if (image.isNull()) {
+    fetchFavicon(domain);
+    return;
+  }
 
-  query.prepare("UPDATE favicon SET last_used_at = unixepoch() WHERE id = :domain;");
-  query.bindValue(":domain", domain);
+  auto pixmap = QPixmap::fromImage(image);
 
-  if (!query.exec()) { qDebug() << "Favicon DB: failed to update last_used_at" << query.lastError(); }
+  insertCache(domain, pixmap);
+  resolvePending(domain, pixmap);
+}
 
-  QFile favicon(_dataDir.filePath(domain));
+void FaviconService::fetchFavicon(const QString &domain) {
+  AbstractFaviconRequest *requester = nullptr;
 
-  if (favicon.open(QIODevice::ReadOnly)) {
-    pm.loadFromData(favicon.readAll());
-    insertCache(domain, pm);
+  switch (_requesterType) {
+  case Google:
+    requester = new GoogleFaviconRequester(domain, this);
+    break;
+  case Twenty:
+    requester = new TwentyFaviconRequester(domain, this);
+    break;
+  case None:
+    resolvePending(domain, std::unexpected("Favicon fetching is disabled"));
+    return;
+  default:
+    requester = new DummyFaviconRequest(domain, this);
   }
 
-  return pm;
+  connect(requester, &AbstractFaviconRequest::finished, this,
+          [this, requester, domain](const QPixmap &favicon) {
+            handleFetchedFavicon(domain, favicon);
+            resolvePending(domain, favicon);
+            requester->deleteLater();
+          });
+
+  connect(requester, &AbstractFaviconRequest::failed, this, [this, requester, domain]() {
+    resolvePending(domain, std::unexpected("Failed to fetch favicon"));
+    requester->deleteLater();
+  });
+
+  requester->start();
 }
 
 void FaviconService::setService(const QString &id) {
@@ -79,45 +170,38 @@ void FaviconService::setService(const QString &id) {
 
 void FaviconService::setService(RequesterType type) { _requesterType = type; }
 
-QFuture<FaviconService::FaviconResponse> FaviconService::makeRequest(const QString &domain, QObject *parent) {
-  QPromise<FaviconResponse> promise;
-  auto future = promise.future();
+QFuture<FaviconService::FaviconResponse> FaviconService::makeRequest(const QString &domain) {
+  auto promise = std::make_shared<QPromise<FaviconResponse>>();
+  auto future = promise->future();
 
-  if (auto pix = retrieveFromCache(domain); !pix.isNull()) {
-    promise.addResult(pix);
-    promise.finish();
+  if (auto pix = retrieveFromCache(domain)) {
+    touch(domain);
+    promise->addResult(*pix);
+    promise->finish();
 
     return future;
   }
 
-  AbstractFaviconRequest *requester = nullptr;
+  auto &waiting = m_pending[domain];
 
-  switch (_requesterType) {
-  case Google:
-    requester = new GoogleFaviconRequester(domain, parent);
-    break;
-  case Twenty:
-    requester = new TwentyFaviconRequester(domain, parent);
-    break;
-  case None:
-    promise.addResult(std::unexpected("Favicon fetching is disabled"));
-    promise.finish();
-    return future;
-  default:
-    requester = new DummyFaviconRequest(domain, parent);
-  }
+  waiting.emplace_back(promise);
 
-  qDebug() << "request start !";
+  // a load for this domain is already in flight
+  if (waiting.size() > 1) return future;
 
-  connect(requester, &AbstractFaviconRequest::finished, this,
-          [this, requester, domain, promise = std::move(promise)](const QPixmap &favicon) mutable {
-            handleFetchedFavicon(domain, favicon);
-            promise.addResult(favicon);
-            promise.finish();
-            requester->deleteLater();
-          });
+  touch(domain);
 
-  requester->start();
+  auto watcher = new QFutureWatcher<QImage>(this);
+
+  connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, domain]() {
+    handleDiskLoad(domain, watcher->result());
+    watcher->deleteLater();
+  });
+
+  watcher->setFuture(QtConcurrent::run([path = _dataDir.filePath(domain)]() {
+    // a missing file simply yields a null image
+    return QImageReader(path).read();
+  }));
 
   return future;
 }
@@ -147,4 +231,6 @@ FaviconService::FaviconService(const std::filesystem::path &path, QObject *paren
 	)");
 
   if (!ok) { qDebug() << "Failed to init favicon database:" << query.lastError(); }
+
+  m_writeQueue = std::make_unique<SqlWriteQueue>(_db);
 }
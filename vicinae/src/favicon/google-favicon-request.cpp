@@ -34,7 +34,7 @@ void GoogleFaviconRequester::tryForCurrentSize() {
   auto reply = NetworkFetcher::instance()->fetch(serviceUrl);
 
   connect(reply, &FetchReply::finished, this, &GoogleFaviconRequester::imageLoaded);
-  // connect(reply, &ImageReply::loadingError, this, &GoogleFaviconRequester::loadingFailed);
+  connect(reply, &FetchReply::failed, this, &GoogleFaviconRequester::loadingFailed);
   _currentReply = reply;
 }
 
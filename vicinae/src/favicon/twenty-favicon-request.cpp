@@ -34,7 +34,7 @@ void TwentyFaviconRequester::tryForCurrentSize() {
   auto reply = NetworkFetcher::instance()->fetch(serviceUrl);
 
   connect(reply, &FetchReply::finished, this, &TwentyFaviconRequester::imageLoaded);
-  // connect(reply, &ImageReply::loadingError, this, &TwentyFaviconRequester::loadingFailed);
+  connect(reply, &FetchReply::failed, this, &TwentyFaviconRequester::loadingFailed);
   _currentReply = reply;
 }
 
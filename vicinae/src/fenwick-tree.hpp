@@ -0,0 +1,82 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * Binary indexed tree over a sequence of non-negative values.
+ * Supports point updates and prefix sums in O(log n), which makes it a good fit
+ * to track the offsets of a list of blocks whose sizes change independently.
+ */
+template <typename T> class FenwickTree {
+  std::vector<T> m_tree;
+  std::vector<T> m_values;
+
+public:
+  void assign(const std::vector<T> &values) {
+    m_values = values;
+    m_tree.assign(values.size() + 1, T{});
+
+    // O(n) construction: each node pushes its partial sum to its parent
+    for (size_t i = 1; i <= values.size(); ++i) {
+      m_tree[i] += values[i - 1];
+      if (size_t parent = i + (i & -i); parent <= values.size()) { m_tree[parent] += m_tree[i]; }
+    }
+  }
+
+  void clear() {
+    m_tree.clear();
+    m_values.clear();
+  }
+
+  size_t size() const { return m_values.size(); }
+
+  const T &at(size_t index) const { return m_values.at(index); }
+
+  void set(size_t index, T value) {
+    T delta = value - m_values[index];
+
+    m_values[index] = value;
+
+    for (size_t i = index + 1; i < m_tree.size(); i += i & -i) {
+      m_tree[i] += delta;
+    }
+  }
+
+  /**
+   * Sum of the values in [0, index).
+   */
+  T prefix(size_t index) const {
+    T sum{};
+
+    for (size_t i = index; i > 0; i -= i & -i) {
+      sum += m_tree[i];
+    }
+
+    return sum;
+  }
+
+  T total() const { return prefix(m_values.size()); }
+
+  /**
+   * Index of the first element for which prefix(index + 1) >= target, or size() if there is none.
+   * Values are expected to be non-negative.
+   */
+  size_t lowerBound(T target) const {
+    size_t pos = 0;
+    size_t step = 1;
+    T sum{};
+
+    while (step * 2 < m_tree.size()) {
+      step *= 2;
+    }
+
+    for (; step > 0; step /= 2) {
+      if (pos + step < m_tree.size() && sum + m_tree[pos + step] < target) {
+        pos += step;
+        sum += m_tree[pos];
+      }
+    }
+
+    return pos;
+  }
+};
@@ -0,0 +1,230 @@
+#include "image-fetcher.hpp"
+#include "vicinae.hpp"
+#include <algorithm>
+#include <qstandardpaths.h>
+#include <qstringlist.h>
+
+void FetcherWorker::initialize() {
+  QString directory =
+      QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1StringView("/omnicast/");
+
+  m_manager = new QNetworkAccessManager(this);
+  m_diskCache = new QNetworkDiskCache(m_manager);
+  m_diskCache->setCacheDirectory(directory);
+  m_diskCache->setMaximumCacheSize(Omnicast::IMAGE_DISK_CACHE_MAX_SIZE);
+  m_manager->setCache(m_diskCache);
+}
+
+void FetcherWorker::handleFetchRequest(quint64 id, QNetworkRequest request) {
+  if (!m_manager) return;
+
+  if (!request.attribute(QNetworkRequest::CacheLoadControlAttribute).isValid()) {
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
+  }
+
+  request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+
+  auto reply = m_manager->get(request);
+
+  connect(reply, &QNetworkReply::downloadProgress, this,
+          [this, id](qint64 received, qint64 total) { emit fetchProgress(id, received, total); });
+
+  connect(reply, &QNetworkReply::finished, this, [this, id, reply]() {
+    if (reply->error() != QNetworkReply::NoError) {
+      emit fetchFailed(id, reply->errorString());
+    } else {
+      emit fetchFinished(id, reply->readAll());
+    }
+
+    m_replies.erase(id);
+  });
+
+  m_replies.insert({id, QObjectUniquePtr<QNetworkReply>(reply)});
+}
+
+void FetcherWorker::handleAbortRequest(quint64 id) {
+  auto it = m_replies.find(id);
+
+  if (it == m_replies.end()) return;
+
+  // nobody is waiting on the result anymore, no need to report it
+  it->second->disconnect(this);
+  it->second->abort();
+  m_replies.erase(it);
+}
+
+FetcherWorker::FetcherWorker() {
+  // connected before the worker is moved to its thread, so that requests emitted before it started are
+  // queued rather than lost
+  connect(this, &FetcherWorker::fetchRequested, this, &FetcherWorker::handleFetchRequest);
+  connect(this, &FetcherWorker::abortRequested, this, &FetcherWorker::handleAbortRequest);
+}
+
+NetworkFetcher *NetworkFetcher::instance() {
+  static NetworkFetcher instance;
+
+  return &instance;
+}
+
+FetchReply *NetworkFetcher::fetch(const QUrl &url, Priority priority) {
+  return fetch(QNetworkRequest(url), priority);
+}
+
+QString NetworkFetcher::jobKey(const QNetworkRequest &request) {
+  QStringList parts{request.url().toString(QUrl::FullyEncoded)};
+
+  auto attributes = {QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::CacheSaveControlAttribute};
+
+  for (auto attribute : attributes) {
+    auto value = request.attribute(attribute);
+    parts << (value.isValid() ? value.toString() : QString());
+  }
+
+  auto headers = request.rawHeaderList();
+
+  std::ranges::sort(headers);
+
+  for (const auto &header : headers) {
+    parts << QString::fromUtf8(header + ':' + request.rawHeader(header));
+  }
+
+  return parts.join('\n');
+}
+
+FetchReply *NetworkFetcher::fetch(const QNetworkRequest &request, Priority priority) {
+  QString key = jobKey(request);
+  auto reply = new FetchReply(request.url());
+  quint64 id;
+
+  if (auto it = m_jobsByKey.find(key); it != m_jobsByKey.end()) {
+    id = it->second;
+    m_jobs.at(id).replies.emplace_back(reply);
+    promote(id, priority);
+  } else {
+    id = m_nextId++;
+    m_jobs.insert({id, Job{.key = key, .request = request, .priority = priority, .replies = {reply}}});
+    m_jobsByKey.insert({key, id});
+    m_queues[static_cast<size_t>(priority)].emplace_front(id);
+  }
+
+  connect(reply, &FetchReply::aborted, this, [this, id, reply]() { detach(id, reply); });
+  // row widgets are recycled all the time, which destroys their pending replies
+  connect(reply, &QObject::destroyed, this, [this, id, reply]() { detach(id, reply); });
+
+  startRequests();
+
+  return reply;
+}
+
+void NetworkFetcher::promote(quint64 id, Priority priority) {
+  auto &job = m_jobs.at(id);
+
+  if (job.started || priority >= job.priority) return;
+
+  std::erase(m_queues[static_cast<size_t>(job.priority)], id);
+  m_queues[static_cast<size_t>(priority)].emplace_front(id);
+  job.priority = priority;
+}
+
+void NetworkFetcher::detach(quint64 id, FetchReply *reply) {
+  auto it = m_jobs.find(id);
+
+  if (it == m_jobs.end()) return;
+
+  auto &job = it->second;
+
+  std::erase(job.replies, reply);
+
+  if (!job.replies.empty()) return;
+
+  if (job.started) {
+    emit m_worker->abortRequested(id);
+    m_running -= 1;
+  } else {
+    std::erase(m_queues[static_cast<size_t>(job.priority)], id);
+  }
+
+  m_jobsByKey.erase(job.key);
+  m_jobs.erase(it);
+  startRequests();
+}
+
+void NetworkFetcher::start(quint64 id) {
+  auto &job = m_jobs.at(id);
+
+  job.started = true;
+  m_running += 1;
+  emit m_worker->fetchRequested(id, job.request);
+}
+
+void NetworkFetcher::startRequests() {
+  auto &interactive = m_queues[static_cast<size_t>(Priority::Interactive)];
+
+  // interactive requests don't wait for a slot, the user is waiting on them
+  while (!interactive.empty()) {
+    start(interactive.front());
+    interactive.pop_front();
+  }
+
+  for (auto &queue : m_queues) {
+    while (!queue.empty() && m_running < m_concurrency) {
+      start(queue.front());
+      queue.pop_front();
+    }
+  }
+}
+
+std::vector<QPointer<FetchReply>> NetworkFetcher::takeJob(quint64 id) {
+  auto it = m_jobs.find(id);
+
+  // the job was aborted in the meantime
+  if (it == m_jobs.end()) return {};
+
+  // a slot may destroy other replies waiting on the same request
+  std::vector<QPointer<FetchReply>> replies(it->second.replies.begin(), it->second.replies.end());
+
+  if (it->second.started) m_running -= 1;
+
+  m_jobsByKey.erase(it->second.key);
+  m_jobs.erase(it);
+
+  return replies;
+}
+
+void NetworkFetcher::handleFetchProgress(quint64 id, qint64 received, qint64 total) {
+  auto it = m_jobs.find(id);
+
+  if (it == m_jobs.end()) return;
+
+  std::vector<QPointer<FetchReply>> replies(it->second.replies.begin(), it->second.replies.end());
+
+  for (const auto &reply : replies) {
+    if (reply) emit reply->progress(received, total);
+  }
+}
+
+void NetworkFetcher::handleFetchFinished(quint64 id, const QByteArray &data) {
+  for (const auto &reply : takeJob(id)) {
+    if (reply) emit reply->finished(data);
+  }
+
+  startRequests();
+}
+
+void NetworkFetcher::handleFetchFailed(quint64 id, const QString &error) {
+  for (const auto &reply : takeJob(id)) {
+    if (reply) emit reply->failed(error);
+  }
+
+  startRequests();
+}
+
+NetworkFetcher::NetworkFetcher() {
+  connect(m_thread, &QThread::started, m_worker, &FetcherWorker::initialize);
+  connect(m_worker, &FetcherWorker::fetchProgress, this, &NetworkFetcher::handleFetchProgress);
+  connect(m_worker, &FetcherWorker::fetchFinished, this, &NetworkFetcher::handleFetchFinished);
+  connect(m_worker, &FetcherWorker::fetchFailed, this, &NetworkFetcher::handleFetchFailed);
+  m_thread->setObjectName("network");
+  m_worker->moveToThread(m_thread);
+  m_thread->start();
+}
@@ -1,64 +1,46 @@
 #pragma once
 #include "common.hpp"
-#include "vicinae.hpp"
+#include <array>
+#include <deque>
 #include <qmetacontainer.h>
 #include <qnetworkaccessmanager.h>
 #include <qnetworkdiskcache.h>
 #include <qnetworkreply.h>
+#include <qnetworkrequest.h>
 #include <qobject.h>
-#include <qstandardpaths.h>
+#include <qpointer.h>
 #include <qstringview.h>
 #include <qthread.h>
 #include <qtmetamacros.h>
 #include <qurl.h>
-#include <quuid.h>
 #include <unordered_map>
+#include <vector>
 
+/**
+ * Owns the network access manager and performs the actual requests, on the network thread.
+ */
 class FetcherWorker : public QObject {
   Q_OBJECT
 
-  std::unordered_map<QString, QObjectUniquePtr<QNetworkReply>> m_replies;
+  std::unordered_map<quint64, QObjectUniquePtr<QNetworkReply>> m_replies;
 
   QNetworkAccessManager *m_manager = nullptr;
   QNetworkDiskCache *m_diskCache = nullptr;
 
-  void handleFetchRequest(const QString &id, const QUrl &url) {
-    if (!m_manager) return;
-
-    QNetworkRequest req(url);
-
-    req.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
-
-    auto reply = m_manager->get(req);
-
-    connect(reply, &QNetworkReply::finished, this, [this, id, reply]() {
-      emit fetchFinished(id, reply->readAll());
-      m_replies.erase(id);
-    });
-
-    m_replies.insert({id, QObjectUniquePtr<QNetworkReply>(reply)});
-  }
+  void handleFetchRequest(quint64 id, QNetworkRequest request);
+  void handleAbortRequest(quint64 id);
 
 public:
-  FetcherWorker() {}
-
-  void initialize() {
-    QString directory =
-        QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1StringView("/omnicast/");
+  void initialize();
 
-    m_manager = new QNetworkAccessManager;
-    m_diskCache = new QNetworkDiskCache;
-    m_diskCache->setCacheDirectory(directory);
-    m_diskCache->setMaximumCacheSize(Omnicast::IMAGE_DISK_CACHE_MAX_SIZE);
-    m_manager->setCache(m_diskCache);
-
-    connect(this, &FetcherWorker::fetchRequested, this, &FetcherWorker::handleFetchRequest);
-  }
+  FetcherWorker();
 
 signals:
-  void fetchRequested(const QString &id, const QUrl &url);
-  void abortRequested(const QString &id);
-  void fetchFinished(const QString &id, const QByteArray &array);
+  void fetchRequested(quint64 id, const QNetworkRequest &request);
+  void abortRequested(quint64 id);
+  void fetchProgress(quint64 id, qint64 received, qint64 total);
+  void fetchFinished(quint64 id, const QByteArray &data);
+  void fetchFailed(quint64 id, const QString &error);
 };
 
 class FetchReply : public QObject {
@@ -68,86 +50,86 @@ class FetchReply : public QObject {
 
 public:
   const QUrl &url() const { return m_url; }
+
+  /**
+   * Stop waiting for the response. The request itself is only aborted once no reply is waiting on
+   * it anymore. Destroying the reply has the same effect.
+   */
   void abort() { emit aborted(); }
 
   FetchReply(const QUrl &url) : m_url(url) {}
 
 signals:
   void finished(const QByteArray &data) const;
+  void failed(const QString &error) const;
+  void progress(qint64 received, qint64 total) const;
   void aborted() const;
 };
 
+/**
+ * The network layer shared by the whole app. Every request goes through a single network access
+ * manager, so that connections are reused, and a single size-bounded disk cache.
+ *
+ * Concurrent identical GET requests are coalesced into a single request. Requests are started
+ * by order of priority, and those that nobody waits on anymore are dropped from the queue or aborted.
+ */
 class NetworkFetcher : public QObject {
   Q_OBJECT
 
-  size_t m_concurrency = 6;
-  FetcherWorker *m_worker = new FetcherWorker;
-  QThread *m_thread = new QThread;
-
-  struct QueuedReply {
-    QString id;
-    FetchReply *reply;
+public:
+  enum class Priority {
+    // something the user explicitly asked for and is waiting on, never queued
+    Interactive,
+    // content that is currently displayed, such as images of visible list items
+    Visible
   };
 
-  std::unordered_map<QString, FetchReply *> m_replies;
-  std::deque<QueuedReply> m_queue;
+private:
+  static constexpr size_t PRIORITY_COUNT = 2;
 
-  void handleFetchFinished(const QString &id, const QByteArray &data) {
-    if (auto it = m_replies.find(id); it != m_replies.end()) {
-      m_replies.erase(id);
-      emit it->second->finished(data);
-    }
-    startRequests();
-  }
+  struct Job {
+    QString key;
+    QNetworkRequest request;
+    Priority priority;
+    bool started = false;
+    std::vector<FetchReply *> replies;
+  };
 
-  void startRequests() {
-    while (!m_queue.empty() && m_replies.size() < m_concurrency) {
-      auto queued = m_queue.back();
-      QString id = queued.id;
-      m_queue.pop_back();
+  size_t m_concurrency = 6;
+  size_t m_running = 0;
+  quint64 m_nextId = 0;
+  FetcherWorker *m_worker = new FetcherWorker;
+  QThread *m_thread = new QThread;
 
-      emit fetchRequested(id, queued.reply->url());
-      m_replies.insert({id, queued.reply});
-    }
-  }
+  std::unordered_map<quint64, Job> m_jobs;
+  std::unordered_map<QString, quint64> m_jobsByKey;
+  // most recently requested first within each priority, as it's the most likely to still be relevant
+  std::array<std::deque<quint64>, PRIORITY_COUNT> m_queues;
+
+  /**
+   * Requests are only coalesced when they target the same URL with the same headers and cache
+   * attributes, so that a request that bypasses the cache is never served from a cached one.
+   */
+  static QString jobKey(const QNetworkRequest &request);
+
+  void handleFetchProgress(quint64 id, qint64 received, qint64 total);
+  void handleFetchFinished(quint64 id, const QByteArray &data);
+  void handleFetchFailed(quint64 id, const QString &error);
+
+  /**
+   * Remove the job, returning the replies that were still waiting on it.
+   */
+  std::vector<QPointer<FetchReply>> takeJob(quint64 id);
+  void detach(quint64 id, FetchReply *reply);
+  void promote(quint64 id, Priority priority);
+  void start(quint64 id);
+  void startRequests();
 
 public:
-  FetchReply *fetch(const QUrl &url) {
-    auto id = QUuid::createUuid().toString(QUuid::WithoutBraces);
-    auto reply = new FetchReply(url);
-
-    connect(reply, &FetchReply::aborted, this, [this, reply, id]() {
-      if (auto it = std::ranges::find_if(m_queue, [&](auto &&data) { return data.reply == reply; });
-          it != m_queue.end()) {
-        m_queue.erase(it);
-      };
+  FetchReply *fetch(const QNetworkRequest &request, Priority priority = Priority::Visible);
+  FetchReply *fetch(const QUrl &url, Priority priority = Priority::Visible);
 
-      m_replies.erase(id);
-      emit abortRequested(id);
-    });
+  static NetworkFetcher *instance();
 
-    m_queue.emplace_back(QueuedReply{id, reply});
-    startRequests();
-
-    return reply;
-  }
-
-  NetworkFetcher() {
-    connect(this, &NetworkFetcher::fetchRequested, m_worker, &FetcherWorker::fetchRequested);
-    connect(m_thread, &QThread::started, m_worker, &FetcherWorker::initialize);
-    connect(m_worker, &FetcherWorker::fetchFinished, this, &NetworkFetcher::handleFetchFinished);
-    connect(m_worker, &FetcherWorker::abortRequested, this, &NetworkFetcher::abortRequested);
-    m_worker->moveToThread(m_thread);
-    m_thread->start();
-  }
-
-  static NetworkFetcher *instance() {
-    static NetworkFetcher instance;
-
-    return &instance;
-  }
-
-signals:
-  void fetchRequested(const QString &id, const QUrl &url) const;
-  void abortRequested(const QString &id);
+  NetworkFetcher();
 };
@@ -1,5 +1,9 @@
 #include "ipc-command-handler.hpp"
 #include "common.hpp"
+#include "daemon/startup-profiler.hpp"
+#include "daemon/perf-metrics.hpp"
+#include "daemon/toggle-latency.hpp"
+#include "daemon/trace-recorder.hpp"
 #include "proto/daemon.pb.h"
 #include <algorithm>
 #include "services/config/config-service.hpp"
@@ -30,6 +34,72 @@ proto::ext::daemon::Response *IpcCommandHandler::handleCommand(const proto::ext:
     res->set_allocated_url(new proto::ext::daemon::UrlResponse());
     break;
   }
+  case proto::ext::daemon::Request::kStartupTrace: {
+    auto trace = res->mutable_startup_trace();
+
+    for (const auto &phase : StartupProfiler::instance()->phases()) {
+      auto entry = trace->add_phases();
+
+      entry->set_name(phase.name.toStdString());
+      entry->set_thread(phase.thread.toStdString());
+      entry->set_start_ms(phase.start.count() / 1000.0);
+      entry->set_duration_ms(phase.duration.count() / 1000.0);
+    }
+    break;
+  }
+  case proto::ext::daemon::Request::kToggleLatency: {
+    auto latency = res->mutable_toggle_latency();
+
+    if (auto stats = ToggleLatencyTracker::instance()->stats()) {
+      latency->set_samples(stats->samples);
+      latency->set_last_ms(stats->last.count() / 1000.0);
+      latency->set_min_ms(stats->min.count() / 1000.0);
+      latency->set_median_ms(stats->median.count() / 1000.0);
+      latency->set_p95_ms(stats->p95.count() / 1000.0);
+      latency->set_max_ms(stats->max.count() / 1000.0);
+    }
+    break;
+  }
+  case proto::ext::daemon::Request::kStats: {
+    auto stats = res->mutable_stats();
+    auto metrics = PerfMetrics::instance();
+
+    for (const auto &histogram : metrics->histograms()) {
+      auto timing = stats->add_timings();
+
+      timing->set_name(histogram.name);
+      timing->set_count(histogram.count);
+      timing->set_mean_ms(histogram.mean.count() / 1000.0);
+      timing->set_p50_ms(histogram.p50.count() / 1000.0);
+      timing->set_p90_ms(histogram.p90.count() / 1000.0);
+      timing->set_p99_ms(histogram.p99.count() / 1000.0);
+      timing->set_max_ms(histogram.max.count() / 1000.0);
+    }
+
+    for (const auto &counter : metrics->counters()) {
+      auto stat = stats->add_counters();
+
+      stat->set_name(counter.name);
+      stat->set_value(counter.value);
+    }
+    break;
+  }
+  case proto::ext::daemon::Request::kTraceControl: {
+    auto recorder = TraceRecorder::instance();
+
+    recorder->setEnabled(request.trace_control().enabled());
+    res->mutable_trace_control()->set_enabled(recorder->isEnabled());
+    break;
+  }
+  case proto::ext::daemon::Request::kTraceDump: {
+    auto dump = res->mutable_trace_dump();
+    size_t eventCount = 0;
+    QByteArray json = TraceRecorder::instance()->toChromeTrace(&eventCount);
+
+    dump->set_json(json.toStdString());
+    dump->set_event_count(eventCount);
+    break;
+  }
   default:
     break;
   }
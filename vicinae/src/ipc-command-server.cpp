@@ -1,5 +1,7 @@
 #include "ipc-command-server.hpp"
 #include "proto/daemon.pb.h"
+#include "daemon/toggle-latency.hpp"
+#include <memory>
 #include <qlogging.h>
 
 void IpcCommandServer::processFrame(QLocalSocket *conn, QByteArrayView frame) {
@@ -13,10 +15,15 @@ void IpcCommandServer::processFrame(QLocalSocket *conn, QByteArrayView frame) {
     return;
   }
 
-  auto handlerResult = _handler->handleCommand(req);
+  std::unique_ptr<proto::ext::daemon::Response> handlerResult(_handler->handleCommand(req));
   std::string packet;
 
   handlerResult->SerializeToString(&packet);
+
+  // responses are framed the same way requests are, so that clients can tell when they are complete
+  uint32_t length = htonl(packet.size());
+
+  conn->write(reinterpret_cast<const char *>(&length), sizeof(length));
   conn->write(packet.data(), packet.size());
 }
 
@@ -40,8 +47,11 @@ void IpcCommandServer::handleRead(QLocalSocket *conn) {
       if (!isComplete) break;
 
       auto packet = QByteArrayView(it->frame.data).sliced(sizeof(uint32_t), length);
+      auto latency = ToggleLatencyTracker::instance();
 
+      latency->frameReceived();
       processFrame(conn, packet);
+      latency->frameHandled();
 
       it->frame.data = it->frame.data.sliced(sizeof(uint32_t) + length);
     }
@@ -1,60 +1,155 @@
 #include "unzip.hpp"
+#include <cstring>
 #include <qlogging.h>
 
 namespace fs = std::filesystem;
 
-bool UnzipHandle::positionToIndex(int idx) {
-  if (info.number_entry <= idx) {
-    qCritical() << "Invalid idx" << idx;
-    return false;
-  }
+static voidpf ZCALLBACK memoryOpen(voidpf opaque, const void *, int mode) {
+  // archives are only ever read from memory
+  if ((mode & ZLIB_FILEFUNC_MODE_READWRITEFILTER) != ZLIB_FILEFUNC_MODE_READ) return nullptr;
+
+  static_cast<Unzipper::MemoryStream *>(opaque)->pos = 0;
+
+  return opaque;
+}
+
+static uLong ZCALLBACK memoryRead(voidpf, voidpf stream, void *buf, uLong size) {
+  auto mem = static_cast<Unzipper::MemoryStream *>(stream);
+  ZPOS64_T available = mem->data.size() - std::min<ZPOS64_T>(mem->pos, mem->data.size());
+  uLong count = std::min<ZPOS64_T>(size, available);
 
-  unzGoToFirstFile(file);
+  std::memcpy(buf, mem->data.constData() + mem->pos, count);
+  mem->pos += count;
 
-  for (int i = 0; i != idx; ++i) {
-    unzGoToNextFile(file);
+  return count;
+}
+
+static uLong ZCALLBACK memoryWrite(voidpf, voidpf, const void *, uLong) { return 0; }
+
+static ZPOS64_T ZCALLBACK memoryTell(voidpf, voidpf stream) {
+  return static_cast<Unzipper::MemoryStream *>(stream)->pos;
+}
+
+static long ZCALLBACK memorySeek(voidpf, voidpf stream, ZPOS64_T offset, int origin) {
+  auto mem = static_cast<Unzipper::MemoryStream *>(stream);
+  ZPOS64_T base = 0;
+
+  switch (origin) {
+  case ZLIB_FILEFUNC_SEEK_SET:
+    base = 0;
+    break;
+  case ZLIB_FILEFUNC_SEEK_CUR:
+    base = mem->pos;
+    break;
+  case ZLIB_FILEFUNC_SEEK_END:
+    base = mem->data.size();
+    break;
+  default:
+    return -1;
   }
 
-  return true;
+  if (base + offset > static_cast<ZPOS64_T>(mem->data.size())) return -1;
+
+  mem->pos = base + offset;
+
+  return 0;
 }
 
-ZipedFile::ZipedFile(UnzipHandle handle, const std::filesystem::path &path, int idx)
-    : m_handle(handle), m_path(path), m_idx(idx) {}
+static int ZCALLBACK memoryClose(voidpf, voidpf) { return 0; }
 
-std::string ZipedFile::readAll() {
-  m_handle.positionToIndex(m_idx);
+static int ZCALLBACK memoryError(voidpf, voidpf) { return 0; }
 
+ZipedFile::ZipedFile(UnzipHandle handle, const std::filesystem::path &path, unz64_file_pos pos)
+    : m_handle(handle), m_path(path), m_pos(pos) {}
+
+std::string ZipedFile::readAll() {
   std::array<char, 8192> buffer;
   std::string data;
   int bytesRead;
 
-  if (unzOpenCurrentFile(m_handle.file) != UNZ_OK) {
+  if (unzGoToFilePos64(m_handle.file, &m_pos) != UNZ_OK || unzOpenCurrentFile(m_handle.file) != UNZ_OK) {
     qWarning() << "Failed to open ziped file" << path();
     return {};
   }
 
   while ((bytesRead = unzReadCurrentFile(m_handle.file, buffer.data(), buffer.size())) > 0) {
-    data += std::string(buffer.data(), bytesRead);
+    data.append(buffer.data(), bytesRead);
   }
 
+  unzCloseCurrentFile(m_handle.file);
+
   return data;
 }
 
-void Unzipper::extract(const std::filesystem::path &target, const Unzipper::ExtractOptions &opts) {
+std::optional<std::string> Unzipper::currentFileName(unzFile file) {
+  unz_file_info64 fileInfo;
+
+  if (unzGetCurrentFileInfo64(file, &fileInfo, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK) return {};
+
+  std::string filename(fileInfo.size_filename, '\0');
+
+  if (unzGetCurrentFileInfo64(file, &fileInfo, filename.data(), filename.size(), nullptr, 0, nullptr, 0) !=
+      UNZ_OK) {
+    return {};
+  }
+
+  return filename;
+}
+
+bool Unzipper::extractCurrentFile(unzFile file, const fs::path &path) {
+  std::array<char, 65536> buffer;
+  int bytesRead;
+
+  if (unzOpenCurrentFile(file) != UNZ_OK) return false;
+
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+
+  while ((bytesRead = unzReadCurrentFile(file, buffer.data(), buffer.size())) > 0) {
+    ofs.write(buffer.data(), bytesRead);
+  }
+
+  // also checks the CRC of the entry, which is only known once it was fully read
+  return unzCloseCurrentFile(file) == UNZ_OK && bytesRead == 0 && ofs.good();
+}
+
+bool Unzipper::extract(const std::filesystem::path &target, const Unzipper::ExtractOptions &opts) {
+  if (!m_handle.file) return false;
+
   int sc = opts.stripComponents.value_or(0);
+  fs::path root = target.lexically_normal();
+  size_t extracted = 0;
+  std::error_code ec;
+
+  for (int status = unzGoToFirstFile(m_handle.file); status == UNZ_OK;
+       status = unzGoToNextFile(m_handle.file)) {
+    auto filename = currentFileName(m_handle.file);
+
+    if (!filename) return false;
 
-  for (auto &file : listFiles()) {
     fs::path stripedFilePath =
-        std::ranges::fold_left(fs::path(file.path()) | std::views::drop(sc), fs::path(),
+        std::ranges::fold_left(fs::path(*filename) | std::views::drop(sc), fs::path(),
                                [](auto &&p1, auto &&p2) { return p1 / p2; });
+    fs::path path = (root / stripedFilePath).lexically_normal();
+
+    if (stripedFilePath.empty()) {
+      // the stripped leading directories themselves, nothing to extract
+    } else if (std::ranges::mismatch(root, path).in1 != root.end()) {
+      qWarning() << "Skipping zip entry outside of the extraction directory" << filename->c_str();
+    } else if (filename->ends_with('/')) {
+      fs::create_directories(path, ec);
+    } else {
+      fs::create_directories(path.parent_path(), ec);
+
+      if (!extractCurrentFile(m_handle.file, path)) {
+        qWarning() << "Failed to extract" << filename->c_str();
+        return false;
+      }
+    }
 
-    std::filesystem::path path = target / stripedFilePath;
-    std::filesystem::create_directories(path.parent_path());
-    std::ofstream ofs(path);
-    auto data = file.readAll();
-
-    ofs.write(data.data(), data.size());
+    if (opts.progress) opts.progress(++extracted, m_handle.info.number_entry);
   }
+
+  return true;
 }
 
 std::vector<ZipedFile> Unzipper::listFiles() {
@@ -63,39 +158,39 @@ std::vector<ZipedFile> Unzipper::listFiles() {
   std::vector<ZipedFile> files;
 
   files.reserve(m_handle.info.number_entry);
-  unzGoToFirstFile(m_handle.file);
 
-  for (int i = 0; i != m_handle.info.number_entry; ++i) {
-    unz_file_info fileInfo;
-    char filename[256];
+  for (int status = unzGoToFirstFile(m_handle.file); status == UNZ_OK;
+       status = unzGoToNextFile(m_handle.file)) {
+    unz64_file_pos pos;
+    auto filename = currentFileName(m_handle.file);
 
-    if (unzGetCurrentFileInfo(m_handle.file, &fileInfo, filename, sizeof(filename), nullptr, 0, nullptr, 0) !=
-        UNZ_OK) {
-      continue;
-    }
+    if (!filename || unzGetFilePos64(m_handle.file, &pos) != UNZ_OK) continue;
 
-    files.emplace_back(ZipedFile(m_handle, filename, i));
-    unzGoToNextFile(m_handle.file);
+    files.emplace_back(ZipedFile(m_handle, *filename, pos));
   }
 
   return files;
 }
 
-Unzipper::Unzipper(std::string_view path) {
-  m_tmpFile = std::make_unique<QTemporaryFile>();
-  if (!m_tmpFile->open()) {
-    qCritical() << "Failed to open unzip temp file";
-    return;
-  }
+Unzipper::Unzipper(const QByteArray &data) : m_stream(std::make_unique<MemoryStream>(data)) {
+  zlib_filefunc64_def funcs{.zopen64_file = memoryOpen,
+                            .zread_file = memoryRead,
+                            .zwrite_file = memoryWrite,
+                            .ztell64_file = memoryTell,
+                            .zseek64_file = memorySeek,
+                            .zclose_file = memoryClose,
+                            .zerror_file = memoryError,
+                            .opaque = m_stream.get()};
 
-  m_tmpFile->write(path.data(), path.size());
-  m_handle.file = unzOpen(m_tmpFile->filesystemFileName().c_str());
-  unzGetGlobalInfo(m_handle.file, &m_handle.info);
+  m_handle.file = unzOpen2_64("memory", &funcs);
+
+  if (m_handle.file) unzGetGlobalInfo64(m_handle.file, &m_handle.info);
 }
 
 Unzipper::Unzipper(const std::filesystem::path &path) {
-  m_handle.file = unzOpen(path.c_str());
-  unzGetGlobalInfo(m_handle.file, &m_handle.info);
+  m_handle.file = unzOpen64(path.c_str());
+
+  if (m_handle.file) unzGetGlobalInfo64(m_handle.file, &m_handle.info);
 }
 
 Unzipper::~Unzipper() {
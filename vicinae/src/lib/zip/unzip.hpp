@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <array>
 #include <fstream>
+#include <functional>
 #include <ranges>
 #include <qlogging.h>
 #include <string>
@@ -12,23 +13,22 @@
 
 struct UnzipHandle {
   unzFile file = nullptr;
-  unz_global_info info;
-
-public:
-  bool positionToIndex(int idx);
+  unz_global_info64 info;
 };
 
 class ZipedFile {
   UnzipHandle m_handle;
   std::filesystem::path m_path;
-  int m_idx;
+  // position of the entry in the central directory, so that it can be read back without walking the
+  // whole archive again
+  unz64_file_pos m_pos;
 
 public:
   const std::filesystem::path path() const { return m_path; }
   std::string readAll();
 
 public:
-  ZipedFile(UnzipHandle handle, const std::filesystem::path &path, int idx);
+  ZipedFile(UnzipHandle handle, const std::filesystem::path &path, unz64_file_pos pos);
 };
 
 class Unzipper {
@@ -36,22 +36,38 @@ class Unzipper {
 public:
   struct ExtractOptions {
     std::optional<int> stripComponents;
+    // called after each entry with the number of entries extracted so far and the total
+    std::function<void(size_t extracted, size_t total)> progress;
+  };
+
+  /**
+   * An archive kept in memory, read by minizip through custom I/O callbacks.
+   */
+  struct MemoryStream {
+    QByteArray data;
+    ZPOS64_T pos = 0;
   };
 
 private:
   UnzipHandle m_handle;
-  std::unique_ptr<QTemporaryFile> m_tmpFile;
+  std::unique_ptr<MemoryStream> m_stream;
+
+  static std::optional<std::string> currentFileName(unzFile file);
+  static bool extractCurrentFile(unzFile file, const std::filesystem::path &path);
 
 public:
   operator bool() const { return m_handle.file; }
 
-  void extract(const std::filesystem::path &target, const ExtractOptions &opts = {});
+  /**
+   * Extract every entry in a single sequential pass over the archive. Entries that would end up
+   * outside of `target` are skipped.
+   */
+  bool extract(const std::filesystem::path &target, const ExtractOptions &opts = {});
   std::vector<ZipedFile> listFiles();
 
-  // Handling memory reading directly can be quite tricky so we use a temp file instead
-  // to keep things simple.
-  Unzipper(std::string_view path);
+  Unzipper(const QByteArray &data);
   Unzipper(const std::filesystem::path &path);
+  Unzipper(const Unzipper &) = delete;
 
   ~Unzipper();
 };
@@ -1,5 +1,6 @@
 #include "command-controller.hpp"
 #include "daemon/ipc-client.hpp"
+#include "daemon/startup-profiler.hpp"
 #include "favicon/favicon-service.hpp"
 #include "navigation-controller.hpp"
 #include "ui/launcher-window/launcher-window.hpp"
@@ -24,10 +25,12 @@
 #include <QtSql/QtSql>
 #include "root-extension-manager.hpp"
 #include <QXmlStreamReader>
+#include <QtConcurrent/QtConcurrent>
 #include <QtSql/qsqldatabase.h>
 #include <arpa/inet.h>
 #include <csignal>
 #include <filesystem>
+#include <format>
 #include <fstream>
 #include <iostream>
 #include <qapplication.h>
@@ -42,6 +45,7 @@
 #include <qobject.h>
 #include <qprocess.h>
 #include <qstringview.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 #include "extension/manager/extension-manager.hpp"
 #include "services/emoji-service/emoji-service.hpp"
@@ -64,6 +68,9 @@
 #include "log/message-handler.hpp"
 
 int startDaemon() {
+  // created first, as startup phases are timed relative to it
+  auto profiler = StartupProfiler::instance();
+
   std::filesystem::create_directories(Omnicast::runtimeDir());
   auto pidFile = Omnicast::pidFile();
 
@@ -91,15 +98,25 @@ int startDaemon() {
 
   {
     auto registry = ServiceRegistry::instance();
+
+    // the app scan doesn't depend on any other service: it runs while the rest is being set up
+    auto appProvider = QtConcurrent::run(&AppService::createLocalProvider);
+
+    auto databasePhase = profiler->phase("database");
     auto omniDb = std::make_unique<OmniDatabase>(Omnicast::dataDir() / "vicinae.db");
+    databasePhase.finish();
+
+    auto servicesPhase = profiler->phase("services");
     auto localStorage = std::make_unique<LocalStorageService>(*omniDb);
     auto rootItemManager = std::make_unique<RootItemManager>(*omniDb.get());
     auto commandDb = std::make_unique<OmniCommandDatabase>();
     auto extensionManager = std::make_unique<ExtensionManager>(*commandDb);
+    auto extensionRegistry = std::make_unique<ExtensionRegistry>(*commandDb, *localStorage);
+
+    // manifests are scanned on a worker thread, they are registered once the launcher is up
+    extensionRegistry->rescan();
+
     auto windowManager = std::make_unique<WindowManager>();
-    auto appService = std::make_unique<AppService>(*omniDb.get());
-    auto clipboardManager =
-        std::make_unique<ClipboardService>(Omnicast::dataDir() / "clipboard.db", *windowManager, *appService);
     auto processManager = std::make_unique<ProcessManagerService>();
     auto fontService = std::make_unique<FontService>();
     auto configService = std::make_unique<ConfigService>();
@@ -110,12 +127,20 @@ int startDaemon() {
     auto emojiService = std::make_unique<EmojiService>(*omniDb.get());
     auto calculatorService = std::make_unique<CalculatorService>(*omniDb.get());
     auto fileService = std::make_unique<FileService>();
-    auto extensionRegistry = std::make_unique<ExtensionRegistry>(*commandDb, *localStorage);
     auto raycastStore = std::make_unique<RaycastStoreService>();
+    servicesPhase.finish();
 
+    auto appServicePhase = profiler->phase("app-service");
+    auto appService = std::make_unique<AppService>(*omniDb.get(), appProvider.takeResult());
+    auto clipboardManager =
+        std::make_unique<ClipboardService>(Omnicast::dataDir() / "clipboard.db", *windowManager, *appService);
+    appServicePhase.finish();
+
+    auto extensionManagerPhase = profiler->phase("extension-manager");
     if (!extensionManager->start()) {
       qCritical() << "Failed to load extension manager. Extensions will not work";
     }
+    extensionManagerPhase.finish();
 
     registry->setFileService(std::move(fileService));
     registry->setToastService(std::move(toastService));
@@ -142,16 +167,26 @@ int startDaemon() {
 
     p->start();
 
+    auto builtinsPhase = profiler->phase("builtin-commands");
     auto builtinCommandDb = std::make_unique<CommandDatabase>();
 
     for (const auto &repo : builtinCommandDb->repositories()) {
       registry->commandDb()->registerRepository(repo);
     }
+    builtinsPhase.finish();
 
     auto reg = ServiceRegistry::instance()->extensionRegistry();
 
-    QObject::connect(reg, &ExtensionRegistry::extensionsChanged, [reg]() {
-      for (const auto &manifest : reg->scanAll()) {
+    // the initial scan and every later rescan end up here, extensions are never scanned twice for the
+    // same change
+    QObject::connect(reg, &ExtensionRegistry::extensionsChanged, [reg, initial = true]() mutable {
+      std::optional<StartupProfiler::Scope> phase;
+
+      if (std::exchange(initial, false)) {
+        phase.emplace(*StartupProfiler::instance(), "extension-registration");
+      }
+
+      for (const auto &manifest : reg->manifests()) {
         auto extension = std::make_shared<Extension>(manifest);
 
         ServiceRegistry::instance()->commandDb()->registerRepository(extension);
@@ -162,25 +197,27 @@ int startDaemon() {
       ServiceRegistry::instance()->commandDb()->removeRepository(id);
     });
 
-    for (const auto &manifest : reg->scanAll()) {
-      auto extension = std::make_shared<Extension>(manifest);
-
-      ServiceRegistry::instance()->commandDb()->registerRepository(extension);
-    }
-
     // this one needs to be set last
 
+    auto providersPhase = profiler->phase("root-providers");
     registry->rootItemManager()->addProvider(std::make_unique<AppRootProvider>(*registry->appDb()));
     registry->rootItemManager()->addProvider(std::make_unique<ShortcutRootProvider>(*registry->shortcuts()));
 
     // Force reload providers to make sure items that depend on them are shown
     registry->rootItemManager()->reloadProviders();
+    providersPhase.finish();
 
-    // Start indexing after registerRepository() so that search paths are configured properly
-    registry->fileService()->indexer()->start();
+    // Start indexing after registerRepository() so that search paths are configured properly.
+    // This is deferred to the event loop, as the launcher doesn't need it to be usable.
+    QTimer::singleShot(0, [registry]() {
+      auto phase = StartupProfiler::instance()->phase("file-indexer");
+      registry->fileService()->indexer()->start();
+    });
   }
 
+  auto faviconPhase = profiler->phase("favicon-service");
   FaviconService::initialize(new FaviconService(Omnicast::dataDir() / "favicon"));
+  faviconPhase.finish();
 
   QApplication::setApplicationName("vicinae");
   QApplication::setQuitOnLastWindowClosed(false);
@@ -197,6 +234,7 @@ int startDaemon() {
 
   commandServer.setHandler(new IpcCommandHandler(ctx));
   commandServer.start(Omnicast::commandSocketPath());
+  profiler->mark("ipc-server-ready");
 
   QObject::connect(ServiceRegistry::instance()->config(), &ConfigService::configChanged,
                    [&ctx](const ConfigService::Value &next, const ConfigService::Value &prev) {
@@ -223,14 +261,134 @@ int startDaemon() {
                      }
                    });
 
+  auto windowsPhase = profiler->phase("windows");
   SettingsWindow settings(&ctx);
   LauncherWindow launcher(ctx);
+  windowsPhase.finish();
+
+  profiler->mark("launcher-ready");
+
+  // first iteration of the event loop: the launcher can be toggled from this point on
+  QTimer::singleShot(0, [profiler]() { profiler->mark("event-loop-started"); });
 
   qInfo() << "Vicinae server successfully started. Call vicinae without an argument to toggle the window";
 
   return qApp->exec();
 }
 
+static bool printStartupTrace(DaemonIpcClient &client) {
+  auto trace = client.startupTrace();
+
+  if (!trace) {
+    std::cerr << "Failed to get startup trace from the server\n";
+    return false;
+  }
+
+  std::cout << std::format("{:<28}{:>12}{:>14}  {}\n", "PHASE", "START (ms)", "DURATION (ms)", "THREAD");
+
+  for (const auto &phase : trace->phases()) {
+    std::cout << std::format("{:<28}{:>12.1f}{:>14.1f}  {}\n", phase.name(), phase.start_ms(),
+                             phase.duration_ms(), phase.thread());
+  }
+
+  return true;
+}
+
+static bool printToggleLatency(DaemonIpcClient &client) {
+  auto latency = client.toggleLatency();
+
+  if (!latency) {
+    std::cerr << "Failed to get toggle latency from the server\n";
+    return false;
+  }
+
+  if (latency->samples() == 0) {
+    std::cout << "No toggle was measured yet\n";
+    return true;
+  }
+
+  std::cout << std::format("samples: {}\n", latency->samples());
+  std::cout << std::format("last:    {:.1f}ms\n", latency->last_ms());
+  std::cout << std::format("min:     {:.1f}ms\n", latency->min_ms());
+  std::cout << std::format("median:  {:.1f}ms\n", latency->median_ms());
+  std::cout << std::format("p95:     {:.1f}ms\n", latency->p95_ms());
+  std::cout << std::format("max:     {:.1f}ms\n", latency->max_ms());
+
+  return true;
+}
+
+static bool printStats(DaemonIpcClient &client) {
+  auto stats = client.stats();
+
+  if (!stats) {
+    std::cerr << "Failed to get stats from the server\n";
+    return false;
+  }
+
+  std::cout << std::format("{:<32}{:>8}{:>10}{:>10}{:>10}{:>10}{:>10}\n", "TIMING", "COUNT", "MEAN", "P50",
+                           "P90", "P99", "MAX");
+
+  for (const auto &timing : stats->timings()) {
+    std::cout << std::format("{:<32}{:>8}{:>8.2f}ms{:>8.2f}ms{:>8.2f}ms{:>8.2f}ms{:>8.2f}ms\n", timing.name(),
+                             timing.count(), timing.mean_ms(), timing.p50_ms(), timing.p90_ms(),
+                             timing.p99_ms(), timing.max_ms());
+  }
+
+  if (stats->counters().empty()) return true;
+
+  std::cout << std::format("\n{:<32}{:>8}\n", "COUNTER", "VALUE");
+
+  for (const auto &counter : stats->counters()) {
+    std::cout << std::format("{:<32}{:>8}\n", counter.name(), counter.value());
+  }
+
+  return true;
+}
+
+static bool handleTraceCommand(DaemonIpcClient &client, const QStringList &args) {
+  QString action = args.value(0);
+
+  if (action == "start" || action == "stop") {
+    auto res = client.setTracing(action == "start");
+
+    if (!res) {
+      std::cerr << "Failed to update tracing state\n";
+      return false;
+    }
+
+    std::cout << std::format("Tracing is {}\n", res->enabled() ? "enabled" : "disabled");
+    return true;
+  }
+
+  if (action == "dump") {
+    auto dump = client.traceDump();
+
+    if (!dump) {
+      std::cerr << "Failed to get trace from the server\n";
+      return false;
+    }
+
+    if (args.size() < 2) {
+      std::cout << dump->json();
+      return true;
+    }
+
+    std::ofstream ofs(args.at(1).toStdString(), std::ios::binary | std::ios::trunc);
+
+    if (!(ofs << dump->json())) {
+      std::cerr << std::format("Failed to write trace to {}\n", args.at(1).toStdString());
+      return false;
+    }
+
+    std::cerr << std::format("Wrote {} events to {}, open it with https://ui.perfetto.dev\n",
+                             dump->event_count(), args.at(1).toStdString());
+    return true;
+  }
+
+  std::cerr << "Usage: vicinae trace <start|stop|dump [file]>\n";
+  return false;
+}
+
 int main(int argc, char **argv) {
   QGuiApplication::setHighDpiScaleFactorRoundingPolicy(Qt::HighDpiScaleFactorRoundingPolicy::PassThrough);
   QApplication qapp(argc, argv);
@@ -252,6 +410,13 @@ int main(int argc, char **argv) {
     return 0;
   }
 
+  if (qapp.arguments().at(1) == "startup-trace") { return printStartupTrace(daemonClient) ? 0 : 1; }
+  if (qapp.arguments().at(1) == "toggle-latency") { return printToggleLatency(daemonClient) ? 0 : 1; }
+  if (qapp.arguments().at(1) == "stats") { return printStats(daemonClient) ? 0 : 1; }
+  if (qapp.arguments().at(1) == "trace") {
+    return handleTraceCommand(daemonClient, qapp.arguments().sliced(2)) ? 0 : 1;
+  }
+
   QUrl url(argv[1]);
 
   if (url.isValid()) {
@@ -123,17 +123,21 @@ class RaycastStoreListingView : public ListView {
   QFutureWatcher<Raycast::ListResult> m_queryResultWatcher;
   QString lastQueryText;
   QTimer m_debounce;
+  CancellationSource m_searchCancellation;
 
   void handleDebounce() {
     if (searchText().isEmpty()) return;
 
     setLoading(true);
     lastQueryText = searchText();
-    m_queryResultWatcher.setFuture(m_store->search(lastQueryText));
+    m_queryResultWatcher.setFuture(m_store->search(lastQueryText, m_searchCancellation.next()));
   }
 
   void textChanged(const QString &text) override {
     qDebug() << "Store search" << text;
+    // the request for the previous text is not wanted anymore, even if the new one is only sent later
+    m_searchCancellation.cancel();
+
     if (text.isEmpty()) {
       setLoading(true);
       m_listResultWatcher.setFuture(m_store->fetchExtensions());
@@ -144,7 +148,7 @@ class RaycastStoreListingView : public ListView {
   }
 
   void handleFinishedQuery() {
-    if (searchText() != lastQueryText) return;
+    if (m_searchCancellation.token().isCancelled() || searchText() != lastQueryText) return;
 
     auto result = m_queryResultWatcher.result();
 
@@ -6,10 +6,15 @@
 #include "navigation-controller.hpp"
 #include "services/app-service/app-service.hpp"
 #include "color-formatter.hpp"
+#include "daemon/perf-metrics.hpp"
 #include "actions/calculator/calculator-actions.hpp"
 #include "services/calculator-service/abstract-calculator-backend.hpp"
 #include "services/files-service/abstract-file-indexer.hpp"
 #include "services/root-item-manager/root-item-manager.hpp"
+#include "services/emoji-service/emoji-service.hpp"
+#include "root-search/federated-search.hpp"
+#include "clipboard-history-view.hpp"
+#include "emoji-command.hpp"
 #include "omni-command-db.hpp"
 #include "service-registry.hpp"
 #include "ui/action-pannel/action-item.hpp"
@@ -45,6 +50,7 @@
 #include <quuid.h>
 #include <qwidget.h>
 #include <ranges>
+#include <unordered_map>
 #include "ui/views/list-view.hpp"
 
 class RootSearchItem : public AbstractDefaultListItem, public ListView::Actionnable {
@@ -205,9 +211,12 @@ class RootFileListItem : public AbstractDefaultListItem, public ListView::Action
     auto mime = m_mimeDb.mimeTypeForFile(m_path.c_str());
 
     if (!mime.name().isEmpty()) {
-      if (!QIcon::fromTheme(mime.iconName()).isNull()) { return ImageURL::system(mime.iconName()); }
+      auto icon = QIcon::fromTheme(mime.iconName()).isNull() ? ImageURL::system(mime.genericIconName())
+                                                             : ImageURL::system(mime.iconName());
 
-      return ImageURL::system(mime.genericIconName());
+      if (mime.name().startsWith("image/")) { return ImageURL::thumbnail(m_path).withFallback(icon); }
+
+      return icon;
     }
 
     return ImageURL::builtin("question-mark-circle");
@@ -242,39 +251,250 @@ public:
   RootFileListItem(const std::filesystem::path &path) : m_path(path) {}
 };
 
+class RootClipboardListItem : public AbstractDefaultListItem, public ListView::Actionnable {
+  ClipboardHistoryEntry m_entry;
+
+  std::unique_ptr<ActionPanelState> newActionPanel(ApplicationContext *ctx) const override {
+    auto panel = std::make_unique<ActionPanelState>();
+    auto section = panel->createSection();
+    auto copy = new CopyClipboardSelection(m_entry.id);
+
+    if (ctx->services->windowManager()->canPaste()) {
+      auto paste = new PasteClipboardSelection(m_entry.id);
+
+      paste->setPrimary(true);
+      section->addAction(paste);
+    } else {
+      copy->setPrimary(true);
+    }
+
+    section->addAction(copy);
+
+    return panel;
+  }
+
+public:
+  QString generateId() const override { return QString("clipboard.%1").arg(m_entry.id); }
+
+  ItemData data() const override {
+    return {.iconUrl = ClipboardHistoryItemWidget::iconForMime(m_entry),
+            .name = m_entry.textPreview.simplified(),
+            .subtitle = getRelativeTimeString(QDateTime::fromSecsSinceEpoch(m_entry.updatedAt))};
+  }
+
+  RootClipboardListItem(const ClipboardHistoryEntry &entry) : m_entry(entry) {}
+};
+
+class RootEmojiListItem : public AbstractDefaultListItem, public ListView::Actionnable {
+  const EmojiData &m_emoji;
+
+  std::unique_ptr<ActionPanelState> newActionPanel(ApplicationContext *ctx) const override {
+    auto panel = std::make_unique<ActionPanelState>();
+    auto section = panel->createSection();
+    auto copy = new CopyToClipboardAction(Clipboard::Text(qStringFromStdView(m_emoji.emoji)), "Copy emoji");
+    auto copyName =
+        new CopyToClipboardAction(Clipboard::Text(qStringFromStdView(m_emoji.name)), "Copy emoji name");
+
+    if (ctx->services->windowManager()->canPaste()) {
+      auto paste = new PasteEmojiAction(m_emoji.emoji);
+
+      paste->setPrimary(true);
+      section->addAction(paste);
+    } else {
+      copy->setPrimary(true);
+    }
+
+    section->addAction(copy);
+    section->addAction(copyName);
+
+    return panel;
+  }
+
+public:
+  QString generateId() const override { return QString("emoji.%1").arg(qStringFromStdView(m_emoji.emoji)); }
+
+  ItemData data() const override {
+    return {.iconUrl = ImageURL::emoji(qStringFromStdView(m_emoji.emoji)),
+            .name = qStringFromStdView(m_emoji.name),
+            .subtitle = qStringFromStdView(m_emoji.group)};
+  }
+
+  RootEmojiListItem(const EmojiData &emoji) : m_emoji(emoji) {}
+};
+
+/**
+ * The root search is federated: every source of results is searched independently, and each one fills
+ * its own section of the list as soon as its results are available. The sections are created once, when
+ * the user starts typing, so that results coming in only cause their own section to be laid out again.
+ */
 class RootSearchView : public ListView {
-  QTimer *m_calcDebounce = new QTimer(this);
-  QTimer *m_fileSearchDebounce = new QTimer(this);
-  std::optional<AbstractCalculatorBackend::CalculatorResult> m_currentCalculatorEntry;
-  std::vector<IndexerFileResult> m_fileResults;
-  QFutureWatcher<std::vector<IndexerFileResult>> m_pendingFileSearchResults;
-  QString m_lastFileSearchQuery;
-  QString m_searchText;
-
-  void handleFileResults() {
-    if (!m_pendingFileSearchResults.isFinished()) return;
-
-    auto results = m_pendingFileSearchResults.result();
-
-    if (m_lastFileSearchQuery != m_searchText) return;
-    m_fileResults = results;
-    render(m_searchText);
+  // sections of the search model, in display order
+  enum SearchSection { CalculatorSection, ResultsSection, FilesSection, ClipboardSection, EmojiSection };
+
+  static constexpr int MIN_ASYNC_QUERY_LENGTH = 3;
+  static constexpr int MAX_EMOJI_RESULTS = 6;
+
+  FederatedSearch *m_search = new FederatedSearch(this);
+  QTimer *m_backgroundRefresh = new QTimer(this);
+  // source index => section it fills
+  std::unordered_map<size_t, SearchSection> m_sourceSections;
+  // only set while the list holds the search model
+  std::vector<const OmniList::Section *> m_sections;
+  const OmniList::Section *m_fallbackSection = nullptr;
+
+  static bool isComputable(const QString &query) {
+    for (const auto &ch : query.trimmed()) {
+      if (!ch.isLetterOrNumber() || ch.isSpace()) return true;
+    }
+
+    return false;
+  }
+
+  void addSource(SearchSection section, FederatedSearch::Source source) {
+    m_sourceSections[m_search->addSource(std::move(source))] = section;
   }
 
-  void handleFileSearchTimeout() {
-    auto filesService = ServiceRegistry::instance()->fileService();
-    if (m_searchText.size() >= 3) {
-      QString currentQuery = m_searchText;
+  void setupSources() {
+    addSource(CalculatorSection,
+              {.name = "calculator",
+               // the backend is not thread safe, expressions are evaluated on the main thread once typing
+               // pauses
+               .debounce = std::chrono::milliseconds(100),
+               .accepts = [](const QString &query) { return isComputable(query); },
+               .search = [](const QString &query, const CancellationToken &) {
+                 static auto &evalLatency = PerfMetrics::instance()->histogram("calculator-eval");
+                 auto calculator = ServiceRegistry::instance()->calculatorService();
+                 auto timer = evalLatency.time();
+                 FederatedSearch::Items items;
+
+                 if (auto result = calculator->backend()->compute(query.trimmed())) {
+                   items.emplace_back(std::make_shared<BaseCalculatorListItem>(*result));
+                 }
+
+                 return FederatedSearch::ready(std::move(items));
+               }});
+
+    addSource(ResultsSection,
+              {.name = "root-items", .search = [](const QString &query, const CancellationToken &) {
+                 auto manager = ServiceRegistry::instance()->rootItemManager();
+
+                 return FederatedSearch::ready(
+                     manager->prefixSearch(query.trimmed()) | std::views::transform([](const auto &item) {
+                       return std::static_pointer_cast<OmniList::AbstractVirtualItem>(
+                           std::make_shared<RootSearchItem>(item));
+                     }) |
+                     std::ranges::to<std::vector>());
+               }});
+
+    addSource(FilesSection,
+              {.name = "files",
+               .debounce = std::chrono::milliseconds(100),
+               .budget = std::chrono::milliseconds(500),
+               .accepts =
+                   [](const QString &query) {
+                     auto config = ServiceRegistry::instance()->config();
+                     return config->value().rootSearch.searchFiles && query.size() >= MIN_ASYNC_QUERY_LENGTH;
+                   },
+               .search = [](const QString &query, const CancellationToken &cancellation) {
+                 auto indexer = ServiceRegistry::instance()->fileService()->indexer();
+
+                 return indexer->queryAsync(query.toStdString(),
+                                            {.pagination = {.limit = 8}, .cancellation = cancellation})
+                     .then([](const std::vector<IndexerFileResult> &results) {
+                       return results | std::views::transform([](const auto &file) {
+                                return std::static_pointer_cast<OmniList::AbstractVirtualItem>(
+                                    std::make_shared<RootFileListItem>(file.path));
+                              }) |
+                              std::ranges::to<std::vector>();
+                     });
+               }});
+
+    addSource(ClipboardSection,
+              {.name = "clipboard",
+               .debounce = std::chrono::milliseconds(100),
+               .budget = std::chrono::milliseconds(500),
+               .accepts =
+                   [](const QString &query) {
+                     auto config = ServiceRegistry::instance()->config();
+                     return config->value().rootSearch.searchClipboard &&
+                            query.trimmed().size() >= MIN_ASYNC_QUERY_LENGTH;
+                   },
+               .search = [](const QString &query, const CancellationToken &cancellation) {
+                 auto clipman = ServiceRegistry::instance()->clipman();
+
+                 return clipman->listAll(5, 0, {.query = query.trimmed()}, cancellation)
+                     .then([](const PaginatedResponse<ClipboardHistoryEntry> &response) {
+                       return response.data | std::views::transform([](const auto &entry) {
+                                return std::static_pointer_cast<OmniList::AbstractVirtualItem>(
+                                    std::make_shared<RootClipboardListItem>(entry));
+                              }) |
+                              std::ranges::to<std::vector>();
+                     });
+               }});
+
+    addSource(EmojiSection,
+              {.name = "emojis",
+               // the index is only read from the main thread, lookups are cheap as long as it is built
+               .accepts =
+                   [](const QString &query) {
+                     auto config = ServiceRegistry::instance()->config();
+                     auto emojis = ServiceRegistry::instance()->emojiService();
+                     return config->value().rootSearch.searchEmojis && emojis->isIndexReady() &&
+                            query.trimmed().size() >= 2;
+                   },
+               .search = [](const QString &query, const CancellationToken &) {
+                 auto emojis = ServiceRegistry::instance()->emojiService();
+
+                 return FederatedSearch::ready(
+                     emojis->search(query.trimmed().toStdString()) | std::views::take(MAX_EMOJI_RESULTS) |
+                     std::views::transform([](const EmojiData *emoji) {
+                       return std::static_pointer_cast<OmniList::AbstractVirtualItem>(
+                           std::make_shared<RootEmojiListItem>(*emoji));
+                     }) |
+                     std::ranges::to<std::vector>());
+               }});
+  }
+
+  void handleResults(size_t source, const FederatedSearch::Items &items) {
+    if (m_sections.empty()) return;
+
+    m_list->setSectionItems(*m_sections.at(m_sourceSections.at(source)), items);
+  }
+
+  void handleResultsInvalidated(size_t source) { handleResults(source, {}); }
+
+  QString fallbackTitle(const QString &text) const { return QString("Use \"%1\" with...").arg(text); }
+
+  /**
+   * Create the (empty) sections of the search model, that sources then fill independently.
+   */
+  void renderSearchModel(const QString &text) {
+    auto rootItemManager = ServiceRegistry::instance()->rootItemManager();
+
+    m_list->beginResetModel();
+    m_sections = {&m_list->addSection("Calculator"), &m_list->addSection("Results"),
+                  &m_list->addSection("Files"), &m_list->addSection("Clipboard"),
+                  &m_list->addSection("Emojis")};
+
+    auto &fallbackSection = m_list->addSection(fallbackTitle(text));
+
+    auto fallbackItems =
+        rootItemManager->allItems() | std::views::filter([rootItemManager](const auto &item) {
+          return rootItemManager->isFallback(item->uniqueId());
+        });
 
-      m_pendingFileSearchResults.setFuture(
-          filesService->indexer()->queryAsync(currentQuery.toStdString(), {.pagination = {.limit = 8}}));
-      m_lastFileSearchQuery = currentQuery;
+    for (const auto &fallback : fallbackItems) {
+      fallbackSection.addItem(std::make_unique<FallbackRootSearchItem>(fallback));
     }
+
+    m_fallbackSection = &fallbackSection;
+    m_list->endResetModel(OmniList::SelectFirst);
   }
 
   void renderEmpty() {
-    m_fileResults.clear();
-    m_currentCalculatorEntry.reset();
+    m_search->cancel();
+    m_sections.clear();
+    m_fallbackSection = nullptr;
 
     m_list->beginResetModel();
     auto commandDb = ServiceRegistry::instance()->commandDb();
@@ -338,136 +558,69 @@ class RootSearchView : public ListView {
 
   void itemSelected(const OmniList::AbstractVirtualItem *item) override {}
 
-  void render(const QString &text) {
-    auto rootItemManager = ServiceRegistry::instance()->rootItemManager();
-    auto commandDb = ServiceRegistry::instance()->commandDb();
-    auto appDb = ServiceRegistry::instance()->appDb();
-    const auto &appEntries = appDb->list();
-    const auto &commandEntries = commandDb->commands();
-    size_t maxReserve = appEntries.size() + commandEntries.size();
-
-    m_list->beginResetModel();
-
-    auto start = std::chrono::high_resolution_clock::now();
-
-    if (m_currentCalculatorEntry) {
-      m_list->addSection("Calculator")
-          .addItem(std::make_unique<BaseCalculatorListItem>(*m_currentCalculatorEntry));
-    }
-
-    {
-      /*
-  auto parsedColor = ColorFormatter().parse(text);
-
-  if (parsedColor.has_value()) {
-    qDebug() << "color=" << parsedColor.value().color << text;
-    m_list->addSection("Color").addItem(std::make_unique<ColorListItem>(text, parsedColor.value()));
-  }
-      */
-    }
-
-    auto &results = m_list->addSection("Results");
-
-    auto searchResults = rootItemManager->prefixSearch(text.trimmed());
-
-    for (const auto &item : searchResults) {
-      results.addItem(std::make_unique<RootSearchItem>(item));
-    }
-
-    if (!m_fileResults.empty()) {
-      auto &section = m_list->addSection("Files");
-
-      for (const auto &file : m_fileResults) {
-        section.addItem(std::make_unique<RootFileListItem>(file.path));
-      }
-    }
-
-    auto &fallbackSection = m_list->addSection(QString("Use \"%1\" with...").arg(text));
-
-    auto fallbackItems =
-        rootItemManager->allItems() | std::views::filter([rootItemManager](const auto &item) {
-          return rootItemManager->isFallback(item->uniqueId());
-        });
-
-    for (const auto &fallback : fallbackItems) {
-      fallbackSection.addItem(std::make_unique<FallbackRootSearchItem>(fallback));
-    }
-
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-
-    m_list->endResetModel(OmniList::SelectFirst);
-    // qDebug() << "root searched in " << duration << "ms";
-  }
-
   void textChanged(const QString &text) override {
-    m_searchText = text;
-    QString query = text.trimmed();
+    static auto &keystrokes = PerfMetrics::instance()->counter("root-search-keystrokes");
+    static auto &searchLatency = PerfMetrics::instance()->histogram("root-search");
 
-    if (query.isEmpty()) return renderEmpty();
+    keystrokes.increment();
 
-    m_calcDebounce->start();
+    if (text.trimmed().isEmpty()) return renderEmpty();
 
-    if (context()->services->config()->value().rootSearch.searchFiles) { m_fileSearchDebounce->start(); }
+    // only covers the sources that answer synchronously, the others have their own timings
+    auto timer = searchLatency.time();
 
-    if (text.size() < 3) { m_fileResults.clear(); }
+    if (m_sections.empty()) {
+      renderSearchModel(text);
+    } else {
+      m_list->setSectionTitle(*m_fallbackSection, fallbackTitle(text));
+    }
 
-    return render(text);
+    m_search->query(text);
   }
 
-  void handleCalculatorTimeout() {
-    auto calculator = ServiceRegistry::instance()->calculatorService();
-    QString expression = searchText().trimmed();
-    bool isComputable = false;
-
-    for (const auto &ch : expression) {
-      if (!ch.isLetterOrNumber() || ch.isSpace()) {
-        isComputable = true;
-        break;
-      }
-    }
-
-    if (!isComputable) {
-      m_currentCalculatorEntry.reset();
-      render(searchText());
+  /**
+   * Root items changing while the view is hidden still need to be reflected, otherwise the stale list
+   * would have to be rebuilt when the window is toggled. Bursts of changes are coalesced so that
+   * the list is rebuilt once, in the background.
+   */
+  void refresh() {
+    if (isVisible()) {
+      rebuild();
       return;
     }
 
-    auto result = calculator->backend()->compute(expression);
-
-    if (result) {
-      m_currentCalculatorEntry = *result;
-    } else {
-      m_currentCalculatorEntry.reset();
-    }
-    render(searchText());
+    m_backgroundRefresh->start();
   }
 
-  void handleFavoriteChanged(const QString &itemId, bool value) {
-    if (isVisible()) textChanged(searchText());
+  /**
+   * Rebuild the whole list, including the fallback items of the search model.
+   */
+  void rebuild() {
+    m_sections.clear();
+    textChanged(searchText());
   }
 
-  void handleItemChange() {
-    if (isVisible()) textChanged(searchText());
-  }
+  void handleFavoriteChanged(const QString &itemId, bool value) { refresh(); }
+
+  void handleItemChange() { refresh(); }
 
   void initialize() override {
     auto manager = context()->services->rootItemManager();
 
-    m_calcDebounce->setInterval(100);
-    m_calcDebounce->setSingleShot(true);
-    m_fileSearchDebounce->setInterval(100);
-    m_fileSearchDebounce->setSingleShot(true);
+    m_backgroundRefresh->setInterval(100);
+    m_backgroundRefresh->setSingleShot(true);
+    setupSources();
 
     setSearchPlaceholderText("Search for anything...");
-    textChanged(searchText());
 
     connect(manager, &RootItemManager::itemsChanged, this, &RootSearchView::handleItemChange);
     connect(manager, &RootItemManager::itemFavoriteChanged, this, &RootSearchView::handleFavoriteChanged);
-    connect(m_calcDebounce, &QTimer::timeout, this, &RootSearchView::handleCalculatorTimeout);
-    connect(m_fileSearchDebounce, &QTimer::timeout, this, &RootSearchView::handleFileSearchTimeout);
-    connect(&m_pendingFileSearchResults, &QFutureWatcher<std::vector<IndexerFileResult>>::finished, this,
-            &RootSearchView::handleFileResults);
+    // sources that answer synchronously report their results from within the first query
+    connect(m_search, &FederatedSearch::resultsReady, this, &RootSearchView::handleResults);
+    connect(m_search, &FederatedSearch::resultsInvalidated, this, &RootSearchView::handleResultsInvalidated);
+    connect(m_backgroundRefresh, &QTimer::timeout, this, &RootSearchView::rebuild);
+
+    textChanged(searchText());
   }
 
 public:
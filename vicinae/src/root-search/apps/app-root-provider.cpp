@@ -32,6 +32,13 @@ AccessoryList AppRootItem::accessories() const {
 
 QString AppRootItem::uniqueId() const { return QString("apps.%1").arg(m_app->id()); }
 
+bool AppRootItem::hasSameData(const RootItem &other) const {
+  // the app database only creates a new application when its desktop file changed
+  auto app = dynamic_cast<const AppRootItem *>(&other);
+
+  return app && app->m_app == m_app;
+}
+
 ImageURL AppRootItem::iconUrl() const { return m_app->iconUrl(); }
 
 std::unique_ptr<ActionPanelState> AppRootItem::newActionPanel(ApplicationContext *ctx,
@@ -116,8 +123,41 @@ std::vector<std::shared_ptr<RootItem>> AppRootProvider::loadItems() const {
          std::ranges::to<std::vector>();
 }
 
+void AppRootProvider::handleAppsChanged() {
+  auto scanDelta = m_appService.lastScanDelta();
+
+  if (!scanDelta) {
+    emit itemsChanged();
+    return;
+  }
+
+  auto makeId = [](const QString &appId) { return QString("apps.%1").arg(appId); };
+  RootItemDelta delta;
+
+  for (const auto &app : scanDelta->added) {
+    if (app->displayable()) delta.added.emplace_back(std::make_shared<AppRootItem>(app));
+  }
+
+  for (const auto &app : scanDelta->changed) {
+    if (app->displayable()) {
+      delta.updated.emplace_back(std::make_shared<AppRootItem>(app));
+    } else {
+      delta.removed.emplace_back(makeId(app->id()));
+    }
+  }
+
+  for (const auto &id : scanDelta->removed) {
+    delta.removed.emplace_back(makeId(id));
+  }
+
+  // mime associations changed, but no application did
+  if (delta.empty()) return;
+
+  emit itemsDelta(delta);
+}
+
 AppRootProvider::AppRootProvider(AppService &appService) : m_appService(appService) {
-  connect(&m_appService, &AppService::appsChanged, this, &AppRootProvider::itemsChanged);
+  connect(&m_appService, &AppService::appsChanged, this, &AppRootProvider::handleAppsChanged);
 }
 
 void AppRootProvider::preferencesChanged(const QJsonObject &preferences) {
@@ -19,6 +19,7 @@ class AppRootItem : public RootItem {
   ImageURL iconUrl() const override;
   QWidget *settingsDetail(const QJsonObject &preferences) const override;
   std::vector<QString> keywords() const override;
+  bool hasSameData(const RootItem &other) const override;
 
 public:
   const Application &app() const { return *m_app.get(); }
@@ -29,6 +30,8 @@ class AppRootProvider : public RootProvider {
 public:
   AppService &m_appService;
 
+  void handleAppsChanged();
+
   std::vector<std::shared_ptr<RootItem>> loadItems() const override;
 
   QJsonObject generateDefaultPreferences() const override;
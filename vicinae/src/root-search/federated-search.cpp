@@ -0,0 +1,133 @@
+#include "federated-search.hpp"
+#include <qdebug.h>
+#include <qfuturewatcher.h>
+#include <qlogging.h>
+#include <qpromise.h>
+
+QFuture<FederatedSearch::Items> FederatedSearch::ready(Items items) {
+  QPromise<Items> promise;
+  auto future = promise.future();
+
+  promise.start();
+  promise.addResult(std::move(items));
+  promise.finish();
+
+  return future;
+}
+
+size_t FederatedSearch::addSource(Source source) {
+  auto state = std::make_unique<SourceState>();
+  size_t index = m_sources.size();
+  std::string name = source.name.toStdString();
+
+  state->latency = &PerfMetrics::instance()->histogram("root-search-source-" + name);
+  state->timeouts = &PerfMetrics::instance()->counter("root-search-source-" + name + "-timeouts");
+  state->debounce = new QTimer(this);
+  state->debounce->setSingleShot(true);
+  state->debounce->setInterval(source.debounce);
+  state->deadline = new QTimer(this);
+  state->deadline->setSingleShot(true);
+  state->deadline->setInterval(source.budget);
+  state->source = std::move(source);
+
+  connect(state->debounce, &QTimer::timeout, this, [this, index]() { dispatch(index); });
+  connect(state->deadline, &QTimer::timeout, this, [this, index]() { expire(index); });
+  m_sources.emplace_back(std::move(state));
+
+  return index;
+}
+
+void FederatedSearch::reset(SourceState &state) {
+  state.debounce->stop();
+  state.deadline->stop();
+  state.pending = false;
+  state.cancellation.cancel();
+
+  if (state.timer) {
+    state.timer->cancel();
+    state.timer.reset();
+  }
+}
+
+void FederatedSearch::cancel() {
+  ++m_generation;
+
+  for (const auto &state : m_sources) {
+    reset(*state);
+  }
+}
+
+void FederatedSearch::query(const QString &query) {
+  cancel();
+  m_query = query;
+
+  for (size_t i = 0; i != m_sources.size(); ++i) {
+    auto &state = *m_sources[i];
+
+    state.pending = true;
+
+    if (state.source.accepts && !state.source.accepts(query)) {
+      settle(i, {});
+      continue;
+    }
+
+    // the latency is the one perceived by the user, debounce included
+    state.timer.emplace(*state.latency);
+
+    if (state.source.budget.count() > 0) state.deadline->start();
+
+    if (state.source.debounce.count() > 0) {
+      state.debounce->start();
+    } else {
+      dispatch(i);
+    }
+
+    if (state.pending) emit resultsInvalidated(i);
+  }
+}
+
+void FederatedSearch::dispatch(size_t index) {
+  auto &state = *m_sources[index];
+  auto future = state.source.search(m_query, state.cancellation.next());
+
+  if (future.isFinished()) {
+    settle(index, future.resultCount() > 0 ? future.result() : Items{});
+    return;
+  }
+
+  auto watcher = new QFutureWatcher<Items>(this);
+
+  connect(watcher, &QFutureWatcher<Items>::finished, this, [this, index, watcher, gen = m_generation]() {
+    watcher->deleteLater();
+
+    // superseded by a newer query
+    if (gen != m_generation) return;
+
+    settle(index, watcher->future().resultCount() > 0 ? watcher->result() : Items{});
+  });
+  watcher->setFuture(future);
+}
+
+void FederatedSearch::settle(size_t index, Items items) {
+  auto &state = *m_sources[index];
+
+  // late results, the source was already reported as having none
+  if (!state.pending) return;
+
+  state.pending = false;
+  state.deadline->stop();
+  state.timer.reset();
+  emit resultsReady(index, items);
+}
+
+void FederatedSearch::expire(size_t index) {
+  auto &state = *m_sources[index];
+
+  if (!state.pending) return;
+
+  qDebug() << "FederatedSearch: source" << state.source.name << "did not answer within"
+           << state.source.budget.count() << "ms";
+  state.timeouts->increment();
+  reset(state);
+  emit resultsReady(index, {});
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "daemon/perf-metrics.hpp"
+#include "ui/omni-list/omni-list.hpp"
+#include "utils/cancellation-token/cancellation-token.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <qfuture.h>
+#include <qobject.h>
+#include <qstring.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <vector>
+
+/**
+ * Runs a query against several independent sources of results (root items, calculator, files...)
+ * and reports the results of each source as soon as they are available, so that a slow source never
+ * holds back the others.
+ *
+ * Every source is given a latency budget, counted from the moment the query was started: a source
+ * that did not answer in time is reported as having no results, and whatever it answers later is
+ * dropped. This keeps the list from moving around once the user had time to look at it.
+ *
+ * Starting a new query supersedes the current one: results that belong to a previous query are never
+ * reported, and the searches still running for it are cancelled.
+ */
+class FederatedSearch : public QObject {
+  Q_OBJECT
+
+public:
+  using Items = std::vector<std::shared_ptr<OmniList::AbstractVirtualItem>>;
+
+  struct Source {
+    QString name;
+    // wait for the query to be stable for that long before starting the search
+    std::chrono::milliseconds debounce{0};
+    // no budget if zero
+    std::chrono::milliseconds budget{0};
+    // if set and false for a query, the source is reported as having no results without being searched
+    std::function<bool(const QString &query)> accepts;
+    // started on the main thread, sources that can answer right away should return a finished future,
+    // see `ready`. The token is cancelled once the results are not wanted anymore.
+    std::function<QFuture<Items>(const QString &query, const CancellationToken &cancellation)> search;
+  };
+
+  /**
+   * A finished future holding `items`, for sources that are searched synchronously.
+   */
+  static QFuture<Items> ready(Items items);
+
+  /**
+   * Returns the index of the source, as passed to `resultsReady`.
+   */
+  size_t addSource(Source source);
+
+  /**
+   * Start searching every source for `query`. Sources that answer synchronously are reported
+   * before this returns.
+   */
+  void query(const QString &query);
+
+  /**
+   * Stop the current query without starting a new one.
+   */
+  void cancel();
+
+  const QString &currentQuery() const { return m_query; }
+
+  FederatedSearch(QObject *parent = nullptr) : QObject(parent) {}
+
+signals:
+  /**
+   * Emitted exactly once per source and query, with no items if the source did not answer in time.
+   */
+  void resultsReady(size_t source, const Items &items) const;
+
+  /**
+   * Emitted when a query starts for a source that can't answer right away: whatever it reported
+   * for the previous query should not be displayed anymore.
+   */
+  void resultsInvalidated(size_t source) const;
+
+private:
+  struct SourceState {
+    Source source;
+    PerfMetrics::Histogram *latency = nullptr;
+    PerfMetrics::Counter *timeouts = nullptr;
+    QTimer *debounce = nullptr;
+    QTimer *deadline = nullptr;
+    std::optional<PerfMetrics::Timer> timer;
+    CancellationSource cancellation;
+    bool pending = false;
+  };
+
+  void dispatch(size_t index);
+  void settle(size_t index, Items items);
+  void expire(size_t index);
+  void reset(SourceState &state);
+
+  std::vector<std::unique_ptr<SourceState>> m_sources;
+  QString m_query;
+  uint64_t m_generation = 0;
+};
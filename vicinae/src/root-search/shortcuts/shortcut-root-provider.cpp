@@ -129,8 +129,22 @@ ImageURL ShortcutRootProvider::icon() const {
 QString ShortcutRootProvider::uniqueId() const { return "shortcuts"; }
 RootProvider::Type ShortcutRootProvider::type() const { return RootProvider::Type::GroupProvider; }
 
+std::shared_ptr<RootItem> ShortcutRootProvider::makeItem(const QString &shortcutId) const {
+  for (const auto &shortcut : m_db.shortcuts()) {
+    if (shortcut->id() == shortcutId) return std::make_shared<RootShortcutItem>(shortcut);
+  }
+
+  return nullptr;
+}
+
 ShortcutRootProvider::ShortcutRootProvider(ShortcutService &db) : m_db(db) {
-  connect(&db, &ShortcutService::shortcutSaved, this, [this]() { emit itemsChanged(); });
-  connect(&db, &ShortcutService::shortcutRemoved, this, [this]() { emit itemsChanged(); });
-  connect(&db, &ShortcutService::shortcutUpdated, this, [this]() { emit itemsChanged(); });
+  connect(&db, &ShortcutService::shortcutSaved, this, [this](const Shortcut &shortcut) {
+    if (auto item = makeItem(shortcut.id())) { emit itemsDelta({.added = {item}}); }
+  });
+  connect(&db, &ShortcutService::shortcutRemoved, this, [this](const QString &id) {
+    emit itemsDelta({.removed = {QString("shortcuts.%1").arg(id)}});
+  });
+  connect(&db, &ShortcutService::shortcutUpdated, this, [this](const QString &id) {
+    if (auto item = makeItem(id)) { emit itemsDelta({.updated = {item}}); }
+  });
 }
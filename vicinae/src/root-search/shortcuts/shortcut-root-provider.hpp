@@ -27,6 +27,8 @@ public:
 class ShortcutRootProvider : public RootProvider {
   ShortcutService &m_db;
 
+  std::shared_ptr<RootItem> makeItem(const QString &shortcutId) const;
+
 public:
   QString displayName() const override;
   QString uniqueId() const override;
@@ -1,6 +1,7 @@
 #pragma once
 #include "../../ui/image/url.hpp"
 #include <QString>
+#include <optional>
 #include <qmimetype.h>
 #include <qobject.h>
 #include <qtmetamacros.h>
@@ -45,6 +46,27 @@ public:
 
   virtual bool scan(const std::vector<std::filesystem::path> &paths) = 0;
 
+  /**
+   * Whether the last call to `scan` changed anything. Implementations that can't tell
+   * should always return true.
+   */
+  virtual bool lastScanChanged() const { return true; }
+
+  /**
+   * Applications added, modified or removed (by id) by the last call to `scan`.
+   * Changes to mime associations alone are not reported.
+   */
+  struct ScanDelta {
+    std::vector<AppPtr> added;
+    std::vector<AppPtr> changed;
+    std::vector<QString> removed;
+  };
+
+  /**
+   * What the last call to `scan` changed, if the implementation can tell.
+   */
+  virtual std::optional<ScanDelta> lastScanDelta() const { return std::nullopt; }
+
   virtual bool launch(const Application &exec, const std::vector<QString> &args = {}) const = 0;
   /**
    * Returns the best app to open the passed target.
@@ -1,7 +1,9 @@
 #include "app-service.hpp"
+#include "daemon/startup-profiler.hpp"
 #include "services/app-service/xdg/xdg-app-database.hpp"
 #include "omni-database.hpp"
 #include <filesystem>
+#include <qcoreapplication.h>
 #include <qfilesystemwatcher.h>
 
 namespace fs = std::filesystem;
@@ -31,7 +33,12 @@ std::unique_ptr<AbstractAppDatabase> AppService::createLocalProvider() {
 #endif
 
 #if defined(Q_OS_UNIX) && not defined(Q_OS_DARWIN)
-  return std::make_unique<XdgAppDatabase>();
+  auto phase = StartupProfiler::instance()->phase("xdg-app-scan");
+  auto provider = std::make_unique<XdgAppDatabase>();
+
+  if (auto app = QCoreApplication::instance()) { provider->moveToThread(app->thread()); }
+
+  return provider;
 #endif
 }
 
@@ -73,11 +80,10 @@ std::shared_ptr<Application> AppService::find(const QString &target) const {
 }
 
 void AppService::handleDirectoryChanged(const QString &path) {
-  // This event can fire multiple times for a single change.
-  // Since scanning apps is fast we don't really need to batch events, at least for now.
-
-  qInfo() << "app directory" << path << "changed, launching a new scan";
-  scanSync();
+  // This event can fire multiple times for a single change, and package upgrades touch
+  // hundreds of files in bursts: we wait for things to settle before rescanning.
+  qDebug() << "app directory" << path << "changed, scheduling a new scan";
+  m_rescanTimer->start();
 }
 
 void AppService::setAdditionalSearchPaths(const std::vector<std::filesystem::path> &paths) {
@@ -106,12 +112,23 @@ bool AppService::reinstallWatches(const std::vector<fs::path> &paths) {
 bool AppService::scanSync() {
   bool result = m_provider->scan(mergedPaths());
 
-  emit appsChanged();
+  m_rescanTimer->stop();
+
+  if (m_provider->lastScanChanged()) { emit appsChanged(); }
 
   return result;
 }
 
-AppService::AppService(OmniDatabase &db) : m_db(db), m_provider(createLocalProvider()) {
+AppService::AppService(OmniDatabase &db) : AppService(db, createLocalProvider()) {}
+
+AppService::AppService(OmniDatabase &db, std::unique_ptr<AbstractAppDatabase> provider)
+    : m_db(db), m_provider(std::move(provider)) {
+  m_rescanTimer->setSingleShot(true);
+  m_rescanTimer->setInterval(RESCAN_DEBOUNCE_MS);
   reinstallWatches(mergedPaths());
   connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &AppService::handleDirectoryChanged);
+  connect(m_rescanTimer, &QTimer::timeout, this, [this]() {
+    qInfo() << "app directories changed, launching a new scan";
+    scanSync();
+  });
 }
@@ -7,6 +7,7 @@
 #include <qobject.h>
 #include <qobjectdefs.h>
 #include <qsqlquery.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
 
 class AppService : public QObject, public NonCopyable {
@@ -16,17 +17,25 @@ public:
   std::vector<std::filesystem::path> m_additionalSearchPaths;
 
 private:
+  static constexpr int RESCAN_DEBOUNCE_MS = 500;
+
   QFileSystemWatcher *m_watcher = new QFileSystemWatcher(this);
+  QTimer *m_rescanTimer = new QTimer(this);
   OmniDatabase &m_db;
   std::unique_ptr<AbstractAppDatabase> m_provider;
 
-  static std::unique_ptr<AbstractAppDatabase> createLocalProvider();
   std::vector<std::filesystem::path> mergedPaths() const;
 
   bool reinstallWatches(const std::vector<std::filesystem::path> &paths);
   void handleDirectoryChanged(const QString &path);
 
 public:
+  /**
+   * Creates the app database for the underlying system, which performs an initial scan.
+   * It's safe to call this from a worker thread: the returned object is moved to the main thread.
+   */
+  static std::unique_ptr<AbstractAppDatabase> createLocalProvider();
+
   /**
    * Concrete implementation for the underlying system.
    */
@@ -70,8 +79,14 @@ public:
    */
   bool scanSync();
 
+  /**
+   * What the last scan changed, if the app database can tell. Valid when `appsChanged` is emitted.
+   */
+  std::optional<AbstractAppDatabase::ScanDelta> lastScanDelta() const { return m_provider->lastScanDelta(); }
+
   std::vector<std::shared_ptr<Application>> findOpeners(const QString &target) const;
 
+  AppService(OmniDatabase &db, std::unique_ptr<AbstractAppDatabase> provider);
   AppService(OmniDatabase &db);
 
 signals:
@@ -1,16 +1,23 @@
 #include "xdg-app-database.hpp"
 #include "vicinae.hpp"
 #include <filesystem>
+#include <qdatastream.h>
 #include <qlogging.h>
+#include <qsavefile.h>
 #include <qsettings.h>
+#include <qstandardpaths.h>
 #include <ranges>
 #include <set>
 #include <QDir>
+#include <sys/stat.h>
 
 namespace fs = std::filesystem;
 
 using AppPtr = XdgAppDatabase::AppPtr;
 
+static constexpr quint32 PARSE_CACHE_MAGIC = 0x56444543; // VDEC
+static constexpr quint32 PARSE_CACHE_VERSION = 1;
+
 static const std::vector<fs::path> wellKnownPaths = {"/usr/share/applications",
                                                      "/usr/local/share/applications"};
 
@@ -59,14 +66,150 @@ AppPtr XdgAppDatabase::findBestTerminalEmulator() const {
   return *result.begin();
 }
 
-bool XdgAppDatabase::scan(const std::vector<std::filesystem::path> &paths) {
-  appMap.clear();
-  mimeToApps.clear();
-  appToMimes.clear();
+std::optional<XdgAppDatabase::DesktopFileState> XdgAppDatabase::statFile(const fs::path &path) {
+  struct stat st;
+
+  if (::stat(path.c_str(), &st) != 0) return std::nullopt;
+
+  return DesktopFileState{.mtime = st.st_mtim.tv_sec * 1'000'000'000LL + st.st_mtim.tv_nsec,
+                          .inode = st.st_ino,
+                          .size = st.st_size};
+}
+
+void XdgAppDatabase::indexApp(const std::shared_ptr<XdgApplication> &app, std::set<QString> &mimes) {
+  for (const auto &mimeName : app->xdgData().mimeType) {
+    m_desktopMimeToApps[mimeName].insert(app->id());
+    m_desktopAppToMimes[app->id()].insert(mimeName);
+    mimes.insert(mimeName);
+  }
+
+  appMap.insert({app->id(), app});
+
+  for (const auto &action : app->actions()) {
+    appMap.insert({action->id(), action});
+  }
+}
+
+void XdgAppDatabase::unindexApp(const std::shared_ptr<XdgApplication> &app, std::set<QString> &mimes) {
+  for (const auto &mimeName : app->xdgData().mimeType) {
+    if (auto it = m_desktopMimeToApps.find(mimeName); it != m_desktopMimeToApps.end()) {
+      it->second.erase(app->id());
+      if (it->second.empty()) m_desktopMimeToApps.erase(it);
+    }
+    mimes.insert(mimeName);
+  }
+
+  m_desktopAppToMimes.erase(app->id());
+
+  // only erase entries that still point to this app, a file with the same name may have replaced it
+  if (auto it = appMap.find(app->id()); it != appMap.end() && it->second == app) { appMap.erase(it); }
+
+  for (const auto &action : app->xdgData().actions) {
+    auto id = app->id() + "." + action.id;
+
+    if (auto it = appMap.find(id); it != appMap.end() && it->second->path() == app->path()) {
+      appMap.erase(it);
+    }
+  }
+}
+
+void XdgAppDatabase::recomputeMime(const QString &mime) {
+  std::set<QString> result;
+
+  if (auto it = m_desktopMimeToApps.find(mime); it != m_desktopMimeToApps.end()) { result = it->second; }
+
+  if (auto it = m_mimeOverlay.find(mime); it != m_mimeOverlay.end()) {
+    for (const auto &op : it->second) {
+      if (op.add) {
+        result.insert(op.value);
+      } else {
+        result.clear();
+      }
+    }
+  }
+
+  if (result.empty()) {
+    mimeToApps.erase(mime);
+  } else {
+    mimeToApps[mime] = std::move(result);
+  }
+}
+
+void XdgAppDatabase::recomputeApp(const QString &appId) {
+  std::set<QString> result;
+
+  if (auto it = m_desktopAppToMimes.find(appId); it != m_desktopAppToMimes.end()) { result = it->second; }
+
+  if (auto it = m_appOverlay.find(appId); it != m_appOverlay.end()) {
+    for (const auto &op : it->second) {
+      if (op.add) {
+        result.insert(op.value);
+      } else {
+        result.clear();
+      }
+    }
+  }
+
+  if (result.empty()) {
+    appToMimes.erase(appId);
+  } else {
+    appToMimes[appId] = std::move(result);
+  }
+}
+
+bool XdgAppDatabase::scanMimeApps() {
+  auto toMimeApp = [](const fs::path &path) { return path / "mimeapps.list"; };
+  std::vector<std::pair<std::string, int64_t>> files;
+
+  // we reverse the config dir order to scan the directories with the least priority first
+  for (const auto &path :
+       Omnicast::xdgConfigDirs() | std::views::reverse | std::views::transform(toMimeApp)) {
+    if (auto state = statFile(path)) { files.emplace_back(path.string(), state->mtime); }
+  }
+
+  if (files == m_mimeAppsFiles) return false;
+
+  m_mimeAppsFiles = files;
+  m_mimeOverlay.clear();
+  m_appOverlay.clear();
   mimeToDefaultApp.clear();
-  apps.clear();
 
+  for (const auto &[path, _] : files) {
+    QSettings ini(path.c_str(), QSettings::IniFormat);
+
+    ini.beginGroup("Default Applications");
+    for (const auto &key : ini.allKeys()) {
+      auto appId = ini.value(key).toString();
+
+      mimeToDefaultApp[key] = appId;
+    }
+    ini.endGroup();
+
+    ini.beginGroup("Added Associations");
+    for (const auto &mime : ini.childKeys()) {
+      for (const auto app : ini.value(mime).toString().split(";")) {
+        m_mimeOverlay[mime].push_back({.add = true, .value = app});
+        m_appOverlay[app].push_back({.add = true, .value = mime});
+      }
+    }
+    ini.endGroup();
+
+    ini.beginGroup("Removed Associations");
+    for (const auto &mime : ini.childKeys()) {
+      for (const auto app : ini.value(mime).toString().split(";")) {
+        m_mimeOverlay[mime].push_back({.add = false});
+        m_appOverlay[app].push_back({.add = false});
+      }
+    }
+    ini.endGroup();
+  }
+
+  return true;
+}
+
+bool XdgAppDatabase::scan(const std::vector<std::filesystem::path> &paths) {
   std::vector<fs::path> traversed;
+  std::vector<fs::path> desktopFiles;
   std::set<std::string> processedFilenames; // Track which .desktop filenames we've already processed
 
   // scan dirs
@@ -88,62 +231,132 @@ bool XdgAppDatabase::scan(const std::vector<std::filesystem::path> &paths) {
       // This ensures that the first occurrence (highest priority) wins
       if (processedFilenames.find(filename) == processedFilenames.end()) {
         processedFilenames.insert(filename);
-        addDesktopFile(entry.path().c_str());
+        desktopFiles.emplace_back(entry.path());
       }
     }
   }
 
-  auto toMimeApp = [](const fs::path &path) { return path / "mimeapps.list"; };
-  auto isFile = [](const fs::path &path) {
-    std::error_code ec;
-    return fs::is_regular_file(path, ec);
-  };
-  // we reverse the config dir order to scan the directories with the least priority first
-  auto mimeAppPaths = Omnicast::xdgConfigDirs() | std::views::reverse | std::views::transform(toMimeApp) |
-                      std::views::filter(isFile);
+  std::unordered_map<std::string, DesktopFileState> files;
+  std::vector<std::shared_ptr<XdgApplication>> removedApps;
+  std::vector<std::shared_ptr<XdgApplication>> addedApps;
+  size_t parsedCount = 0;
+  size_t cacheHits = 0;
 
-  for (const auto &path : mimeAppPaths) {
-    QSettings ini(path.c_str(), QSettings::IniFormat);
+  files.reserve(desktopFiles.size());
 
-    ini.beginGroup("Default Applications");
-    for (const auto &key : ini.allKeys()) {
-      auto appId = ini.value(key).toString();
+  for (const auto &path : desktopFiles) {
+    auto state = statFile(path);
 
-      mimeToDefaultApp[key] = appId;
+    if (!state) continue;
+
+    auto previous = m_files.find(path.string());
+
+    if (previous != m_files.end() && previous->second == *state) {
+      files[path.string()] = std::move(previous->second);
+      m_files.erase(previous);
+      continue;
     }
-    ini.endGroup();
 
-    ini.beginGroup("Added Associations");
-    for (const auto &mime : ini.childKeys()) {
-      for (const auto app : ini.value(mime).toString().split(";")) {
-        // add mime -> apps mapping
-        if (auto it = mimeToApps.find(mime); it != mimeToApps.end()) {
-          it->second.insert(app);
-        } else {
-          mimeToApps.insert({mime, {app}});
-        }
+    if (previous != m_files.end()) {
+      if (previous->second.app) removedApps.emplace_back(previous->second.app);
+      m_files.erase(previous);
+    }
 
-        // add app -> mimes mapping
-        if (auto it = appToMimes.find(app); it != appToMimes.end()) {
-          it->second.insert(mime);
-        } else {
-          appToMimes.insert({app, {mime}});
-        }
-      }
+    if (auto cached = m_parseCache.find(path.string());
+        cached != m_parseCache.end() && cached->second == *state) {
+      state->app = cached->second.app;
+      ++cacheHits;
+    } else {
+      state->app = parseDesktopFile(path.c_str());
+      ++parsedCount;
     }
-    ini.endGroup();
 
-    ini.beginGroup("Removed Associations");
-    for (const auto &mime : ini.childKeys()) {
-      for (const auto app : ini.value(mime).toString().split(";")) {
-        // add mime -> apps mapping
-        if (auto it = mimeToApps.find(mime); it != mimeToApps.end()) { mimeToApps.erase(it); }
+    if (state->app) addedApps.emplace_back(state->app);
+    files[path.string()] = std::move(*state);
+  }
+
+  // whatever is left was not found during this scan
+  for (const auto &[_, state] : m_files) {
+    if (state.app) removedApps.emplace_back(state.app);
+  }
+
+  bool parseCacheStale = parsedCount > 0 || !m_files.empty() || cacheHits != m_parseCache.size();
 
-        // add app -> mimes mapping
-        if (auto it = appToMimes.find(app); it != appToMimes.end()) { appToMimes.erase(it); }
+  m_files = std::move(files);
+  m_parseCache.clear();
+
+  if (parseCacheStale) saveParseCache();
+
+  std::set<QString> affectedMimes;
+  std::set<QString> affectedApps;
+
+  for (const auto &app : removedApps) {
+    unindexApp(app, affectedMimes);
+    affectedApps.insert(app->id());
+  }
+
+  for (const auto &app : addedApps) {
+    indexApp(app, affectedMimes);
+    affectedApps.insert(app->id());
+  }
+
+  bool mimeAppsChanged = scanMimeApps();
+
+  if (mimeAppsChanged) {
+    mimeToApps.clear();
+    appToMimes.clear();
+
+    for (const auto &[mime, _] : m_desktopMimeToApps) {
+      recomputeMime(mime);
+    }
+    for (const auto &[mime, _] : m_mimeOverlay) {
+      recomputeMime(mime);
+    }
+    for (const auto &[app, _] : m_desktopAppToMimes) {
+      recomputeApp(app);
+    }
+    for (const auto &[app, _] : m_appOverlay) {
+      recomputeApp(app);
+    }
+  } else {
+    for (const auto &mime : affectedMimes) {
+      recomputeMime(mime);
+    }
+    for (const auto &app : affectedApps) {
+      recomputeApp(app);
+    }
+  }
+
+  m_lastScanChanged = mimeAppsChanged || !removedApps.empty() || !addedApps.empty();
+  m_lastScanDelta = {};
+
+  std::set<QString> removedIds;
+
+  for (const auto &app : removedApps) {
+    removedIds.insert(app->id());
+  }
+
+  // a modified file is seen as removed then added again, under the same id
+  for (const auto &app : addedApps) {
+    if (removedIds.erase(app->id())) {
+      m_lastScanDelta.changed.emplace_back(app);
+    } else {
+      m_lastScanDelta.added.emplace_back(app);
+    }
+  }
+
+  m_lastScanDelta.removed.assign(removedIds.begin(), removedIds.end());
+
+  if (m_lastScanChanged) {
+    apps.clear();
+    apps.reserve(desktopFiles.size());
+
+    // preserve the priority order of the search paths
+    for (const auto &path : desktopFiles) {
+      if (auto it = m_files.find(path.string()); it != m_files.end() && it->second.app) {
+        apps.emplace_back(it->second.app);
       }
     }
-    ini.endGroup();
   }
 
   return true;
@@ -346,7 +559,7 @@ AppPtr XdgAppDatabase::findByClass(const QString &name) const {
 
 std::vector<AppPtr> XdgAppDatabase::list() const { return {apps.begin(), apps.end()}; }
 
-bool XdgAppDatabase::addDesktopFile(const QString &path) {
+std::shared_ptr<XdgApplication> XdgAppDatabase::parseDesktopFile(const QString &path) const {
   QFileInfo info(path);
 
   try {
@@ -354,27 +567,98 @@ bool XdgAppDatabase::addDesktopFile(const QString &path) {
 
     // we should not track hidden apps as they are explictly removed, unlike apps with NoDisplay
     // see: https://specifications.freedesktop.org/desktop-entry-spec/latest/recognized-keys.html
-    if (ent.hidden) return true;
+    if (ent.hidden) return nullptr;
 
-    auto entry = std::make_shared<XdgApplication>(info, ent);
+    return std::make_shared<XdgApplication>(info, ent);
+  } catch (const std::exception &except) {
+    qWarning() << "Failed to parse app at" << path << except.what();
+    return nullptr;
+  }
+}
 
-    for (const auto &mimeName : ent.mimeType) {
-      mimeToApps[mimeName].insert(entry->id());
-      appToMimes[entry->id()].insert(mimeName);
-    }
+fs::path XdgAppDatabase::parseCachePath() {
+  return fs::path(QStandardPaths::writableLocation(QStandardPaths::CacheLocation).toStdString()) /
+         "desktop-entries.bin";
+}
+
+void XdgAppDatabase::loadParseCache() {
+  QFile file(parseCachePath());
+
+  if (!file.open(QIODevice::ReadOnly)) return;
+
+  QDataStream stream(&file);
+  quint32 magic = 0, version = 0;
+  QByteArray locale;
+  quint32 count = 0;
+
+  stream.setVersion(QDataStream::Qt_6_0);
+  stream >> magic >> version >> locale >> count;
+
+  // entries are resolved against the locale at parse time, so a locale change invalidates everything
+  if (stream.status() != QDataStream::Ok || magic != PARSE_CACHE_MAGIC || version != PARSE_CACHE_VERSION ||
+      locale.toStdString() != XdgDesktopEntry::messagesLocale()) {
+    return;
+  }
+
+  m_parseCache.reserve(count);
 
-    apps.push_back(entry);
-    appMap.insert({entry->id(), entry});
+  for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+    QString path;
+    qint64 mtime = 0, size = 0;
+    quint64 inode = 0;
+    bool hasApp = false;
+    DesktopFileState state;
 
-    for (const auto &action : entry->actions()) {
-      appMap.insert({action->id(), action});
+    stream >> path >> mtime >> inode >> size >> hasApp;
+    state.mtime = mtime;
+    state.inode = inode;
+    state.size = size;
+
+    if (hasApp) {
+      XdgDesktopEntry entry;
+
+      stream >> entry;
+      state.app = std::make_shared<XdgApplication>(QFileInfo(path), entry);
     }
-  } catch (const std::exception &except) {
-    qWarning() << "Failed to parse app at" << path << except.what();
-    return false;
+
+    m_parseCache[path.toStdString()] = std::move(state);
   }
 
-  return true;
+  if (stream.status() != QDataStream::Ok) {
+    qWarning() << "Ignoring corrupted desktop entry cache" << file.fileName();
+    m_parseCache.clear();
+  }
+}
+
+void XdgAppDatabase::saveParseCache() const {
+  auto cachePath = parseCachePath();
+  std::error_code ec;
+
+  fs::create_directories(cachePath.parent_path(), ec);
+
+  QSaveFile file(QString(cachePath.c_str()));
+
+  if (!file.open(QIODevice::WriteOnly)) {
+    qWarning() << "Failed to open desktop entry cache for writing" << file.errorString();
+    return;
+  }
+
+  QDataStream stream(&file);
+  auto locale = QByteArray::fromStdString(XdgDesktopEntry::messagesLocale());
+
+  stream.setVersion(QDataStream::Qt_6_0);
+  stream << PARSE_CACHE_MAGIC << PARSE_CACHE_VERSION << locale << static_cast<quint32>(m_files.size());
+
+  for (const auto &[path, state] : m_files) {
+    stream << QString::fromStdString(path) << static_cast<qint64>(state.mtime)
+           << static_cast<quint64>(state.inode) << static_cast<qint64>(state.size) << bool(state.app);
+    if (state.app) stream << state.app->xdgData();
+  }
+
+  if (!file.commit()) { qWarning() << "Failed to save desktop entry cache" << file.errorString(); }
 }
 
-XdgAppDatabase::XdgAppDatabase() { scan(defaultSearchPaths()); }
+XdgAppDatabase::XdgAppDatabase() {
+  loadParseCache();
+  scan(defaultSearchPaths());
+}
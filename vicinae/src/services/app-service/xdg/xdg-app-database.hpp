@@ -7,6 +7,7 @@
 #include <qmimedatabase.h>
 #include <qmimetype.h>
 #include <qprocess.h>
+#include <sys/types.h>
 #include <set>
 #include <ranges>
 
@@ -75,6 +76,31 @@ public:
 };
 
 class XdgAppDatabase : public AbstractAppDatabase {
+  /**
+   * What we know about a desktop file that was indexed during the last scan.
+   * A file is only parsed again if its mtime, inode or size changed.
+   */
+  struct DesktopFileState {
+    int64_t mtime = 0;
+    ino_t inode = 0;
+    off_t size = 0;
+    // null if the entry is hidden or could not be parsed
+    std::shared_ptr<XdgApplication> app;
+
+    bool operator==(const DesktopFileState &rhs) const {
+      return mtime == rhs.mtime && inode == rhs.inode && size == rhs.size;
+    }
+  };
+
+  /**
+   * An operation from a mimeapps.list file, replayed in order on top of the associations
+   * declared by the desktop files. `value` is cleared if `add` is false.
+   */
+  struct AssociationOp {
+    bool add;
+    QString value;
+  };
+
   std::vector<QDir> paths;
   std::unordered_map<QString, std::shared_ptr<Application>> appMap;
   std::unordered_map<QString, std::set<QString>> mimeToApps;
@@ -83,13 +109,44 @@ class XdgAppDatabase : public AbstractAppDatabase {
   QMimeDatabase mimeDb;
   std::vector<std::shared_ptr<XdgApplication>> apps;
 
+  std::unordered_map<std::string, DesktopFileState> m_files;
+  std::vector<std::pair<std::string, int64_t>> m_mimeAppsFiles;
+  std::unordered_map<QString, std::set<QString>> m_desktopMimeToApps;
+  std::unordered_map<QString, std::set<QString>> m_desktopAppToMimes;
+  std::unordered_map<QString, std::vector<AssociationOp>> m_mimeOverlay;
+  std::unordered_map<QString, std::vector<AssociationOp>> m_appOverlay;
+  bool m_lastScanChanged = true;
+  ScanDelta m_lastScanDelta;
+
+  /**
+   * Desktop files parsed by a previous run, loaded from disk on construction so that the first
+   * scan only needs to parse the files that changed since. Left empty after the first scan.
+   */
+  std::unordered_map<std::string, DesktopFileState> m_parseCache;
+
   std::shared_ptr<Application> defaultForMime(const QString &mime) const;
-  bool addDesktopFile(const QString &path);
+  std::shared_ptr<XdgApplication> parseDesktopFile(const QString &path) const;
+  static std::optional<DesktopFileState> statFile(const std::filesystem::path &path);
+  static std::filesystem::path parseCachePath();
+  void loadParseCache();
+  void saveParseCache() const;
+
+  void indexApp(const std::shared_ptr<XdgApplication> &app, std::set<QString> &mimes);
+  void unindexApp(const std::shared_ptr<XdgApplication> &app, std::set<QString> &mimes);
+  bool scanMimeApps();
+  void recomputeMime(const QString &mime);
+  void recomputeApp(const QString &appId);
 
   AppPtr findBestTerminalEmulator() const;
 
 public:
+  /**
+   * Scanning is incremental: only desktop files that were added, removed or modified since the last
+   * scan are parsed, and only the mime associations they affect are recomputed.
+   */
   bool scan(const std::vector<std::filesystem::path> &paths) override;
+  bool lastScanChanged() const override { return m_lastScanChanged; }
+  std::optional<ScanDelta> lastScanDelta() const override { return m_lastScanDelta; }
   std::vector<std::filesystem::path> defaultSearchPaths() const override;
   AppPtr findByClass(const QString &name) const override;
   AppPtr findBestOpener(const QString &target) const override;
@@ -1,5 +1,6 @@
 #include "calculator-service.hpp"
 #include "crypto.hpp"
+#include "daemon/startup-profiler.hpp"
 #include "omni-database.hpp"
 #include "services/calculator-service/abstract-calculator-backend.hpp"
 #include "services/calculator-service/calculator-service.hpp"
@@ -9,12 +10,13 @@
 #include <qnamespace.h>
 #include <qobjectdefs.h>
 #include <qsqlquery.h>
+#include <QtConcurrent/QtConcurrent>
 #include "services/calculator-service/qalculate/qalculate-backend.hpp"
 
 using CalculatorRecord = CalculatorService::CalculatorRecord;
 
-std::vector<CalculatorService::CalculatorRecord> CalculatorService::loadAll() const {
-  QSqlQuery query = m_db.createQuery();
+std::vector<CalculatorService::CalculatorRecord> CalculatorService::loadAll(QSqlDatabase db) {
+  QSqlQuery query(db);
 
   query.prepare(R"(
 		SELECT
@@ -50,7 +52,16 @@ std::vector<CalculatorService::CalculatorRecord> CalculatorService::loadAll() co
   return records;
 }
 
-std::vector<CalculatorRecord> CalculatorService::records() const { return m_records; }
+std::vector<CalculatorRecord> &CalculatorService::history() const {
+  if (m_pendingRecords.isValid()) {
+    m_records = m_pendingRecords.takeResult();
+    m_pendingRecords = {};
+  }
+
+  return m_records;
+}
+
+std::vector<CalculatorRecord> CalculatorService::records() const { return history(); }
 
 std::vector<CalculatorRecord> CalculatorService::query(const QString &query) {
   /**
@@ -138,7 +149,14 @@ CalculatorService::groupRecordsByTime(const std::vector<CalculatorRecord> &recor
   return groups;
 }
 
-AbstractCalculatorBackend *CalculatorService::backend() const { return m_backend.get(); }
+AbstractCalculatorBackend *CalculatorService::backend() const {
+  if (m_pendingBackend.isValid()) {
+    m_backend = m_pendingBackend.takeResult();
+    m_pendingBackend = {};
+  }
+
+  return m_backend.get();
+}
 
 bool CalculatorService::addRecord(const AbstractCalculatorBackend::CalculatorResult &result) {
   QSqlQuery query = m_db.createQuery();
@@ -165,13 +183,14 @@ bool CalculatorService::addRecord(const AbstractCalculatorBackend::CalculatorRes
   record.typeHint = result.type;
   record.createdAt = QDateTime::currentDateTime();
 
-  auto it = m_records.begin();
+  auto &records = history();
+  auto it = records.begin();
 
-  while (it != m_records.end() && it->pinnedAt) {
+  while (it != records.end() && it->pinnedAt) {
     ++it;
   }
 
-  m_records.insert(it, record);
+  records.insert(it, record);
 
   return true;
 }
@@ -187,12 +206,13 @@ bool CalculatorService::pinRecord(const QString &id) {
     return false;
   }
 
-  auto currentPos = std::ranges::find_if(m_records, [&](auto &&rec) { return rec.id == id; });
+  auto &records = history();
+  auto currentPos = std::ranges::find_if(records, [&](auto &&rec) { return rec.id == id; });
   auto record = *currentPos;
 
   record.pinnedAt = QDateTime::currentDateTime();
-  m_records.erase(currentPos);
-  m_records.insert(m_records.begin(), record);
+  records.erase(currentPos);
+  records.insert(records.begin(), record);
   emit recordPinned(id);
 
   return true;
@@ -209,22 +229,23 @@ bool CalculatorService::unpinRecord(const QString &id) {
     return false;
   }
 
-  auto currentPos = std::ranges::find_if(m_records, [&](auto &&rec) { return rec.id == id; });
+  auto &records = history();
+  auto currentPos = std::ranges::find_if(records, [&](auto &&rec) { return rec.id == id; });
   auto record = *currentPos;
 
-  auto newPos = m_records.begin();
+  auto newPos = records.begin();
 
-  while (newPos != m_records.end() && newPos->pinnedAt) {
+  while (newPos != records.end() && newPos->pinnedAt) {
     ++newPos;
   }
 
-  while (newPos != m_records.end() && newPos->createdAt > currentPos->createdAt) {
+  while (newPos != records.end() && newPos->createdAt > currentPos->createdAt) {
     ++newPos;
   }
 
-  m_records.erase(currentPos);
+  records.erase(currentPos);
   record.pinnedAt = std::nullopt;
-  m_records.insert(newPos, record);
+  records.insert(newPos, record);
 
   emit recordUnpinned(id);
 
@@ -242,9 +263,10 @@ bool CalculatorService::removeRecord(const QString &id) {
     return false;
   }
 
-  auto it = std::ranges::find_if(m_records, [&](auto &&rec) { return rec.id == id; });
+  auto &records = history();
+  auto it = std::ranges::find_if(records, [&](auto &&rec) { return rec.id == id; });
 
-  if (it != m_records.end()) m_records.erase(it);
+  if (it != records.end()) records.erase(it);
 
   emit recordRemoved(id);
 
@@ -256,7 +278,7 @@ void CalculatorService::setUpdateConversionsAfterRateUpdate(bool value) {
 }
 
 bool CalculatorService::refreshExchangeRates() {
-  if (!m_backend->reloadExchangeRates()) { return false; }
+  if (!backend()->reloadExchangeRates()) { return false; }
   if (m_updateConversionsAfterRateUpdate) { updateConversionRecords(); }
 
   return true;
@@ -287,8 +309,8 @@ void CalculatorService::updateConversionRecords() {
     return record.typeHint == AbstractCalculatorBackend::CONVERSION;
   };
 
-  for (auto &record : m_records | std::views::filter(isConversionRecord)) {
-    auto result = m_backend->compute(record.question);
+  for (auto &record : history() | std::views::filter(isConversionRecord)) {
+    auto result = backend()->compute(record.question);
 
     if (!result) continue;
 
@@ -311,10 +333,35 @@ void CalculatorService::updateConversionRecords() {
 }
 
 CalculatorService::CalculatorService(OmniDatabase &db) : m_db(db) {
-  m_records = loadAll();
-  /**
-   * We are doing proper backend abstraction, but for now it is not planned to add alternative backends.
-   * libqalculate is very complete and will probably support most of our future needs.
-   */
-  m_backend = std::make_unique<QalculateBackend>();
+  QString connectionName = m_db.db().connectionName();
+
+  m_pendingRecords = QtConcurrent::run([connectionName]() {
+    auto phase = StartupProfiler::instance()->phase("calculator-history");
+    // a connection can only be used from the thread that created it
+    QString workerConnection = connectionName + "-calculator-history";
+    std::vector<CalculatorRecord> records;
+
+    {
+      auto db = QSqlDatabase::cloneDatabase(connectionName, workerConnection);
+
+      if (db.open()) {
+        records = loadAll(db);
+      } else {
+        qCritical() << "Failed to open database to load calculator history" << db.lastError();
+      }
+    }
+
+    QSqlDatabase::removeDatabase(workerConnection);
+
+    return records;
+  });
+
+  m_pendingBackend = QtConcurrent::run([]() -> std::unique_ptr<AbstractCalculatorBackend> {
+    auto phase = StartupProfiler::instance()->phase("calculator-backend");
+    /**
+     * We are doing proper backend abstraction, but for now it is not planned to add alternative backends.
+     * libqalculate is very complete and will probably support most of our future needs.
+     */
+    return std::make_unique<QalculateBackend>();
+  });
 }
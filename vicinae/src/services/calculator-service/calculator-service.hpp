@@ -2,7 +2,9 @@
 #include "omni-database.hpp"
 #include "services/calculator-service/abstract-calculator-backend.hpp"
 #include <qdatetime.h>
+#include <qfuture.h>
 #include <qobject.h>
+#include <qsqldatabase.h>
 #include <qtmetamacros.h>
 
 /**
@@ -37,12 +39,26 @@ public:
 
 private:
   OmniDatabase &m_db;
-  std::vector<CalculatorRecord> m_records;
-  std::unique_ptr<AbstractCalculatorBackend> m_backend;
-  std::vector<CalculatorRecord> loadAll() const;
   bool m_updateConversionsAfterRateUpdate = true;
 
+  // both are loaded on worker threads when the service is created, see `history` and `backend`
+  mutable std::vector<CalculatorRecord> m_records;
+  mutable QFuture<std::vector<CalculatorRecord>> m_pendingRecords;
+  mutable std::unique_ptr<AbstractCalculatorBackend> m_backend;
+  mutable QFuture<std::unique_ptr<AbstractCalculatorBackend>> m_pendingBackend;
+
+  static std::vector<CalculatorRecord> loadAll(QSqlDatabase db);
+
+  /**
+   * In memory list of records, waiting for the initial load to complete if needed.
+   */
+  std::vector<CalculatorRecord> &history() const;
+
 public:
+  /**
+   * Loading the backend can take a while (libqalculate loads its unit and currency definitions),
+   * so this blocks until it's ready if it's called right after startup.
+   */
   AbstractCalculatorBackend *backend() const;
 
   void setUpdateConversionsAfterRateUpdate(bool value);
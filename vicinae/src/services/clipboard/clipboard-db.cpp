@@ -1,5 +1,6 @@
 #include "clipboard-db.hpp"
 #include "crypto.hpp"
+#include "utils/cancellation-token/cancellation-token.hpp"
 #include "utils/migration-manager/migration-manager.hpp"
 #include "vicinae.hpp"
 #include <qlogging.h>
@@ -36,10 +37,12 @@ std::optional<ClipboardSelectionRecord> ClipboardDatabase::findSelection(const Q
   return selection;
 }
 
-PaginatedResponse<ClipboardHistoryEntry> ClipboardDatabase::listAll(int limit, int offset,
-                                                                    const ClipboardListSettings &opts) const {
+PaginatedResponse<ClipboardHistoryEntry>
+ClipboardDatabase::listAll(int limit, int offset, const ClipboardListSettings &opts,
+                           const CancellationToken &cancellation) const {
 
   QSqlQuery query(m_db);
+  SqliteCancellationScope cancellationScope(m_db, cancellation);
 
   if (!query.exec("SELECT COUNT(*) FROM selection;") || !query.next()) { return {}; }
 
@@ -90,11 +93,14 @@ PaginatedResponse<ClipboardHistoryEntry> ClipboardDatabase::listAll(int limit, i
   if (opts.kind) { query.bindValue(":kind", static_cast<quint8>(*opts.kind)); }
 
   if (!query.exec()) {
+    if (cancellation.isCancelled()) return {};
     qWarning() << "Failed to list all clipboard items" << query.lastError();
     return {};
   }
 
   while (query.next()) {
+    if (cancellation.isCancelled()) return {};
+
     auto sum = query.value(4).toString();
     ClipboardHistoryEntry dto{
         .id = query.value(0).toString(),
@@ -154,7 +160,7 @@ bool ClipboardDatabase::removeAll() {
   return query.exec("DELETE FROM selection");
 }
 
-std::vector<QString> ClipboardDatabase::removeSelection(const QString &selectionId) {
+std::vector<RemovedClipboardOfferRecord> ClipboardDatabase::removeSelection(const QString &selectionId) {
   if (!m_db.transaction()) { return {}; }
 
   QSqlQuery query(m_db);
@@ -164,7 +170,7 @@ std::vector<QString> ClipboardDatabase::removeSelection(const QString &selection
 		data_offer
 	WHERE 
 		selection_id = :selection_id
-	RETURNING id
+	RETURNING id, content_hash_md5
   )");
   query.bindValue(":selection_id", selectionId);
 
@@ -174,10 +180,11 @@ std::vector<QString> ClipboardDatabase::removeSelection(const QString &selection
     return {};
   }
 
-  std::vector<QString> deletedOffers;
+  std::vector<RemovedClipboardOfferRecord> deletedOffers;
 
   while (query.next()) {
-    deletedOffers.emplace_back(query.value(0).toString());
+    deletedOffers.emplace_back(
+        RemovedClipboardOfferRecord{.id = query.value(0).toString(), .md5sum = query.value(1).toString()});
   }
 
   query.prepare("DELETE FROM selection WHERE id = :selection_id");
@@ -194,6 +201,21 @@ std::vector<QString> ClipboardDatabase::removeSelection(const QString &selection
   return deletedOffers;
 }
 
+bool ClipboardDatabase::hasContentHash(const QString &md5sum) {
+  QSqlQuery query(m_db);
+
+  query.prepare("SELECT 1 FROM data_offer WHERE content_hash_md5 = :hash LIMIT 1");
+  query.bindValue(":hash", md5sum);
+
+  if (!query.exec()) {
+    qWarning() << "Failed to look up content hash" << query.lastError();
+    // assume it's still used, so that we don't remove anything we shouldn't
+    return true;
+  }
+
+  return query.next();
+}
+
 std::optional<PreferredClipboardOfferRecord>
 ClipboardDatabase::findPreferredOffer(const QString &selectionId) {
   QSqlQuery query(m_db);
@@ -222,6 +244,35 @@ ClipboardDatabase::findPreferredOffer(const QString &selectionId) {
   return PreferredClipboardOfferRecord{.id = id, .encryption = encryption};
 }
 
+std::vector<ClipboardImageOfferRecord> ClipboardDatabase::listImageOffers() {
+  QSqlQuery query(m_db);
+
+  query.prepare(R"(
+		SELECT o.id, o.content_hash_md5, o.encryption_type FROM data_offer o
+		JOIN selection s ON s.id = o.selection_id
+		WHERE o.mime_type = s.preferred_mime_type
+		AND s.kind = :kind
+	)");
+  query.bindValue(":kind", static_cast<quint8>(ClipboardOfferKind::Image));
+
+  if (!query.exec()) {
+    qCritical() << "Failed to list image offers" << query.lastError();
+    return {};
+  }
+
+  std::vector<ClipboardImageOfferRecord> records;
+
+  while (query.next()) {
+    records.emplace_back(ClipboardImageOfferRecord{
+        .id = query.value(0).toString(),
+        .md5sum = query.value(1).toString(),
+        .encryption = static_cast<ClipboardEncryptionType>(query.value(2).toUInt()),
+    });
+  }
+
+  return records;
+}
+
 bool ClipboardDatabase::setPinned(const QString &id, bool pinned) {
   QSqlQuery query(m_db);
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "common.hpp"
+#include "utils/cancellation-token/cancellation-token.hpp"
 #include <qsqldatabase.h>
 #include <qvariant.h>
 
@@ -74,6 +75,17 @@ struct ClipboardSelectionRecord {
   std::vector<ClipboardSelectionOfferRecord> offers;
 };
 
+struct RemovedClipboardOfferRecord {
+  QString id;
+  QString md5sum;
+};
+
+struct ClipboardImageOfferRecord {
+  QString id;
+  QString md5sum;
+  ClipboardEncryptionType encryption;
+};
+
 class ClipboardDatabase {
   QSqlDatabase m_db;
 
@@ -84,8 +96,12 @@ public:
 
   std::optional<ClipboardSelectionRecord> findSelection(const QString &id);
 
+  /**
+   * An empty response is returned if `cancellation` is cancelled while the query runs.
+   */
   PaginatedResponse<ClipboardHistoryEntry> listAll(int limit = 100, int offset = 0,
-                                                   const ClipboardListSettings &opts = {}) const;
+                                                   const ClipboardListSettings &opts = {},
+                                                   const CancellationToken &cancellation = {}) const;
 
   bool removeAll();
 
@@ -106,9 +122,19 @@ public:
    * Remove the selection from the database and return the list of offers
    * that were deleted with it.
    */
-  std::vector<QString> removeSelection(const QString &selectionId);
+  std::vector<RemovedClipboardOfferRecord> removeSelection(const QString &selectionId);
+
+  /**
+   * Whether any offer still holds content with this hash.
+   */
+  bool hasContentHash(const QString &md5sum);
   std::optional<PreferredClipboardOfferRecord> findPreferredOffer(const QString &selectionId);
 
+  /**
+   * Preferred offer of every image selection.
+   */
+  std::vector<ClipboardImageOfferRecord> listImageOffers();
+
   /**
    * Apply new migrations if any. If no new migration is available this is a no-op.
    */
@@ -12,12 +12,14 @@
 #include <QImage>
 #include "clipboard-server-factory.hpp"
 #include "crypto.hpp"
+#include "daemon/perf-metrics.hpp"
 #include "services/app-service/app-service.hpp"
 #include "services/clipboard/clipboard-db.hpp"
 #include "wlr/wlr-clipboard-server.hpp"
 #include "gnome/gnome-clipboard-server.hpp"
 #include "services/window-manager/abstract-window-manager.hpp"
 #include "services/window-manager/window-manager.hpp"
+#include "ui/image/thumbnail-cache.hpp"
 
 namespace fs = std::filesystem;
 
@@ -117,6 +119,8 @@ bool ClipboardService::pasteContent(const Clipboard::Content &content, const Cli
   auto window = m_wm.getFocusedWindow();
   KeyboardShortcut shortcut = KeyboardShortcut::paste();
 
+  if (!window) return false;
+
   if (auto app = m_appDb.find(window->wmClass())) {
     if (app->isTerminalEmulator()) { shortcut = KeyboardShortcut::shiftPaste(); }
   }
@@ -174,9 +178,14 @@ bool ClipboardService::copyText(const QString &text, const Clipboard::CopyOption
 }
 
 QFuture<PaginatedResponse<ClipboardHistoryEntry>>
-ClipboardService::listAll(int limit, int offset, const ClipboardListSettings &opts) const {
-  return QtConcurrent::run(
-      [opts, limit, offset]() { return ClipboardDatabase().listAll(limit, offset, opts); });
+ClipboardService::listAll(int limit, int offset, const ClipboardListSettings &opts,
+                          const CancellationToken &cancellation) const {
+  return QtConcurrent::run([opts, limit, offset, cancellation]() -> PaginatedResponse<ClipboardHistoryEntry> {
+    // superseded while it was waiting for a thread
+    if (cancellation.isCancelled()) return {};
+
+    return ClipboardDatabase().listAll(limit, offset, opts, cancellation);
+  });
 }
 
 ClipboardOfferKind ClipboardService::getKind(const ClipboardDataOffer &offer) {
@@ -240,7 +249,12 @@ bool ClipboardService::removeSelection(const QString &selectionId) {
   ClipboardDatabase cdb;
 
   for (const auto &offer : cdb.removeSelection(selectionId)) {
-    fs::remove(m_dataDir / offer.toStdString());
+    fs::remove(m_dataDir / offer.id.toStdString());
+
+    // the same content may still be referenced by another selection
+    if (!offer.md5sum.isEmpty() && !cdb.hasContentHash(offer.md5sum)) {
+      ThumbnailCache::removeContentThumbnail(offer.md5sum);
+    }
   }
 
   emit selectionRemoved(selectionId);
@@ -350,6 +364,10 @@ void ClipboardService::saveSelection(ClipboardSelection selection) {
     return;
   }
 
+  static auto &ingestLatency = PerfMetrics::instance()->histogram("clipboard-ingest");
+  static auto &writeLatency = PerfMetrics::instance()->histogram("clipboard-db-write");
+  static auto &duplicates = PerfMetrics::instance()->counter("clipboard-duplicate-selections");
+  auto timer = ingestLatency.time();
   auto selectionHash = QString::fromUtf8(computeSelectionHash(selection).toHex());
   QString preferredMimeType = getSelectionPreferredMimeType(selection);
 
@@ -359,8 +377,13 @@ void ClipboardService::saveSelection(ClipboardSelection selection) {
   auto preferredOfferIt =
       std::ranges::find_if(selection.offers, [&](auto &&o) { return o.mimeType == preferredMimeType; });
 
+  auto writeTimer = writeLatency.time();
+
   cdb.transaction([&](ClipboardDatabase &db) {
-    if (db.tryBubbleUpSelection(selectionHash)) return true;
+    if (db.tryBubbleUpSelection(selectionHash)) {
+      duplicates.increment();
+      return true;
+    }
 
     QString selectionId = Crypto::UUID::v4();
     ClipboardOfferKind kind = getKind(*preferredOfferIt);
@@ -421,6 +444,12 @@ void ClipboardService::saveSelection(ClipboardSelection selection) {
 
       // Set the insertedEntry for the preferred offer
       if (offer.mimeType == preferredMimeType) {
+        if (kind == ClipboardOfferKind::Image) {
+          QThreadPool::globalInstance()->start([data = offer.data, hash = QString::fromUtf8(md5sum)]() {
+            ThumbnailCache::contentThumbnail(hash, ThumbnailCache::Flavor::Normal, data);
+          });
+        }
+
         insertedEntry.id = selectionId;
         insertedEntry.pinnedAt = 0;
         insertedEntry.updatedAt = {};
@@ -433,6 +462,8 @@ void ClipboardService::saveSelection(ClipboardSelection selection) {
     return true;
   });
 
+  writeTimer.finish();
+  timer.finish();
   emit itemInserted(insertedEntry);
 }
 
@@ -513,12 +544,33 @@ bool ClipboardService::removeAllSelections() {
 
   fs::remove_all(m_dataDir);
   fs::create_directories(m_dataDir);
+  ThumbnailCache::removeContentThumbnails();
 
   emit allSelectionsRemoved();
 
   return true;
 }
 
+void ClipboardService::backfillThumbnails() {
+  QThreadPool::globalInstance()->start([this, offers = ClipboardDatabase().listImageOffers()]() {
+    for (const auto &offer : offers) {
+      auto thumbnail = ThumbnailCache::contentThumbnailPath(offer.md5sum, ThumbnailCache::Flavor::Normal);
+
+      if (fs::exists(thumbnail)) continue;
+
+      QFile file(m_dataDir / offer.id.toStdString());
+
+      if (!file.open(QIODevice::ReadOnly)) continue;
+
+      auto data = decryptOffer(file.readAll(), offer.encryption);
+
+      if (data.isEmpty()) continue;
+
+      ThumbnailCache::contentThumbnail(offer.md5sum, ThumbnailCache::Flavor::Normal, data);
+    }
+  });
+}
+
 AbstractClipboardServer *ClipboardService::clipboardServer() const { return m_clipboardServer.get(); }
 
 ClipboardService::ClipboardService(const std::filesystem::path &path, WindowManager &wm, AppService &app)
@@ -554,6 +606,7 @@ ClipboardService::ClipboardService(const std::filesystem::path &path, WindowMana
 
     if (res) { m_localEncryptionKey = res.value(); }
     m_isEncryptionReady = true; // at that point, we know whether we can encrypt or not
+    backfillThumbnails();
   });
 
   connect(m_clipboardServer.get(), &AbstractClipboardServer::selectionAdded, this,
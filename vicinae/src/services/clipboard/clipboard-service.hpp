@@ -93,6 +93,12 @@ private:
 
   static ClipboardOfferKind getKind(const ClipboardDataOffer &offer);
 
+  /**
+   * Generate the thumbnails missing for images saved before thumbnails were written
+   * with the selection. Needs the encryption key to be resolved.
+   */
+  void backfillThumbnails();
+
 public:
   ClipboardService(const std::filesystem::path &path, WindowManager &wm, AppService &app);
 
@@ -106,7 +112,8 @@ public:
   bool removeSelection(const QString &id);
   bool setPinned(const QString id, bool pinned);
   QFuture<PaginatedResponse<ClipboardHistoryEntry>> listAll(int limit = 100, int offset = 0,
-                                                            const ClipboardListSettings &opts = {}) const;
+                                                            const ClipboardListSettings &opts = {},
+                                                            const CancellationToken &cancellation = {}) const;
   bool copyText(const QString &text, const Clipboard::CopyOptions &options = {.concealed = true});
   bool copyHtml(const Clipboard::Html &data, const Clipboard::CopyOptions &options = {.concealed = false});
   bool copyFile(const std::filesystem::path &path,
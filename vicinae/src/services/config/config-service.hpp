@@ -34,6 +34,8 @@ public:
     } window;
     struct {
       bool searchFiles;
+      bool searchClipboard;
+      bool searchEmojis;
     } rootSearch;
     struct {
       std::optional<QString> normal;
@@ -80,6 +82,8 @@ private:
       auto rootSearch = obj.value("rootSearch").toObject();
 
       cfg.rootSearch.searchFiles = rootSearch.value("searchFiles").toBool(true);
+      cfg.rootSearch.searchClipboard = rootSearch.value("searchClipboard").toBool(false);
+      cfg.rootSearch.searchEmojis = rootSearch.value("searchEmojis").toBool(true);
     }
 
     {
@@ -158,6 +162,8 @@ public:
       QJsonObject rootSearch;
 
       rootSearch["searchFiles"] = value.rootSearch.searchFiles;
+      rootSearch["searchClipboard"] = value.rootSearch.searchClipboard;
+      rootSearch["searchEmojis"] = value.rootSearch.searchEmojis;
       obj["rootSearch"] = rootSearch;
     }
 
@@ -1,61 +1,119 @@
 #include "emoji-service.hpp"
+#include "daemon/startup-profiler.hpp"
 #include "omni-database.hpp"
 #include "services/emoji-service/emoji.hpp"
+#include <algorithm>
 #include <cstdlib>
 #include <qcontainerfwd.h>
 #include <qlogging.h>
 #include "utils/utils.hpp"
 #include <qsqlquery.h>
+#include <ranges>
+#include <QtConcurrent/QtConcurrent>
 
-void EmojiService::buildIndex() {
-  std::unordered_map<std::string_view, QString> keywordMap;
-
-  for (const auto &visited : getVisited()) {
-    if (!visited.keywords.isEmpty()) { keywordMap.insert({visited.data->emoji, visited.keywords}); }
-  }
+EmojiService::EmojiIndex
+EmojiService::buildIndex(const std::unordered_map<std::string_view, QString> &customKeywords) {
+  auto phase = StartupProfiler::instance()->phase("emoji-index");
+  EmojiIndex index;
 
   for (const auto &emoji : StaticEmojiDatabase::orderedList()) {
-    if (auto it = keywordMap.find(emoji.emoji); it != keywordMap.end()) {
-      m_index.indexLatinText(it->second.toStdString(), &emoji);
+    if (auto it = customKeywords.find(emoji.emoji); it != customKeywords.end()) {
+      index.indexLatinText(it->second.toStdString(), &emoji);
     }
 
     for (const auto &keyword : emoji.keywords) {
-      m_index.indexLatinText(keyword, &emoji);
+      index.indexLatinText(keyword, &emoji);
     }
   }
+
+  return index;
+}
+
+EmojiService::EmojiIndex &EmojiService::index() const {
+  if (m_pendingIndex.isValid()) {
+    m_index = m_pendingIndex.takeResult();
+    m_pendingIndex = {};
+  }
+
+  return m_index;
 }
 
 std::vector<const EmojiData *> EmojiService::search(std::string_view query) const {
-  return m_index.prefixSearch(query);
+  return index().prefixSearch(query);
 }
 
-void EmojiService::createDbEntry(std::string_view emoji) {
+void EmojiService::loadRecords() {
   QSqlQuery query = m_db.createQuery();
+  const auto &mapping = StaticEmojiDatabase::mapping();
+
+  if (!query.exec(
+          "SELECT emoji, visit_count, last_visited_at, pinned_at, custom_keywords FROM visited_emoji")) {
+    qCritical() << "Failed to load visited emojis" << query.lastError();
+    return;
+  }
 
-  query.prepare("INSERT INTO visited_emoji (emoji) VALUES (:emoji) ON CONFLICT(emoji) DO NOTHING");
-  query.addBindValue(QString::fromUtf8(emoji.data(), emoji.size()));
+  while (query.next()) {
+    auto emoji = query.value(0).toString();
+    auto it = mapping.find(emoji.toStdString());
 
-  if (!query.exec()) { qCritical() << "Failed to create database entry for emoji" << query.lastError(); }
+    if (it == mapping.end()) {
+      qWarning() << "Emoji is not in the mapping" << emoji;
+      continue;
+    }
+
+    VisitRecord record;
+
+    record.visitCount = query.value(1).toUInt();
+    if (auto value = query.value(2); !value.isNull()) record.lastVisitedAt = value.toLongLong();
+    if (auto value = query.value(3); !value.isNull()) record.pinnedAt = value.toLongLong();
+    record.keywords = query.value(4).toString();
+    m_records[it->second->emoji] = record;
+  }
+}
+
+void EmojiService::queueUpsert(std::string_view emoji,
+                               const std::vector<std::pair<QString, QVariant>> &columns, const QString &key) {
+  QStringList names, placeholders, assignments;
+  SqlWriteQueue::Statement statement;
+
+  statement.bindings.emplace_back(":emoji", qStringFromStdView(emoji));
+
+  for (const auto &[column, value] : columns) {
+    names << column;
+    placeholders << ":" + column;
+    assignments << QString("%1 = excluded.%1").arg(column);
+    statement.bindings.emplace_back(":" + column, value);
+  }
+
+  statement.sql = QString(R"(
+	INSERT INTO visited_emoji (emoji, %1) VALUES (:emoji, %2)
+	ON CONFLICT(emoji) DO UPDATE SET %3
+  )")
+                      .arg(names.join(", "))
+                      .arg(placeholders.join(", "))
+                      .arg(assignments.join(", "));
+
+  QString writeKey = key.isEmpty() ? QString() : key + qStringFromStdView(emoji);
+
+  m_db.writeQueue().enqueue(std::move(statement), writeKey);
 }
 
 bool EmojiService::registerVisit(std::string_view emoji) {
-  QSqlQuery query = m_db.createQuery();
+  auto it = StaticEmojiDatabase::mapping().find(emoji);
 
-  query.prepare(R"(
-  	INSERT INTO visited_emoji (emoji, visit_count, last_visited_at)
-	VALUES (:emoji, 1, (unixepoch()))
-	ON CONFLICT(emoji) DO UPDATE 
-	SET 
-		visit_count = visit_count + 1, 
-		last_visited_at = unixepoch()
-	)");
-  query.addBindValue(QString::fromUtf8(emoji.data(), emoji.size()));
-
-  if (!query.exec()) {
-    qCritical() << "Failed to register visit for emoji" << emoji << query.lastError();
+  if (it == StaticEmojiDatabase::mapping().end()) {
+    qCritical() << "Failed to register visit for unknown emoji" << emoji;
     return false;
   }
 
+  auto &record = m_records[it->second->emoji];
+
+  record.visitCount += 1;
+  record.lastVisitedAt = QDateTime::currentSecsSinceEpoch();
+
+  // the absolute count is written, so that coalesced visits don't lose increments
+  queueUpsert(emoji, {{"visit_count", record.visitCount}, {"last_visited_at", *record.lastVisitedAt}},
+              "visit:");
   emit visited(emoji);
 
   return true;
@@ -80,43 +138,42 @@ std::vector<std::pair<std::string_view, std::vector<const EmojiData *>>> EmojiSe
   return grouped;
 }
 
-std::vector<EmojiWithMetadata> EmojiService::getVisited() const {
-  QSqlQuery query = m_db.createQuery();
+EmojiWithMetadata EmojiService::withMetadata(const EmojiData *data, const VisitRecord &record) const {
+  EmojiWithMetadata result;
 
-  bool ok = query.exec(R"(
-	SELECT emoji, visit_count, pinned_at, custom_keywords FROM visited_emoji ORDER BY pinned_at DESC, visit_count DESC, last_visited_at DESC
-  )");
+  result.data = data;
+  result.visitCount = record.visitCount;
+  result.keywords = record.keywords;
 
-  if (!ok) {
-    qCritical() << "Failed to getVisited()" << query.lastError();
-    return {};
-  }
+  if (record.pinnedAt) { result.pinnedAt = QDateTime::fromSecsSinceEpoch(*record.pinnedAt); }
 
-  std::vector<EmojiWithMetadata> results;
-  const auto &mapping = StaticEmojiDatabase::mapping();
+  return result;
+}
 
-  while (query.next()) {
-    EmojiWithMetadata result;
-    auto emoji = query.value(0).toString();
-    auto it = mapping.find(emoji.toStdString());
+std::vector<EmojiWithMetadata> EmojiService::getVisited() const {
+  std::vector<std::pair<const EmojiData *, const VisitRecord *>> records;
+  const auto &mapping = StaticEmojiDatabase::mapping();
 
-    if (it == mapping.end()) {
-      qWarning() << "Emoji is not in the mapping" << emoji;
-      continue;
-    }
+  records.reserve(m_records.size());
 
-    result.data = it->second;
-    result.visitCount = query.value(1).toUInt();
-    result.keywords = query.value(3).toString();
+  for (const auto &[emoji, record] : m_records) {
+    if (auto it = mapping.find(emoji); it != mapping.end()) { records.emplace_back(it->second, &record); }
+  }
 
-    if (auto value = query.value(2); !value.isNull()) {
-      result.pinnedAt = QDateTime::fromSecsSinceEpoch(value.toULongLong());
-    }
+  // same order as `ORDER BY pinned_at DESC, visit_count DESC, last_visited_at DESC`, nulls last
+  std::ranges::sort(records, [](const auto &a, const auto &b) {
+    const VisitRecord &ra = *a.second;
+    const VisitRecord &rb = *b.second;
 
-    results.emplace_back(result);
-  }
+    if (ra.pinnedAt != rb.pinnedAt) return ra.pinnedAt > rb.pinnedAt;
+    if (ra.visitCount != rb.visitCount) return ra.visitCount > rb.visitCount;
+    return ra.lastVisitedAt > rb.lastVisitedAt;
+  });
 
-  return results;
+  return records | std::views::transform([this](const auto &pair) {
+           return withMetadata(pair.first, *pair.second);
+         }) |
+         std::ranges::to<std::vector>();
 }
 
 std::vector<EmojiWithMetadata> EmojiService::mapMetadata(const std::vector<const EmojiData *> &items) {
@@ -144,114 +201,91 @@ std::vector<EmojiWithMetadata> EmojiService::mapMetadata(const std::vector<const
 }
 
 EmojiWithMetadata EmojiService::mapMetadata(std::string_view emoji) {
-  QSqlQuery query = m_db.createQuery();
   auto it = StaticEmojiDatabase::mapping().find(emoji);
 
   if (it == StaticEmojiDatabase::mapping().end()) { return {}; }
 
-  query.prepare("SELECT visit_count, pinned_at, custom_keywords FROM visited_emoji WHERE emoji = :emoji");
-  query.addBindValue(qStringFromStdView(emoji));
-
-  if (!query.exec()) {
-    qCritical() << "Failed to map metadata for" << emoji << query.lastError();
-    return {.data = it->second};
+  if (auto record = m_records.find(it->second->emoji); record != m_records.end()) {
+    return withMetadata(it->second, record->second);
   }
 
-  if (!query.next()) { return EmojiWithMetadata{.data = it->second}; }
-
-  EmojiWithMetadata result;
-
-  result.data = it->second;
-  result.visitCount = query.value(0).toUInt();
-  result.keywords = query.value(2).toString();
-
-  if (auto value = query.value(1); !value.isNull()) {
-    result.pinnedAt = QDateTime::fromSecsSinceEpoch(value.toULongLong());
-  }
-
-  return result;
+  return {.data = it->second};
 }
 
 bool EmojiService::setCustomKeywords(std::string_view emoji, const QString &keywords) {
-  QSqlQuery query = m_db.createQuery();
   auto oldMetadata = mapMetadata(emoji);
 
-  createDbEntry(emoji);
-
-  query.prepare("UPDATE visited_emoji SET custom_keywords = :keywords WHERE emoji = :emoji");
-  query.addBindValue(keywords);
-  query.addBindValue(qStringFromStdView(emoji));
-
-  if (!query.exec()) {
-    qCritical() << "Failed to setCustomKeywords for emoji" << emoji << query.lastError();
+  if (!oldMetadata.data) {
+    qCritical() << "Failed to setCustomKeywords for unknown emoji" << emoji;
     return false;
   }
 
-  qCritical() << "updated keywords for" << emoji;
+  m_records[oldMetadata.data->emoji].keywords = keywords;
+  queueUpsert(emoji, {{"custom_keywords", keywords}}, "keywords:");
 
   // hot reload index
 
-  if (oldMetadata.data && !oldMetadata.keywords.isEmpty()) {
-    m_index.removeLatinTextItem(oldMetadata.keywords.toStdString(), oldMetadata.data);
+  if (!oldMetadata.keywords.isEmpty()) {
+    index().removeLatinTextItem(oldMetadata.keywords.toStdString(), oldMetadata.data);
   }
 
-  m_index.indexLatinText(keywords.toStdString(), oldMetadata.data);
+  index().indexLatinText(keywords.toStdString(), oldMetadata.data);
 
   return true;
 }
 
 bool EmojiService::resetRanking(std::string_view emoji) {
-  createDbEntry(emoji);
-
-  QSqlQuery query = m_db.createQuery();
+  auto it = StaticEmojiDatabase::mapping().find(emoji);
 
-  query.prepare("UPDATE visited_emoji SET visit_count = 0, last_visited_at = NULL WHERE emoji = :emoji");
-  query.addBindValue(qStringFromStdView(emoji));
+  if (it == StaticEmojiDatabase::mapping().end()) return false;
 
-  if (!query.exec()) {
-    qCritical() << "Failed to reset ranking" << query.lastError();
-    return false;
-  }
+  auto &record = m_records[it->second->emoji];
 
+  record.visitCount = 0;
+  record.lastVisitedAt.reset();
+  queueUpsert(emoji, {{"visit_count", 0}, {"last_visited_at", QVariant()}}, "visit:");
   emit rankingReset(emoji);
 
   return true;
 }
 
 bool EmojiService::unpin(std::string_view emoji) {
-  createDbEntry(emoji);
-
-  QSqlQuery query = m_db.createQuery();
-
-  query.prepare("UPDATE visited_emoji SET pinned_at = NULL WHERE emoji = :emoji");
-  query.addBindValue(QString::fromUtf8(emoji.data(), emoji.size()));
+  auto it = StaticEmojiDatabase::mapping().find(emoji);
 
-  if (!query.exec()) {
-    qCritical() << "Failed to pin emoji" << emoji;
-    return false;
-  }
+  if (it == StaticEmojiDatabase::mapping().end()) return false;
 
+  m_records[it->second->emoji].pinnedAt.reset();
+  queueUpsert(emoji, {{"pinned_at", QVariant()}}, "pin:");
   emit unpinned(emoji);
 
   return true;
 }
 
 bool EmojiService::pin(std::string_view emoji) {
-  createDbEntry(emoji);
-
-  QSqlQuery query = m_db.createQuery();
+  auto it = StaticEmojiDatabase::mapping().find(emoji);
 
-  query.prepare("UPDATE visited_emoji SET pinned_at = unixepoch() WHERE emoji = :emoji");
-  query.addBindValue(QString::fromUtf8(emoji.data(), emoji.size()));
+  if (it == StaticEmojiDatabase::mapping().end()) return false;
 
-  if (!query.exec()) {
-    qCritical() << "Failed to pin emoji" << emoji;
-    return false;
-  }
+  auto &record = m_records[it->second->emoji];
 
+  record.pinnedAt = QDateTime::currentSecsSinceEpoch();
+  queueUpsert(emoji, {{"pinned_at", *record.pinnedAt}}, "pin:");
   emit pinned(emoji);
 
   return true;
 }
 
-EmojiService::EmojiService(OmniDatabase &db) : m_db(db) { buildIndex(); }
+EmojiService::EmojiService(OmniDatabase &db) : m_db(db) {
+  std::unordered_map<std::string_view, QString> customKeywords;
+
+  // the database can only be used from the thread that opened it, the rest is done on a worker thread
+  loadRecords();
+
+  for (const auto &[emoji, record] : m_records) {
+    if (!record.keywords.isEmpty()) { customKeywords.insert({emoji, record.keywords}); }
+  }
+
+  m_pendingIndex = QtConcurrent::run([customKeywords = std::move(customKeywords)]() {
+    return buildIndex(customKeywords);
+  });
+}
@@ -2,9 +2,11 @@
 #include "trie.hpp"
 #include "omni-database.hpp"
 #include "services/emoji-service/emoji.hpp"
+#include <qfuture.h>
 #include <qobject.h>
 #include <qtmetamacros.h>
 #include <string_view>
+#include <unordered_map>
 
 /**
  * Provides all emoji-related services. Also integrates with the local sqlite database to provide
@@ -26,18 +28,54 @@ struct EmojiWithMetadata {
 class EmojiService : public QObject {
   Q_OBJECT
 
-  Trie<const EmojiData *, EmojiDataHash> m_index;
+  using EmojiIndex = Trie<const EmojiData *, EmojiDataHash>;
+
+  struct VisitRecord {
+    uint32_t visitCount = 0;
+    std::optional<qint64> lastVisitedAt;
+    std::optional<qint64> pinnedAt;
+    QString keywords;
+  };
+
+  mutable EmojiIndex m_index;
+  mutable QFuture<EmojiIndex> m_pendingIndex;
   OmniDatabase &m_db;
 
-  void createDbEntry(std::string_view emoji);
+  /**
+   * In-memory copy of the `visited_emoji` table, loaded once. Writes update it right away and are then
+   * queued to the database, so reads never have to wait for them to be committed.
+   */
+  std::unordered_map<std::string_view, VisitRecord> m_records;
+
+  void loadRecords();
+  EmojiWithMetadata withMetadata(const EmojiData *data, const VisitRecord &record) const;
+
+  /**
+   * Queue an upsert of `columns` for `emoji`, creating the row if it doesn't exist yet.
+   */
+  void queueUpsert(std::string_view emoji, const std::vector<std::pair<QString, QVariant>> &columns,
+                   const QString &key = {});
 
-public:
   /**
-   * Synchronously build search index.
+   * Build the search index from the static emoji list, plus the custom keywords set by the user.
+   * This doesn't touch the database so that it can be called from a worker thread.
    */
-  void buildIndex();
+  static EmojiIndex buildIndex(const std::unordered_map<std::string_view, QString> &customKeywords);
+
+  /**
+   * The index is built on a worker thread when the service is created. If it's not ready yet,
+   * this blocks until it is.
+   */
+  EmojiIndex &index() const;
+
+public:
   std::vector<const EmojiData *> search(std::string_view query) const;
 
+  /**
+   * Whether the search index is built, in which case `search` returns without blocking.
+   */
+  bool isIndexReady() const { return !m_pendingIndex.isValid() || m_pendingIndex.isFinished(); }
+
   /**
    * List of emojis, ordered and grouped.
    */
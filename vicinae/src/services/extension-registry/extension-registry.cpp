@@ -1,31 +1,245 @@
 #include "extension-registry.hpp"
 #include "common.hpp"
+#include "daemon/startup-profiler.hpp"
 #include "services/local-storage/local-storage-service.hpp"
 #include "vicinae.hpp"
 #include <QJsonArray>
 #include "services/extension-registry/extension-registry.hpp"
 #include "utils/utils.hpp"
 #include "zip/unzip.hpp"
+#include <QtConcurrent/QtConcurrent>
 #include <filesystem>
 #include <qfilesystemwatcher.h>
+#include <qdatastream.h>
+#include <qfuturewatcher.h>
 #include <qjsonparseerror.h>
 #include <qlogging.h>
+#include <qsavefile.h>
+#include <qstandardpaths.h>
+#include <sys/stat.h>
 
 namespace fs = std::filesystem;
 
+static constexpr quint32 CATALOG_MAGIC = 0x56455843; // VEXC
+// to be bumped whenever the manifest format or the way it's parsed changes
+static constexpr quint32 CATALOG_VERSION = 1;
+static constexpr int SCAN_DEBOUNCE_MS = 100;
+
+static QDataStream &operator<<(QDataStream &stream, const CommandArgument &arg) {
+  stream << arg.name << static_cast<qint32>(arg.type) << arg.placeholder << arg.required
+         << arg.data.has_value();
+
+  if (arg.data) {
+    stream << static_cast<quint32>(arg.data->size());
+    for (const auto &option : *arg.data) {
+      stream << option.title << option.value;
+    }
+  }
+
+  return stream;
+}
+
+static QDataStream &operator>>(QDataStream &stream, CommandArgument &arg) {
+  qint32 type = 0;
+  bool hasData = false;
+
+  stream >> arg.name >> type >> arg.placeholder >> arg.required >> hasData;
+  arg.type = static_cast<CommandArgument::Type>(type);
+
+  if (hasData) {
+    quint32 count = 0;
+
+    stream >> count;
+    arg.data.emplace();
+
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+      CommandArgument::DropdownData option;
+
+      stream >> option.title >> option.value;
+      arg.data->emplace_back(option);
+    }
+  }
+
+  return stream;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const Preference &pref) {
+  auto data = pref.data();
+
+  stream << pref.name() << pref.title() << pref.description() << pref.placeholder() << pref.required()
+         << pref.defaultValue() << static_cast<quint32>(data.index());
+
+  if (auto checkbox = std::get_if<Preference::CheckboxData>(&data)) stream << checkbox->label;
+
+  if (auto dropdown = std::get_if<Preference::DropdownData>(&data)) {
+    stream << static_cast<quint32>(dropdown->options.size());
+    for (const auto &option : dropdown->options) {
+      stream << option.title << option.value;
+    }
+  }
+
+  return stream;
+}
+
+static QDataStream &operator>>(QDataStream &stream, Preference &pref) {
+  QString name, title, description, placeholder;
+  bool required = false;
+  QJsonValue defaultValue;
+  quint32 index = 0;
+
+  stream >> name >> title >> description >> placeholder >> required >> defaultValue >> index;
+  pref.setName(name);
+  pref.setTitle(title);
+  pref.setDescription(description);
+  pref.setPlaceholder(placeholder);
+  pref.setRequired(required);
+  pref.setDefaultValue(defaultValue);
+
+  switch (index) {
+  case 1:
+    pref.setData(Preference::TextData());
+    break;
+  case 2:
+    pref.setData(Preference::PasswordData());
+    break;
+  case 3: {
+    QString label;
+
+    stream >> label;
+    pref.setData(Preference::CheckboxData(label));
+    break;
+  }
+  case 4: {
+    quint32 count = 0;
+    std::vector<Preference::DropdownData::Option> options;
+
+    stream >> count;
+
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+      Preference::DropdownData::Option option;
+
+      stream >> option.title >> option.value;
+      options.emplace_back(option);
+    }
+
+    pref.setData(Preference::DropdownData{options});
+    break;
+  }
+  default:
+    break;
+  }
+
+  return stream;
+}
+
+template <typename T> static QDataStream &writeList(QDataStream &stream, const std::vector<T> &list) {
+  stream << static_cast<quint32>(list.size());
+  for (const auto &item : list) {
+    stream << item;
+  }
+  return stream;
+}
+
+template <typename T> static QDataStream &readList(QDataStream &stream, std::vector<T> &list) {
+  quint32 count = 0;
+
+  stream >> count;
+
+  for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+    T item;
+
+    stream >> item;
+    list.emplace_back(std::move(item));
+  }
+
+  return stream;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const ExtensionManifest::Command &cmd) {
+  stream << cmd.name << cmd.title << cmd.description << static_cast<qint32>(cmd.mode);
+  writeList(stream, cmd.preferences);
+  writeList(stream, cmd.arguments);
+
+  return stream << cmd.icon.has_value() << cmd.icon.value_or(QString())
+                << QString::fromStdString(cmd.entrypoint.string()) << cmd.defaultDisabled;
+}
+
+static QDataStream &operator>>(QDataStream &stream, ExtensionManifest::Command &cmd) {
+  qint32 mode = 0;
+  bool hasIcon = false;
+  QString icon, entrypoint;
+
+  stream >> cmd.name >> cmd.title >> cmd.description >> mode;
+  readList(stream, cmd.preferences);
+  readList(stream, cmd.arguments);
+  stream >> hasIcon >> icon >> entrypoint >> cmd.defaultDisabled;
+  cmd.mode = static_cast<CommandMode>(mode);
+  cmd.entrypoint = entrypoint.toStdString();
+  if (hasIcon) cmd.icon = icon;
+
+  return stream;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const ExtensionManifest &manifest) {
+  stream << QString::fromStdString(manifest.path.string()) << manifest.id << manifest.name << manifest.title
+         << manifest.description << manifest.icon << manifest.author;
+  writeList(stream, manifest.categories);
+  writeList(stream, manifest.preferences);
+  return writeList(stream, manifest.commands);
+}
+
+static QDataStream &operator>>(QDataStream &stream, ExtensionManifest &manifest) {
+  QString path;
+
+  stream >> path >> manifest.id >> manifest.name >> manifest.title >> manifest.description >> manifest.icon >>
+      manifest.author;
+  manifest.path = path.toStdString();
+  readList(stream, manifest.categories);
+  readList(stream, manifest.preferences);
+  return readList(stream, manifest.commands);
+}
+
 ExtensionRegistry::ExtensionRegistry(OmniCommandDatabase &commandDb, LocalStorageService &storage)
     : m_db(commandDb), m_storage(storage) {
   m_watcher->addPath(extensionDir().c_str());
+  m_scanTimer->setSingleShot(true);
+  m_scanTimer->setInterval(SCAN_DEBOUNCE_MS);
 
   // XXX: we currently do not support removing extensions by filesystem removal
   // An extension should be removed from within Vicinae directly so that other cleanup tasks
   // can be performed.
   connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, [this]() { requestScan(); });
+  connect(m_scanTimer, &QTimer::timeout, this, &ExtensionRegistry::rescan);
+  connect(m_scanWatcher, &QFutureWatcher<std::vector<ExtensionManifest>>::finished, this,
+          &ExtensionRegistry::handleScanFinished);
+}
+
+void ExtensionRegistry::requestScan() { m_scanTimer->start(); }
+
+void ExtensionRegistry::rescan() {
+  m_scanTimer->stop();
+
+  if (m_scanWatcher->isRunning()) {
+    m_scanPending = true;
+    return;
+  }
+
+  m_scanWatcher->setFuture(QtConcurrent::run([this]() { return scanAll(); }));
+}
+
+void ExtensionRegistry::handleScanFinished() {
+  m_manifests = m_scanWatcher->result();
+  emit extensionsChanged();
+
+  if (m_scanPending) {
+    m_scanPending = false;
+    rescan();
+  }
 }
 
 fs::path ExtensionRegistry::extensionDir() const { return Omnicast::dataDir() / "extensions"; }
 
-CommandArgument ExtensionRegistry::parseArgumentFromObject(const QJsonObject &obj) {
+CommandArgument ExtensionRegistry::parseArgumentFromObject(const QJsonObject &obj) const {
   CommandArgument arg;
   QString type = obj.value("type").toString();
 
@@ -55,22 +269,83 @@ CommandArgument ExtensionRegistry::parseArgumentFromObject(const QJsonObject &ob
   return arg;
 }
 
-bool ExtensionRegistry::installFromZip(const QString &id, std::string_view data) {
-  fs::path extractDir = extensionDir() / id.toStdString();
+bool ExtensionRegistry::installBundle(QPromise<bool> &promise, const QByteArray &data,
+                                      const fs::path &target) {
+  // staged next to the final location, so that it's on the same filesystem and can be renamed in place
+  fs::path staging = target.parent_path() / std::format(".{}.staging", target.filename().string());
+  fs::path previous = target.parent_path() / std::format(".{}.previous", target.filename().string());
+  std::error_code ec;
   Unzipper unzip(data);
 
   if (!unzip) {
-    qCritical() << "Failed to create unzipper";
+    qCritical() << "Failed to open extension archive";
     return false;
   }
 
-  unzip.extract(extractDir, {.stripComponents = 1});
-  emit extensionAdded(id);
-  emit extensionsChanged();
+  fs::remove_all(staging, ec);
+  promise.setProgressRange(0, 100);
+
+  auto progress = [&](size_t extracted, size_t total) {
+    promise.setProgressValue(total ? static_cast<int>(extracted * 100 / total) : 100);
+  };
+
+  if (!unzip.extract(staging, {.stripComponents = 1, .progress = progress})) {
+    qCritical() << "Failed to extract extension archive";
+    fs::remove_all(staging, ec);
+    return false;
+  }
+
+  fs::remove_all(previous, ec);
+
+  if (fs::exists(target)) fs::rename(target, previous, ec);
+
+  if (ec) {
+    qCritical() << "Failed to move previous bundle out of the way" << ec.message();
+    fs::remove_all(staging, ec);
+    return false;
+  }
+
+  fs::rename(staging, target, ec);
+
+  if (ec) {
+    qCritical() << "Failed to move extension bundle into place" << ec.message();
+    fs::remove_all(staging, ec);
+
+    // put the installed version back rather than leaving the extension uninstalled
+    if (fs::exists(previous, ec)) {
+      fs::rename(previous, target, ec);
+      if (ec) qCritical() << "Failed to restore previous bundle" << ec.message();
+    }
+
+    return false;
+  }
+
+  fs::remove_all(previous, ec);
 
   return true;
 }
 
+QFuture<bool> ExtensionRegistry::installFromZip(const QString &id, const QByteArray &data) {
+  fs::path target = extensionDir() / id.toStdString();
+  auto future = QtConcurrent::run([data, target](QPromise<bool> &promise) {
+    promise.addResult(installBundle(promise, data, target));
+  });
+  auto watcher = new QFutureWatcher<bool>(this);
+
+  connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher, id]() {
+    if (watcher->result()) {
+      emit extensionAdded(id);
+      requestScan();
+    }
+
+    watcher->deleteLater();
+  });
+
+  watcher->setFuture(future);
+
+  return future;
+}
+
 bool ExtensionRegistry::uninstall(const QString &id) {
   fs::path bundle = extensionDir() / id.toStdString();
 
@@ -80,12 +355,12 @@ bool ExtensionRegistry::uninstall(const QString &id) {
   m_storage.clearNamespace(id);
 
   emit extensionUninstalled(id);
-  emit extensionsChanged();
+  requestScan();
 
   return true;
 }
 
-Preference ExtensionRegistry::parsePreferenceFromObject(const QJsonObject &obj) {
+Preference ExtensionRegistry::parsePreferenceFromObject(const QJsonObject &obj) const {
   auto type = obj["type"].toString();
   Preference base;
 
@@ -127,7 +402,7 @@ Preference ExtensionRegistry::parsePreferenceFromObject(const QJsonObject &obj)
   return base;
 }
 
-ExtensionManifest::Command ExtensionRegistry::parseCommandFromObject(const QJsonObject &obj) {
+ExtensionManifest::Command ExtensionRegistry::parseCommandFromObject(const QJsonObject &obj) const {
   ExtensionManifest::Command command;
   auto type = obj.value("mode");
 
@@ -157,23 +432,126 @@ ExtensionManifest::Command ExtensionRegistry::parseCommandFromObject(const QJson
   return command;
 }
 
-std::vector<ExtensionManifest> ExtensionRegistry::scanAll() {
+fs::path ExtensionRegistry::catalogPath() {
+  return fs::path(QStandardPaths::writableLocation(QStandardPaths::CacheLocation).toStdString()) /
+         "extension-manifests.bin";
+}
+
+void ExtensionRegistry::loadCatalog() const {
+  QFile file(catalogPath());
+
+  if (!file.open(QIODevice::ReadOnly)) return;
+
+  QDataStream stream(&file);
+  quint32 magic = 0, version = 0, count = 0;
+
+  stream.setVersion(QDataStream::Qt_6_0);
+  stream >> magic >> version >> count;
+
+  if (stream.status() != QDataStream::Ok || magic != CATALOG_MAGIC || version != CATALOG_VERSION) return;
+
+  m_catalog.reserve(count);
+
+  for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+    QString path;
+    qint64 mtime = 0, size = 0;
+    quint64 inode = 0;
+    CatalogEntry entry;
+
+    stream >> path >> mtime >> inode >> size >> entry.manifest;
+    entry.mtime = mtime;
+    entry.inode = inode;
+    entry.size = size;
+    m_catalog[path.toStdString()] = std::move(entry);
+  }
+
+  if (stream.status() != QDataStream::Ok) {
+    qWarning() << "Ignoring corrupted extension manifest catalog" << file.fileName();
+    m_catalog.clear();
+  }
+}
+
+void ExtensionRegistry::saveCatalog() const {
+  auto path = catalogPath();
+  std::error_code ec;
+
+  fs::create_directories(path.parent_path(), ec);
+
+  QSaveFile file(QString(path.c_str()));
+
+  if (!file.open(QIODevice::WriteOnly)) {
+    qWarning() << "Failed to open extension manifest catalog for writing" << file.errorString();
+    return;
+  }
+
+  QDataStream stream(&file);
+
+  stream.setVersion(QDataStream::Qt_6_0);
+  stream << CATALOG_MAGIC << CATALOG_VERSION << static_cast<quint32>(m_catalog.size());
+
+  for (const auto &[path, entry] : m_catalog) {
+    stream << QString::fromStdString(path) << static_cast<qint64>(entry.mtime)
+           << static_cast<quint64>(entry.inode) << static_cast<qint64>(entry.size) << entry.manifest;
+  }
+
+  if (!file.commit()) { qWarning() << "Failed to save extension manifest catalog" << file.errorString(); }
+}
+
+std::vector<ExtensionManifest> ExtensionRegistry::scanAll() const {
+  std::lock_guard lock(m_catalogMutex);
   std::error_code ec;
   std::vector<ExtensionManifest> manifests;
+  std::unordered_map<std::string, CatalogEntry> catalog;
+  bool changed = false;
+  std::optional<StartupProfiler::Scope> phase;
+
+  // the first scan happens during startup
+  if (!m_catalogLoaded) {
+    phase.emplace(*StartupProfiler::instance(), "extension-manifests");
+    loadCatalog();
+    m_catalogLoaded = true;
+  }
 
   for (const auto &entry : fs::directory_iterator(extensionDir(), ec)) {
-    if (!entry.is_directory()) continue;
+    // bundles being installed are staged in hidden directories
+    if (!entry.is_directory() || entry.path().filename().string().starts_with('.')) continue;
+
+    struct stat st;
+    auto manifestPath = entry.path() / "package.json";
+    auto key = entry.path().string();
+
+    if (::stat(manifestPath.c_str(), &st) == 0) {
+      int64_t mtime = st.st_mtim.tv_sec * 1'000'000'000LL + st.st_mtim.tv_nsec;
+
+      if (auto it = m_catalog.find(key); it != m_catalog.end() && it->second.mtime == mtime &&
+                                         it->second.inode == st.st_ino && it->second.size == st.st_size) {
+        manifests.emplace_back(it->second.manifest);
+        catalog[key] = std::move(it->second);
+        continue;
+      }
 
-    auto manifest = scanBundle(entry.path());
+      auto manifest = scanBundle(entry.path());
+
+      if (manifest) {
+        changed = true;
+        manifests.emplace_back(manifest.value());
+        catalog[key] = CatalogEntry{
+            .mtime = mtime, .inode = st.st_ino, .size = st.st_size, .manifest = std::move(manifest.value())};
+        continue;
+      }
 
-    if (!manifest) {
       qCritical() << "Failed to load bundle at" << entry.path().c_str() << manifest.error().m_message;
-      continue;
+    } else {
+      qCritical() << "Failed to load bundle at" << entry.path().c_str() << "no package.json";
     }
-
-    manifests.emplace_back(manifest.value());
   }
 
+  // bundles that were removed since the last scan
+  changed = changed || catalog.size() != m_catalog.size();
+  m_catalog = std::move(catalog);
+
+  if (changed) saveCatalog();
+
   return manifests;
 }
 
@@ -181,7 +559,7 @@ bool ExtensionRegistry::isInstalled(const QString &id) const {
   return fs::is_directory(extensionDir() / id.toStdString());
 }
 
-std::expected<ExtensionManifest, ManifestError> ExtensionRegistry::scanBundle(const fs::path &path) {
+std::expected<ExtensionManifest, ManifestError> ExtensionRegistry::scanBundle(const fs::path &path) const {
   static const std::vector<CommandMode> supportedModes{CommandMode::CommandModeView, CommandModeNoView};
   fs::path manifestPath = path / "package.json";
 
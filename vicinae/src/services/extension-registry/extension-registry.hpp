@@ -5,6 +5,13 @@
 #include "services/local-storage/local-storage-service.hpp"
 #include <expected>
 #include <filesystem>
+#include <mutex>
+#include <qfuture.h>
+#include <qfuturewatcher.h>
+#include <qpromise.h>
+#include <qtimer.h>
+#include <sys/types.h>
+#include <unordered_map>
 #include <qfilesystemwatcher.h>
 #include <qjsonobject.h>
 #include <qobject.h>
@@ -46,33 +53,89 @@ struct ExtensionManifest {
 class ExtensionRegistry : public QObject {
   Q_OBJECT
 
+  /**
+   * A parsed manifest, along with the state of the package.json it was parsed from.
+   */
+  struct CatalogEntry {
+    int64_t mtime = 0;
+    ino_t inode = 0;
+    off_t size = 0;
+    ExtensionManifest manifest;
+  };
+
   OmniCommandDatabase &m_db;
   LocalStorageService &m_storage;
   QFileSystemWatcher *m_watcher = new QFileSystemWatcher(this);
 
-  CommandArgument parseArgumentFromObject(const QJsonObject &obj);
-  Preference parsePreferenceFromObject(const QJsonObject &obj);
-  ExtensionManifest::Command parseCommandFromObject(const QJsonObject &obj);
+  // filesystem events come in bursts, especially while a bundle is being installed
+  QTimer *m_scanTimer = new QTimer(this);
+  QFutureWatcher<std::vector<ExtensionManifest>> *m_scanWatcher =
+      new QFutureWatcher<std::vector<ExtensionManifest>>(this);
+  bool m_scanPending = false;
+  std::vector<ExtensionManifest> m_manifests;
+
+  // keyed by bundle path, shared by scans running on worker threads
+  mutable std::mutex m_catalogMutex;
+  mutable std::unordered_map<std::string, CatalogEntry> m_catalog;
+  mutable bool m_catalogLoaded = false;
+
+  CommandArgument parseArgumentFromObject(const QJsonObject &obj) const;
+  Preference parsePreferenceFromObject(const QJsonObject &obj) const;
+  ExtensionManifest::Command parseCommandFromObject(const QJsonObject &obj) const;
 
   std::filesystem::path extensionDir() const;
 
+  static bool installBundle(QPromise<bool> &promise, const QByteArray &data,
+                            const std::filesystem::path &target);
+
+  static std::filesystem::path catalogPath();
+  void loadCatalog() const;
+  void saveCatalog() const;
+  void handleScanFinished();
+
 public:
-  bool installFromZip(const QString &id, std::string_view data);
+  /**
+   * Install an extension bundle from a zip archive held in memory.
+   *
+   * The archive is extracted on a worker thread, in a staging directory that is then renamed into
+   * place, so that a partially extracted bundle is never visible. Extraction progress is reported
+   * through the returned future, as a percentage.
+   */
+  QFuture<bool> installFromZip(const QString &id, const QByteArray &data);
 
-  std::expected<ExtensionManifest, ManifestError> scanBundle(const std::filesystem::path &path);
-  std::vector<ExtensionManifest> scanAll();
-  void rescanBundle();
+  std::expected<ExtensionManifest, ManifestError> scanBundle(const std::filesystem::path &path) const;
+
+  /**
+   * The manifest of every installed extension. Only bundles whose package.json changed since they
+   * were last seen are parsed again, the others come from a catalog persisted across runs.
+   * Safe to call from a worker thread.
+   */
+  std::vector<ExtensionManifest> scanAll() const;
   bool isInstalled(const QString &id) const;
   bool uninstall(const QString &id);
 
-  ExtensionRegistry(OmniCommandDatabase &commandDb, LocalStorageService &storage);
+  /**
+   * Manifests found by the last scan.
+   */
+  const std::vector<ExtensionManifest> &manifests() const { return m_manifests; }
+
+  /**
+   * Scan the extension directory right away, on a worker thread. `extensionsChanged` is emitted
+   * once it's done. If a scan is already running, another one is started after it.
+   */
+  void rescan();
 
-  void requestScan() { emit extensionsChanged(); }
+  /**
+   * Schedule a rescan, requests made in a short time span are coalesced into a single scan.
+   */
+  void requestScan();
+
+  ExtensionRegistry(OmniCommandDatabase &commandDb, LocalStorageService &storage);
 
 signals:
   void extensionAdded(const QString &id);
   void extensionUninstalled(const QString &id);
 
-  // used to notify subscribers that they should rescan
+  // emitted after each scan, `manifests` returns the up to date list of manifests
   void extensionsChanged() const;
 };
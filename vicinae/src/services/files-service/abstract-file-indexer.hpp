@@ -1,4 +1,5 @@
 #pragma once
+#include "utils/cancellation-token/cancellation-token.hpp"
 #include <filesystem>
 #include <qfuture.h>
 #include <qobject.h>
@@ -49,6 +50,8 @@ public:
 
   struct QueryParams {
     Pagination pagination;
+    // the query is abandoned as soon as this is cancelled, with no results
+    CancellationToken cancellation;
   };
 
 public:
@@ -1,6 +1,7 @@
 #include "file-indexer-db.hpp"
 #include "vicinae.hpp"
 #include "services/files-service/file-indexer/relevancy-scorer.hpp"
+#include "utils/cancellation-token/cancellation-token.hpp"
 #include "utils/migration-manager/migration-manager.hpp"
 #include "utils/utils.hpp"
 #include <qlogging.h>
@@ -242,18 +243,23 @@ std::vector<fs::path> FileIndexerDatabase::search(std::string_view searchQuery,
                          .arg(qStringFromStdView(searchQuery));
 
   QSqlQuery query(m_db);
+  SqliteCancellationScope cancellation(m_db, params.cancellation);
 
   query.prepare(queryString);
   query.bindValue(":limit", params.pagination.limit);
   query.bindValue(":offset", params.pagination.offset);
 
-  if (!query.exec()) { qWarning() << "Search query failed" << query.lastError(); }
+  if (!query.exec()) {
+    if (params.cancellation.isCancelled()) return {};
+    qWarning() << "Search query failed" << query.lastError();
+  }
 
   std::vector<fs::path> results;
 
   results.reserve(params.pagination.limit);
 
-  while (query.next()) {
+  // checking that the files still exist hits the disk
+  while (!params.cancellation.isCancelled() && query.next()) {
     fs::path path = query.value(0).toString().toStdString();
 
     if (fs::exists(path)) { results.emplace_back(path); }
@@ -2,6 +2,8 @@
 #include <filesystem>
 #include <mutex>
 #include <QtConcurrent/QtConcurrent>
+#include "daemon/perf-metrics.hpp"
+#include "daemon/trace-recorder.hpp"
 #include "services/files-service/abstract-file-indexer.hpp"
 #include "file-indexer-db.hpp"
 #include "file-indexer.hpp"
@@ -16,6 +18,7 @@
 #include <QSqlError>
 #include <qthreadpool.h>
 #include <ranges>
+#include <pthread.h>
 #include <thread>
 #include <unistd.h>
 
@@ -36,6 +39,7 @@ void WriterWorker::stop() {
 }
 
 void WriterWorker::run() {
+  pthread_setname_np(pthread_self(), "file-writer");
   db = std::make_unique<FileIndexerDatabase>();
 
   while (m_alive) {
@@ -57,6 +61,8 @@ void WriterWorker::run() {
 
 void WriterWorker::batchWrite(const std::vector<fs::path> &paths) {
   // Writing is happening in the writerThread
+  TraceRecorder::Scope trace("file-index-write");
+
   db->indexFiles(paths);
 }
 
@@ -125,17 +131,39 @@ QFuture<std::vector<IndexerFileResult>> FileIndexer::queryAsync(std::string_view
   QString finalQuery = preparePrefixSearchQuery(view);
   QPromise<std::vector<IndexerFileResult>> promise;
   auto future = promise.future();
+  static auto &queryLatency = PerfMetrics::instance()->histogram("file-query");
+  static auto &dbLatency = PerfMetrics::instance()->histogram("file-query-db");
+  static auto &cancelled = PerfMetrics::instance()->counter("file-query-cancelled");
+
+  // the query latency includes the time spent waiting for a thread, which is what the user perceives
+  QThreadPool::globalInstance()->start([params, finalQuery, promise = std::move(promise),
+                                        timer = queryLatency.time()]() mutable {
+    // superseded while it was waiting for a thread, or while the database was being searched
+    auto abandon = [&]() {
+      timer.cancel();
+      cancelled.increment();
+      promise.addResult(std::vector<IndexerFileResult>{});
+      promise.finish();
+    };
+
+    if (params.cancellation.isCancelled()) return abandon();
 
-  QThreadPool::globalInstance()->start([params, finalQuery, promise = std::move(promise)]() mutable {
     std::vector<fs::path> paths;
     {
+      auto dbTimer = dbLatency.time();
       FileIndexerDatabase db;
       paths = db.search(finalQuery.toStdString(), params);
+
+      if (params.cancellation.isCancelled()) dbTimer.cancel();
     }
+
+    if (params.cancellation.isCancelled()) return abandon();
+
     std::vector<IndexerFileResult> results =
         paths | std::views::transform([](auto &&path) { return IndexerFileResult{.path = path}; }) |
         std::ranges::to<std::vector>();
 
+    timer.finish();
     promise.addResult(results);
     promise.finish();
   });
@@ -1,8 +1,10 @@
 #include "indexer-scanner.hpp"
+#include "daemon/trace-recorder.hpp"
 #include "services/files-service/file-indexer/file-indexer-db.hpp"
 #include "services/files-service/file-indexer/file-indexer.hpp"
 #include "services/files-service/file-indexer/filesystem-walker.hpp"
 #include "services/files-service/file-indexer/incremental-scanner.hpp"
+#include <pthread.h>
 #include <qlogging.h>
 
 namespace fs = std::filesystem;
@@ -66,6 +68,7 @@ void IndexerScanner::enqueue(const std::filesystem::path &path, FileIndexerDatab
 }
 
 void IndexerScanner::run() {
+  pthread_setname_np(pthread_self(), "file-scanner");
   m_db = std::make_unique<FileIndexerDatabase>();
   m_writerWorker = std::make_unique<WriterWorker>(m_batchMutex, m_writeBatches, m_batchCv);
   m_writerThread = std::thread([&]() { m_writerWorker->run(); });
@@ -88,6 +91,7 @@ void IndexerScanner::run() {
     }
 
     auto scanRecord = result.value();
+    TraceRecorder::Scope trace("file-index-scan");
 
     m_db->updateScanStatus(scanRecord.id, FileIndexerDatabase::ScanStatus::Started);
 
@@ -2,25 +2,40 @@
 #include <qsqlquery.h>
 #include <qsqlerror.h>
 #include <qjsonobject.h>
+#include <unordered_map>
 
 class OmniDatabase;
 
+/**
+ * Key-value storage for extensions, each extension having its own namespace.
+ *
+ * A namespace is loaded in memory the first time it's accessed, so that reads never hit the database.
+ * Writes update the in-memory copy right away and are then committed in batches through the database
+ * write queue.
+ */
 class LocalStorageService {
 public:
   enum ValueType { Number, String, Boolean };
 
 private:
+  struct Namespace {
+    std::unordered_map<QString, QJsonValue> items;
+    // sequence number of the last write queued for this namespace
+    uint64_t lastWrite = 0;
+    // number of extension sessions currently using the namespace
+    int sessions = 0;
+  };
+
   OmniDatabase &db;
-  QSqlQuery m_clearQuery;
-  QSqlQuery m_listQuery;
-  QSqlQuery m_removeQuery;
-  QSqlQuery m_setItemQuery;
-  QSqlQuery m_getQuery;
+  std::unordered_map<QString, Namespace> m_namespaces;
 
   std::pair<QString, ValueType> serializeValue(const QJsonValue &value) const;
 
   QJsonValue deserializeValue(const QString &value, ValueType type);
 
+  Namespace &loadNamespace(const QString &namespaceId);
+  void queueSet(Namespace &ns, const QString &namespaceId, const QString &key, const QJsonValue &json);
+
 public:
   bool clearNamespace(const QString &namespaceId);
   QJsonObject listNamespaceItems(const QString &namespaceId);
@@ -29,5 +44,18 @@ public:
   QJsonValue getItem(const QString &namespaceId, const QString &key);
   QJsonObject getItemAsJson(const QString &namespaceId, const QString &key);
 
+  /**
+   * Values of all the `keys` that are set. Missing keys are not part of the returned object.
+   */
+  QJsonObject getItems(const QString &namespaceId, const QStringList &keys);
+  void setItems(const QString &namespaceId, const QJsonObject &values);
+
+  /**
+   * Extension sessions hold the namespace they use while they run. Once the last session using it is
+   * gone, the namespace is dropped from memory, unless some of its writes are still queued.
+   */
+  void acquireNamespace(const QString &namespaceId);
+  void releaseNamespace(const QString &namespaceId);
+
   LocalStorageService(OmniDatabase &db);
 };
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
 #include <qsqlquery.h>
@@ -36,98 +37,133 @@ QJsonObject LocalStorageService::getItemAsJson(const QString &namespaceId, const
   return QJsonDocument::fromJson(json.toString().toUtf8()).object();
 }
 
-QJsonValue LocalStorageService::getItem(const QString &namespaceId, const QString &key) {
-  m_getQuery.bindValue(":namespace_id", namespaceId);
-  m_getQuery.bindValue(":key", key);
+LocalStorageService::Namespace &LocalStorageService::loadNamespace(const QString &namespaceId) {
+  if (auto it = m_namespaces.find(namespaceId); it != m_namespaces.end()) return it->second;
+
+  auto &ns = m_namespaces[namespaceId];
+  QSqlQuery query = db.createQuery();
+
+  query.setForwardOnly(true);
+  query.prepare("SELECT key, value, value_type FROM storage_data_item WHERE namespace_id = :namespace_id");
+  query.bindValue(":namespace_id", namespaceId);
 
-  if (!m_getQuery.exec()) {
-    qCritical() << "LocalStorageService::getItem: failed to execute query" << m_getQuery.lastError();
-    return {};
+  if (!query.exec()) {
+    qCritical() << "LocalStorageService: failed to load namespace" << namespaceId << query.lastError();
+    return ns;
   }
 
-  if (!m_getQuery.next()) return {};
+  while (query.next()) {
+    ValueType valueType = static_cast<ValueType>(query.value(2).toUInt());
 
-  QString value = m_getQuery.value(0).toString();
-  ValueType valueType = static_cast<ValueType>(m_getQuery.value(1).toUInt());
+    ns.items[query.value(0).toString()] = deserializeValue(query.value(1).toString(), valueType);
+  }
 
-  return deserializeValue(value, valueType);
+  return ns;
 }
 
-bool LocalStorageService::setItem(const QString &namespaceId, const QString &key, const QJsonValue &json) {
+void LocalStorageService::queueSet(Namespace &ns, const QString &namespaceId, const QString &key,
+                                   const QJsonValue &json) {
   auto [value, valueType] = serializeValue(json);
 
-  m_setItemQuery.bindValue(":namespace_id", namespaceId);
-  m_setItemQuery.bindValue(":key", key);
-  m_setItemQuery.bindValue(":value", value);
-  m_setItemQuery.bindValue(":value_type", valueType);
+  ns.lastWrite = db.writeQueue().enqueue({.sql = R"(
+		INSERT INTO storage_data_item (namespace_id, key, value, value_type)
+		VALUES (:namespace_id, :key, :value, :value_type)
+		ON CONFLICT (namespace_id, key) DO UPDATE SET value = :value, value_type = :value_type
+	)",
+                                          .bindings = {{":namespace_id", namespaceId},
+                                                       {":key", key},
+                                                       {":value", value},
+                                                       {":value_type", valueType}}},
+                                         QString("storage:%1:%2").arg(namespaceId).arg(key));
+
+  // stored the way it will be read back from the database
+  ns.items[key] = deserializeValue(value, valueType);
+}
 
-  if (!m_setItemQuery.exec()) {
-    qCritical() << "LocalStorageService::setItem: failed to execute query" << m_setItemQuery.lastError();
-    return false;
-  }
+QJsonValue LocalStorageService::getItem(const QString &namespaceId, const QString &key) {
+  auto &ns = loadNamespace(namespaceId);
 
-  return true;
+  if (auto it = ns.items.find(key); it != ns.items.end()) return it->second;
+
+  return {};
 }
 
-bool LocalStorageService::removeItem(const QString &namespaceId, const QString &key) {
-  m_removeQuery.bindValue(":namespace_id", namespaceId);
-  m_removeQuery.bindValue(":key", key);
+QJsonObject LocalStorageService::getItems(const QString &namespaceId, const QStringList &keys) {
+  auto &ns = loadNamespace(namespaceId);
+  QJsonObject values;
 
-  if (!m_removeQuery.exec()) {
-    qCritical() << "LocalStorageService::removeItem: failed to execute query" << m_removeQuery.lastError();
-    return false;
+  for (const auto &key : keys) {
+    if (auto it = ns.items.find(key); it != ns.items.end()) values[key] = it->second;
   }
 
-  return m_removeQuery.numRowsAffected() != 0;
+  return values;
 }
 
-QJsonObject LocalStorageService::listNamespaceItems(const QString &namespaceId) {
-  m_listQuery.bindValue(":namespace_id", namespaceId);
+bool LocalStorageService::setItem(const QString &namespaceId, const QString &key, const QJsonValue &json) {
+  queueSet(loadNamespace(namespaceId), namespaceId, key, json);
+
+  return true;
+}
+
+void LocalStorageService::setItems(const QString &namespaceId, const QJsonObject &values) {
+  auto &ns = loadNamespace(namespaceId);
 
-  if (!m_listQuery.exec()) {
-    qCritical() << "LocalStorageService::listNamespaceItems: failed to execute query"
-                << m_listQuery.lastError();
-    return {};
+  for (auto it = values.begin(); it != values.end(); ++it) {
+    queueSet(ns, namespaceId, it.key(), it.value());
   }
+}
 
-  QJsonObject obj;
+bool LocalStorageService::removeItem(const QString &namespaceId, const QString &key) {
+  auto &ns = loadNamespace(namespaceId);
 
-  while (m_listQuery.next()) {
-    auto key = m_listQuery.value(0).toString();
-    auto value = m_listQuery.value(1);
+  if (!ns.items.erase(key)) return false;
 
-    obj[key] = QJsonValue::fromVariant(value);
+  ns.lastWrite = db.writeQueue().enqueue(
+      {.sql = "DELETE FROM storage_data_item WHERE namespace_id = :namespace_id AND key = :key",
+       .bindings = {{":namespace_id", namespaceId}, {":key", key}}},
+      QString("storage:%1:%2").arg(namespaceId).arg(key));
+
+  return true;
+}
+
+QJsonObject LocalStorageService::listNamespaceItems(const QString &namespaceId) {
+  auto &ns = loadNamespace(namespaceId);
+  QJsonObject obj;
+
+  for (const auto &[key, value] : ns.items) {
+    obj[key] = value;
   }
 
   return obj;
 }
 
 bool LocalStorageService::clearNamespace(const QString &namespaceId) {
-  m_clearQuery.bindValue(":namespace_id", namespaceId);
+  auto &ns = m_namespaces[namespaceId];
 
-  if (!m_clearQuery.exec()) {
-    qCritical() << "LocalStorageService::clearNamespace: failed to execute query" << m_clearQuery.lastError();
-    return false;
-  }
+  // no need to load a namespace only to clear it
+  ns.items.clear();
+  ns.lastWrite =
+      db.writeQueue().enqueue({.sql = "DELETE FROM storage_data_item WHERE namespace_id = :namespace_id",
+                               .bindings = {{":namespace_id", namespaceId}}});
 
   return true;
 }
 
-LocalStorageService::LocalStorageService(OmniDatabase &db) : db(db) {
-  m_clearQuery = db.createQuery();
-  m_listQuery = db.createQuery();
-  m_removeQuery = db.createQuery();
-  m_setItemQuery = db.createQuery();
-  m_getQuery = db.createQuery();
-
-  m_clearQuery.prepare("DELETE FROM storage_data_item WHERE namespace_id = :namespace_id");
-  m_listQuery.prepare("SELECT key, value FROM storage_data_item WHERE namespace_id = :namespace_id");
-  m_removeQuery.prepare("DELETE FROM storage_data_item WHERE namespace_id = :namespace_id AND key = :key");
-  m_setItemQuery.prepare(R"(
-		INSERT INTO storage_data_item (namespace_id, key, value, value_type)
-		VALUES (:namespace_id, :key, :value, :value_type)
-		ON CONFLICT (namespace_id, key) DO UPDATE SET value = :value, value_type = :value_type
-	)");
-  m_getQuery.prepare(
-      "SELECT value, value_type FROM storage_data_item WHERE namespace_id = :namespace_id AND key = :key");
+void LocalStorageService::acquireNamespace(const QString &namespaceId) {
+  loadNamespace(namespaceId).sessions += 1;
+}
+
+void LocalStorageService::releaseNamespace(const QString &namespaceId) {
+  auto it = m_namespaces.find(namespaceId);
+
+  if (it == m_namespaces.end()) return;
+
+  auto &ns = it->second;
+
+  ns.sessions = std::max(0, ns.sessions - 1);
+
+  // reloading it from the database would lose writes that are not committed yet
+  if (ns.sessions == 0 && ns.lastWrite <= db.writeQueue().committedSequence()) { m_namespaces.erase(it); }
 }
+
+LocalStorageService::LocalStorageService(OmniDatabase &db) : db(db) {}
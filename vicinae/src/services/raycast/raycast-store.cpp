@@ -1,50 +1,67 @@
 #include "raycast-store.hpp"
+#include "image-fetcher.hpp"
 #include <qfuture.h>
-#include <qnetworkdiskcache.h>
-#include <qnetworkreply.h>
+#include <qpromise.h>
 #include <expected>
 
-QFuture<Raycast::ListResult> RaycastStoreService::search(const QString &query) {
+using Priority = NetworkFetcher::Priority;
 
-  QUrl endpoint = QString("%1/store_listings/search?q=%2").arg(BASE_URL).arg(query);
-  QPromise<Raycast::ListResult> promise;
-  auto future = promise.future();
+static Raycast::ListResult parseListResponse(const QByteArray &data) {
+  QJsonParseError error;
+  QJsonDocument doc = QJsonDocument::fromJson(data, &error);
+
+  if (error.error != QJsonParseError::NoError) {
+    qWarning() << "JSON parse error:" << error.errorString();
+    return std::unexpected("Failed to parse response");
+  }
+
+  auto jsonList = doc.object().value("data").toArray();
+  std::vector<Raycast::Extension> extensions;
+
+  extensions.reserve(jsonList.size());
+
+  for (const auto &result : jsonList) {
+    extensions.emplace_back(Raycast::Extension::fromJson(result.toObject()));
+  }
+
+  return extensions;
+}
+
+static QNetworkRequest makeApiRequest(const QUrl &endpoint) {
   QNetworkRequest request(endpoint);
 
   request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
   request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
 
-  auto reply = m_net->get(request);
-
-  connect(reply, &QNetworkReply::finished, this, [this, reply, promise = std::move(promise)]() mutable {
-    if (reply->error() != QNetworkReply::NoError) {
-      promise.addResult(std::unexpected(""));
-    } else {
-      std::vector<Raycast::Extension> extensions;
-      auto data = reply->readAll();
-      QJsonParseError error;
-      QJsonDocument doc = QJsonDocument::fromJson(data, &error);
-
-      if (error.error != QJsonParseError::NoError) {
-        qWarning() << "JSON parse error:" << error.errorString();
-        promise.addResult(std::unexpected("Failed to parse response"));
-        promise.finish();
-        reply->deleteLater();
-        return;
-      }
+  return request;
+}
 
-      auto jsonList = doc.object().value("data").toArray();
+QFuture<Raycast::ListResult> RaycastStoreService::search(const QString &query,
+                                                         const CancellationToken &cancellation) {
+  QUrl endpoint = QString("%1/store_listings/search?q=%2").arg(BASE_URL).arg(query);
+  auto promise = std::make_shared<QPromise<Raycast::ListResult>>();
+  auto future = promise->future();
+  auto reply = NetworkFetcher::instance()->fetch(makeApiRequest(endpoint), Priority::Interactive);
 
-      extensions.reserve(jsonList.size());
+  connect(reply, &FetchReply::finished, this, [reply, promise](const QByteArray &data) {
+    promise->addResult(parseListResponse(data));
+    promise->finish();
+    reply->deleteLater();
+  });
 
-      for (const auto &result : doc.object().value("data").toArray()) {
-        extensions.emplace_back(Raycast::Extension::fromJson(result.toObject()));
-      }
+  connect(reply, &FetchReply::failed, this, [reply, promise]() {
+    promise->addResult(std::unexpected(""));
+    promise->finish();
+    reply->deleteLater();
+  });
 
-      promise.addResult(extensions);
-    }
+  cancellation.onCancelled(reply, [reply, promise]() {
+    // the response came in before the reply got deleted
+    if (promise->future().isFinished()) return;
 
-    promise.finish();
+    reply->abort();
+    promise->addResult(std::unexpected("Cancelled"));
+    promise->finish();
     reply->deleteLater();
   });
 
@@ -53,20 +70,30 @@ QFuture<Raycast::ListResult> RaycastStoreService::search(const QString &query) {
 
 QFuture<Raycast::DownloadExtensionResult> RaycastStoreService::downloadExtension(const QUrl &url) {
   QNetworkRequest request(url);
-  QPromise<Raycast::DownloadExtensionResult> promise;
-  auto future = promise.future();
-  auto reply = m_net->get(request);
+  auto promise = std::make_shared<QPromise<Raycast::DownloadExtensionResult>>();
+  auto future = promise->future();
 
-  request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
+  // bundles are fetched once and installed right away, keeping them in the cache would only waste space
+  request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+  request.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
 
-  connect(reply, &QNetworkReply::finished, this, [this, reply, promise = std::move(promise)]() mutable {
-    if (reply->error() != QNetworkReply::NoError) {
-      promise.addResult(std::unexpected("Failed to fetch"));
-    } else {
-      promise.addResult(reply->readAll());
-    }
+  auto reply = NetworkFetcher::instance()->fetch(request, Priority::Interactive);
 
-    promise.finish();
+  promise->setProgressRange(0, 100);
+
+  connect(reply, &FetchReply::progress, this, [promise](qint64 received, qint64 total) {
+    if (total > 0) promise->setProgressValue(static_cast<int>(received * 100 / total));
+  });
+
+  connect(reply, &FetchReply::finished, this, [reply, promise](const QByteArray &data) {
+    promise->addResult(data);
+    promise->finish();
+    reply->deleteLater();
+  });
+
+  connect(reply, &FetchReply::failed, this, [reply, promise]() {
+    promise->addResult(std::unexpected("Failed to fetch"));
+    promise->finish();
     reply->deleteLater();
   });
 
@@ -75,66 +102,37 @@ QFuture<Raycast::DownloadExtensionResult> RaycastStoreService::downloadExtension
 
 QFuture<Raycast::ListResult>
 RaycastStoreService::fetchExtensions(const Raycast::ListPaginationOptions &opts) {
-
   QUrl endpoint =
       QString("%1/store_listings?page=%2&per_page=%3").arg(BASE_URL).arg(opts.page).arg(opts.perPage);
-  QPromise<Raycast::ListResult> promise;
-  auto future = promise.future();
-  QNetworkRequest request(endpoint);
+  auto promise = std::make_shared<QPromise<Raycast::ListResult>>();
+  auto future = promise->future();
 
   if (auto it = m_cachedPages.find(opts.page); it != m_cachedPages.end()) {
     qDebug() << "cached page" << opts.page;
-    promise.addResult(it->second);
-    promise.finish();
+    promise->addResult(it->second);
+    promise->finish();
     return future;
   }
 
-  request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-  request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
-
-  auto reply = m_net->get(request);
-
-  connect(reply, &QNetworkReply::finished, this, [this, opts, reply, promise = std::move(promise)]() mutable {
-    if (reply->error() != QNetworkReply::NoError) {
-      promise.addResult(std::unexpected(""));
-    } else {
-      std::vector<Raycast::Extension> extensions;
-      auto data = reply->readAll();
-      QJsonParseError error;
-      QJsonDocument doc = QJsonDocument::fromJson(data, &error);
-
-      if (error.error != QJsonParseError::NoError) {
-        qWarning() << "JSON parse error:" << error.errorString();
-        promise.addResult(std::unexpected("Failed to parse response"));
-        promise.finish();
-        reply->deleteLater();
-        return;
-      }
-
-      auto jsonList = doc.object().value("data").toArray();
+  auto reply = NetworkFetcher::instance()->fetch(makeApiRequest(endpoint), Priority::Interactive);
 
-      extensions.reserve(jsonList.size());
+  connect(reply, &FetchReply::finished, this, [this, opts, reply, promise](const QByteArray &data) {
+    auto result = parseListResponse(data);
 
-      for (const auto &result : doc.object().value("data").toArray()) {
-        extensions.emplace_back(Raycast::Extension::fromJson(result.toObject()));
-      }
+    if (result) m_cachedPages.insert({opts.page, *result});
 
-      m_cachedPages.insert({opts.page, extensions});
-      promise.addResult(extensions);
-    }
+    promise->addResult(result);
+    promise->finish();
+    reply->deleteLater();
+  });
 
-    promise.finish();
+  connect(reply, &FetchReply::failed, this, [reply, promise]() {
+    promise->addResult(std::unexpected(""));
+    promise->finish();
     reply->deleteLater();
   });
 
   return future;
 }
 
-RaycastStoreService::RaycastStoreService() {
-  auto diskCache = new QNetworkDiskCache;
-  auto cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
-                  QLatin1StringView("/omnicast/raycast-store");
-
-  diskCache->setCacheDirectory(cacheDir);
-  m_net->setCache(diskCache);
-}
+RaycastStoreService::RaycastStoreService() {}
@@ -2,12 +2,12 @@
 #include "common.hpp"
 #include "../../ui/image/url.hpp"
 #include "theme.hpp"
+#include "utils/cancellation-token/cancellation-token.hpp"
 #include <expected>
 #include <qcontainerfwd.h>
 #include <qstringview.h>
 #include <vector>
 #include <qfuture.h>
-#include <qnetworkaccessmanager.h>
 #include <qobject.h>
 #include <QString>
 #include <QStringList>
@@ -482,16 +482,20 @@ using DownloadExtensionResult = std::expected<QByteArray, QString>;
 
 class RaycastStoreService : public QObject, NonCopyable {
   std::unordered_map<int, Raycast::ListFrontPageResponse> m_cachedPages;
-  QNetworkAccessManager *m_net = new QNetworkAccessManager(this);
   static constexpr const char *BASE_URL = "https://backend.raycast.com/api/v1";
 
 public:
   RaycastStoreService();
 
   /**
-   * Download the extension bundle as a zip file.
+   * Download the extension bundle as a zip file. Download progress is reported through the future, as
+   * a percentage.
    */
   QFuture<Raycast::DownloadExtensionResult> downloadExtension(const QUrl &url);
   QFuture<Raycast::ListResult> fetchExtensions(const Raycast::ListPaginationOptions &opts = {});
-  QFuture<Raycast::ListResult> search(const QString &query);
+
+  /**
+   * The request is aborted once `cancellation` is cancelled, the future then finishing with an error.
+   */
+  QFuture<Raycast::ListResult> search(const QString &query, const CancellationToken &cancellation = {});
 };
@@ -1,55 +1,264 @@
 #include "root-item-manager.hpp"
 #include "root-search.hpp"
 #include <bits/chrono.h>
+#include <ctime>
 #include <qlogging.h>
 #include <ranges>
+#include <span>
 
-RootItemMetadata RootItemManager::loadMetadata(const QString &id) {
-  RootItemMetadata item;
-  QSqlQuery query = m_db.createQuery();
+RootItem *RootItemManager::findItemById(const QString &id) const {
+  if (auto it = m_itemIndex.find(id); it != m_itemIndex.end()) return m_items[it->second].get();
 
-  query.prepare(R"(
+  return nullptr;
+}
+
+RootProvider *RootItemManager::findProviderById(const QString &id) const {
+  auto it = std::ranges::find_if(m_providers, [&](auto &&provider) { return provider->uniqueId() == id; });
+
+  if (it == m_providers.end()) return nullptr;
+
+  return it->get();
+}
+
+std::optional<std::unordered_map<QString, RootItemManager::ItemRecord>>
+RootItemManager::loadItemRecords(const std::vector<QString> *ids) {
+  // older SQLite builds cap the number of bound variables per statement at 999
+  static constexpr size_t MAX_IDS_PER_QUERY = 500;
+  std::unordered_map<QString, ItemRecord> records;
+  QString sql = R"(
 		SELECT
-			enabled, fallback, fallback_position, alias, rank_visit_count, rank_last_visited_at, provider_id, favorite
+			id, enabled, fallback, fallback_position, alias, rank_visit_count, rank_last_visited_at, provider_id,
+			favorite, preference_values
 		FROM
 			root_provider_item
-		WHERE id = :id
-	)");
-  query.bindValue(":id", id);
+	)";
 
-  if (!query.exec()) {
-    qCritical() << "Failed to load item metadata for" << id << query.lastError();
+  auto load = [&](std::span<const QString> chunk) {
+    QSqlQuery query = m_db.createQuery();
+    QString chunkSql = sql;
+
+    if (ids) {
+      QStringList placeholders(chunk.size(), "?");
+
+      chunkSql += QString("WHERE id IN (%1)").arg(placeholders.join(','));
+    }
+
+    query.setForwardOnly(true);
+    query.prepare(chunkSql);
+
+    for (const auto &id : chunk) {
+      query.addBindValue(id);
+    }
+
+    if (!query.exec()) {
+      qCritical() << "Failed to load item metadata" << query.lastError();
+      return false;
+    }
+
+    while (query.next()) {
+      ItemRecord record;
+      auto &item = record.metadata;
+
+      item.isEnabled = query.value(1).toBool();
+      item.isFallback = query.value(2).toBool();
+      item.fallbackPosition = query.value(3).toInt();
+      item.alias = query.value(4).toString();
+      item.visitCount = query.value(5).toInt();
+      item.lastVisitedAt = std::chrono::system_clock::from_time_t(query.value(6).toULongLong());
+      item.providerId = query.value(7).toString();
+      item.favorite = query.value(8).toBool();
+      record.preferenceValues = QJsonDocument::fromJson(query.value(9).toString().toUtf8()).object();
+      records[query.value(0).toString()] = std::move(record);
+    }
+
+    return true;
+  };
+
+  if (!ids) {
+    if (!load({})) return std::nullopt;
+    return records;
+  }
+
+  for (size_t i = 0; i < ids->size(); i += MAX_IDS_PER_QUERY) {
+    size_t count = std::min(MAX_IDS_PER_QUERY, ids->size() - i);
+
+    if (!load(std::span(*ids).subspan(i, count))) return std::nullopt;
+  }
+
+  return records;
+}
+
+std::unordered_map<QString, QJsonObject> RootItemManager::loadProviderPreferenceValues() {
+  std::unordered_map<QString, QJsonObject> values;
+  QSqlQuery query = m_db.createQuery();
+
+  query.setForwardOnly(true);
+
+  if (!query.exec("SELECT id, preference_values FROM root_provider")) {
+    qCritical() << "Failed to load provider preferences" << query.lastError();
     return {};
   }
 
-  if (!query.next()) { return {}; };
+  while (query.next()) {
+    values[query.value(0).toString()] = QJsonDocument::fromJson(query.value(1).toString().toUtf8()).object();
+  }
 
-  item.isEnabled = query.value(0).toBool();
-  item.isFallback = query.value(1).toBool();
-  item.fallbackPosition = query.value(2).toInt();
-  item.alias = query.value(3).toString();
-  item.visitCount = query.value(4).toInt();
-  item.lastVisitedAt = std::chrono::system_clock::from_time_t(query.value(5).toULongLong());
-  item.providerId = query.value(6).toString();
-  item.favorite = query.value(7).toBool();
+  return values;
+}
 
-  return item;
+QJsonObject RootItemManager::withPreferenceDefaults(const RootItem &item, QJsonObject values) const {
+  for (const auto &preference : item.preferences()) {
+    QJsonValue defaultValue = preference.defaultValue();
+    if (!values.contains(preference.name()) && !defaultValue.isNull()) {
+      values[preference.name()] = defaultValue;
+    }
+  }
+
+  return values;
 }
 
-RootItem *RootItemManager::findItemById(const QString &id) const {
-  auto it = std::ranges::find_if(m_items, [&](auto &&v) { return v->uniqueId() == id; });
+void RootItemManager::queueMetadataWrite(SqlWriteQueue::Statement statement, const std::vector<QString> &ids,
+                                         const QString &key) {
+  uint64_t seq = m_db.writeQueue().enqueue(std::move(statement), key);
+
+  for (const auto &id : ids) {
+    m_pendingMetadataWrites[id] = seq;
+  }
+}
 
-  if (it != m_items.end()) return it->get();
+bool RootItemManager::hasPendingMetadataWrite(const QString &id) const {
+  auto it = m_pendingMetadataWrites.find(id);
 
-  return nullptr;
+  return it != m_pendingMetadataWrites.end() && it->second > m_db.writeQueue().committedSequence();
 }
 
-RootProvider *RootItemManager::findProviderById(const QString &id) const {
-  auto it = std::ranges::find_if(m_providers, [&](auto &&provider) { return provider->uniqueId() == id; });
+bool RootItemManager::syncProviders(const std::vector<ProviderItems> &providers, bool partial,
+                                    bool notifyDefaulted) {
+  std::vector<QString> ids;
+  uint64_t committed = m_db.writeQueue().committedSequence();
 
-  if (it == m_providers.end()) return nullptr;
+  std::erase_if(m_pendingMetadataWrites, [&](const auto &pair) { return pair.second <= committed; });
 
-  return it->get();
+  if (partial) {
+    for (const auto &[_, items] : providers) {
+      for (const auto &item : items) {
+        ids.emplace_back(item->uniqueId());
+      }
+    }
+  }
+
+  auto loadedRecords = loadItemRecords(partial ? &ids : nullptr);
+
+  if (!loadedRecords) return false;
+
+  auto &records = *loadedRecords;
+  auto providerPreferences = loadProviderPreferenceValues();
+  std::vector<std::pair<const RootProvider *, const RootItem *>> missingItems;
+  std::vector<const RootProvider *> missingProviders;
+  std::vector<RootProvider *> defaultedProviders;
+
+  for (const auto &[provider, items] : providers) {
+    if (!providerPreferences.contains(provider->uniqueId())) { missingProviders.emplace_back(provider); }
+
+    if (auto &preferences = providerPreferences[provider->uniqueId()]; preferences.empty()) {
+      preferences = provider->generateDefaultPreferences();
+      if (!preferences.empty()) { defaultedProviders.emplace_back(provider); }
+    }
+
+    for (const auto &item : items) {
+      if (!records.contains(item->uniqueId())) { missingItems.emplace_back(provider, item.get()); }
+    }
+  }
+
+  if (!missingProviders.empty() || !missingItems.empty() || !defaultedProviders.empty()) {
+    if (!m_db.db().transaction()) {
+      qCritical() << "Failed to start root item sync transaction" << m_db.db().lastError();
+      return false;
+    }
+
+    QSqlQuery providerQuery = m_db.createQuery();
+    QSqlQuery itemQuery = m_db.createQuery();
+    QSqlQuery preferenceQuery = m_db.createQuery();
+
+    providerQuery.prepare("INSERT INTO root_provider (id) VALUES (:id) ON CONFLICT(id) DO NOTHING");
+    itemQuery.prepare(R"(
+		INSERT INTO 
+			root_provider_item (id, provider_id, enabled, fallback) 
+		VALUES (:id, :provider_id, :enabled, :fallback) 
+		ON CONFLICT(id) DO NOTHING
+	)");
+    preferenceQuery.prepare("UPDATE root_provider SET preference_values = :preferences WHERE id = :id");
+
+    for (const auto &provider : missingProviders) {
+      providerQuery.bindValue(":id", provider->uniqueId());
+
+      if (!providerQuery.exec()) {
+        qCritical() << "Failed to insert provider" << provider->uniqueId() << providerQuery.lastError();
+        m_db.db().rollback();
+        return false;
+      }
+    }
+
+    for (const auto &[provider, item] : missingItems) {
+      itemQuery.bindValue(":id", item->uniqueId());
+      itemQuery.bindValue(":provider_id", provider->uniqueId());
+      itemQuery.bindValue(":enabled", !item->isDefaultDisabled());
+      itemQuery.bindValue(":fallback", item->isDefaultFallback());
+
+      if (!itemQuery.exec()) {
+        qCritical() << "Failed to insert item" << item->uniqueId() << itemQuery.lastError();
+        m_db.db().rollback();
+        return false;
+      }
+
+      // mirrors the column defaults, so that we don't need to read the rows back
+      records[item->uniqueId()] = ItemRecord{.metadata = {
+                                                 .isEnabled = !item->isDefaultDisabled(),
+                                                 .lastVisitedAt = std::chrono::system_clock::from_time_t(0),
+                                                 .isFallback = item->isDefaultFallback(),
+                                                 .providerId = provider->uniqueId(),
+                                             }};
+    }
+
+    for (const auto &provider : defaultedProviders) {
+      preferenceQuery.bindValue(":preferences",
+                                QJsonDocument(providerPreferences[provider->uniqueId()]).toJson());
+      preferenceQuery.bindValue(":id", provider->uniqueId());
+
+      if (!preferenceQuery.exec()) {
+        qCritical() << "Failed to save default preferences for" << provider->uniqueId()
+                    << preferenceQuery.lastError();
+        m_db.db().rollback();
+        return false;
+      }
+    }
+
+    if (!m_db.db().commit()) {
+      qCritical() << "Failed to commit root item sync" << m_db.db().lastError();
+      return false;
+    }
+  }
+
+  for (const auto &[provider, items] : providers) {
+    for (const auto &item : items) {
+      auto &record = records[item->uniqueId()];
+
+      // the loaded row doesn't reflect writes that are still queued, unless the item was removed since
+      if (!hasPendingMetadataWrite(item->uniqueId()) || !m_metadata.contains(item->uniqueId())) {
+        m_metadata[item->uniqueId()] = record.metadata;
+      }
+      m_itemPreferenceValues[item->uniqueId()] = record.preferenceValues;
+      item->preferenceValuesChanged(withPreferenceDefaults(*item, record.preferenceValues));
+    }
+  }
+
+  if (notifyDefaulted) {
+    for (auto provider : defaultedProviders) {
+      provider->preferencesChanged(providerPreferences[provider->uniqueId()]);
+    }
+  }
+
+  return true;
 }
 
 void RootItemManager::reloadProviders() {
@@ -60,77 +269,138 @@ void RootItemManager::reloadProviders() {
     return;
   }
 
-  m_items.clear();
+  std::vector<ProviderItems> providers;
+
   isReloading = true;
+  providers.reserve(m_providers.size());
 
   for (const auto &provider : m_providers) {
-    auto items = provider->loadItems();
+    providers.emplace_back(ProviderItems{.provider = provider.get(), .items = provider->loadItems()});
+  }
 
-    if (!upsertProvider(*provider.get())) continue;
+  if (syncProviders(providers)) { rebuildItemIndex(providers); }
 
-    m_items.insert(m_items.end(), items.begin(), items.end());
+  isReloading = false;
+  emit itemsChanged();
+}
+
+void RootItemManager::rebuildItemIndex(const std::vector<ProviderItems> &providers) {
+  m_items.clear();
+  m_itemIndex.clear();
+  m_providerItems.clear();
 
-    std::ranges::for_each(items, [&](const auto &item) { upsertItem(provider->uniqueId(), *item.get()); });
+  for (const auto &[provider, items] : providers) {
+    auto &ids = m_providerItems[provider];
 
-    auto preferences = getProviderPreferenceValues(provider->uniqueId());
+    for (const auto &item : items) {
+      auto id = item->uniqueId();
 
-    if (preferences.empty()) {
-      preferences = provider->generateDefaultPreferences();
+      // first one wins, same as the linear lookup we used to do
+      if (!m_itemIndex.try_emplace(id, m_items.size()).second) continue;
+
+      ids.insert(id);
+      m_items.emplace_back(item);
+    }
+  }
+}
 
-      if (!preferences.empty()) { setProviderPreferenceValues(provider->uniqueId(), preferences); }
+void RootItemManager::reloadProvider(RootProvider *provider) {
+  auto items = provider->loadItems();
+  auto &current = m_providerItems[provider];
+  std::unordered_set<QString> seen;
+  RootItemDelta delta;
+
+  seen.reserve(items.size());
+
+  for (const auto &item : items) {
+    auto id = item->uniqueId();
+
+    seen.insert(id);
+
+    if (!current.contains(id)) {
+      delta.added.emplace_back(item);
+      continue;
     }
 
-    // provider->preferencesChanged(preferences);
+    if (auto existing = findItemById(id); !existing || !existing->hasSameData(*item)) {
+      delta.updated.emplace_back(item);
+    }
   }
 
-  isReloading = false;
-  emit itemsChanged();
+  for (const auto &id : current) {
+    if (!seen.contains(id)) delta.removed.emplace_back(id);
+  }
+
+  applyDelta(provider, delta);
 }
 
-bool RootItemManager::upsertItem(const QString &providerId, const RootItem &item) {
-  QSqlQuery query = m_db.createQuery();
+void RootItemManager::removeItem(const QString &id) {
+  auto it = m_itemIndex.find(id);
 
-  query.prepare(R"(
-		INSERT INTO 
-			root_provider_item (id, provider_id, enabled, fallback) 
-		VALUES (:id, :provider_id, :enabled, :fallback) 
-		ON CONFLICT(id) DO NOTHING
-	)");
-  query.bindValue(":id", item.uniqueId());
-  query.bindValue(":provider_id", providerId);
-  query.bindValue(":enabled", !item.isDefaultDisabled());
-  query.bindValue(":fallback", item.isDefaultFallback());
+  if (it == m_itemIndex.end()) return;
 
-  if (!query.exec()) {
-    qCritical() << "Failed to upsert provider with id" << item.uniqueId() << query.lastError();
-    return false;
+  size_t index = it->second;
+
+  // order doesn't matter as results are always sorted, swap with the last item to avoid shifting
+  if (index != m_items.size() - 1) {
+    m_items[index] = std::move(m_items.back());
+    m_itemIndex[m_items[index]->uniqueId()] = index;
   }
 
-  m_metadata[item.uniqueId()] = loadMetadata(item.uniqueId());
+  m_items.pop_back();
+  m_itemIndex.erase(it);
+  m_metadata.erase(id);
+  m_itemPreferenceValues.erase(id);
+}
 
-  item.preferenceValuesChanged(getItemPreferenceValues(item.uniqueId()));
+void RootItemManager::applyDelta(RootProvider *provider, const RootItemDelta &delta) {
+  if (delta.empty()) return;
 
-  return true;
-}
+  auto &ids = m_providerItems[provider];
+  std::vector<std::shared_ptr<RootItem>> inserted;
+  std::vector<std::shared_ptr<RootItem>> updated;
 
-bool RootItemManager::upsertProvider(const RootProvider &provider) {
-  QSqlQuery query = m_db.createQuery();
+  // providers don't always know whether we already have an item, so both lists are sorted out here
+  auto sortOut = [&](const std::vector<std::shared_ptr<RootItem>> &items) {
+    for (const auto &item : items) {
+      if (m_itemIndex.contains(item->uniqueId())) {
+        updated.emplace_back(item);
+      } else {
+        inserted.emplace_back(item);
+      }
+    }
+  };
 
-  query.prepare(R"(
-		INSERT INTO 
-			root_provider (id) 
-		VALUES (:id) 
-		ON CONFLICT(id) 
-		DO NOTHING 
-	)");
-  query.bindValue(":id", provider.uniqueId());
+  sortOut(delta.added);
+  sortOut(delta.updated);
 
-  if (!query.exec()) {
-    qWarning() << "Failed to upsert provider with id" << provider.uniqueId() << query.lastError();
-    return false;
+  // only new items may need to hit the database, existing ones already have their metadata loaded
+  if (!inserted.empty() && !syncProviders({{.provider = provider, .items = inserted}}, true)) { return; }
+
+  for (const auto &id : delta.removed) {
+    if (ids.erase(id)) removeItem(id);
   }
 
-  return true;
+  for (const auto &item : updated) {
+    auto id = item->uniqueId();
+    auto it = m_itemIndex.find(id);
+
+    if (it == m_itemIndex.end()) continue;
+
+    m_items[it->second] = item;
+    item->preferenceValuesChanged(withPreferenceDefaults(*item, m_itemPreferenceValues[id]));
+  }
+
+  for (const auto &item : inserted) {
+    auto id = item->uniqueId();
+
+    if (!m_itemIndex.try_emplace(id, m_items.size()).second) continue;
+
+    ids.insert(id);
+    m_items.emplace_back(item);
+  }
+
+  emit itemsChanged();
 }
 
 std::vector<std::shared_ptr<RootItem>>
@@ -162,28 +432,19 @@ RootItemManager::prefixSearch(const QString &query, const RootItemPrefixSearchOp
 }
 
 bool RootItemManager::setItemEnabled(const QString &id, bool value) {
-  auto it = std::ranges::find_if(m_items, [&id](const auto &item) { return item->uniqueId() == id; });
-
-  if (it == m_items.end()) {
+  if (!findItemById(id)) {
     qCritical() << "No such item to enable" << id;
     return false;
   }
 
-  QSqlQuery query = m_db.createQuery();
-
-  query.prepare("UPDATE root_provider_item SET enabled = :enabled WHERE id = :id");
-  query.bindValue(":enabled", value);
-  query.bindValue(":id", id);
-
-  if (!query.exec()) {
-    qDebug() << "Failed to update item" << query.lastError();
-    return false;
-  }
+  queueMetadataWrite({.sql = "UPDATE root_provider_item SET enabled = :enabled WHERE id = :id",
+                      .bindings = {{":enabled", value}, {":id", id}}},
+                     {id}, "enabled:" + id);
 
-  auto metadata = itemMetadata((*it)->uniqueId());
+  auto metadata = itemMetadata(id);
 
   metadata.isEnabled = value;
-  m_metadata[(*it)->uniqueId()] = metadata;
+  m_metadata[id] = metadata;
 
   return true;
 }
@@ -232,6 +493,7 @@ bool RootItemManager::setItemPreferenceValues(const QString &id, const QJsonObje
     return false;
   }
 
+  m_itemPreferenceValues[id] = preferences;
   item->preferenceValuesChanged(preferences);
 
   return true;
@@ -281,23 +543,14 @@ void RootItemManager::setPreferenceValues(const QString &id, const QJsonObject &
 }
 
 bool RootItemManager::setAlias(const QString &id, const QString &alias) {
-  auto it = std::ranges::find_if(m_items, [&id](const auto &item) { return item->uniqueId() == id; });
-
-  if (it == m_items.end()) {
+  if (!findItemById(id)) {
     qCritical() << "setAlias: no item with id " << id;
     return false;
   }
 
-  QSqlQuery query = m_db.createQuery();
-
-  query.prepare("UPDATE root_provider_item SET alias = :alias WHERE id = :id");
-  query.bindValue(":alias", alias);
-  query.bindValue(":id", id);
-
-  if (!query.exec()) {
-    qDebug() << "Failed to update item" << query.lastError();
-    return false;
-  }
+  queueMetadataWrite({.sql = "UPDATE root_provider_item SET alias = :alias WHERE id = :id",
+                      .bindings = {{":alias", alias}, {":id", id}}},
+                     {id}, "alias:" + id);
 
   auto metadata = itemMetadata(id);
 
@@ -355,11 +608,9 @@ bool RootItemManager::pruneProvider(const QString &id) {
 
 QJsonObject RootItemManager::getItemPreferenceValues(const QString &id) const {
   auto query = m_db.createQuery();
-  auto it = std::ranges::find_if(m_items, [&id](const auto &item) { return item->uniqueId() == id; });
-
-  if (it == m_items.end()) { return {}; }
+  auto item = findItemById(id);
 
-  auto &item = *it;
+  if (!item) { return {}; }
 
   query.prepare(R"(
 		SELECT 
@@ -382,16 +633,8 @@ QJsonObject RootItemManager::getItemPreferenceValues(const QString &id) const {
   }
   auto rawJson = query.value(0).toString();
   auto json = QJsonDocument::fromJson(rawJson.toUtf8());
-  QJsonObject values = json.object();
-
-  for (const auto &preference : item->preferences()) {
-    QJsonValue defaultValue = preference.defaultValue();
-    if (!values.contains(preference.name()) && !defaultValue.isNull()) {
-      values[preference.name()] = defaultValue;
-    }
-  }
 
-  return values;
+  return withPreferenceDefaults(*item, json.object());
 }
 
 std::vector<Preference> RootItemManager::getMergedItemPreferences(const QString &rootItemId) const {
@@ -478,15 +721,10 @@ int RootItemManager::maxFallbackPosition() {
 bool RootItemManager::isFallback(const QString &id) { return itemMetadata(id).isFallback; }
 
 bool RootItemManager::disableFallback(const QString &id) {
-  QSqlQuery query = m_db.createQuery();
-
-  query.prepare("UPDATE root_provider_item SET fallback = 0, fallback_position = -1 WHERE id = :id");
-  query.bindValue(":id", id);
-
-  if (!query.exec()) {
-    qCritical() << "Failed to disable fallback for id" << id;
-    return false;
-  }
+  queueMetadataWrite(
+      {.sql = "UPDATE root_provider_item SET fallback = 0, fallback_position = -1 WHERE id = :id",
+       .bindings = {{":id", id}}},
+      {id});
 
   auto meta = itemMetadata(id);
 
@@ -498,45 +736,30 @@ bool RootItemManager::disableFallback(const QString &id) {
 }
 
 bool RootItemManager::setFallback(const QString &id, int position) {
-  if (!m_db.db().transaction()) { return false; }
+  std::vector<QString> shiftedIds;
 
-  QSqlQuery query = m_db.createQuery();
+  for (auto &[itemId, metadata] : m_metadata) {
+    if (metadata.fallbackPosition >= position) {
+      metadata.fallbackPosition += 1;
+      shiftedIds.emplace_back(itemId);
+    }
+  }
 
-  query.prepare(R"(
+  // both writes are queued back to back, so they end up in the same transaction
+  queueMetadataWrite({.sql = R"(
 		UPDATE root_provider_item
 		SET fallback_position = fallback_position + 1
 		WHERE fallback_position >= :position
-	)");
-  query.bindValue(":id", id);
-  query.bindValue(":position", position);
-
-  if (!query.exec()) {
-    qCritical() << "Failed to set fallback" << query.lastError();
-    m_db.db().rollback();
-    return false;
-  }
-
-  query.prepare(R"(
+	)",
+                      .bindings = {{":position", position}}},
+                     shiftedIds);
+  queueMetadataWrite({.sql = R"(
 		UPDATE root_provider_item 
 		SET fallback = 1, fallback_position = :position 
 		WHERE id = :id
-	)");
-  query.bindValue(":id", id);
-  query.bindValue(":position", position);
-
-  if (!query.exec()) {
-    qCritical() << "Failed to set fallback" << query.lastError();
-    m_db.db().rollback();
-    return false;
-  }
-
-  if (!m_db.db().commit()) { return false; }
-
-  qDebug() << "updated fallback pos for" << id << position;
-
-  for (auto &pair : m_metadata) {
-    if (pair.second.fallbackPosition >= position) pair.second.fallbackPosition += 1;
-  }
+	)",
+                      .bindings = {{":id", id}, {":position", position}}},
+                     {id});
 
   auto metadata = itemMetadata(id);
 
@@ -549,20 +772,13 @@ bool RootItemManager::setFallback(const QString &id, int position) {
 }
 
 bool RootItemManager::setItemAsFavorite(const QString &itemId, bool value) {
-  auto query = m_db.createQuery();
-
-  query.prepare(R"(
+  queueMetadataWrite({.sql = R"(
 		UPDATE root_provider_item 
 		SET favorite = :favorite
 		WHERE id = :id
-	)");
-  query.addBindValue(value);
-  query.addBindValue(itemId);
-
-  if (!query.exec()) {
-    qCritical() << "Failed to set item as favorite" << itemId << value;
-    return false;
-  }
+	)",
+                      .bindings = {{":favorite", value}, {":id", itemId}}},
+                     {itemId}, "favorite:" + itemId);
 
   m_metadata[itemId].favorite = value;
   emit itemFavoriteChanged(itemId, value);
@@ -636,21 +852,15 @@ std::vector<std::shared_ptr<RootItem>> RootItemManager::querySuggestions(int lim
 }
 
 bool RootItemManager::resetRanking(const QString &id) {
-  QSqlQuery query = m_db.createQuery();
-
-  query.prepare(R"(
+  queueMetadataWrite({.sql = R"(
 		UPDATE root_provider_item 
 		SET 
 			rank_visit_count = 0,
 			rank_last_visited_at = NULL
 		WHERE id = :id
-	)");
-  query.addBindValue(id);
-
-  if (!query.exec()) {
-    qCritical() << "Failed to reset ranking" << query.lastError();
-    return false;
-  }
+	)",
+                      .bindings = {{":id", id}}},
+                     {id});
 
   RootItemMetadata &metadata = m_metadata[id];
 
@@ -662,9 +872,14 @@ bool RootItemManager::resetRanking(const QString &id) {
 }
 
 bool RootItemManager::registerVisit(const QString &id) {
-  QSqlQuery query = m_db.createQuery();
+  auto it = m_metadata.find(id);
 
-  query.prepare(R"(
+  if (it == m_metadata.end()) {
+    qCritical() << "registerVisit: no item with id" << id;
+    return false;
+  }
+
+  queueMetadataWrite({.sql = R"(
 		UPDATE root_provider_item 
 		SET 
 			visit_count = visit_count + 1,
@@ -672,19 +887,13 @@ bool RootItemManager::registerVisit(const QString &id) {
 			last_visited_at = unixepoch(),
 			rank_last_visited_at = unixepoch()
 		WHERE id = :id
-		RETURNING rank_visit_count, rank_last_visited_at, visit_count, last_visited_at
-	)");
-  query.bindValue(":id", id);
-
-  if (!query.exec() || !query.next()) {
-    qDebug() << "Failed to update item" << query.lastError();
-    return false;
-  }
-
-  RootItemMetadata &meta = m_metadata[id];
+	)",
+                      .bindings = {{":id", id}}},
+                     {id});
 
-  meta.visitCount = query.value(0).toInt();
-  meta.lastVisitedAt = std::chrono::system_clock::from_time_t(query.value(1).toULongLong());
+  // mirrors what the queued write does, the database stores it with a precision of one second
+  it->second.visitCount += 1;
+  it->second.lastVisitedAt = std::chrono::system_clock::from_time_t(std::time(nullptr));
 
   return true;
 }
@@ -696,24 +905,22 @@ QString RootItemManager::getItemProviderId(const QString &id) {
 }
 
 bool RootItemManager::setProviderEnabled(const QString &providerId, bool value) {
-  QSqlQuery query = m_db.createQuery();
+  std::vector<QString> ids;
 
-  query.prepare(R"(
+  for (auto &[id, metadata] : m_metadata) {
+    if (providerId == metadata.providerId) {
+      metadata.isEnabled = value;
+      ids.emplace_back(id);
+    }
+  }
+
+  queueMetadataWrite({.sql = R"(
 		UPDATE root_provider_item
 		SET enabled = :enabled
 		WHERE provider_id = :provider_id
-	)");
-  query.bindValue(":enabled", value);
-  query.bindValue(":provider_id", providerId);
-
-  if (!query.exec()) {
-    qDebug() << "Failed to update item" << query.lastError();
-    return false;
-  }
-
-  for (auto &[id, metadata] : m_metadata) {
-    if (providerId == metadata.providerId) { metadata.isEnabled = value; }
-  }
+	)",
+                      .bindings = {{":enabled", value}, {":provider_id", providerId}}},
+                     ids);
 
   m_provider_metadata[providerId].enabled = value;
 
@@ -730,42 +937,45 @@ std::vector<RootProvider *> RootItemManager::providers() const {
 }
 
 void RootItemManager::removeProvider(const QString &id) {
+  auto it = std::ranges::find_if(m_providers, [&](auto &&p) { return p->uniqueId() == id; });
+
   pruneProvider(id);
-  std::erase_if(m_providers, [&](auto &&p) { return p->uniqueId() == id; });
-  reloadProviders();
-}
 
-void RootItemManager::addProvider(std::unique_ptr<RootProvider> provider) {
-  auto items = provider->loadItems();
+  if (it == m_providers.end()) return;
 
-  if (!m_db.db().transaction()) { qWarning() << "Failed to start upsert transaction"; }
+  RootItemDelta delta;
 
-  if (!upsertProvider(*provider.get())) {
-    m_db.db().rollback();
-    return;
+  if (auto items = m_providerItems.find(it->get()); items != m_providerItems.end()) {
+    delta.removed.assign(items->second.begin(), items->second.end());
   }
 
-  m_items.insert(m_items.end(), items.begin(), items.end());
+  applyDelta(it->get(), delta);
+  m_providerItems.erase(it->get());
+  m_providers.erase(it);
+}
 
-  std::ranges::for_each(items, [&](const auto &item) { upsertItem(provider->uniqueId(), *item.get()); });
+void RootItemManager::addProvider(std::unique_ptr<RootProvider> provider) {
+  auto items = provider->loadItems();
+  auto &ids = m_providerItems[provider.get()];
 
-  m_db.db().commit();
+  // notified below whether its preferences were defaulted or not
+  if (!syncProviders({{.provider = provider.get(), .items = items}}, false, false)) return;
 
-  auto preferences = getProviderPreferenceValues(provider->uniqueId());
+  for (const auto &item : items) {
+    auto id = item->uniqueId();
 
-  if (preferences.empty()) {
-    preferences = provider->generateDefaultPreferences();
+    if (!m_itemIndex.try_emplace(id, m_items.size()).second) continue;
 
-    if (!preferences.empty()) {
-      qCritical() << "set default preferences for app" << provider->uniqueId();
-      setProviderPreferenceValues(provider->uniqueId(), preferences);
-    }
+    ids.insert(id);
+    m_items.emplace_back(item);
   }
 
-  provider->preferencesChanged(preferences);
+  provider->preferencesChanged(getProviderPreferenceValues(provider->uniqueId()));
 
   connect(provider.get(), &RootProvider::itemsChanged, this,
-          [this, name = provider->uniqueId()]() { reloadProviders(); });
+          [this, provider = provider.get()]() { reloadProvider(provider); });
+  connect(provider.get(), &RootProvider::itemsDelta, this,
+          [this, provider = provider.get()](const RootItemDelta &delta) { applyDelta(provider, delta); });
   m_providers.emplace_back(std::move(provider));
   emit itemsChanged();
 }
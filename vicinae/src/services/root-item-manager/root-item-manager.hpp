@@ -20,6 +20,7 @@
 #include <qhash.h>
 #include <qtmetamacros.h>
 #include <qwidget.h>
+#include <unordered_set>
 
 class RootItemMetadata;
 
@@ -128,6 +129,25 @@ public:
   virtual std::vector<QString> keywords() const { return {}; }
 
   virtual void preferenceValuesChanged(const QJsonObject &values) const {}
+
+  /**
+   * Whether `other`, an item with the same unique id, holds the same data as this one, in which
+   * case reloading the provider keeps the current item as is. Items that can't tell are always
+   * considered changed.
+   */
+  virtual bool hasSameData(const RootItem &other) const { return false; }
+};
+
+/**
+ * Set of changes made to the items of a single provider.
+ * Updated items replace the item with the same unique id.
+ */
+struct RootItemDelta {
+  std::vector<std::shared_ptr<RootItem>> added;
+  std::vector<std::shared_ptr<RootItem>> updated;
+  std::vector<QString> removed;
+
+  bool empty() const { return added.empty() && updated.empty() && removed.empty(); }
 };
 
 class RootProvider : public QObject {
@@ -182,7 +202,13 @@ public:
   virtual PreferenceList preferences() const { return {}; }
 
 signals:
+  /**
+   * Signals that the items of this provider changed in an unknown way.
+   * Only this provider is reloaded, and its items are diffed against the current ones.
+   * Providers that know what changed should emit `itemsDelta` instead.
+   */
   void itemsChanged() const;
+  void itemsDelta(const RootItemDelta &delta) const;
   void itemRemoved(const QString &id) const;
 };
 
@@ -211,18 +237,63 @@ private:
   };
 
   std::vector<std::shared_ptr<RootItem>> m_items;
+  std::unordered_map<QString, size_t> m_itemIndex;
+  std::unordered_map<const RootProvider *, std::unordered_set<QString>> m_providerItems;
+  std::unordered_map<QString, QJsonObject> m_itemPreferenceValues;
   std::unordered_map<QString, RootItemMetadata> m_metadata;
   std::unordered_map<QString, RootProviderMetadata> m_provider_metadata;
   std::vector<std::unique_ptr<RootProvider>> m_providers;
   OmniDatabase &m_db;
 
-  RootItemMetadata loadMetadata(const QString &id);
-  bool upsertProvider(const RootProvider &provider);
-  bool upsertItem(const QString &providerId, const RootItem &item);
+  // sequence number of the last queued write that touched the metadata of an item
+  std::unordered_map<QString, uint64_t> m_pendingMetadataWrites;
+
+  struct ItemRecord {
+    RootItemMetadata metadata;
+    QJsonObject preferenceValues;
+  };
+
+  struct ProviderItems {
+    RootProvider *provider;
+    std::vector<std::shared_ptr<RootItem>> items;
+  };
+
+  /**
+   * Load the rows of all items, or only those in `ids` if provided.
+   */
+  std::optional<std::unordered_map<QString, ItemRecord>>
+  loadItemRecords(const std::vector<QString> *ids = nullptr);
+  std::unordered_map<QString, QJsonObject> loadProviderPreferenceValues();
+  QJsonObject withPreferenceDefaults(const RootItem &item, QJsonObject values) const;
+
+  /**
+   * Reconcile the database with the items provided by `providers`, using one query to load
+   * the existing rows and a single transaction to insert the missing ones.
+   * Item metadata is refreshed in memory and `preferenceValuesChanged` is called for every item.
+   * If `partial` is true, only the rows of the provided items are loaded, which is what we want
+   * when syncing a small delta.
+   * Providers whose preferences were defaulted get `preferencesChanged` once the defaults are stored,
+   * unless `notifyDefaulted` is false because the caller notifies them itself.
+   */
+  bool syncProviders(const std::vector<ProviderItems> &providers, bool partial = false,
+                     bool notifyDefaulted = true);
+  void rebuildItemIndex(const std::vector<ProviderItems> &providers);
+  void reloadProvider(RootProvider *provider);
+  void applyDelta(RootProvider *provider, const RootItemDelta &delta);
+  void removeItem(const QString &id);
   RootItem *findItemById(const QString &id) const;
   RootProvider *findProviderById(const QString &id) const;
   bool pruneProvider(const QString &id);
 
+  /**
+   * Metadata writes go through the database write queue, so that ranking and toggling items never
+   * waits on disk. Until the write is committed, the in-memory metadata of the items in `ids` is
+   * preferred over what is loaded from the database.
+   */
+  void queueMetadataWrite(SqlWriteQueue::Statement statement, const std::vector<QString> &ids,
+                          const QString &key = {});
+  bool hasPendingMetadataWrite(const QString &id) const;
+
 public:
   RootItemManager(OmniDatabase &db) : m_db(db) {}
 
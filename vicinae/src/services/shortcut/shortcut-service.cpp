@@ -49,22 +49,6 @@ Shortcut *ShortcutService::findById(const QString &id) {
 }
 
 bool ShortcutService::registerVisit(const QString &id) {
-  QSqlQuery query = m_db.createQuery();
-
-  query.prepare("UPDATE shortcut SET last_used_at = unixepoch(), open_count = open_count + 1 WHERE id = :id "
-                "RETURNING last_used_at, open_count");
-  query.bindValue(":id", id);
-
-  if (!query.exec()) {
-    qWarning() << "Failed to register shortcut visit" << query.lastError();
-    return false;
-  }
-
-  if (!query.next()) {
-    qWarning() << "No shortcut" << id << "to update";
-    return false;
-  }
-
   auto shortcut = findById(id);
 
   if (!shortcut) {
@@ -72,11 +56,13 @@ bool ShortcutService::registerVisit(const QString &id) {
     return false;
   }
 
-  auto lastOpenedAtEpoch = query.value(0).toULongLong();
-  int count = query.value(1).toInt();
+  // shortcuts are only loaded once, so the in-memory state doesn't need the write to be committed
+  m_db.writeQueue().enqueue(
+      {.sql = "UPDATE shortcut SET last_used_at = unixepoch(), open_count = open_count + 1 WHERE id = :id",
+       .bindings = {{":id", id}}});
 
-  shortcut->setLastOpenedAt(QDateTime::fromSecsSinceEpoch(lastOpenedAtEpoch));
-  shortcut->setOpenCount(count);
+  shortcut->setLastOpenedAt(QDateTime::fromSecsSinceEpoch(QDateTime::currentSecsSinceEpoch()));
+  shortcut->setOpenCount(shortcut->openCount() + 1);
   emit shortcutVisited(id);
 
   return true;
@@ -4,6 +4,6 @@ class DummyWindowManager : public AbstractWindowManager {
   QString id() const override { return "dummy"; }
   QString displayName() const override { return "Dummy (No window manager available)"; }
   bool isActivatable() const override { return false; }
-  void start() const override {}
+  void start() override {}
   bool ping() const override { return false; }
 };
@@ -1,6 +1,8 @@
 #include "gnome-window-manager.hpp"
 #include "utils/environment.hpp"
 #include <QDBusConnection>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
 #include <QDBusReply>
 #include <QJsonDocument>
 #include <QJsonValue>
@@ -100,21 +102,13 @@ QJsonArray GnomeWindowManager::parseJsonArrayResponse(const QString &response) c
   return doc.array();
 }
 
-AbstractWindowManager::WindowList GnomeWindowManager::listWindowsSync() const {
-  qDebug() << "GnomeWindowManager: Listing windows";
-
-  QString response = callDBusMethod("List");
+AbstractWindowManager::WindowList GnomeWindowManager::parseWindowList(const QString &response) const {
   if (response.isEmpty()) {
     qWarning() << "GnomeWindowManager: No response from List method";
     return {};
   }
 
   QJsonArray windowsArray = parseJsonArrayResponse(response);
-  if (windowsArray.isEmpty()) {
-    qDebug() << "GnomeWindowManager: No windows found";
-    return {};
-  }
-
   WindowList windows;
   windows.reserve(windowsArray.size());
 
@@ -129,27 +123,83 @@ AbstractWindowManager::WindowList GnomeWindowManager::listWindowsSync() const {
     windows.push_back(window);
   }
 
-  qDebug() << "GnomeWindowManager: Found" << windows.size() << "windows";
   return windows;
 }
 
+void GnomeWindowManager::setWindows(WindowList windows) const {
+  auto isSame = [](const WindowPtr &a, const WindowPtr &b) {
+    auto ga = std::static_pointer_cast<GnomeWindow>(a);
+    auto gb = std::static_pointer_cast<GnomeWindow>(b);
+
+    return ga->id() == gb->id() && ga->title() == gb->title() && ga->focused() == gb->focused() &&
+           ga->workspace() == gb->workspace();
+  };
+  bool changed = !std::ranges::equal(windows, m_windows, isSame);
+
+  m_windows = std::move(windows);
+
+  // only notify actual changes, as listeners typically query the window list right away
+  if (changed) emit windowsChanged();
+}
+
+void GnomeWindowManager::refreshWindows() const {
+  if (m_refreshPending) {
+    m_refreshQueued = true;
+    return;
+  }
+
+  auto *interface = getDBusInterface();
+  if (!interface || !interface->isValid()) return;
+
+  auto watcher = new QDBusPendingCallWatcher(interface->asyncCall("List"), interface);
+
+  m_refreshPending = true;
+  connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *watcher) {
+    QDBusPendingReply<QString> reply = *watcher;
+
+    watcher->deleteLater();
+    m_refreshPending = false;
+
+    if (reply.isError()) {
+      qWarning() << "GnomeWindowManager: D-Bus call failed for method: List"
+                 << "Error:" << reply.error().message();
+    } else {
+      setWindows(parseWindowList(reply.value()));
+    }
+
+    // something changed while the request was in flight
+    if (std::exchange(m_refreshQueued, false)) refreshWindows();
+  });
+}
+
+void GnomeWindowManager::handleWindowSignal() {
+  m_signalsReceived = true;
+  refreshWindows();
+}
+
+void GnomeWindowManager::refreshWindowsSync() const {
+  QString response = callDBusMethod("List");
+
+  // keep the last known list if the call failed
+  if (!response.isEmpty()) setWindows(parseWindowList(response));
+}
+
+AbstractWindowManager::WindowList GnomeWindowManager::listWindowsSync() const {
+  // without signals from the extension, we have no other way to know the list is outdated
+  if (!m_signalsReceived) refreshWindowsSync();
+
+  return m_windows;
+}
+
 std::shared_ptr<AbstractWindowManager::AbstractWindow> GnomeWindowManager::getFocusedWindowSync() const {
-  qDebug() << "GnomeWindowManager: Getting focused window";
-
-  // Get all windows and find the focused one
-  auto windows = listWindowsSync();
-
-  for (const auto &window : windows) {
-    // Cast to GnomeWindow to access GNOME-specific properties
-    if (auto gnomeWindow = std::dynamic_pointer_cast<GnomeWindow>(window)) {
-      if (gnomeWindow->focused()) {
-        qDebug() << "GnomeWindowManager: Found focused window:" << gnomeWindow->title();
-        return gnomeWindow;
-      }
+  if (!m_signalsReceived) refreshWindowsSync();
+
+  for (const auto &window : m_windows) {
+    if (auto gnomeWindow = std::static_pointer_cast<GnomeWindow>(window); gnomeWindow->focused()) {
+      return gnomeWindow;
     }
   }
 
-  qDebug() << "GnomeWindowManager: No focused window found";
   return nullptr;
 }
 
@@ -213,9 +263,16 @@ bool GnomeWindowManager::ping() const {
   return !response.isEmpty();
 }
 
-void GnomeWindowManager::start() const {
+void GnomeWindowManager::start() {
+  auto bus = QDBusConnection::sessionBus();
+
+  for (const char *signal : DBUS_SIGNALS) {
+    bus.connect(DBUS_SERVICE, DBUS_PATH, DBUS_INTERFACE, signal, this, SLOT(handleWindowSignal()));
+  }
+
+  // the only blocking call, so that the list is available right away
+  setWindows(parseWindowList(callDBusMethod("List")));
   qDebug() << "GnomeWindowManager: Window manager started";
-  // No special startup required for GNOME integration
 }
 
 bool GnomeWindowManager::closeWindow(const AbstractWindow &window) const {
@@ -227,7 +284,7 @@ bool GnomeWindowManager::closeWindow(const AbstractWindow &window) const {
 
   if (!callDBusMethodVoid("Close", args)) { return false; }
 
-  emit windowsChanged();
+  refreshWindows();
 
   return true;
 }
@@ -4,19 +4,42 @@
 #include <QDBusInterface>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <array>
 #include <memory>
 
 /**
  * Window manager implementation for GNOME Shell.
  * Communicates with the Vicinae GNOME extension via D-Bus to manage windows.
+ *
+ * The window list is kept in memory and refreshed asynchronously whenever the extension emits one of
+ * `DBUS_SIGNALS`, so that queries don't block on D-Bus. Older versions of the extension don't emit
+ * them: until a first signal is received, queries fetch the list synchronously, as the cached list
+ * could otherwise point paste actions to a window that is no longer focused.
  */
 class GnomeWindowManager : public AbstractWindowManager {
+  Q_OBJECT
+
 private:
   static constexpr const char *DBUS_SERVICE = "org.gnome.Shell";
   static constexpr const char *DBUS_PATH = "/org/gnome/Shell/Extensions/Windows";
   static constexpr const char *DBUS_INTERFACE = "org.gnome.Shell.Extensions.Windows";
+  static constexpr std::array<const char *, 4> DBUS_SIGNALS = {"WindowOpened", "WindowClosed",
+                                                                "WindowFocused", "WindowChanged"};
 
   mutable std::unique_ptr<QDBusInterface> m_dbusInterface;
+  mutable WindowList m_windows;
+  mutable bool m_refreshPending = false;
+  mutable bool m_refreshQueued = false;
+  bool m_signalsReceived = false;
+
+  /**
+   * Fetch the window list in the background, emitting `windowsChanged` if it differs from the
+   * current one.
+   */
+  void refreshWindows() const;
+  void refreshWindowsSync() const;
+  void setWindows(WindowList windows) const;
+  WindowList parseWindowList(const QString &response) const;
 
   /**
    * Get or create the D-Bus interface
@@ -54,7 +77,7 @@ public:
 
   bool isActivatable() const override;
   bool ping() const override;
-  void start() const override;
+  void start() override;
 
   // GNOME-specific capabilities
   bool supportsInputForwarding() const override { return false; } // Not implemented yet
@@ -66,4 +89,7 @@ public:
    * Get detailed information for a specific window
    */
   std::shared_ptr<GnomeWindow> getWindowDetails(uint32_t windowId) const;
+
+private slots:
+  void handleWindowSignal();
 };
@@ -0,0 +1,157 @@
+#include "hyprctl.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <qlogging.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static constexpr std::string_view BATCH_PREFIX = "[[BATCH]]";
+// hyprland separates the responses of batched commands with this
+static constexpr QByteArrayView BATCH_RESPONSE_SEPARATOR = "\n\n\n";
+static constexpr qsizetype READ_CHUNK_SIZE = 8192;
+
+std::filesystem::path Hyprctl::socketPath() {
+  std::filesystem::path rundir = "/tmp";
+  auto his = getenv("HYPRLAND_INSTANCE_SIGNATURE");
+
+  if (!his) { qWarning() << "Hyprctl: HYPRLAND_INSTANCE_SIGNATURE is not set"; }
+  if (auto p = getenv("XDG_RUNTIME_DIR")) rundir = p;
+
+  return rundir / "hypr" / (his ? his : "") / ".socket.sock";
+}
+
+QByteArray Hyprctl::oneshot(std::string_view command) {
+  auto sockPath = socketPath();
+  int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+
+  if (sock < 0) {
+    qWarning() << "Hyprctl::oneshot() failed: socket() =>" << strerror(errno);
+    return {};
+  }
+
+  struct sockaddr_un serverAddr;
+
+  memset(&serverAddr, 0, sizeof(serverAddr));
+  serverAddr.sun_family = AF_UNIX;
+  strncpy(serverAddr.sun_path, sockPath.c_str(), sizeof(serverAddr.sun_path) - 1);
+
+  if (::connect(sock, reinterpret_cast<sockaddr *>(&serverAddr), sizeof(serverAddr)) < 0) {
+    qWarning() << "Hyprctl::oneshot() failed: connect() =>" << strerror(errno);
+    close(sock);
+    return {};
+  }
+
+  if (send(sock, command.data(), command.size(), 0) <= 0) {
+    qWarning() << "Hyprctl::oneshot() failed: send() =>" << strerror(errno);
+    close(sock);
+    return {};
+  }
+
+  QByteArray data;
+  qsizetype size = 0;
+  ssize_t rc = 0;
+
+  // read straight into the response, growing it as needed instead of appending from a small buffer
+  do {
+    size += rc;
+    if (data.size() - size < READ_CHUNK_SIZE) data.resize(std::max(data.size() * 2, size + READ_CHUNK_SIZE));
+  } while ((rc = recv(sock, data.data() + size, data.size() - size, 0)) > 0);
+
+  close(sock);
+
+  if (rc == -1) return {};
+
+  data.truncate(size);
+
+  return data;
+}
+
+std::string Hyprctl::batch(const std::vector<std::string> &commands) {
+  std::string request(BATCH_PREFIX);
+
+  for (const auto &command : commands) {
+    if (request.size() > BATCH_PREFIX.size()) request += ';';
+    request += command;
+  }
+
+  return request;
+}
+
+std::vector<QByteArrayView> Hyprctl::splitBatchResponse(QByteArrayView response) {
+  std::vector<QByteArrayView> responses;
+  qsizetype start = 0;
+
+  for (qsizetype idx = response.indexOf(BATCH_RESPONSE_SEPARATOR); idx != -1;
+       idx = response.indexOf(BATCH_RESPONSE_SEPARATOR, start)) {
+    responses.emplace_back(response.sliced(start, idx - start));
+    start = idx + BATCH_RESPONSE_SEPARATOR.size();
+  }
+
+  if (start < response.size()) responses.emplace_back(response.sliced(start));
+
+  return responses;
+}
+
+QByteArray Hyprctl::takeBuffer() {
+  if (m_buffers.empty()) return {};
+
+  QByteArray buffer = std::move(m_buffers.back());
+
+  m_buffers.pop_back();
+
+  return buffer;
+}
+
+void Hyprctl::recycleBuffer(QByteArray buffer) {
+  // keeps the allocated capacity around for the next response
+  buffer.resize(0);
+  m_buffers.emplace_back(std::move(buffer));
+}
+
+void Hyprctl::send(const std::string &command, const Callback &callback) {
+  auto socket = new QLocalSocket(this);
+  auto request = std::make_shared<Request>(Request{.socket = socket, .buffer = takeBuffer()});
+  auto payload = QByteArray::fromStdString(command);
+
+  connect(socket, &QLocalSocket::connected, this, [socket, payload]() { socket->write(payload); });
+  connect(socket, &QLocalSocket::readyRead, this, [request]() {
+    auto &buffer = request->buffer;
+    qsizetype size = buffer.size();
+    qint64 available = request->socket->bytesAvailable();
+
+    buffer.resize(size + available);
+    request->socket->read(buffer.data() + size, available);
+  });
+
+  auto finish = [this, request, callback]() {
+    // errorOccurred is also emitted when the compositor closes the connection once done
+    if (!request->socket) return;
+
+    request->buffer.append(request->socket->readAll());
+
+    if (callback) callback(request->buffer);
+
+    std::exchange(request->socket, nullptr)->deleteLater();
+    recycleBuffer(std::move(request->buffer));
+  };
+
+  connect(socket, &QLocalSocket::disconnected, this, finish);
+  connect(socket, &QLocalSocket::errorOccurred, this, [finish, request](QLocalSocket::LocalSocketError err) {
+    if (!request->socket) return;
+
+    if (err != QLocalSocket::PeerClosedError) {
+      qWarning() << "Hyprctl::send() failed:" << request->socket->errorString();
+      request->buffer.resize(0);
+    }
+
+    finish();
+  });
+
+  socket->connectToServer(QString::fromStdString(socketPath()));
+}
+
+void Hyprctl::sendBatch(const std::vector<std::string> &commands, const Callback &callback) {
+  send(batch(commands), callback);
+}
@@ -1,78 +1,60 @@
 #pragma once
-#include <cerrno>
-#include <cstdlib>
-#include <cstring>
-#include <fcntl.h>
 #include <filesystem>
+#include <functional>
+#include <qbytearray.h>
+#include <qbytearrayview.h>
 #include <qlocalsocket.h>
-#include <qlogging.h>
 #include <qobject.h>
-#include <qsocketnotifier.h>
-#include <qstringview.h>
-#include <qtimer.h>
-#include <qtmetamacros.h>
 #include <string>
 #include <string_view>
-#include <sys/socket.h>
-#include <sys/un.h>
-#include <qdebug.h>
-#include <unistd.h>
-#include <expected>
-
+#include <vector>
+
+/**
+ * Client for the Hyprland control socket (`.socket.sock`).
+ *
+ * The compositor answers a single request per connection, so commands that are issued together
+ * should be sent as one `[[BATCH]]` request, which costs a single round trip.
+ * Requests are performed asynchronously on the event loop, and the buffers responses are read into
+ * are recycled from one request to the next.
+ */
 class Hyprctl : public QObject {
 public:
-  static QByteArray oneshot(std::string_view command) { return Hyprctl().start(std::string(command)); }
-
-  Hyprctl() { QLocalSocket client; }
-  ~Hyprctl() {}
-
-  QByteArray start(const std::string &command) {
-    char _buf[1 << 8];
-    auto his = getenv("HYPRLAND_INSTANCE_SIGNATURE");
-
-    if (!his) { qWarning() << "Hyprctl::execute() failed: HYPRLAND_INSTANCE_SIGNATURE is not set"; }
-
-    std::filesystem::path rundir = "/tmp";
-
-    if (auto p = getenv("XDG_RUNTIME_DIR")) rundir = p;
-
-    std::filesystem::path sockPath = rundir / "hypr" / his / ".socket.sock";
-    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+  using Callback = std::function<void(QByteArrayView response)>;
 
-    if (sock < 0) {
-      qWarning() << "Hyprctl::execute() failed: socket() =>" << strerror(errno);
-      return {};
-    }
+private:
+  struct Request {
+    QLocalSocket *socket;
+    QByteArray buffer;
+  };
 
-    struct sockaddr_un serverAddr;
+  std::vector<QByteArray> m_buffers;
 
-    memset(&serverAddr, 0, sizeof(serverAddr));
-    serverAddr.sun_family = AF_UNIX;
-    strncpy(serverAddr.sun_path, sockPath.c_str(), sizeof(serverAddr.sun_path) - 1);
+  QByteArray takeBuffer();
+  void recycleBuffer(QByteArray buffer);
 
-    if (::connect(sock, reinterpret_cast<sockaddr *>(&serverAddr), sizeof(serverAddr)) < 0) {
-      qWarning() << "Hyprctl::execute() failed: connect() =>" << strerror(errno);
-      close(sock);
-      return {};
-    }
-
-    if (send(sock, command.data(), command.size(), 0) <= 0) {
-      qWarning() << "Hyprctl::execute() failed: send() =>" << strerror(errno);
-      close(sock);
-      return {};
-    }
-
-    int rc = 0;
-    QByteArray data;
-
-    while ((rc = recv(sock, _buf, sizeof(_buf), 0)) > 0) {
-      data += QByteArrayView{_buf, rc};
-    }
-
-    close(sock);
-
-    if (rc == -1) return {};
-
-    return data;
-  }
+public:
+  static std::filesystem::path socketPath();
+
+  /**
+   * Send a command and block until the response was received. Prefer `send` unless the response is
+   * needed right away.
+   */
+  static QByteArray oneshot(std::string_view command);
+
+  /**
+   * Group several commands into a single request.
+   */
+  static std::string batch(const std::vector<std::string> &commands);
+
+  /**
+   * Split the response to a batch request into the response to each command.
+   */
+  static std::vector<QByteArrayView> splitBatchResponse(QByteArrayView response);
+
+  /**
+   * Send a command asynchronously. The response passed to `callback` is only valid for the duration
+   * of the call. An empty response is passed if the request failed.
+   */
+  void send(const std::string &command, const Callback &callback = {});
+  void sendBatch(const std::vector<std::string> &commands, const Callback &callback = {});
 };
@@ -0,0 +1,43 @@
+#include "hyprland-events.hpp"
+#include <qlogging.h>
+
+std::filesystem::path HyprlandEventListener::defaultSocketPath() {
+  std::filesystem::path rundir = "/tmp";
+  const char *his = getenv("HYPRLAND_INSTANCE_SIGNATURE");
+
+  if (auto p = getenv("XDG_RUNTIME_DIR")) rundir = p;
+
+  return rundir / "hypr" / (his ? his : "") / ".socket2.sock";
+}
+
+void HyprlandEventListener::handleReadyRead() {
+  while (m_socket.canReadLine()) {
+    QString line = QString::fromUtf8(m_socket.readLine()).trimmed();
+    qsizetype separator = line.indexOf(QLatin1StringView(">>"));
+
+    if (separator == -1) continue;
+
+    emit eventReceived(line.first(separator), line.sliced(separator + 2));
+  }
+}
+
+void HyprlandEventListener::handleDisconnected() {
+  if (!m_reconnectTimer.isActive()) {
+    qWarning() << "Lost connection to the hyprland event socket, retrying in" << RECONNECT_INTERVAL_MS
+               << "ms";
+    m_reconnectTimer.start();
+  }
+}
+
+void HyprlandEventListener::start() { m_socket.connectToServer(QString::fromStdString(m_path)); }
+
+HyprlandEventListener::HyprlandEventListener(const std::filesystem::path &path) : m_path(path) {
+  m_reconnectTimer.setInterval(RECONNECT_INTERVAL_MS);
+  m_reconnectTimer.setSingleShot(true);
+
+  connect(&m_reconnectTimer, &QTimer::timeout, this, &HyprlandEventListener::start);
+  connect(&m_socket, &QLocalSocket::readyRead, this, &HyprlandEventListener::handleReadyRead);
+  connect(&m_socket, &QLocalSocket::connected, this, &HyprlandEventListener::connected);
+  connect(&m_socket, &QLocalSocket::disconnected, this, &HyprlandEventListener::handleDisconnected);
+  connect(&m_socket, &QLocalSocket::errorOccurred, this, &HyprlandEventListener::handleDisconnected);
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <filesystem>
+#include <qlocalsocket.h>
+#include <qobject.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+
+/**
+ * Listens to the Hyprland event socket (`.socket2.sock`), on which the compositor writes one
+ * `EVENT>>DATA` line per event. The connection is re-established if the compositor goes away.
+ */
+class HyprlandEventListener : public QObject {
+  Q_OBJECT
+
+  static constexpr int RECONNECT_INTERVAL_MS = 1000;
+
+  std::filesystem::path m_path;
+  QLocalSocket m_socket;
+  QTimer m_reconnectTimer;
+
+  void handleReadyRead();
+  void handleDisconnected();
+
+public:
+  /**
+   * Path to the event socket of the running Hyprland instance.
+   */
+  static std::filesystem::path defaultSocketPath();
+
+  void start();
+
+  /**
+   * Listen on `path` instead of the socket of the running instance. This makes it possible to run
+   * against a fake compositor.
+   */
+  HyprlandEventListener(const std::filesystem::path &path = defaultSocketPath());
+
+signals:
+  /**
+   * The listener (re)connected to the compositor. Events may have been missed in the meantime.
+   */
+  void connected();
+  void eventReceived(const QString &name, const QString &data);
+};
@@ -1,12 +1,150 @@
 #include "hyprland.hpp"
 #include "services/window-manager/abstract-window-manager.hpp"
 #include "services/window-manager/hyprland/hyprctl.hpp"
+#include <algorithm>
 #include <ranges>
 
 HyprlandWindow::HyprlandWindow(const QJsonObject &json) {
   m_id = json.value("address").toString();
   m_title = json.value("title").toString();
   m_wmClass = json.value("class").toString();
+
+  if (auto pid = json.value("pid"); pid.isDouble()) m_pid = pid.toInt();
+  if (auto ws = json.value("workspace").toObject().value("id"); ws.isDouble()) m_workspace = ws.toInt();
+}
+
+HyprlandWindow::HyprlandWindow(const QString &id, const QString &wmClass, const QString &title,
+                               std::optional<int> workspace)
+    : m_id(id), m_title(title), m_wmClass(wmClass), m_workspace(workspace) {}
+
+static std::optional<int> parseWorkspaceId(const QString &text) {
+  bool ok = false;
+  int id = text.toInt(&ok);
+
+  if (!ok) return std::nullopt;
+
+  return id;
+}
+
+QString HyprlandWindowManager::normalizeAddress(QStringView address) {
+  if (address.startsWith(QLatin1StringView("0x"))) return address.toString();
+
+  return QLatin1StringView("0x") + address;
+}
+
+std::shared_ptr<HyprlandWindow> HyprlandWindowManager::findWindow(const QString &id) const {
+  auto it = std::ranges::find_if(m_windows, [&](auto &&window) { return window->id() == id; });
+
+  if (it == m_windows.end()) return nullptr;
+
+  return *it;
+}
+
+void HyprlandWindowManager::syncWindows() {
+  m_hyprctl.sendBatch({"-j/clients", "-j/activewindow"}, [this](QByteArrayView response) {
+    auto responses = Hyprctl::splitBatchResponse(response);
+
+    if (responses.size() != 2) {
+      qWarning() << "HyprlandWindowManager: unexpected response to window sync, got" << responses.size()
+                 << "responses instead of 2";
+      return;
+    }
+
+    handleSync(QByteArray::fromRawData(responses[0].data(), responses[0].size()),
+               QByteArray::fromRawData(responses[1].data(), responses[1].size()));
+  });
+}
+
+void HyprlandWindowManager::handleSync(const QByteArray &clientsJson, const QByteArray &activeJson) {
+  auto clients = QJsonDocument::fromJson(clientsJson).array();
+  std::vector<std::pair<int, std::shared_ptr<HyprlandWindow>>> windows;
+
+  windows.reserve(clients.size());
+
+  for (const auto &value : clients) {
+    auto obj = value.toObject();
+    windows.emplace_back(obj.value("focusHistoryID").toInt(), std::make_shared<HyprlandWindow>(obj));
+  }
+
+  std::ranges::sort(windows, std::less{}, [](auto &&pair) { return pair.first; });
+  m_windows = windows | std::views::values | std::ranges::to<std::vector>();
+
+  auto active = QJsonDocument::fromJson(activeJson).object();
+
+  m_focused = findWindow(active.value("address").toString());
+  emit windowsChanged();
+}
+
+void HyprlandWindowManager::handleWindowOpened(const QString &data) {
+  // ADDRESS,WORKSPACENAME,WINDOWCLASS,WINDOWTITLE - the title may itself contain commas
+  auto parts = data.split(',');
+
+  if (parts.size() < 4) return;
+
+  QString title = parts.sliced(3).join(',');
+  auto window = std::make_shared<HyprlandWindow>(normalizeAddress(parts.at(0)), parts.at(2), title,
+                                                 parseWorkspaceId(parts.at(1)));
+
+  m_windows.emplace_back(window);
+  emit windowsChanged();
+}
+
+void HyprlandWindowManager::handleWindowClosed(const QString &id) {
+  QString address = normalizeAddress(id);
+
+  if (m_focused && m_focused->id() == address) m_focused.reset();
+  if (std::erase_if(m_windows, [&](auto &&window) { return window->id() == address; }) > 0) {
+    emit windowsChanged();
+  }
+}
+
+void HyprlandWindowManager::handleWindowFocused(const QString &id) {
+  // no window is focused anymore
+  if (id.isEmpty() || id == ",") {
+    m_focused.reset();
+    return;
+  }
+
+  QString address = normalizeAddress(id);
+  auto it = std::ranges::find_if(m_windows, [&](auto &&window) { return window->id() == address; });
+
+  if (it == m_windows.end()) return;
+
+  std::rotate(m_windows.begin(), it, std::next(it));
+  m_focused = m_windows.front();
+  emit windowsChanged();
+}
+
+void HyprlandWindowManager::handleWindowTitleChanged(const QString &data) {
+  // ADDRESS,TITLE
+  qsizetype separator = data.indexOf(',');
+
+  if (separator == -1) return;
+
+  if (auto window = findWindow(normalizeAddress(data.first(separator)))) {
+    window->setTitle(data.sliced(separator + 1));
+    emit windowsChanged();
+  }
+}
+
+void HyprlandWindowManager::handleWindowMoved(const QString &data) {
+  // ADDRESS,WORKSPACEID,WORKSPACENAME
+  auto parts = data.split(',');
+
+  if (parts.size() < 2) return;
+
+  if (auto window = findWindow(normalizeAddress(parts.at(0)))) {
+    window->setWorkspace(parseWorkspaceId(parts.at(1)));
+    emit windowsChanged();
+  }
+}
+
+void HyprlandWindowManager::handleEvent(const QString &name, const QString &data) {
+  if (name == "openwindow") return handleWindowOpened(data);
+  if (name == "closewindow") return handleWindowClosed(data);
+  if (name == "activewindowv2") return handleWindowFocused(data);
+  if (name == "windowtitlev2") return handleWindowTitleChanged(data);
+  if (name == "movewindowv2") return handleWindowMoved(data);
 }
 
 QString HyprlandWindowManager::stringifyModifiers(QFlags<Qt::KeyboardModifier> mods) {
@@ -25,25 +163,10 @@ QString HyprlandWindowManager::id() const { return "hyprland"; }
 QString HyprlandWindowManager::displayName() const { return "Hyprland"; }
 
 AbstractWindowManager::WindowList HyprlandWindowManager::listWindowsSync() const {
-  auto response = Hyprctl::oneshot("-j/clients");
-  auto json = QJsonDocument::fromJson(response);
-  auto windows = json.array() |
-                 std::views::transform([](const QJsonValue &value) -> std::shared_ptr<AbstractWindow> {
-                   return std::make_shared<HyprlandWindow>(value.toObject());
-                 }) |
-                 std::ranges::to<std::vector>();
-
-  return windows;
+  return {m_windows.begin(), m_windows.end()};
 }
 
-AbstractWindowManager::WindowPtr HyprlandWindowManager::getFocusedWindowSync() const {
-  auto response = Hyprctl::oneshot("-j/activewindow");
-  auto json = QJsonDocument::fromJson(response);
-
-  if (json.isEmpty()) { return nullptr; }
-
-  return std::make_shared<HyprlandWindow>(json.object());
-}
+AbstractWindowManager::WindowPtr HyprlandWindowManager::getFocusedWindowSync() const { return m_focused; }
 
 bool HyprlandWindowManager::supportsInputForwarding() const { return true; }
 
@@ -53,19 +176,18 @@ bool HyprlandWindowManager::sendShortcutSync(const AbstractWindow &window, const
                  .arg(stringifyKey(shortcut.key))
                  .arg(window.id());
 
-  // qWarning() << "send dispatcher" << cmd;
-  Hyprctl::oneshot(cmd.toStdString());
+  m_hyprctl.send(cmd.toStdString());
 
   return true;
 }
 
 void HyprlandWindowManager::focusWindowSync(const AbstractWindow &window) const {
-  Hyprctl::oneshot(std::format("dispatch focuswindow address:{}", window.id().toStdString()));
+  m_hyprctl.send(std::format("dispatch focuswindow address:{}", window.id().toStdString()));
 }
 
 bool HyprlandWindowManager::closeWindow(const AbstractWindow &window) const {
-  Hyprctl::oneshot(std::format("dispatch closewindow address:{}", window.id().toStdString()));
-  emit windowsChanged();
+  // the window list is updated once the compositor reports the window as closed
+  m_hyprctl.send(std::format("dispatch closewindow address:{}", window.id().toStdString()));
 
   return true;
 }
@@ -81,4 +203,11 @@ bool HyprlandWindowManager::ping() const {
   return true;
 }
 
-void HyprlandWindowManager::start() const {}
+void HyprlandWindowManager::start() { m_events.start(); }
+
+HyprlandWindowManager::HyprlandWindowManager(const std::filesystem::path &eventSocket)
+    : m_events(eventSocket) {
+  // anything could have happened while we were not listening
+  connect(&m_events, &HyprlandEventListener::connected, this, &HyprlandWindowManager::syncWindows);
+  connect(&m_events, &HyprlandEventListener::eventReceived, this, &HyprlandWindowManager::handleEvent);
+}
@@ -1,5 +1,7 @@
 #pragma once
 #include "services/window-manager/abstract-window-manager.hpp"
+#include "services/window-manager/hyprland/hyprctl.hpp"
+#include "services/window-manager/hyprland/hyprland-events.hpp"
 #include <QtConcurrent/qtconcurrentrun.h>
 #include <lib/xkbcommon-utils.hpp>
 #include <qapplication.h>
@@ -21,22 +23,48 @@ class HyprlandWindow : public AbstractWindowManager::AbstractWindow {
   QString m_id;
   QString m_title;
   QString m_wmClass;
-  int m_pid;
+  std::optional<int> m_pid;
+  std::optional<int> m_workspace;
 
 public:
   QString id() const override { return m_id; }
   std::optional<int> pid() const override { return m_pid; }
   QString title() const override { return m_title; }
   QString wmClass() const override { return m_wmClass; }
-
-  // Extended AbstractWindow interface - use defaults for now
-  std::optional<int> workspace() const override { return std::nullopt; }
+  std::optional<int> workspace() const override { return m_workspace; }
   bool canClose() const override { return true; }
 
+  void setTitle(const QString &title) { m_title = title; }
+  void setWorkspace(std::optional<int> workspace) { m_workspace = workspace; }
+
   HyprlandWindow(const QJsonObject &json);
+  HyprlandWindow(const QString &id, const QString &wmClass, const QString &title,
+                 std::optional<int> workspace);
 };
 
+/**
+ * Windows are tracked from the compositor event socket rather than queried on demand, so that
+ * listing windows or getting the focused one never requires any IPC. The full list is only fetched
+ * when (re)connecting to the event socket.
+ */
 class HyprlandWindowManager : public AbstractWindowManager {
+  HyprlandEventListener m_events;
+  // dispatching does not change any state we keep track of ourselves
+  mutable Hyprctl m_hyprctl;
+  // most recently focused first
+  std::vector<std::shared_ptr<HyprlandWindow>> m_windows;
+  std::shared_ptr<HyprlandWindow> m_focused;
+
+  std::shared_ptr<HyprlandWindow> findWindow(const QString &id) const;
+  void syncWindows();
+  void handleSync(const QByteArray &clientsJson, const QByteArray &activeJson);
+  void handleEvent(const QString &name, const QString &data);
+  void handleWindowOpened(const QString &data);
+  void handleWindowClosed(const QString &id);
+  void handleWindowFocused(const QString &id);
+  void handleWindowTitleChanged(const QString &data);
+  void handleWindowMoved(const QString &data);
+
   QString stringifyModifiers(QFlags<Qt::KeyboardModifier> mods);
 
   QString stringifyKey(Qt::Key key) const;
@@ -53,7 +81,14 @@ public:
   bool isActivatable() const override;
 
   bool ping() const override;
-  void start() const override;
+  void start() override;
+
+  /**
+   * Event addresses are not prefixed with 0x, unlike the ones returned by hyprctl.
+   */
+  static QString normalizeAddress(QStringView address);
 
+  HyprlandWindowManager(
+      const std::filesystem::path &eventSocket = HyprlandEventListener::defaultSocketPath());
   ~HyprlandWindowManager() override = default;
 };
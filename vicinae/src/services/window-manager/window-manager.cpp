@@ -32,4 +32,7 @@ AbstractWindowManager::WindowPtr WindowManager::getFocusedWindow() {
 
 bool WindowManager::canPaste() const { return m_provider->supportsInputForwarding(); }
 
-WindowManager::WindowManager() { m_provider = createProvider(); }
+WindowManager::WindowManager() {
+  m_provider = createProvider();
+  m_provider->start();
+}
@@ -4,14 +4,8 @@
 DataUriImageLoader::DataUriImageLoader(const QString &url) {
   DataUri uri(url);
 
-  if (!m_tmp.open()) {
-    qCritical() << "Failed to open temp file for data URI image";
-    return;
-  }
-
-  m_tmp.write(uri.decodeContent());
-  m_tmp.close();
-  m_loader.reset(new LocalImageLoader(m_tmp.filesystemFileName()));
+  // decoded straight from memory, no need to go through a temporary file
+  m_loader.reset(new IODeviceImageLoader(uri.decodeContent()));
   m_loader->forwardSignals(this);
 }
 
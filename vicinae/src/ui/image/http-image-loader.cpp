@@ -3,10 +3,12 @@
 #include <qbuffer.h>
 
 void HttpImageLoader::render(const RenderConfig &cfg) {
-  if (m_reply) { m_reply->abort(); }
+  if (m_reply) {
+    m_reply->abort();
+    m_reply->deleteLater();
+  }
 
-  QNetworkRequest request(m_url);
-  auto reply = NetworkFetcher::instance()->fetch(m_url);
+  auto reply = NetworkFetcher::instance()->fetch(m_url, NetworkFetcher::Priority::Visible);
 
   // important: we connect to the current reply, not m_reply
   m_reply = reply;
@@ -14,12 +16,20 @@ void HttpImageLoader::render(const RenderConfig &cfg) {
   connect(reply, &FetchReply::finished, this, [this, reply, cfg](const QByteArray &data) {
     if (m_reply != reply) return;
 
-    m_loader.reset(new IODeviceImageLoader(data));
+    m_loader.reset(new IODeviceImageLoader(data, m_url.toString()));
     m_loader->forwardSignals(this);
     m_loader->render(cfg);
     if (m_reply == reply) { m_reply = nullptr; }
     reply->deleteLater();
   });
+
+  connect(reply, &FetchReply::failed, this, [this, reply](const QString &error) {
+    if (m_reply != reply) return;
+
+    m_reply = nullptr;
+    reply->deleteLater();
+    emit errorOccured(error);
+  });
 }
 
 HttpImageLoader::HttpImageLoader(const QUrl &url) : m_url(url) {}
@@ -0,0 +1,328 @@
+#include "ui/image/image-decoder.hpp"
+#include "daemon/perf-metrics.hpp"
+#include "ui/image/animated-image-loader.hpp"
+#include "ui/image/thumbnail-cache.hpp"
+#include "vicinae.hpp"
+#include <algorithm>
+#include <qbuffer.h>
+#include <qcoreapplication.h>
+#include <qcryptographichash.h>
+#include <qfile.h>
+#include <qimagereader.h>
+#include <qmimedatabase.h>
+#include <qpointer.h>
+#include <qthread.h>
+
+static constexpr size_t CACHE_BUDGET = Omnicast::IMAGE_MEMORY_CACHE_MAX_SIZE;
+
+void ImageDecodeReply::cancel() { ImageDecoder::instance()->detach(this); }
+
+ImageDecodeReply::~ImageDecodeReply() {
+  if (!m_finished) cancel();
+}
+
+ImageDecoder *ImageDecoder::instance() {
+  static ImageDecoder decoder;
+
+  return &decoder;
+}
+
+ImageDecoder::ImageDecoder() {
+  // decoding is mostly memory bound, using every core doesn't buy us much and starves the rest of the app
+  m_pool.setMaxThreadCount(std::max(2, QThread::idealThreadCount() / 2));
+
+  // the decoder outlives the application object, but pixmaps must not outlive the GUI
+  if (auto app = QCoreApplication::instance()) {
+    connect(app, &QCoreApplication::aboutToQuit, this, [this]() {
+      for (auto &[key, pending] : m_pending) {
+        *pending.cancelled = true;
+      }
+      m_pool.clear();
+      m_pool.waitForDone();
+      clearCache();
+    });
+  }
+}
+
+QString ImageDecoder::configKey(const RenderConfig &cfg) {
+  return QString("%1x%2@%3:%4")
+      .arg(cfg.size.width())
+      .arg(cfg.size.height())
+      .arg(cfg.devicePixelRatio)
+      .arg(static_cast<int>(cfg.fit));
+}
+
+QImage ImageDecoder::decodeStatic(const QByteArray &bytes, const RenderConfig &cfg) {
+  static auto &decodeLatency = PerfMetrics::instance()->histogram("image-decode");
+  auto timer = decodeLatency.time();
+  QSize deviceSize = cfg.size * cfg.devicePixelRatio;
+  QBuffer buf;
+  buf.setData(bytes);
+  buf.open(QIODevice::ReadOnly);
+  QImageReader reader(&buf);
+  QSize originalSize = reader.size();
+  bool isDownScalable =
+      originalSize.height() > deviceSize.height() || originalSize.width() > deviceSize.width();
+
+  if (originalSize.isValid() && isDownScalable) {
+    reader.setScaledSize(originalSize.scaled(deviceSize, cfg.fit == ObjectFitFill ? Qt::IgnoreAspectRatio
+                                                                                  : Qt::KeepAspectRatio));
+  }
+
+  auto image = reader.read();
+
+  image.setDevicePixelRatio(cfg.devicePixelRatio);
+
+  return image;
+}
+
+QImage ImageDecoder::fitToConfig(const QImage &image, const RenderConfig &cfg) {
+  QSize deviceSize = cfg.size * cfg.devicePixelRatio;
+  bool isDownScalable = image.height() > deviceSize.height() || image.width() > deviceSize.width();
+  QImage scaled = image;
+
+  if (isDownScalable) {
+    scaled = image.scaled(deviceSize, cfg.fit == ObjectFitFill ? Qt::IgnoreAspectRatio : Qt::KeepAspectRatio,
+                          Qt::SmoothTransformation);
+  }
+
+  scaled.setDevicePixelRatio(cfg.devicePixelRatio);
+
+  return scaled;
+}
+
+ImageDecoder::DecodeResult ImageDecoder::decode(const Source &source, const RenderConfig &cfg,
+                                                const std::atomic<bool> &cancelled) {
+  QByteArray data;
+
+  if (auto thumbnail = std::get_if<ThumbnailSource>(&source)) {
+    QMimeDatabase mimeDb;
+    auto flavor = ThumbnailCache::flavorFor(cfg.size * cfg.devicePixelRatio);
+    bool isAnimated = mimeDb.mimeTypeForFile(thumbnail->path.c_str()).name() == "image/gif";
+
+    if (!flavor || isAnimated) return decode(thumbnail->path, cfg, cancelled);
+
+    auto image = ThumbnailCache::fileThumbnail(thumbnail->path, *flavor);
+
+    if (image.isNull()) return {.error = "Failed to generate thumbnail"};
+
+    return {.image = fitToConfig(image, cfg)};
+  }
+
+  if (auto path = std::get_if<std::filesystem::path>(&source)) {
+    QFile file(*path);
+
+    if (!file.open(QIODevice::ReadOnly)) {
+      return {.error = QString("Failed to open %1: %2").arg(file.fileName()).arg(file.errorString())};
+    }
+
+    data = file.readAll();
+  } else {
+    data = std::get<QByteArray>(source);
+  }
+
+  if (cancelled) return {};
+
+  QMimeDatabase mimeDb;
+
+  if (mimeDb.mimeTypeForData(data).name() == "image/gif") { return {.animation = data}; }
+
+  auto image = decodeStatic(data, cfg);
+
+  if (image.isNull()) return {.error = "Failed to decode image"};
+
+  return {.image = image};
+}
+
+QString ImageDecoder::fileKey(const std::filesystem::path &path) {
+  std::error_code ec;
+  auto mtime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+
+  return QString("%1:%2").arg(path.c_str()).arg(mtime);
+}
+
+ImageDecodeReply *ImageDecoder::decodeFile(const std::filesystem::path &path, const RenderConfig &cfg) {
+  return request(QString("file:%1:%2").arg(fileKey(path)).arg(configKey(cfg)), path, cfg);
+}
+
+ImageDecodeReply *ImageDecoder::decodeThumbnail(const std::filesystem::path &path, const RenderConfig &cfg) {
+  return request(QString("thumbnail:%1:%2").arg(fileKey(path)).arg(configKey(cfg)),
+                 ThumbnailSource{.path = path}, cfg);
+}
+
+ImageDecodeReply *ImageDecoder::decodeData(const QByteArray &data, const RenderConfig &cfg,
+                                           const QString &cacheKey) {
+  QString source = cacheKey;
+
+  if (source.isEmpty()) {
+    source = QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex());
+  }
+
+  QString key = QString("data:%1:%2").arg(source).arg(configKey(cfg));
+
+  return request(key, data, cfg);
+}
+
+ImageDecodeReply *ImageDecoder::request(const QString &key, const Source &source, const RenderConfig &cfg) {
+  static auto &cacheHits = PerfMetrics::instance()->counter("image-cache-hits");
+  static auto &cacheMisses = PerfMetrics::instance()->counter("image-cache-misses");
+  auto reply = new ImageDecodeReply(key);
+
+  if (auto pixmap = cached(key)) {
+    cacheHits.increment();
+    reply->m_pixmap = *pixmap;
+    reply->m_finished = true;
+    return reply;
+  }
+
+  if (auto it = m_pending.find(key); it != m_pending.end()) {
+    it->second.replies.emplace_back(reply);
+    return reply;
+  }
+
+  cacheMisses.increment();
+
+  uint64_t id = m_nextId++;
+  auto cancelled = std::make_shared<std::atomic<bool>>(false);
+
+  m_pending[key] = PendingDecode{.id = id, .cancelled = cancelled, .replies = {reply}};
+
+  m_pool.start([this, key, id, source, cfg, cancelled]() {
+    if (*cancelled) return;
+
+    auto result = decode(source, cfg, *cancelled);
+
+    if (*cancelled) return;
+
+    QMetaObject::invokeMethod(this, [this, key, id, result = std::move(result)]() {
+      handleFinished(key, id, result);
+    });
+  });
+
+  return reply;
+}
+
+void ImageDecoder::handleFinished(const QString &key, uint64_t id, const DecodeResult &result) {
+  auto it = m_pending.find(key);
+
+  // the request was cancelled and possibly reissued in the meantime
+  if (it == m_pending.end() || it->second.id != id) return;
+
+  // a slot may destroy other replies waiting on the same decode
+  std::vector<QPointer<ImageDecodeReply>> replies(it->second.replies.begin(), it->second.replies.end());
+
+  m_pending.erase(it);
+
+  for (auto &reply : replies) {
+    reply->m_finished = true;
+  }
+
+  if (!result.error.isEmpty()) {
+    for (auto &reply : replies) {
+      if (reply) emit reply->failed(result.error);
+    }
+    return;
+  }
+
+  if (!result.animation.isEmpty()) {
+    for (auto &reply : replies) {
+      if (reply) emit reply->animationReady(result.animation);
+    }
+    return;
+  }
+
+  auto pixmap = QPixmap::fromImage(result.image);
+
+  insertCache(key, pixmap);
+
+  for (auto &reply : replies) {
+    if (!reply) continue;
+    reply->m_pixmap = pixmap;
+    emit reply->finished(pixmap);
+  }
+}
+
+void ImageDecoder::detach(ImageDecodeReply *reply) {
+  auto it = m_pending.find(reply->key());
+
+  if (it == m_pending.end()) return;
+
+  auto &replies = it->second.replies;
+
+  std::erase(replies, reply);
+
+  if (replies.empty()) {
+    *it->second.cancelled = true;
+    m_pending.erase(it);
+  }
+}
+
+const QPixmap *ImageDecoder::cached(const QString &key) {
+  auto it = m_cache.find(key);
+
+  if (it == m_cache.end()) return nullptr;
+
+  m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+
+  return &it->second.pixmap;
+}
+
+void ImageDecoder::insertCache(const QString &key, const QPixmap &pixmap) {
+  size_t size = static_cast<size_t>(pixmap.width()) * pixmap.height() * std::max(1, pixmap.depth() / 8);
+
+  // a single image larger than the whole budget would evict everything else
+  if (size > CACHE_BUDGET) return;
+
+  if (auto it = m_cache.find(key); it != m_cache.end()) {
+    m_cacheSize -= it->second.size;
+    m_lru.erase(it->second.lru);
+    m_cache.erase(it);
+  }
+
+  m_lru.push_front(key);
+  m_cache[key] = CacheEntry{.pixmap = pixmap, .size = size, .lru = m_lru.begin()};
+  m_cacheSize += size;
+
+  while (m_cacheSize > CACHE_BUDGET && !m_lru.empty()) {
+    auto it = m_cache.find(m_lru.back());
+
+    m_cacheSize -= it->second.size;
+    m_cache.erase(it);
+    m_lru.pop_back();
+  }
+}
+
+void ImageDecoder::clearCache() {
+  m_cache.clear();
+  m_lru.clear();
+  m_cacheSize = 0;
+}
+
+void DecodedImageLoader::setReply(ImageDecodeReply *reply, const RenderConfig &cfg) {
+  if (m_reply) {
+    disconnect(m_reply.get());
+    m_reply->cancel();
+  }
+
+  m_reply.reset(reply);
+  m_animation.reset();
+
+  if (reply->isFinished()) {
+    emit dataUpdated(reply->pixmap());
+    return;
+  }
+
+  connect(reply, &ImageDecodeReply::finished, this, &DecodedImageLoader::dataUpdated);
+  connect(reply, &ImageDecodeReply::failed, this, &DecodedImageLoader::errorOccured);
+  connect(reply, &ImageDecodeReply::animationReady, this, [this, cfg](const QByteArray &data) {
+    m_animation = std::make_unique<AnimatedIODeviceImageLoader>(data);
+    m_animation->forwardSignals(this);
+    m_animation->render(cfg);
+  });
+}
+
+void DecodedImageLoader::abort() const {
+  if (m_reply) m_reply->cancel();
+}
+
+DecodedImageLoader::~DecodedImageLoader() { abort(); }
@@ -0,0 +1,159 @@
+#pragma once
+#include "ui/image/image.hpp"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <qbytearray.h>
+#include <qimage.h>
+#include <qobject.h>
+#include <qpixmap.h>
+#include <qthreadpool.h>
+#include <qtmetamacros.h>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+/**
+ * Handle to a decode request made through `ImageDecoder`.
+ * Requests served from the memory cache are finished as soon as they are returned, so callers
+ * need to check `isFinished` before waiting for a signal.
+ * Destroying the reply cancels the request: no signal is emitted afterwards, and the decode
+ * job itself is skipped if nobody else is waiting for it.
+ */
+class ImageDecodeReply : public QObject {
+  Q_OBJECT
+
+  QString m_key;
+  QPixmap m_pixmap;
+  bool m_finished = false;
+
+  friend class ImageDecoder;
+
+public:
+  const QString &key() const { return m_key; }
+  bool isFinished() const { return m_finished; }
+  const QPixmap &pixmap() const { return m_pixmap; }
+  void cancel();
+
+  ImageDecodeReply(const QString &key) : m_key(key) {}
+  ~ImageDecodeReply();
+
+signals:
+  void finished(const QPixmap &pixmap) const;
+
+  /**
+   * The source turned out to be an animated image, which needs to be played
+   * from the GUI thread. The raw data is handed over as is.
+   */
+  void animationReady(const QByteArray &data) const;
+  void failed(const QString &reason) const;
+};
+
+/**
+ * Decodes images on a dedicated thread pool and keeps the most recently used results
+ * in memory, bounded by the total size of the decoded pixmaps.
+ *
+ * Requests are keyed by source, target size, object fit and device pixel ratio so that
+ * identical requests made while a decode is in flight share the same job.
+ */
+class ImageDecoder : public QObject {
+public:
+  /**
+   * Decode through the persistent thumbnail cache instead of reading the original file.
+   */
+  struct ThumbnailSource {
+    std::filesystem::path path;
+  };
+
+  using Source = std::variant<std::filesystem::path, QByteArray, ThumbnailSource>;
+
+  static ImageDecoder *instance();
+
+  /**
+   * Decodes the file at `path`. The file is read from the worker thread.
+   * The file modification time is part of the cache key, so that updated files are not served stale.
+   */
+  ImageDecodeReply *decodeFile(const std::filesystem::path &path, const RenderConfig &cfg);
+
+  /**
+   * Like `decodeFile` but goes through `ThumbnailCache`, generating the thumbnail if needed.
+   * Falls back to decoding the original file if the requested size is larger than any thumbnail
+   * flavor or if the file is animated.
+   */
+  ImageDecodeReply *decodeThumbnail(const std::filesystem::path &path, const RenderConfig &cfg);
+
+  /**
+   * Decodes an in-memory buffer. If `cacheKey` is empty, the key is a SHA-256 digest of the content.
+   */
+  ImageDecodeReply *decodeData(const QByteArray &data, const RenderConfig &cfg, const QString &cacheKey = {});
+
+  void clearCache();
+  size_t cacheSize() const { return m_cacheSize; }
+
+  /**
+   * Decode a static image to the device size implied by the render config, downscaling
+   * at decode time when the image is larger than needed.
+   */
+  static QImage decodeStatic(const QByteArray &data, const RenderConfig &cfg);
+
+  ImageDecoder();
+
+private:
+  struct DecodeResult {
+    QImage image;
+    QByteArray animation;
+    QString error;
+  };
+
+  struct PendingDecode {
+    uint64_t id = 0;
+    std::shared_ptr<std::atomic<bool>> cancelled;
+    std::vector<ImageDecodeReply *> replies;
+  };
+
+  struct CacheEntry {
+    QPixmap pixmap;
+    size_t size = 0;
+    std::list<QString>::iterator lru;
+  };
+
+  QThreadPool m_pool;
+  uint64_t m_nextId = 0;
+  std::unordered_map<QString, PendingDecode> m_pending;
+  std::unordered_map<QString, CacheEntry> m_cache;
+  std::list<QString> m_lru;
+  size_t m_cacheSize = 0;
+
+  static QString configKey(const RenderConfig &cfg);
+  static QString fileKey(const std::filesystem::path &path);
+  static QImage fitToConfig(const QImage &image, const RenderConfig &cfg);
+  static DecodeResult decode(const Source &source, const RenderConfig &cfg,
+                             const std::atomic<bool> &cancelled);
+
+  ImageDecodeReply *request(const QString &key, const Source &source, const RenderConfig &cfg);
+  void handleFinished(const QString &key, uint64_t id, const DecodeResult &result);
+  void detach(ImageDecodeReply *reply);
+
+  const QPixmap *cached(const QString &key);
+  void insertCache(const QString &key, const QPixmap &pixmap);
+
+  friend class ImageDecodeReply;
+};
+
+/**
+ * Base for loaders that go through `ImageDecoder`. Replacing or destroying the current
+ * reply cancels it, so that recycled widgets don't keep decoding images nobody will see.
+ */
+class DecodedImageLoader : public AbstractImageLoader {
+  QObjectUniquePtr<ImageDecodeReply> m_reply;
+  std::unique_ptr<AbstractImageLoader> m_animation;
+
+protected:
+  void setReply(ImageDecodeReply *reply, const RenderConfig &cfg);
+
+public:
+  void abort() const override;
+  ~DecodedImageLoader();
+};
@@ -108,7 +108,7 @@ void ImageWidget::setUrlImpl(const ImageURL &url) {
 
     if (std::filesystem::is_regular_file(suffixedPath)) { path = suffixedPath; }
 
-    m_loader.reset(new LocalImageLoader(path));
+    m_loader.reset(new LocalImageLoader(path, url.param("thumbnail").has_value()));
   }
 
   else if (type == ImageURLType::Http) {
@@ -1,26 +1,10 @@
 #include "io-image-loader.hpp"
-#include "static-image-loader.hpp"
-#include "animated-image-loader.hpp"
-#include "ui/image/image.hpp"
-#include <qmimedatabase.h>
+#include "ui/image/image-decoder.hpp"
 #include <qstringview.h>
 
-bool IODeviceImageLoader::isAnimatableMimeType(const QMimeType &type) const {
-  return type.name() == "image/gif";
-}
-
 void IODeviceImageLoader::render(const RenderConfig &cfg) {
-  QMimeDatabase mimeDb;
-  QMimeType mime = mimeDb.mimeTypeForData(m_data);
-
-  if (isAnimatableMimeType(mime)) {
-    m_loader = std::make_unique<AnimatedIODeviceImageLoader>(m_data);
-  } else {
-    m_loader = std::make_unique<StaticIODeviceImageLoader>(m_data);
-  }
-
-  m_loader->forwardSignals(this);
-  m_loader->render(cfg);
+  setReply(ImageDecoder::instance()->decodeData(m_data, cfg, m_cacheKey), cfg);
 }
 
-IODeviceImageLoader::IODeviceImageLoader(QByteArray bytes) : m_data(bytes) {}
+IODeviceImageLoader::IODeviceImageLoader(QByteArray bytes, const QString &cacheKey)
+    : m_data(bytes), m_cacheKey(cacheKey) {}
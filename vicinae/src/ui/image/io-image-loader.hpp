@@ -1,16 +1,17 @@
 #pragma once
-#include "image.hpp"
-#include <qmimetype.h>
+#include "image-decoder.hpp"
 #include <qstringview.h>
 
-class IODeviceImageLoader : public AbstractImageLoader {
-  std::unique_ptr<AbstractImageLoader> m_loader;
+class IODeviceImageLoader : public DecodedImageLoader {
   QByteArray m_data;
-
-  bool isAnimatableMimeType(const QMimeType &type) const;
+  QString m_cacheKey;
 
 public:
   void render(const RenderConfig &cfg) override;
 
-  IODeviceImageLoader(QByteArray bytes);
+  /**
+   * `cacheKey` uniquely identifies the data (e.g its URL). If not provided, a key is derived
+   * from the content itself.
+   */
+  IODeviceImageLoader(QByteArray bytes, const QString &cacheKey = {});
 };
@@ -2,13 +2,10 @@
 #include "local-image-loader.hpp"
 
 void LocalImageLoader::render(const RenderConfig &cfg) {
-  QFile file(m_path);
+  auto decoder = ImageDecoder::instance();
 
-  file.open(QIODevice::ReadOnly);
-
-  m_loader = std::make_unique<IODeviceImageLoader>(file.readAll());
-  m_loader->forwardSignals(this);
-  m_loader->render(cfg);
+  setReply(m_thumbnail ? decoder->decodeThumbnail(m_path, cfg) : decoder->decodeFile(m_path, cfg), cfg);
 }
 
-LocalImageLoader::LocalImageLoader(const std::filesystem::path &path) { m_path = path; }
+LocalImageLoader::LocalImageLoader(const std::filesystem::path &path, bool thumbnail)
+    : m_path(path), m_thumbnail(thumbnail) {}
@@ -1,13 +1,17 @@
 #pragma once
-#include "ui/image/image.hpp"
-#include "io-image-loader.hpp"
+#include "ui/image/image-decoder.hpp"
+#include <filesystem>
 
-class LocalImageLoader : public AbstractImageLoader {
-  std::unique_ptr<IODeviceImageLoader> m_loader;
+class LocalImageLoader : public DecodedImageLoader {
   std::filesystem::path m_path;
+  bool m_thumbnail = false;
 
 public:
   void render(const RenderConfig &cfg) override;
 
-  LocalImageLoader(const std::filesystem::path &path);
+  /**
+   * If `thumbnail` is true, the image is rendered from the persistent thumbnail cache whenever the
+   * requested size allows it.
+   */
+  LocalImageLoader(const std::filesystem::path &path, bool thumbnail = false);
 };
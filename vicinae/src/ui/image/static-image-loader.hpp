@@ -1,20 +1,16 @@
-#include "ui/image/image.hpp"
-#include <qbuffer.h>
-#include <qfuturewatcher.h>
+#pragma once
+#include "ui/image/image-decoder.hpp"
 #include <qstringview.h>
 
-class StaticIODeviceImageLoader : public AbstractImageLoader {
-  using ImageWatcher = QFutureWatcher<QImage>;
-  QSharedPointer<ImageWatcher> m_watcher;
+/**
+ * Decodes a static image through the shared `ImageDecoder`, off the GUI thread.
+ */
+class StaticIODeviceImageLoader : public DecodedImageLoader {
   QByteArray m_data;
 
-  static QImage loadStatic(const QByteArray &data, const RenderConfig &cfg);
-
 public:
-  void abort() const override;
   void render(const RenderConfig &cfg) override;
 
 public:
   StaticIODeviceImageLoader(const QByteArray &data);
-  ~StaticIODeviceImageLoader();
 };
@@ -0,0 +1,185 @@
+#include "ui/image/thumbnail-cache.hpp"
+#include <array>
+#include <chrono>
+#include <qbuffer.h>
+#include <qcryptographichash.h>
+#include <qfile.h>
+#include <qimagereader.h>
+#include <qlogging.h>
+#include <qsavefile.h>
+#include <qstandardpaths.h>
+#include <qurl.h>
+
+namespace fs = std::filesystem;
+
+static constexpr std::array<ThumbnailCache::Flavor, 4> FLAVORS = {
+    ThumbnailCache::Flavor::Normal, ThumbnailCache::Flavor::Large, ThumbnailCache::Flavor::XLarge,
+    ThumbnailCache::Flavor::XXLarge};
+
+int ThumbnailCache::flavorSize(Flavor flavor) {
+  switch (flavor) {
+  case Flavor::Normal:
+    return 128;
+  case Flavor::Large:
+    return 256;
+  case Flavor::XLarge:
+    return 512;
+  case Flavor::XXLarge:
+    return 1024;
+  }
+
+  return 128;
+}
+
+QString ThumbnailCache::flavorName(Flavor flavor) {
+  switch (flavor) {
+  case Flavor::Normal:
+    return "normal";
+  case Flavor::Large:
+    return "large";
+  case Flavor::XLarge:
+    return "x-large";
+  case Flavor::XXLarge:
+    return "xx-large";
+  }
+
+  return "normal";
+}
+
+std::optional<ThumbnailCache::Flavor> ThumbnailCache::flavorFor(QSize deviceSize) {
+  int side = std::max(deviceSize.width(), deviceSize.height());
+
+  for (auto flavor : FLAVORS) {
+    if (side <= flavorSize(flavor)) return flavor;
+  }
+
+  return std::nullopt;
+}
+
+fs::path ThumbnailCache::directory() {
+  return fs::path(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation).toStdString()) /
+         "thumbnails";
+}
+
+fs::path ThumbnailCache::contentDirectory() {
+  return fs::path(QStandardPaths::writableLocation(QStandardPaths::CacheLocation).toStdString()) /
+         "thumbnails";
+}
+
+fs::path ThumbnailCache::fileThumbnailPath(const fs::path &file, Flavor flavor) {
+  auto uri = QUrl::fromLocalFile(file.c_str()).toEncoded();
+  auto hash = QCryptographicHash::hash(uri, QCryptographicHash::Md5).toHex();
+
+  return directory() / flavorName(flavor).toStdString() / (hash.toStdString() + ".png");
+}
+
+fs::path ThumbnailCache::contentThumbnailPath(const QString &hash, Flavor flavor) {
+  return contentDirectory() / flavorName(flavor).toStdString() / (hash.toStdString() + ".png");
+}
+
+QImage ThumbnailCache::scaleToFlavor(QImage image, Flavor flavor) {
+  int size = flavorSize(flavor);
+
+  // thumbnails are never upscaled, as per the spec
+  if (image.width() <= size && image.height() <= size) return image;
+
+  return image.scaled(size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
+
+bool ThumbnailCache::save(QImage image, const fs::path &path) {
+  std::error_code ec;
+
+  fs::create_directories(path.parent_path(), ec);
+  fs::permissions(path.parent_path(), fs::perms::owner_all, ec);
+
+  // write to a temporary file and rename it in place so that readers never see a partial thumbnail
+  QSaveFile file(QString(path.c_str()));
+
+  if (!file.open(QIODevice::WriteOnly)) {
+    qWarning() << "Failed to open thumbnail for writing" << path.c_str() << file.errorString();
+    return false;
+  }
+
+  file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+
+  if (!image.save(&file, "PNG") || !file.commit()) {
+    qWarning() << "Failed to save thumbnail" << path.c_str();
+    return false;
+  }
+
+  return true;
+}
+
+QImage ThumbnailCache::fileThumbnail(const fs::path &file, Flavor flavor) {
+  std::error_code ec;
+  auto mtime = fs::last_write_time(file, ec);
+
+  if (ec) return {};
+
+  // the spec expresses mtime in seconds since the unix epoch
+  auto mtimeSecs = std::chrono::duration_cast<std::chrono::seconds>(
+                       std::chrono::clock_cast<std::chrono::system_clock>(mtime).time_since_epoch())
+                       .count();
+  auto thumbnailPath = fileThumbnailPath(file, flavor);
+  QString uri = QUrl::fromLocalFile(file.c_str()).toString(QUrl::FullyEncoded);
+
+  if (fs::is_regular_file(thumbnailPath, ec)) {
+    QImageReader reader(QString(thumbnailPath.c_str()));
+
+    if (reader.text("Thumb::MTime").toLongLong() == mtimeSecs && reader.text("Thumb::URI") == uri) {
+      if (auto image = reader.read(); !image.isNull()) return image;
+    }
+  }
+
+  QImageReader reader(QString(file.c_str()));
+  QSize originalSize = reader.size();
+  int size = flavorSize(flavor);
+
+  if (originalSize.isValid() && (originalSize.width() > size || originalSize.height() > size)) {
+    reader.setScaledSize(originalSize.scaled(size, size, Qt::KeepAspectRatio));
+  }
+
+  QImage image = reader.read();
+
+  if (image.isNull()) return {};
+
+  image.setText("Thumb::URI", uri);
+  image.setText("Thumb::MTime", QString::number(mtimeSecs));
+  image.setText("Thumb::Size", QString::number(fs::file_size(file, ec)));
+  save(image, thumbnailPath);
+
+  return image;
+}
+
+QImage ThumbnailCache::contentThumbnail(const QString &hash, Flavor flavor, const QByteArray &data) {
+  auto thumbnailPath = contentThumbnailPath(hash, flavor);
+  std::error_code ec;
+
+  if (fs::is_regular_file(thumbnailPath, ec)) {
+    if (QImage image(QString(thumbnailPath.c_str())); !image.isNull()) return image;
+  }
+
+  if (data.isEmpty()) return {};
+
+  QImage image = scaleToFlavor(QImage::fromData(data), flavor);
+
+  if (image.isNull()) return {};
+
+  save(image, thumbnailPath);
+
+  return image;
+}
+
+void ThumbnailCache::removeContentThumbnail(const QString &hash) {
+  for (auto flavor : {Flavor::Normal, Flavor::Large, Flavor::XLarge, Flavor::XXLarge}) {
+    std::error_code ec;
+
+    fs::remove(contentThumbnailPath(hash, flavor), ec);
+  }
+}
+
+void ThumbnailCache::removeContentThumbnails() {
+  std::error_code ec;
+
+  fs::remove_all(contentDirectory(), ec);
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <filesystem>
+#include <optional>
+#include <qbytearray.h>
+#include <qimage.h>
+#include <qsize.h>
+#include <qstring.h>
+
+/**
+ * Persistent thumbnail cache following the freedesktop thumbnail specification:
+ * https://specifications.freedesktop.org/thumbnail-spec/latest/
+ *
+ * File thumbnails are stored in $XDG_CACHE_HOME/thumbnails/<flavor>/<md5 of file URI>.png
+ * and are validated against the Thumb::MTime attribute, which means they are shared with
+ * other applications following the spec (file managers, mostly).
+ *
+ * Thumbnails for in-memory content (clipboard images) are not covered by the spec and are keyed
+ * by content hash in our own cache directory.
+ *
+ * All functions are thread safe and meant to be called from worker threads.
+ */
+class ThumbnailCache {
+public:
+  enum class Flavor { Normal, Large, XLarge, XXLarge };
+
+  /**
+   * Smallest flavor that can render an image of `deviceSize` without upscaling, or nothing if
+   * the requested size is larger than the largest flavor.
+   */
+  static std::optional<Flavor> flavorFor(QSize deviceSize);
+  static int flavorSize(Flavor flavor);
+  static QString flavorName(Flavor flavor);
+
+  static std::filesystem::path fileThumbnailPath(const std::filesystem::path &file, Flavor flavor);
+  static std::filesystem::path contentThumbnailPath(const QString &hash, Flavor flavor);
+
+  /**
+   * Returns the cached thumbnail for `file`, generating and storing it if it's missing or stale.
+   */
+  static QImage fileThumbnail(const std::filesystem::path &file, Flavor flavor);
+
+  /**
+   * Returns the cached thumbnail for content identified by `hash`, generating it from `data`
+   * if it's missing. `data` can be left empty to only lookup the cache.
+   */
+  static QImage contentThumbnail(const QString &hash, Flavor flavor, const QByteArray &data = {});
+
+  /**
+   * Remove the thumbnails of every flavor for the content identified by `hash`.
+   */
+  static void removeContentThumbnail(const QString &hash);
+  static void removeContentThumbnails();
+
+private:
+  static std::filesystem::path directory();
+  static std::filesystem::path contentDirectory();
+  static QImage scaleToFlavor(QImage image, Flavor flavor);
+  static bool save(QImage image, const std::filesystem::path &path);
+};
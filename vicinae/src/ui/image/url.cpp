@@ -271,6 +271,10 @@ ImageURL ImageURL::local(const QString &path) {
 
 ImageURL ImageURL::local(const std::filesystem::path &path) { return local(QString(path.c_str())); }
 
+ImageURL ImageURL::thumbnail(const std::filesystem::path &path) {
+  return local(path).param("thumbnail", "1");
+}
+
 ImageURL ImageURL::http(const QUrl &httpUrl) {
   ImageURL url;
 
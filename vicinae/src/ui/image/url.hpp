@@ -120,6 +120,12 @@ public:
   static ImageURL system(const QString &name);
   static ImageURL local(const QString &path);
   static ImageURL local(const std::filesystem::path &path);
+
+  /**
+   * Local image rendered through the persistent thumbnail cache, for places where
+   * the image is only shown as a small preview.
+   */
+  static ImageURL thumbnail(const std::filesystem::path &path);
   static ImageURL http(const QUrl &httpUrl);
   static ImageURL emoji(const QString &emoji);
   static ImageURL rawData(const QByteArray &data, const QString &mimeType);
@@ -1,6 +1,7 @@
 #include "launcher-window.hpp"
 #include "action-panel/action-panel.hpp"
 #include "common.hpp"
+#include "daemon/toggle-latency.hpp"
 #include "ui/keyboard.hpp"
 #include "ui/status-bar/status-bar.hpp"
 #include "ui/top-bar/top-bar.hpp"
@@ -26,7 +27,23 @@
 #include <QStackedWidget>
 #include "settings-controller/settings-controller.hpp"
 
-void LauncherWindow::showEvent(QShowEvent *event) { m_hud->hide(); }
+void LauncherWindow::showEvent(QShowEvent *event) {
+  m_hud->hide();
+  ToggleLatencyTracker::instance()->windowShown();
+}
+
+void LauncherWindow::hideEvent(QHideEvent *event) {
+  // closing the window usually pops back to the root view, let that settle first
+  QTimer::singleShot(0, this, &LauncherWindow::prewarm);
+}
+
+void LauncherWindow::prewarm() {
+  if (isVisible()) return;
+
+  createWinId();
+  ensurePolished();
+  if (auto layout = this->layout()) layout->activate();
+}
 
 LauncherWindow::LauncherWindow(ApplicationContext &ctx) : m_ctx(ctx) {
   using namespace std::chrono_literals;
@@ -122,6 +139,8 @@ LauncherWindow::LauncherWindow(ApplicationContext &ctx) : m_ctx(ctx) {
     if (m_currentOverlayWrapper->isVisible()) return;
     m_bar->setVisible(value);
   });
+
+  prewarm();
 }
 
 void LauncherWindow::handleShowHUD(const QString &text, const std::optional<ImageURL> &icon) {
@@ -275,6 +294,11 @@ void LauncherWindow::paintEvent(QPaintEvent *event) {
   } else {
     painter.fillRect(rect(), finalBgColor);
   }
+
+  // children are painted right after us as part of the same frame, the queued call runs once it's done
+  if (auto latency = ToggleLatencyTracker::instance(); latency->isMeasuring()) {
+    QMetaObject::invokeMethod(this, [latency]() { latency->framePainted(); }, Qt::QueuedConnection);
+  }
 }
 
 QWidget *LauncherWindow::createWidget() const {
@@ -42,6 +42,7 @@ protected:
   bool event(QEvent *event) override;
   void handleActionVisibilityChanged(bool visible);
   void showEvent(QShowEvent *event) override;
+  void hideEvent(QHideEvent *event) override;
 
 private:
   ActionVeilWidget *m_actionVeil;
@@ -63,4 +64,10 @@ private:
   void handleViewChange(const NavigationController::ViewState &state);
   void setupUI();
   QWidget *createWidget() const;
+
+  /**
+   * Gets the window ready to be shown while it is still hidden, so that toggling it only needs to map
+   * and paint an already laid out surface.
+   */
+  void prewarm();
 };
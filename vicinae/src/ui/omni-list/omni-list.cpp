@@ -55,161 +55,174 @@ void OmniList::updateFocusChain() {
   }
 }
 
-void OmniList::updateVisibleItems() {
+size_t OmniList::firstVisibleIndex() {
+  int low = scrollBar->value();
+  int high = low + height();
 
-  m_visibleWidgets.clear();
-  if (m_items.empty()) return;
-  setUpdatesEnabled(false);
+  for (size_t b = m_blockHeights.lowerBound(low); b < m_blocks.size(); ++b) {
+    ensureLaidOut(b);
 
-  int scrollHeight = scrollBar->value();
-  size_t startIndex = 0;
+    auto &block = m_blocks[b];
+    int top = m_blockHeights.prefix(b);
+    auto begin = m_itemBottoms.begin() + block.firstItem;
+    auto end = begin + block.itemCount;
 
-  while (startIndex < m_items.size() && !isInViewport(m_items.at(startIndex).bounds)) {
-    ++startIndex;
-  }
+    if (auto it = std::lower_bound(begin, end, low - top); it != end) {
+      size_t index = std::distance(m_itemBottoms.begin(), it);
 
-  if (startIndex >= m_items.size()) {
-    visibleIndexRange = VisibleRangeV2::empty();
-    return;
+      if (itemBounds(index).y() > high) return m_items.size();
+
+      return index;
+    }
   }
 
-  auto &cell = m_items[startIndex];
+  return m_items.size();
+}
+
+OmniListItemWidgetWrapper *OmniList::takeRecyclable(const AbstractVirtualItem *item) {
+  auto it = m_recyclableWidgets.find(item->recyclingId());
+
+  if (it == m_recyclableWidgets.end() || it->second.empty()) return nullptr;
+
+  auto node = _widgetCache.extract(it->second.back());
+
+  it->second.pop_back();
+  node.key() = item->id();
+
+  auto widget = node.mapped().widget;
+
+  _widgetCache.insert(std::move(node));
+
+  return widget;
+}
+
+void OmniList::updateVisibleItems() {
+  m_visibleWidgets.clear();
+  setUpdatesEnabled(false);
+
+  int scrollHeight = scrollBar->value();
+  size_t startIndex = m_items.empty() ? 0 : firstVisibleIndex();
+  size_t endIndex = startIndex;
   int marginOffset = std::max(0, margins.top - scrollHeight);
   QSize viewportSize = size();
-  size_t endIndex = startIndex;
+  int cellY = startIndex < m_items.size() ? itemBounds(startIndex).y() : 0;
 
-  std::unordered_set<QString> reused;
+  // we perform a first scan to compute the range of items that fit in the viewport, so that
+  // cached widgets that are still in range are not recycled to display another item.
+  // Calling refresh() on a widget with the same ID is very likely to be a no-op.
 
-  // we perform a first scan to mark all cached widgets with an ID in range
-  // so that we can reuse them directly. Calling refresh() on a widget with the same ID
-  // is very likely to be a no-op.
-
-  int viewportY = marginOffset + cell.bounds.y() - scrollHeight;
+  int viewportY = marginOffset + cellY - scrollHeight;
   int lastY = -1;
 
   while (endIndex < m_items.size()) {
-    auto &vinfo = m_items[endIndex];
-    auto cacheIt = _widgetCache.find(vinfo.item->id());
+    int y = itemBounds(endIndex).y();
 
-    if (lastY != -1 && lastY != vinfo.bounds.y()) { viewportY += vinfo.bounds.y() - lastY; }
+    if (lastY != -1 && lastY != y) { viewportY += y - lastY; }
 
     if (viewportY >= viewportSize.height()) break;
 
-    if (cacheIt != _widgetCache.end()) reused.insert(vinfo.item->id());
-
-    lastY = vinfo.bounds.y();
+    lastY = y;
     ++endIndex;
   }
 
-  lastY = -1;
-  viewportY = marginOffset + cell.bounds.y() - scrollHeight;
-  endIndex = startIndex;
+  auto isInRange = [&](const QString &id) {
+    auto it = m_idIndex.find(id);
+    return it != m_idIndex.end() && it->second >= startIndex && it->second < endIndex;
+  };
 
-  while (endIndex < m_items.size()) {
-    auto &vinfo = m_items[endIndex];
-    auto cacheIt = _widgetCache.find(vinfo.item->id());
-    OmniListItemWidgetWrapper *widget = nullptr;
+  for (auto &[_, ids] : m_recyclableWidgets) {
+    ids.clear();
+  }
 
-    if (lastY != -1 && lastY != vinfo.bounds.y()) { viewportY += vinfo.bounds.y() - lastY; }
+  for (const auto &[id, cache] : _widgetCache) {
+    if (cache.recyclingId && !isInRange(id)) { m_recyclableWidgets[cache.recyclingId].emplace_back(id); }
+  }
 
-    if (viewportY >= viewportSize.height()) break;
+  lastY = -1;
+  viewportY = marginOffset + cellY - scrollHeight;
 
-    bool isWidgetCreated = false;
+  for (size_t index = startIndex; index != endIndex; ++index) {
+    auto &vinfo = m_items[index];
+    auto bounds = itemBounds(index);
+    auto cacheIt = _widgetCache.find(vinfo.item->id());
+    OmniListItemWidgetWrapper *widget = nullptr;
 
-    auto start = std::chrono::high_resolution_clock::now();
+    if (lastY != -1 && lastY != bounds.y()) { viewportY += bounds.y() - lastY; }
 
-    if (cacheIt == _widgetCache.end()) {
-      bool recycled = false;
-      // TODO: find a more efficient solution, this is doing too much map stuff
-      for (const auto &[key, cache] : _widgetCache) {
-        bool reserved = reused.find(key) != reused.end();
+    if (cacheIt != _widgetCache.end()) {
+      widget = cacheIt->second.widget;
 
-        if (!reserved && vinfo.item->recyclable() && vinfo.item->recyclingId() == cache.recyclingId) {
-          vinfo.item->recycle(cache.widget->widget());
-          vinfo.item->attached(cache.widget->widget());
-          widget = cache.widget;
-          _widgetCache[vinfo.item->id()] = cache;
-          reused.insert(vinfo.item->id());
-          // qDebug() << "placed to reused" << vinfo.item->id();
-          _widgetCache.erase(key);
+      if (m_refreshCachedWidgets) {
+        QWidget *content = widget->widget();
 
-          // qInfo() << "recycled in place" << vinfo.item->id();
-          recycled = true;
-          break;
-        }
+        content->setUpdatesEnabled(false);
+        vinfo.item->refresh(content);
+        content->setUpdatesEnabled(true);
+      }
+    } else if (vinfo.item->recyclable() && (widget = takeRecyclable(vinfo.item))) {
+      vinfo.item->recycle(widget->widget());
+      vinfo.item->attached(widget->widget());
+    } else {
+      if (auto wrapper = takeFromPool(vinfo.item->recyclingId())) {
+        wrapper->setParent(this);
+        vinfo.item->recycle(wrapper->widget());
+        vinfo.item->attached(wrapper->widget());
+        wrapper->blockSignals(false);
+        wrapper->setUpdatesEnabled(true);
+        widget = wrapper;
+      } else {
+        widget = new OmniListItemWidgetWrapper(this);
+        connect(widget, &OmniListItemWidgetWrapper::clicked, this, &OmniList::itemClicked,
+                Qt::UniqueConnection);
+        connect(widget, &OmniListItemWidgetWrapper::doubleClicked, this, &OmniList::itemDoubleClicked,
+                Qt::UniqueConnection);
+        connect(widget, &OmniListItemWidgetWrapper::rightClicked, this, &OmniList::rightClicked,
+                Qt::UniqueConnection);
+        widget->stackUnder(scrollBar);
+        OmniListItemWidget *w = vinfo.item->createWidget();
+        widget->setWidget(w);
+        vinfo.item->attached(w);
       }
 
-      if (!recycled) {
-        if (auto wrapper = takeFromPool(vinfo.item->recyclingId())) {
-          wrapper->setParent(this);
-          vinfo.item->recycle(wrapper->widget());
-          vinfo.item->attached(wrapper->widget());
-          wrapper->blockSignals(false);
-          wrapper->setUpdatesEnabled(true);
-          widget = wrapper;
-        } else {
-          widget = new OmniListItemWidgetWrapper(this);
-          connect(widget, &OmniListItemWidgetWrapper::clicked, this, &OmniList::itemClicked,
-                  Qt::UniqueConnection);
-          connect(widget, &OmniListItemWidgetWrapper::doubleClicked, this, &OmniList::itemDoubleClicked,
-                  Qt::UniqueConnection);
-          connect(widget, &OmniListItemWidgetWrapper::rightClicked, this, &OmniList::rightClicked,
-                  Qt::UniqueConnection);
-          widget->stackUnder(scrollBar);
-          OmniListItemWidget *w = vinfo.item->createWidget();
-          widget->setWidget(w);
-          vinfo.item->attached(w);
-        }
-
-        CachedWidget cache{.widget = widget, .recyclingId = 0};
+      CachedWidget cache{.widget = widget, .recyclingId = 0};
 
-        if (vinfo.item->recyclable()) { cache.recyclingId = vinfo.item->recyclingId(); }
+      if (vinfo.item->recyclable()) { cache.recyclingId = vinfo.item->recyclingId(); }
 
-        isWidgetCreated = true;
-        reused.insert(vinfo.item->id());
-        _widgetCache[vinfo.item->id()] = cache;
-      }
-    } else {
-      widget = cacheIt->second.widget;
+      _widgetCache[vinfo.item->id()] = cache;
     }
 
-    QPoint pos(vinfo.bounds.x(), viewportY);
-    QSize size(vinfo.bounds.width(), vinfo.bounds.height());
-
-    // qDebug() << "pos" << pos << "size" << size << "index" << endIndex << vinfo.item->id();
+    QPoint pos(bounds.x(), viewportY);
+    QSize size(bounds.width(), bounds.height());
 
     widget->blockSignals(true);
-    widget->setIndex(endIndex);
-    widget->setSelected(endIndex == m_selected);
+    widget->setIndex(index);
+    widget->setSelected(index == m_selected);
     if (widget->size() != size) { widget->resize(size); }
     widget->move(pos);
     widget->show();
-
-    /*
-qDebug() << "Widget" << vinfo.item->id() << "visible:" << widget->isVisible()
-         << "parent:" << widget->parent() << "geometry:" << widget->geometry()
-         << "enabled:" << widget->isEnabled();
-                     */
     widget->blockSignals(false);
 
-    lastY = vinfo.bounds.y();
+    lastY = bounds.y();
     m_visibleWidgets.emplace_back(widget);
-    reused.insert(vinfo.item->id());
-
-    auto end = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1e6;
-    ++endIndex;
   }
 
+  // widgets that went out of the viewport and were not recycled in place
   for (auto it = _widgetCache.begin(); it != _widgetCache.end();) {
-    if (auto match = reused.find(it->first); match == reused.end()) {
-      it->second.widget->deleteLater();
-      it = _widgetCache.erase(it);
-    } else {
+    if (isInRange(it->first)) {
       ++it;
+      continue;
+    }
+
+    if (it->second.recyclingId) {
+      moveToPool(it->second.recyclingId, it->second.widget);
+    } else {
+      it->second.widget->deleteLater();
     }
+
+    it = _widgetCache.erase(it);
   }
 
+  m_refreshCachedWidgets = false;
   setUpdatesEnabled(true);
   recalculateMousePosition();
   updateFocusChain();
@@ -224,13 +237,168 @@ bool OmniList::isDividableContent(const ModelItem &item) {
   return false;
 }
 
+std::vector<OmniList::VirtualWidgetInfo> OmniList::blockItems(size_t blockIndex) {
+  auto &modelItem = m_model.at(m_blocks.at(blockIndex).modelIndex);
+  std::vector<VirtualWidgetInfo> items;
+
+  if (auto divider = std::get_if<Divider>(&modelItem)) {
+    items.push_back({.item = divider->item(), .block = blockIndex});
+    return items;
+  }
+
+  auto &section = std::get<std::unique_ptr<Section>>(modelItem);
+  auto &layoutItems = section->layoutItems();
+
+  items.reserve(layoutItems.size() + 1);
+
+  for (const auto &layoutItem : layoutItems) {
+    auto widget = std::get_if<Section::VirtualWidget>(&layoutItem);
+
+    if (!widget) continue;
+
+    // Show section header above the first actually displayed item (after filtering has been
+    // considered)
+    if (items.empty()) {
+      if (auto header = section->headerItem(); header && !section->title().isEmpty()) {
+        items.push_back({.item = header, .block = blockIndex});
+      }
+    }
+
+    items.push_back({.item = widget->get(), .enumerable = true, .block = blockIndex});
+  }
+
+  return items;
+}
+
+std::optional<int> OmniList::uniformBlockHeight(size_t blockIndex) {
+  auto section = std::get_if<std::unique_ptr<Section>>(&m_model.at(m_blocks.at(blockIndex).modelIndex));
+
+  if (!section || !(*section)->uniformItem()) return std::nullopt;
+
+  auto &sec = **section;
+  int width = availableWidth();
+  int spaceWidth = sec.spacing() * (sec.columns() - 1);
+  int columnWidth = (width - spaceWidth) / sec.columns();
+  int step = columnWidth + sec.spacing();
+  int count = sec.layoutItems().size();
+
+  if (count == 0) return 0;
+
+  // mirrors the wrapping rule applied in layoutBlock: a row ends as soon as x reaches the available width
+  int needed = width - margins.left;
+  int perRow = step <= 0 ? count : std::max(1, needed <= 0 ? 1 : (needed + step - 1) / step);
+  int rows = (count + perRow - 1) / perRow;
+  int itemHeight = calculateItemHeight(sec.uniformItem(), columnWidth);
+  int height = rows * itemHeight + (rows - 1) * sec.spacing();
+
+  if (auto header = sec.headerItem(); header && !sec.title().isEmpty()) {
+    height += header->calculateHeight(width);
+  }
+
+  return height;
+}
+
+int OmniList::layoutBlock(size_t blockIndex) {
+  auto &block = m_blocks.at(blockIndex);
+  auto &modelItem = m_model.at(block.modelIndex);
+  int width = availableWidth();
+  int yOffset = 0;
+  size_t index = block.firstItem;
+
+  if (auto divider = std::get_if<Divider>(&modelItem)) {
+    int height = divider->item()->calculateHeight(width);
+
+    m_items[index].bounds = QRect(0, 0, this->width(), height);
+    yOffset = height;
+  } else {
+    auto &section = std::get<std::unique_ptr<Section>>(modelItem);
+    int spaceWidth = section->spacing() * (section->columns() - 1);
+    int columnWidth = (width - spaceWidth) / section->columns();
+    SectionCalculationContext sctx{.x = margins.left, .maxHeight = 0};
+    bool headerShown = false;
+
+    for (auto &sectionItem : section->layoutItems()) {
+      if (auto spacer = std::get_if<Spacer>(&sectionItem)) {
+        yOffset += spacer->value;
+        continue;
+      }
+
+      auto &item = std::get<Section::VirtualWidget>(sectionItem);
+
+      if (!headerShown) {
+        headerShown = true;
+
+        if (auto header = section->headerItem(); header && !section->title().isEmpty()) {
+          int height = header->calculateHeight(width);
+
+          m_items[index++].bounds = QRect(margins.left, yOffset, width, height);
+          yOffset += height;
+        }
+      }
+
+      if (sctx.x == margins.left && sctx.index > 0) { yOffset += section->spacing(); }
+
+      int x = sctx.x;
+      int y = yOffset;
+      int height = calculateItemHeight(item.get(), columnWidth);
+
+      sctx.x = sctx.x + columnWidth + section->spacing();
+      sctx.maxHeight = std::max(sctx.maxHeight, height);
+
+      if (sctx.x >= width) {
+        yOffset += sctx.maxHeight;
+        sctx.x = margins.left;
+        sctx.maxHeight = 0;
+      }
+
+      ++sctx.index;
+      m_items[index++].bounds = QRect(x, y, columnWidth, height);
+    }
+
+    yOffset += sctx.maxHeight;
+  }
+
+  int maxBottom = 0;
+
+  for (size_t i = block.firstItem; i != block.firstItem + block.itemCount; ++i) {
+    maxBottom = std::max(maxBottom, m_items[i].bounds.y() + m_items[i].bounds.height());
+    m_itemBottoms[i] = maxBottom;
+  }
+
+  block.laidOut = true;
+
+  return yOffset;
+}
+
+void OmniList::ensureLaidOut(size_t blockIndex) {
+  if (!m_blocks[blockIndex].laidOut) { layoutBlock(blockIndex); }
+}
+
+QRect OmniList::itemBounds(size_t index) {
+  auto &info = m_items.at(index);
+
+  ensureLaidOut(info.block);
+
+  return info.bounds.translated(0, m_blockHeights.prefix(info.block));
+}
+
+void OmniList::updateVirtualHeight() {
+  int height = m_blockHeights.total();
+
+  if (!m_items.empty()) { height += margins.bottom + margins.top; }
+
+  scrollBar->setMaximum(std::max(0, height - this->height()));
+  scrollBar->setMinimum(0);
+  m_virtualHeight = height;
+}
+
 void OmniList::calculateHeights() {
   Timer timer;
 
   int yOffset = 0;
-  int availableWidth = width() - margins.left - margins.right;
-  std::optional<SectionCalculationContext> sctx;
-  std::unordered_map<QString, CachedWidget> updatedCache;
+  // blocks that start below this offset are laid out lazily, if they can be
+  int lazyThreshold = scrollBar->value() + height() * 2;
+  std::vector<int> heights;
 
   auto view = m_model | std::views::filter([](const auto &item) {
                 return std::holds_alternative<std::unique_ptr<Section>>(item);
@@ -242,145 +410,51 @@ void OmniList::calculateHeights() {
 
   m_items.reserve(totalSize);
   m_items.clear();
+  m_idIndex.clear();
+  m_idIndex.reserve(totalSize);
+  m_blocks.clear();
+  heights.reserve(m_model.size());
   visibleIndexRange = VisibleRangeV2::empty();
 
-  size_t i = -1;
+  for (size_t i = 0; i != m_model.size(); ++i) {
+    auto &item = m_model[i];
 
-  for (const auto &item : m_model) {
-    ++i;
-    if (auto divider = std::get_if<Divider>(&item)) {
+    if (std::holds_alternative<Divider>(item)) {
       if (yOffset == 0) continue;
       if (i + 1 == m_model.size() || !isDividableContent(m_model.at(i + 1))) continue;
+    } else if (std::get<std::unique_ptr<Section>>(item)->layoutItems().empty()) {
+      continue;
+    }
 
-      int height = divider->item()->calculateHeight(availableWidth);
-      QRect bounds(0, yOffset, width(), height);
-      VirtualWidgetInfo vinfo{.bounds = bounds, .item = divider->item()};
-
-      m_items.push_back(vinfo);
-      yOffset += height;
-    } else if (auto p = std::get_if<std::unique_ptr<Section>>(&item)) {
-      auto &section = *p;
-
-      auto &items = section->layoutItems();
-      int spaceWidth = section->spacing() * (section->columns() - 1);
-      int columnWidth = (availableWidth - spaceWidth) / section->columns();
+    size_t blockIndex = m_blocks.size();
 
-      if (items.empty()) continue;
+    m_blocks.push_back({.modelIndex = i, .firstItem = m_items.size()});
 
-      sctx = {.x = margins.left, .maxHeight = 0};
+    auto items = blockItems(blockIndex);
 
-      size_t shownCount = 0;
+    m_blocks.back().itemCount = items.size();
 
-      for (auto &sectionItem : items) {
-        if (auto spacer = std::get_if<Spacer>(&sectionItem)) {
-          yOffset += spacer->value;
-          continue;
-        }
+    for (const auto &info : items) {
+      m_idIndex.try_emplace(info.item->id(), m_items.size());
+      m_items.push_back(info);
+    }
 
-        if (auto p = std::get_if<Section::VirtualWidget>(&sectionItem)) {
-          auto &item = *p;
-
-          // Show section header above the first actually displayed item (after filtering has been
-          // considered)
-          if (shownCount == 0) {
-            if (auto header = section->headerItem(); header && !section->title().isEmpty()) {
-              int height = header->calculateHeight(availableWidth);
-              QRect geometry(margins.left, yOffset, availableWidth, height);
-
-              VirtualWidgetInfo vinfo{.bounds = geometry, .item = header};
-
-              m_items.push_back(vinfo);
-              yOffset += height;
-            }
-          }
-
-          ++shownCount;
-
-          int vIndex = m_items.size();
-          int height = 0;
-          int width = columnWidth;
-          int x = margins.left;
-          int y = yOffset;
-
-          if (sctx) {
-            // width = sctx->section->calculateItemWidth(width, sctx->index);
-            //  x = sctx->section->calculateItemX(sctx->x, sctx->index);
-            if (sctx->x == margins.left && sctx->index > 0) {
-              yOffset += section->spacing();
-              y = yOffset;
-            }
-
-            x = sctx->x;
-            sctx->x = sctx->x + width + section->spacing();
-            height = calculateItemHeight(item.get(), width);
-            sctx->maxHeight = std::max(sctx->maxHeight, height);
-
-            if (sctx->x >= availableWidth) {
-              yOffset += sctx->maxHeight;
-              sctx->x = margins.left;
-              sctx->maxHeight = 0;
-            }
-
-            ++sctx->index;
-          } else {
-            height = item->calculateHeight(width);
-            yOffset += height;
-          }
-
-          QRect geometry(x, y, width, height);
-          VirtualWidgetInfo vinfo{.bounds = geometry, .item = item.get(), .enumerable = true};
-
-          // TODO: if in viewport, look for cached entry
-          if (isInViewport(geometry)) {
-            if (auto it = _widgetCache.find(item->id()); it != _widgetCache.end()) {
-              QWidget *widget = it->second.widget->widget();
-
-              widget->setUpdatesEnabled(false);
-              item->refresh(widget);
-              widget->setUpdatesEnabled(true);
-              updatedCache[item->id()] = it->second;
-              _widgetCache.erase(it->first);
-            } else {
-              for (const auto &[key, cache] : _widgetCache) {
-                if (cache.recyclingId == item->recyclingId()) {
-                  QWidget *widget = cache.widget->widget();
-
-                  widget->setUpdatesEnabled(false);
-                  item->attached(widget);
-                  item->recycle(widget);
-                  widget->setUpdatesEnabled(true);
-                  updatedCache[item->id()] = cache;
-                  _widgetCache.erase(key);
-                  break;
-                }
-              }
-            }
-          }
-
-          ++shownCount;
-          m_items.push_back(vinfo);
-        }
-      }
+    m_itemBottoms.resize(m_items.size());
 
-      if (sctx) { yOffset += sctx->maxHeight; }
-    }
-  }
+    std::optional<int> height;
 
-  if (!m_items.empty()) { yOffset += margins.bottom + margins.top; }
+    if (yOffset > lazyThreshold) { height = uniformBlockHeight(blockIndex); }
+    if (!height) { height = layoutBlock(blockIndex); }
 
-  for (auto &[key, cache] : _widgetCache) {
-    if (cache.recyclingId) {
-      moveToPool(cache.recyclingId, cache.widget);
-    } else {
-      cache.widget->deleteLater();
-    }
+    heights.push_back(*height);
+    yOffset += *height;
   }
 
+  m_itemBottoms.resize(m_items.size());
+  m_blockHeights.assign(heights);
   _visibleWidgets.clear();
-  _widgetCache = updatedCache;
-  scrollBar->setMaximum(std::max(0, yOffset - height()));
-  scrollBar->setMinimum(0);
-  m_virtualHeight = yOffset;
+  m_refreshCachedWidgets = true;
+  updateVirtualHeight();
 
   // timer.time("calculateHeights");
 
@@ -389,6 +463,62 @@ void OmniList::calculateHeights() {
   emit virtualHeightChanged(m_virtualHeight);
 }
 
+void OmniList::relayoutBlock(size_t blockIndex) {
+  auto &block = m_blocks.at(blockIndex);
+  auto items = blockItems(blockIndex);
+  auto first = m_items.begin() + block.firstItem;
+  auto last = first + block.itemCount;
+  ptrdiff_t delta = static_cast<ptrdiff_t>(items.size()) - static_cast<ptrdiff_t>(block.itemCount);
+
+  // if the number of items changes, every item laid out after this block moves as well
+  auto affectedEnd = delta == 0 ? last : m_items.end();
+
+  for (auto it = first; it != affectedEnd; ++it) {
+    if (auto idx = m_idIndex.find(it->item->id());
+        idx != m_idIndex.end() && idx->second == std::distance(m_items.begin(), it)) {
+      m_idIndex.erase(idx);
+    }
+  }
+
+  m_items.erase(first, last);
+  m_items.insert(m_items.begin() + block.firstItem, items.begin(), items.end());
+  m_itemBottoms.erase(m_itemBottoms.begin() + block.firstItem,
+                      m_itemBottoms.begin() + block.firstItem + block.itemCount);
+  m_itemBottoms.insert(m_itemBottoms.begin() + block.firstItem, items.size(), 0);
+  block.itemCount = items.size();
+
+  for (size_t b = blockIndex + 1; b < m_blocks.size(); ++b) {
+    m_blocks[b].firstItem += delta;
+  }
+
+  size_t reindexEnd = delta == 0 ? block.firstItem + block.itemCount : m_items.size();
+
+  // first one wins on duplicate ids, as in `calculateHeights`
+  for (size_t i = block.firstItem; i != reindexEnd; ++i) {
+    auto [idx, inserted] = m_idIndex.try_emplace(m_items[i].item->id(), i);
+
+    if (!inserted && idx->second > static_cast<int>(i)) idx->second = i;
+  }
+
+  m_blockHeights.set(blockIndex, layoutBlock(blockIndex));
+  updateVirtualHeight();
+}
+
+void OmniList::restoreSelection() {
+  if (m_selected == -1) {
+    updateVisibleItems();
+    return;
+  }
+
+  if (auto it = m_idIndex.find(m_selectedId); !m_selectedId.isEmpty() && it != m_idIndex.end()) {
+    m_selected = it->second;
+    updateVisibleItems();
+    return;
+  }
+
+  setSelected(PreserveSelection);
+}
+
 bool OmniList::isInViewport(const QRect &bounds) {
   int low = scrollBar->value();
   int high = low + height();
@@ -543,24 +673,22 @@ bool OmniList::selectDown() {
     return true;
   }
 
-  auto &current = m_items[m_selected];
+  QRect current = itemBounds(m_selected);
   int next = m_selected;
 
   while (next < m_items.size() &&
-         (m_items[next].bounds.y() == current.bounds.y() || !m_items[next].item->selectable())) {
+         (itemBounds(next).y() == current.y() || !m_items[next].item->selectable())) {
     ++next;
   }
 
   int endNext = next;
 
-  while (endNext < m_items.size() && m_items[endNext].bounds.y() == m_items[next].bounds.y()) {
+  while (endNext < m_items.size() && itemBounds(endNext).y() == itemBounds(next).y()) {
     ++endNext;
   }
 
   for (int i = endNext - 1; i >= next; --i) {
-    auto &vItem = m_items[i];
-
-    if (vItem.bounds.x() <= current.bounds.x() && vItem.item->selectable()) {
+    if (itemBounds(i).x() <= current.x() && m_items[i].item->selectable()) {
       setSelectedIndex(i, ScrollBehaviour::ScrollRelative);
       return true;
     }
@@ -576,13 +704,12 @@ bool OmniList::selectUp() {
     return true;
   }
 
-  auto &current = m_items[m_selected];
+  QRect current = itemBounds(m_selected);
 
   for (int i = m_selected - 1; i >= 0; --i) {
-    auto &vitem = m_items[i];
+    QRect bounds = itemBounds(i);
 
-    if (vitem.bounds.y() < current.bounds.y() && vitem.bounds.x() <= current.bounds.x() &&
-        vitem.item->selectable()) {
+    if (bounds.y() < current.y() && bounds.x() <= current.x() && m_items[i].item->selectable()) {
       setSelectedIndex(i, ScrollBehaviour::ScrollRelative);
       return true;
     }
@@ -592,15 +719,15 @@ bool OmniList::selectUp() {
 }
 
 bool OmniList::selectLeft() {
-  auto base = m_items[m_selected];
+  QRect base = itemBounds(m_selected);
   int availableWidth = width() - margins.left - margins.right;
 
   for (int i = m_selected - 1; i >= 0; --i) {
-    auto &vItem = m_items[i];
+    if (!m_items[i].item->selectable()) { continue; }
+
+    QRect bounds = itemBounds(i);
 
-    if (!vItem.item->selectable()) { continue; }
-    if (vItem.bounds.y() < base.bounds.y() && vItem.bounds.width() == base.bounds.width() &&
-        base.bounds.width() == availableWidth) {
+    if (bounds.y() < base.y() && bounds.width() == base.width() && base.width() == availableWidth) {
       return false;
     }
 
@@ -612,16 +739,15 @@ bool OmniList::selectLeft() {
 }
 
 bool OmniList::selectRight() {
-  auto base = m_items[m_selected];
+  QRect base = itemBounds(m_selected);
   int availableWidth = width() - margins.left - margins.right;
 
   for (int i = m_selected + 1; i < m_items.size(); ++i) {
-    auto &vItem = m_items[i];
+    if (!m_items[i].item->selectable()) { continue; }
 
-    if (!vItem.item->selectable()) { continue; }
+    QRect bounds = itemBounds(i);
 
-    if (vItem.bounds.y() > base.bounds.y() && vItem.bounds.width() == base.bounds.width() &&
-        base.bounds.width() == availableWidth)
+    if (bounds.y() > base.y() && bounds.width() == base.width() && base.width() == availableWidth)
       return false;
 
     setSelectedIndex(i, ScrollBehaviour::ScrollRelative);
@@ -660,24 +786,20 @@ void OmniList::setSelectedIndex(int index, ScrollBehaviour scrollBehaviour) {
 }
 
 int OmniList::previousRowIndex(int index) {
-  auto &base = m_items[index];
+  int baseY = itemBounds(index).y();
 
   for (int i = index - 1; i >= 0; --i) {
-    auto &info = m_items[i];
-
-    if (info.bounds.y() < base.bounds.y()) { return i; }
+    if (itemBounds(i).y() < baseY) { return i; }
   }
 
   return -1;
 }
 
 int OmniList::nextRowIndex(int index) {
-  auto &base = m_items[index];
+  int baseY = itemBounds(index).y();
 
   for (int i = index + 1; i < m_items.size(); ++i) {
-    auto &info = m_items[i];
-
-    if (info.bounds.y() > base.bounds.y()) { return i; }
+    if (itemBounds(i).y() > baseY) { return i; }
   }
 
   return -1;
@@ -686,8 +808,7 @@ int OmniList::nextRowIndex(int index) {
 void OmniList::scrollTo(int idx, ScrollBehaviour behaviour) {
   if (idx < 0 || idx >= m_items.size()) return;
 
-  auto &item = m_items[idx];
-  auto &bounds = item.bounds;
+  QRect bounds = itemBounds(idx);
 
   int previousIdx = previousRowIndex(idx);
 
@@ -716,10 +837,10 @@ void OmniList::scrollTo(int idx, ScrollBehaviour behaviour) {
   if (behaviour == ScrollBehaviour::ScrollAbsolute) { newScroll = bounds.y(); }
 
   if (previousIdx != -1 && m_items[previousIdx].item->isSection()) {
-    auto &anchor = m_items[previousIdx];
+    QRect anchor = itemBounds(previousIdx);
     int low = newScroll;
     int high = low + height();
-    bool isAnchorVisible = anchor.bounds.y() >= low && anchor.bounds.y() <= high;
+    bool isAnchorVisible = anchor.y() >= low && anchor.y() <= high;
 
     if (!isAnchorVisible) { return scrollTo(previousIdx, behaviour); }
   }
@@ -806,17 +927,13 @@ void OmniList::refresh() const {
 }
 
 const OmniList::AbstractVirtualItem *OmniList::itemAt(const QString &id) const {
-  for (const auto &entry : m_items) {
-    if (entry.item->id() == id) return entry.item;
-  }
+  if (auto it = m_idIndex.find(id); it != m_idIndex.end()) return m_items.at(it->second).item;
 
   return nullptr;
 }
 
 OmniList::AbstractVirtualItem *OmniList::itemAt(const QString &id) {
-  for (const auto &entry : m_items) {
-    if (entry.item->id() == id) return entry.item;
-  }
+  if (auto it = m_idIndex.find(id); it != m_idIndex.end()) return m_items.at(it->second).item;
 
   return nullptr;
 }
@@ -849,24 +966,216 @@ void OmniList::clear() {
 }
 
 bool OmniList::removeItem(const QString &id) {
-  qCritical() << "remove item not implemented";
+  auto indexIt = m_idIndex.find(id);
 
-  return false;
+  if (indexIt == m_idIndex.end()) return false;
+
+  size_t blockIndex = m_items[indexIt->second].block;
+  auto item = m_items[indexIt->second].item;
+  auto section = std::get_if<std::unique_ptr<Section>>(&m_model.at(m_blocks[blockIndex].modelIndex));
+
+  if (!section || !item->isListItem()) return false;
+
+  if (auto it = _widgetCache.find(id); it != _widgetCache.end()) {
+    item->detached(it->second.widget->widget());
+
+    if (it->second.recyclingId) {
+      moveToPool(it->second.recyclingId, it->second.widget);
+    } else {
+      it->second.widget->deleteLater();
+    }
+
+    _widgetCache.erase(it);
+  }
+
+  m_idIndex.erase(indexIt);
+
+  // relayoutBlock reads the ids of the previous items of the block, so the removed item
+  // needs to outlive it.
+  std::shared_ptr<AbstractVirtualItem> owner;
+
+  for (const auto &layoutItem : (*section)->layoutItems()) {
+    if (auto widget = std::get_if<Section::VirtualWidget>(&layoutItem); widget && widget->get() == item) {
+      owner = *widget;
+      break;
+    }
+  }
+
+  (*section)->removeItem(item);
+
+  // removing the last item of a section changes whether the surrounding dividers and header are shown
+  if ((*section)->widgetCount() == 0) {
+    calculateHeights();
+  } else {
+    relayoutBlock(blockIndex);
+  }
+
+  restoreSelection();
+  emit virtualHeightChanged(m_virtualHeight);
+
+  return true;
+}
+
+bool OmniList::insertItem(const QString &anchorId, std::shared_ptr<AbstractVirtualItem> item, bool after) {
+  auto indexIt = m_idIndex.find(anchorId);
+
+  if (indexIt == m_idIndex.end()) return false;
+
+  size_t blockIndex = m_items[indexIt->second].block;
+  auto anchor = m_items[indexIt->second].item;
+  auto section = std::get_if<std::unique_ptr<Section>>(&m_model.at(m_blocks[blockIndex].modelIndex));
+
+  if (!section || !(*section)->insertItem(anchor, std::move(item), after)) return false;
+
+  relayoutBlock(blockIndex);
+  restoreSelection();
+  emit virtualHeightChanged(m_virtualHeight);
+
+  return true;
+}
+
+bool OmniList::insertItemBefore(const QString &id, std::shared_ptr<AbstractVirtualItem> item) {
+  return insertItem(id, std::move(item), false);
+}
+
+bool OmniList::insertItemAfter(const QString &id, std::shared_ptr<AbstractVirtualItem> item) {
+  return insertItem(id, std::move(item), true);
+}
+
+std::optional<size_t> OmniList::modelIndexOf(const Section &section) const {
+  auto it = std::ranges::find_if(m_model, [&](auto &&item) {
+    auto ptr = std::get_if<std::unique_ptr<Section>>(&item);
+    return ptr && ptr->get() == &section;
+  });
+
+  if (it == m_model.end()) return std::nullopt;
+
+  return std::distance(m_model.begin(), it);
+}
+
+std::optional<size_t> OmniList::blockIndexOf(size_t modelIndex) const {
+  auto it = std::ranges::find(m_blocks, modelIndex, &LayoutBlock::modelIndex);
+
+  if (it == m_blocks.end()) return std::nullopt;
+
+  return std::distance(m_blocks.begin(), it);
+}
+
+bool OmniList::setSectionItems(const Section &section,
+                               std::vector<std::shared_ptr<AbstractVirtualItem>> items) {
+  auto modelIndex = modelIndexOf(section);
+
+  if (!modelIndex) return false;
+
+  auto &target = *std::get<std::unique_ptr<Section>>(m_model[*modelIndex]);
+
+  if (target.layoutItems().empty() && items.empty()) return true;
+
+  bool followFirst = m_selected == -1 || selected() == firstSelectableItem();
+  auto blockIndex = blockIndexOf(*modelIndex);
+  // relayoutBlock reads the ids of the previous items of the block, so they need to outlive it
+  auto previous = target.takeItems();
+
+  target.addItems(std::move(items));
+
+  // a section that appears or disappears changes whether the surrounding dividers are shown
+  if (!blockIndex || target.layoutItems().empty()) {
+    calculateHeights();
+  } else {
+    relayoutBlock(*blockIndex);
+
+    auto &block = m_blocks[*blockIndex];
+
+    // widgets are cached by item id: the ones that are kept need to show the new item
+    for (size_t i = block.firstItem; i != block.firstItem + block.itemCount; ++i) {
+      auto item = m_items[i].item;
+      auto it = _widgetCache.find(item->id());
+
+      if (it == _widgetCache.end()) continue;
+
+      QWidget *widget = it->second.widget->widget();
+
+      if (item->hasPartialUpdates()) {
+        item->refresh(widget);
+      } else if (item->recyclable()) {
+        item->recycle(widget);
+      } else {
+        it->second.widget->deleteLater();
+        _widgetCache.erase(it);
+        continue;
+      }
+
+      item->attached(widget);
+    }
+  }
+
+  if (followFirst) {
+    selectFirst();
+  } else {
+    restoreSelection();
+  }
+
+  emit virtualHeightChanged(m_virtualHeight);
+
+  return true;
+}
+
+bool OmniList::setSectionTitle(const Section &section, const QString &title) {
+  auto modelIndex = modelIndexOf(section);
+
+  if (!modelIndex) return false;
+
+  auto &target = *std::get<std::unique_ptr<Section>>(m_model[*modelIndex]);
+
+  if (target.title() == title) return true;
+
+  // same as for setSectionItems, the previous header needs to outlive the layout
+  auto previous = target.setTitle(title);
+
+  if (auto blockIndex = blockIndexOf(*modelIndex)) {
+    relayoutBlock(*blockIndex);
+    restoreSelection();
+    emit virtualHeightChanged(m_virtualHeight);
+  }
+
+  return true;
 }
 
 bool OmniList::updateItem(const QString &id, const UpdateItemCallback &cb) {
-  auto item = itemAt(id);
+  auto indexIt = m_idIndex.find(id);
 
-  if (!item) return false;
+  if (indexIt == m_idIndex.end()) return false;
+
+  size_t index = indexIt->second;
+  auto item = m_items[index].item;
 
   cb(item);
 
-  if (item->recyclable()) {
-    if (auto it2 = _widgetCache.find(id); it2 != _widgetCache.end()) {
-      item->recycle(it2->second.widget->widget());
+  if (!item->hasUniformHeight()) {
+    QRect bounds = itemBounds(index);
+
+    if (item->calculateHeight(bounds.width()) != bounds.height()) {
+      // only the block of this item needs to be laid out again, following blocks are merely offset
+      relayoutBlock(m_items[index].block);
+      restoreSelection();
+      emit itemUpdated(*item);
+      emit virtualHeightChanged(m_virtualHeight);
+      return true;
+    }
+  }
+
+  if (auto it = _widgetCache.find(id); it != _widgetCache.end()) {
+    QWidget *widget = it->second.widget->widget();
+
+    if (item->hasPartialUpdates()) {
+      item->refresh(widget);
+    } else if (item->recyclable()) {
+      item->recycle(widget);
     }
   }
 
+  emit itemUpdated(*item);
+
   return true;
 }
 
@@ -905,12 +1214,10 @@ void OmniList::invalidateCache(const QString &id) {
 
 const OmniList::AbstractVirtualItem *OmniList::setSelected(const QString &id,
                                                            ScrollBehaviour scrollBehaviour) {
-  for (int i = 0; i != m_items.size(); ++i) {
-    if (m_items[i].item->id() == id) {
-      setSelectedIndex(i, scrollBehaviour);
+  if (auto it = m_idIndex.find(id); it != m_idIndex.end()) {
+    setSelectedIndex(it->second, scrollBehaviour);
 
-      return m_items[i].item;
-    }
+    return m_items[it->second].item;
   }
 
   return nullptr;
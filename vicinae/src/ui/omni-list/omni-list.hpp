@@ -1,5 +1,6 @@
 #pragma once
 #include "common.hpp"
+#include "fenwick-tree.hpp"
 #include "../image/url.hpp"
 #include "ui/omni-list/omni-list-item-widget.hpp"
 #include "ui/omni-list/omni-list-item-widget-wrapper.hpp"
@@ -13,6 +14,7 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <qboxlayout.h>
 #include <qelapsedtimer.h>
 #include <qfuture.h>
@@ -28,6 +30,7 @@
 #include <ranges>
 #include <stack>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 
 class OmniList : public QWidget {
@@ -198,6 +201,25 @@ public:
     size_t m_itemCount = 0;
     int m_columns = 1;
     int m_spacing = 0;
+    // set as long as every layout item is an item of uniform height sharing the same recycling id
+    std::shared_ptr<AbstractVirtualItem> m_uniformItem;
+    bool m_uniform = true;
+
+    void trackUniformity(size_t from) {
+      for (size_t i = from; i < m_layoutItems.size() && m_uniform; ++i) {
+        auto item = std::get_if<VirtualWidget>(&m_layoutItems[i]);
+
+        if (!item || !(*item)->hasUniformHeight()) {
+          m_uniform = false;
+        } else if (!m_uniformItem) {
+          m_uniformItem = *item;
+        } else if (m_uniformItem->recyclingId() != (*item)->recyclingId()) {
+          m_uniform = false;
+        }
+      }
+
+      if (!m_uniform) m_uniformItem.reset();
+    }
 
   public:
     Section(const QString &title = "", const QString &subtitle = "") : m_title(title), m_subtitle(subtitle) {
@@ -246,35 +268,112 @@ public:
 
     const std::vector<LayoutItem> &layoutItems() const { return m_layoutItems; }
 
+    /**
+     * If all the items of this section have the same uniform height, one of them.
+     * This allows the list to compute the height of the section without laying out every item.
+     */
+    const AbstractVirtualItem *uniformItem() const { return m_uniformItem.get(); }
+
+    /**
+     * Number of layout items that are actual widgets (i.e not spacers).
+     */
+    size_t widgetCount() const {
+      return std::ranges::count_if(m_layoutItems,
+                                   [](auto &&item) { return std::holds_alternative<VirtualWidget>(item); });
+    }
+
     Section &addItem(std::shared_ptr<AbstractVirtualItem> item) {
       m_layoutItems.emplace_back(std::move(item));
       ++m_itemCount;
+      trackUniformity(m_layoutItems.size() - 1);
       return *this;
     }
 
     Section &addSpacing(int value) {
       m_layoutItems.emplace_back(Spacer(value));
+      trackUniformity(m_layoutItems.size() - 1);
       return *this;
     }
 
     Section &addDivider() {
       m_layoutItems.emplace_back(std::make_unique<DividerItem>());
+      trackUniformity(m_layoutItems.size() - 1);
       return *this;
     }
 
     Section &addItems(std::vector<std::unique_ptr<AbstractVirtualItem>> items) {
+      size_t from = m_layoutItems.size();
+
       m_layoutItems.insert(m_layoutItems.end(), std::make_move_iterator(items.begin()),
                            std::make_move_iterator(items.end()));
       m_itemCount += items.size();
+      trackUniformity(from);
       return *this;
     }
 
     Section &addItems(std::vector<std::shared_ptr<AbstractVirtualItem>> items) {
+      size_t from = m_layoutItems.size();
+
       m_layoutItems.insert(m_layoutItems.end(), std::make_move_iterator(items.begin()),
                            std::make_move_iterator(items.end()));
       m_itemCount += items.size();
+      trackUniformity(from);
       return *this;
     }
+
+    /**
+     * Insert an item right before or after `anchor`, which needs to be part of this section.
+     */
+    bool insertItem(const AbstractVirtualItem *anchor, std::shared_ptr<AbstractVirtualItem> item,
+                    bool after) {
+      auto it = std::ranges::find_if(m_layoutItems, [&](auto &&layoutItem) {
+        auto widget = std::get_if<VirtualWidget>(&layoutItem);
+        return widget && widget->get() == anchor;
+      });
+
+      if (it == m_layoutItems.end()) return false;
+      if (after) ++it;
+
+      size_t index = std::distance(m_layoutItems.begin(), it);
+
+      m_layoutItems.insert(it, std::move(item));
+      ++m_itemCount;
+      trackUniformity(index);
+      return true;
+    }
+
+    /**
+     * Remove every item of the section. The removed items are returned, as the list may still
+     * reference them until it is laid out again.
+     */
+    std::vector<LayoutItem> takeItems() {
+      m_itemCount = 0;
+      m_uniform = true;
+      m_uniformItem.reset();
+      return std::exchange(m_layoutItems, {});
+    }
+
+    /**
+     * Change the title of the section, which replaces its header item. The previous header item is
+     * returned for the same reason as in `takeItems`.
+     */
+    std::unique_ptr<AbstractVirtualItem> setTitle(const QString &title) {
+      m_title = title;
+      return std::exchange(m_headerItem, std::make_unique<VirtualSection>(title));
+    }
+
+    bool removeItem(const AbstractVirtualItem *item) {
+      auto it = std::ranges::find_if(m_layoutItems, [&](auto &&layoutItem) {
+        auto widget = std::get_if<VirtualWidget>(&layoutItem);
+        return widget && widget->get() == item;
+      });
+
+      if (it == m_layoutItems.end()) return false;
+
+      m_layoutItems.erase(it);
+      m_itemCount = m_itemCount > 0 ? m_itemCount - 1 : 0;
+      return true;
+    }
   };
 
   using RootListItem = std::variant<std::unique_ptr<Section>, std::unique_ptr<AbstractVirtualItem>>;
@@ -308,10 +407,28 @@ private:
     int bottom = 0;
   } margins;
   struct VirtualWidgetInfo {
+    // relative to the top of the layout block the item belongs to, only valid once the block is laid out.
+    // Use itemBounds() to get the absolute bounds.
     QRect bounds;
     AbstractVirtualItem *item = nullptr;
     bool enumerable = false;
+    size_t block = 0;
+  };
+
+  /**
+   * A contiguous range of m_items produced by a single model item (a section or a divider).
+   * Blocks are laid out independently from each other: the height of every block is tracked in a
+   * fenwick tree so that inserting, removing or resizing an item only requires to lay out its own block.
+   * Blocks made of uniform height items that are far from the viewport are only laid out when they are
+   * first accessed.
+   */
+  struct LayoutBlock {
+    size_t modelIndex = 0;
+    size_t firstItem = 0;
+    size_t itemCount = 0;
+    bool laidOut = false;
   };
+
   struct SectionCalculationContext {
     int index = 0;
     int x = 0;
@@ -324,6 +441,18 @@ private:
 
   QScrollBar *scrollBar = new OmniScrollBar(this);
   std::vector<VirtualWidgetInfo> m_items;
+  // item id => index in m_items, rebuilt on every layout
+  std::unordered_map<QString, int> m_idIndex;
+  // running maximum of the bottom edge of m_items, relative to their block. Sorted by construction inside
+  // each block so that the first visible item can be found using a binary search.
+  std::vector<int> m_itemBottoms;
+  std::vector<LayoutBlock> m_blocks;
+  FenwickTree<int> m_blockHeights;
+  // set after a full relayout so that widgets that are kept for the same item id get refreshed
+  bool m_refreshCachedWidgets = false;
+  // recyclingId => ids of cached widgets that are out of the viewport and can be reused.
+  // Vectors are cleared but kept around between updates to avoid reallocating.
+  std::unordered_map<size_t, std::vector<QString>> m_recyclableWidgets;
   std::vector<OmniListItemWidgetWrapper *> m_visibleWidgets;
   std::map<size_t, OmniListItemWidgetWrapper *> _visibleWidgets;
   std::unordered_map<QString, CachedWidget> _widgetCache;
@@ -339,6 +468,12 @@ private:
   void rightClicked(int index) const;
 
   void updateVisibleItems();
+  size_t firstVisibleIndex();
+
+  /**
+   * Take a cached widget that is no longer in the viewport and rekey it for `item`.
+   */
+  OmniListItemWidgetWrapper *takeRecyclable(const AbstractVirtualItem *item);
   bool isDividableContent(const ModelItem &item);
   bool isInViewport(const QRect &bounds);
 
@@ -349,6 +484,38 @@ private:
   int calculateItemHeight(const AbstractVirtualItem *item, int width);
   void calculateHeights();
 
+  std::vector<VirtualWidgetInfo> blockItems(size_t blockIndex);
+
+  /**
+   * Height of a block whose items all share the same uniform height, computed without laying out
+   * its items.
+   */
+  std::optional<int> uniformBlockHeight(size_t blockIndex);
+
+  /**
+   * Compute the bounds of every item in the block. Returns the height of the block.
+   */
+  int layoutBlock(size_t blockIndex);
+  void ensureLaidOut(size_t blockIndex);
+
+  /**
+   * Recreate the items of a single block from its model and lay it out again, leaving
+   * the other blocks untouched.
+   */
+  void relayoutBlock(size_t blockIndex);
+
+  /**
+   * Absolute bounds of the item at index, laying out its block if needed.
+   */
+  QRect itemBounds(size_t index);
+  int availableWidth() const { return width() - margins.left - margins.right; }
+  void updateVirtualHeight();
+  void restoreSelection();
+  bool insertItem(const QString &anchorId, std::shared_ptr<AbstractVirtualItem> item, bool after);
+
+  std::optional<size_t> modelIndexOf(const Section &section) const;
+  std::optional<size_t> blockIndexOf(size_t modelIndex) const;
+
   int indexOfItem(const QString &id) const;
 
   void clearVisibleWidgets();
@@ -448,9 +615,31 @@ public:
   const AbstractVirtualItem *itemAt(const QString &id) const;
   AbstractVirtualItem *itemAt(const QString &id);
   bool selectFirst();
+
+  /**
+   * Update a single item in place, without recomputing the layout of the whole list.
+   * If the item is currently visible, its widget is refreshed right away.
+   * A full relayout is only performed if the height of the item changed as a result of the update.
+   */
   bool updateItem(const QString &id, const UpdateItemCallback &cb);
+
+  /**
+   * Insert or remove a single item, only laying out the section it belongs to again.
+   */
+  bool insertItemBefore(const QString &id, std::shared_ptr<AbstractVirtualItem> item);
+  bool insertItemAfter(const QString &id, std::shared_ptr<AbstractVirtualItem> item);
   bool removeItem(const QString &id);
 
+  /**
+   * Replace the items of a section of the current model, only laying out that section again.
+   * This is meant for models whose sections are filled independently from each other, as results
+   * come in.
+   * The selection stays on the first item if it was there, as it would after a reset. Otherwise the
+   * selected item is kept if it is still part of the list.
+   */
+  bool setSectionItems(const Section &section, std::vector<std::shared_ptr<AbstractVirtualItem>> items);
+  bool setSectionTitle(const Section &section, const QString &title);
+
   void setMargins(int left, int top, int right, int bottom);
   void setMargins(int value);
   void clear();
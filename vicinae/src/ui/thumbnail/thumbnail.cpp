@@ -48,7 +48,11 @@ void Thumbnail::setClickable(bool clickable) {
 }
 
 void Thumbnail::setImage(const ImageURL &url) {
-  m_content->setUrl(ImageURL(url).setMask(OmniPainter::RoundedRectangleMask));
+  ImageURL thumbnailUrl(url);
+
+  if (thumbnailUrl.type() == ImageURLType::Local) { thumbnailUrl.param("thumbnail", "1"); }
+
+  m_content->setUrl(thumbnailUrl.setMask(OmniPainter::RoundedRectangleMask));
 }
 
 void Thumbnail::setRadius(int radius) {
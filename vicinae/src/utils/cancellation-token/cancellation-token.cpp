@@ -0,0 +1,104 @@
+#include "cancellation-token.hpp"
+#include <qlogging.h>
+#include <qsqldatabase.h>
+#include <qsqldriver.h>
+#include <qvariant.h>
+#include <dlfcn.h>
+
+void CancellationToken::cancel() const {
+  if (!m_state || m_state->cancelled.exchange(true)) return;
+
+  decltype(m_state->callbacks) callbacks;
+
+  {
+    std::lock_guard lock(m_state->mutex);
+    callbacks = std::move(m_state->callbacks);
+  }
+
+  for (const auto &[context, callback] : callbacks) {
+    if (context) callback();
+  }
+}
+
+void CancellationToken::onCancelled(QObject *context, std::function<void()> callback) const {
+  if (!m_state) return;
+
+  {
+    std::lock_guard lock(m_state->mutex);
+
+    if (!m_state->cancelled.load()) {
+      m_state->callbacks.emplace_back(context, std::move(callback));
+      return;
+    }
+  }
+
+  callback();
+}
+
+CancellationToken CancellationSource::next() {
+  cancel();
+  m_current = CancellationToken(std::make_shared<CancellationToken::State>());
+
+  return m_current;
+}
+
+void CancellationSource::cancel() { m_current.cancel(); }
+
+CancellationSource::~CancellationSource() { cancel(); }
+
+SqliteCancellationScope::SetProgressHandler
+SqliteCancellationScope::resolveSetProgressHandler(const QSqlDatabase &db) {
+  // every connection goes through the same driver plugin
+  static const SetProgressHandler resolved = [&]() -> SetProgressHandler {
+    Dl_info info;
+
+    // the meta object of the driver lives in the plugin that defines it
+    if (!dladdr(db.driver()->metaObject(), &info) || !info.dli_fname) return nullptr;
+
+    void *library = dlopen(info.dli_fname, RTLD_LAZY | RTLD_NOLOAD);
+
+    if (!library) return nullptr;
+
+    // resolved from the plugin itself, then from its dependencies: whichever SQLite it really uses
+    auto fn = reinterpret_cast<SetProgressHandler>(dlsym(library, "sqlite3_progress_handler"));
+
+    // only drops the reference we just took, the plugin stays loaded for as long as Qt needs it
+    dlclose(library);
+
+    if (!fn) {
+      qWarning() << "SQLite queries can't be interrupted: the SQLite library used by" << info.dli_fname
+                 << "does not export sqlite3_progress_handler";
+    }
+
+    return fn;
+  }();
+
+  return resolved;
+}
+
+int SqliteCancellationScope::progressHandler(void *data) {
+  return static_cast<CancellationToken::State *>(data)->cancelled.load(std::memory_order_relaxed);
+}
+
+SqliteCancellationScope::SqliteCancellationScope(const QSqlDatabase &db, const CancellationToken &token) {
+  if (!token.m_state) return;
+
+  QVariant handle = db.driver()->handle();
+
+  if (!handle.isValid() || qstrcmp(handle.typeName(), "sqlite3*") != 0) return;
+
+  m_setProgressHandler = resolveSetProgressHandler(db);
+
+  if (!m_setProgressHandler) return;
+
+  m_handle = *static_cast<sqlite3 *const *>(handle.constData());
+  m_state = token.m_state;
+
+  // roughly every few microseconds, which is frequent enough for the check to be instant from the
+  // user's perspective while remaining negligible in terms of cost
+  m_setProgressHandler(m_handle, 1000, &SqliteCancellationScope::progressHandler, m_state.get());
+}
+
+SqliteCancellationScope::~SqliteCancellationScope() {
+  if (m_handle) m_setProgressHandler(m_handle, 0, nullptr, nullptr);
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "common.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <qobject.h>
+#include <qpointer.h>
+#include <utility>
+#include <vector>
+
+class QSqlDatabase;
+struct sqlite3;
+
+/**
+ * Tells asynchronous work started for a query that its result is not wanted anymore, typically because
+ * the user typed another character in the meantime. Tokens are cheap to copy and can be checked from
+ * any thread, work that can't poll them (network requests...) registers a callback instead.
+ *
+ * A default constructed token is never cancelled.
+ */
+class CancellationToken {
+  struct State {
+    std::atomic<bool> cancelled = false;
+    std::mutex mutex;
+    std::vector<std::pair<QPointer<QObject>, std::function<void()>>> callbacks;
+  };
+
+  std::shared_ptr<State> m_state;
+
+  explicit CancellationToken(std::shared_ptr<State> state) : m_state(std::move(state)) {}
+  void cancel() const;
+
+  friend class CancellationSource;
+  friend class SqliteCancellationScope;
+
+public:
+  bool isCancelled() const { return m_state && m_state->cancelled.load(std::memory_order_relaxed); }
+
+  /**
+   * Call `callback` once the token is cancelled, on the thread that cancels it, unless `context` was
+   * destroyed by then. The callback is called right away if the token is already cancelled.
+   */
+  void onCancelled(QObject *context, std::function<void()> callback) const;
+
+  CancellationToken() = default;
+};
+
+/**
+ * Hands out one token per query generation: starting a new generation cancels the token of the
+ * previous one. Destroying the source cancels its current token.
+ */
+class CancellationSource : public NonCopyable {
+  CancellationToken m_current;
+
+public:
+  /**
+   * Cancel the current token and return a new one.
+   */
+  CancellationToken next();
+  void cancel();
+
+  CancellationToken token() const { return m_current; }
+
+  ~CancellationSource();
+};
+
+/**
+ * Makes the statements executed on `db` fail with SQLITE_INTERRUPT as soon as `token` is cancelled,
+ * for as long as the scope is alive. SQLite polls the token every few thousand virtual machine
+ * instructions, so that even a single long running statement is interrupted right away.
+ *
+ * The connection handle is obtained from the Qt SQLite driver. Qt may bundle its own copy of SQLite,
+ * so the handler is installed with the `sqlite3_progress_handler` of the library the driver was loaded
+ * with, never with one we would link against. If it can't be resolved, the scope does nothing.
+ */
+class SqliteCancellationScope : public NonCopyable {
+  using SetProgressHandler = void (*)(sqlite3 *, int, int (*)(void *), void *);
+
+  sqlite3 *m_handle = nullptr;
+  SetProgressHandler m_setProgressHandler = nullptr;
+  std::shared_ptr<CancellationToken::State> m_state;
+
+  static int progressHandler(void *data);
+  static SetProgressHandler resolveSetProgressHandler(const QSqlDatabase &db);
+
+public:
+  SqliteCancellationScope(const QSqlDatabase &db, const CancellationToken &token);
+  ~SqliteCancellationScope();
+};
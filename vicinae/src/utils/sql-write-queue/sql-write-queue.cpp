@@ -0,0 +1,138 @@
+#include "sql-write-queue.hpp"
+#include "daemon/perf-metrics.hpp"
+#include <qlogging.h>
+#include <qsqlerror.h>
+#include <qsqlquery.h>
+
+uint64_t SqlWriteQueue::enqueue(Statement statement, const QString &key) {
+  uint64_t seq = 0;
+
+  {
+    std::lock_guard lock(m_mutex);
+
+    if (!key.isEmpty()) {
+      std::erase_if(m_pending, [&](const PendingWrite &write) { return write.key == key; });
+    }
+
+    m_pending.emplace_back(PendingWrite{.statement = std::move(statement), .key = key});
+    seq = ++m_enqueued;
+  }
+
+  m_pendingCv.notify_one();
+
+  return seq;
+}
+
+void SqlWriteQueue::flush() {
+  std::unique_lock lock(m_mutex);
+  uint64_t target = m_enqueued;
+
+  if (m_committed >= target) return;
+
+  m_flushRequested = true;
+  m_pendingCv.notify_one();
+  m_committedCv.wait(lock, [&]() { return m_committed >= target; });
+}
+
+void SqlWriteQueue::commit(QSqlDatabase &db, const std::vector<PendingWrite> &batch) {
+  static auto &commitLatency = PerfMetrics::instance()->histogram("sql-write-commit");
+  static auto &batchCount = PerfMetrics::instance()->counter("sql-write-batches");
+  // divided by the number of batches, gives the average batch size
+  static auto &writeCount = PerfMetrics::instance()->counter("sql-write-batched-writes");
+  auto timer = commitLatency.time();
+
+  batchCount.increment();
+  writeCount.increment(batch.size());
+
+  if (!db.transaction()) {
+    qCritical() << "SqlWriteQueue: failed to start transaction" << db.lastError();
+    return;
+  }
+
+  QSqlQuery query(db);
+
+  for (const auto &write : batch) {
+    query.prepare(write.statement.sql);
+
+    for (const auto &[name, value] : write.statement.bindings) {
+      query.bindValue(name, value);
+    }
+
+    // a failing write doesn't abort the batch, as other writes are unrelated to it
+    if (!query.exec()) { qCritical() << "SqlWriteQueue: failed to execute write" << query.lastError(); }
+  }
+
+  if (!db.commit()) {
+    qCritical() << "SqlWriteQueue: failed to commit batch of" << batch.size() << "writes" << db.lastError();
+    db.rollback();
+  }
+}
+
+void SqlWriteQueue::run() {
+  {
+    // connections can only be used from the thread that created them
+    QSqlDatabase db = QSqlDatabase::cloneDatabase(m_connectionName, m_workerConnectionName);
+
+    if (!db.open()) { qCritical() << "SqlWriteQueue: failed to open database" << db.lastError(); }
+
+    QSqlQuery query(db);
+
+    for (const auto &pragma : m_pragmas) {
+      if (!query.exec(pragma)) {
+        qWarning() << "SqlWriteQueue: failed to run" << pragma << query.lastError();
+      }
+    }
+
+    while (true) {
+      std::vector<PendingWrite> batch;
+      uint64_t last = 0;
+
+      {
+        std::unique_lock lock(m_mutex);
+
+        m_pendingCv.wait(lock, [&]() { return !m_alive || !m_pending.empty(); });
+
+        if (!m_alive && m_pending.empty()) break;
+
+        // give other writes a chance to join the batch, unless someone is waiting on them
+        m_pendingCv.wait_for(lock, BATCH_DELAY, [&]() {
+          return !m_alive || m_flushRequested || m_pending.size() >= MAX_BATCH_SIZE;
+        });
+
+        batch.swap(m_pending);
+        last = m_enqueued;
+        m_flushRequested = false;
+      }
+
+      if (db.isOpen()) commit(db, batch);
+
+      {
+        std::lock_guard lock(m_mutex);
+        m_committed = last;
+      }
+
+      m_committedCv.notify_all();
+    }
+
+    db.close();
+  }
+
+  QSqlDatabase::removeDatabase(m_workerConnectionName);
+}
+
+SqlWriteQueue::SqlWriteQueue(const QSqlDatabase &db, const std::vector<QString> &pragmas)
+    : m_connectionName(db.connectionName()), m_workerConnectionName(db.connectionName() + "-writer"),
+      m_pragmas(pragmas) {
+  m_thread = std::thread([this]() { run(); });
+}
+
+SqlWriteQueue::~SqlWriteQueue() {
+  {
+    std::lock_guard lock(m_mutex);
+    m_alive = false;
+  }
+
+  // whatever is still queued is committed before the thread exits
+  m_pendingCv.notify_one();
+  m_thread.join();
+}
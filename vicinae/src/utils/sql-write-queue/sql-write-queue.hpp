@@ -0,0 +1,83 @@
+#pragma once
+#include "common.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <qsqldatabase.h>
+#include <qstring.h>
+#include <qvariant.h>
+#include <thread>
+#include <vector>
+
+/**
+ * Write-behind queue for a SQLite database. Writes are queued from the main thread and committed
+ * in batches, each batch being a single transaction executed on a dedicated thread with its own
+ * connection. This keeps frequent small writes (visit counters, last used timestamps...) from
+ * blocking the UI on disk I/O and from paying for one transaction each.
+ *
+ * Queued writes are not visible to reads made on other connections until they are committed.
+ * Callers are expected to keep their own in-memory overlay of what they wrote, and can use the
+ * sequence number returned by `enqueue` along with `committedSequence` to know when the database
+ * caught up with it.
+ */
+class SqlWriteQueue : public NonCopyable {
+public:
+  struct Statement {
+    QString sql;
+    std::vector<std::pair<QString, QVariant>> bindings;
+  };
+
+private:
+  static constexpr std::chrono::milliseconds BATCH_DELAY = std::chrono::milliseconds(250);
+  static constexpr size_t MAX_BATCH_SIZE = 256;
+
+  struct PendingWrite {
+    Statement statement;
+    QString key;
+  };
+
+  QString m_connectionName;
+  QString m_workerConnectionName;
+  std::vector<QString> m_pragmas;
+
+  std::mutex m_mutex;
+  std::condition_variable m_pendingCv;
+  std::condition_variable m_committedCv;
+  std::vector<PendingWrite> m_pending;
+  uint64_t m_enqueued = 0;
+  bool m_flushRequested = false;
+  bool m_alive = true;
+  std::atomic<uint64_t> m_committed = 0;
+  std::thread m_thread;
+
+  void run();
+  void commit(QSqlDatabase &db, const std::vector<PendingWrite> &batch);
+
+public:
+  /**
+   * Queue a write. If `key` is not empty, a still queued write with the same key is dropped in favor
+   * of this one, which is useful for writes that overwrite a value (e.g a timestamp).
+   * Returns the sequence number of the write.
+   */
+  uint64_t enqueue(Statement statement, const QString &key = {});
+
+  /**
+   * Sequence number of the last write that was committed to the database.
+   */
+  uint64_t committedSequence() const { return m_committed; }
+
+  /**
+   * Block until everything that was queued so far is committed. This is meant for code that
+   * needs to read back from the database and can't use an overlay, not for interactive paths.
+   */
+  void flush();
+
+  /**
+   * `db` is cloned into a connection owned by the writer thread. `pragmas` are executed on that
+   * connection once it's opened, as most of them are per-connection.
+   */
+  SqlWriteQueue(const QSqlDatabase &db, const std::vector<QString> &pragmas = {});
+  ~SqlWriteQueue();
+};
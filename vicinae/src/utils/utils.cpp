@@ -1,9 +1,13 @@
 #include "utils.hpp"
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <filesystem>
+#include <pthread.h>
+#include <qcoreapplication.h>
 #include <qmimedatabase.h>
 #include <qmimetype.h>
+#include <qthread.h>
 
 namespace fs = std::filesystem;
 
@@ -185,3 +189,20 @@ QString formatCount(int count) {
 
   return QString::number(count);
 }
+
+QString currentThreadName() {
+  auto thread = QThread::currentThread();
+
+  if (auto app = QCoreApplication::instance(); app && app->thread() == thread) return "main";
+  if (!thread->objectName().isEmpty()) return thread->objectName();
+
+  std::array<char, 16> name{};
+
+  // threads inherit the name of the process by default, which tells us nothing
+  if (pthread_getname_np(pthread_self(), name.data(), name.size()) == 0 &&
+      QCoreApplication::applicationName() != name.data() && name.front() != '\0') {
+    return name.data();
+  }
+
+  return QString("0x%1").arg(reinterpret_cast<quintptr>(QThread::currentThreadId()), 0, 16);
+}
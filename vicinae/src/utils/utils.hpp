@@ -49,3 +49,9 @@ QJsonValue protoToJsonValue(const google::protobuf::Value &value);
 QString formatSize(size_t bytes);
 
 QString slugify(const QString &input, const QString &separator = "-");
+
+/**
+ * Human readable name of the calling thread, for diagnostics. Threads that were not given a name
+ * through Qt or `pthread_setname_np` are identified by their id.
+ */
+QString currentThreadName();
@@ -7,8 +7,10 @@
 
 namespace Omnicast {
 
+constexpr long long MB = 1e6;
 constexpr long long GB = 1e9;
 constexpr long long IMAGE_DISK_CACHE_MAX_SIZE = GB * 5;
+constexpr long long IMAGE_MEMORY_CACHE_MAX_SIZE = MB * 128;
 
 static const QString GH_REPO = "https://github.com/yechielw/vicinae";
 static const QString GH_REPO_CREATE_ISSUE = GH_REPO + "/issues/new";
@@ -1,365 +1,299 @@
 #include "xdg-desktop.hpp"
+#include <qfile.h>
 #include <qnamespace.h>
 #include <qstringview.h>
+#include <stdexcept>
 
-static bool isGroupHeaderNameChar(QChar c) { return c.isPrint() && c != '[' && c != ']'; }
-
-static bool isEntryKey(QChar c) { return c.isLetterOrNumber() || c == '-'; }
-
-static bool isValueKey(QChar c) { return c != '\n'; }
-
-static bool isLocaleKey(QChar c) { return c.isLetter() || c == '_' || c == '@' || c == '-'; }
-
-Locale::Locale(QStringView data) {
-  enum State { LANG, COUNTRY, ENC, AT, MOD, DONE };
-  State state = LANG;
-
-  size_t cursor = 0;
-  size_t i = 0;
-  size_t end = i;
-
-  while (state != DONE && i < data.size()) {
-    QChar c = data.at(i);
-
-    switch (state) {
-    case LANG:
-      if (c.isLetter()) {
-        ++end;
-        break;
-      }
-
-      lang = data.sliced(cursor, end - cursor);
-      cursor = end = i + 1;
-
-      if (c == '_' || c == '-') {
-        state = COUNTRY;
-      } else if (c == '.') {
-        state = ENC;
-      } else if (c == '@') {
-        state = AT;
-      } else {
-        state = DONE;
-      }
-      break;
-    case COUNTRY:
-      if (c.isLetter()) {
-        ++end;
-        break;
-      }
-
-      country = data.sliced(cursor, end - cursor);
-      cursor = end = i + 1;
-
-      if (c == '.') {
-        state = ENC;
-      } else if (c == '-') {
-        state = MOD;
-      } else if (c == '@') {
-        state = AT;
-      } else {
-        state = DONE;
-      }
-
-      break;
-    case ENC:
-      if (c.isLetterOrNumber() || c == '-') {
-        ++end;
-        break;
-      }
-
-      encoding = data.sliced(cursor, end - cursor);
-      cursor = end = i + 1;
-
-      if (c == '@') {
-        state = AT;
-      } else {
-        state = DONE;
-      }
-
-      break;
-    case AT:
-      if (c.isLetter()) {
-        ++end;
-        break;
-      }
-
-      modifier = data.sliced(cursor, end - cursor);
-      cursor = end = i + 1;
-      state = DONE;
-
-      break;
-    case MOD:
-      if (c.isLetter()) {
-        ++end;
-        break;
-      }
-
-      variant = data.sliced(cursor, end - cursor);
-      cursor = end = i + 1;
-
-      if (c == '@') {
-        state = AT;
-      } else {
-        state = DONE;
-      }
-
-      break;
-    default:
-      break;
-    }
+static std::string_view trimLeft(std::string_view view) {
+  while (!view.empty() && (view.front() == ' ' || view.front() == '\t'))
+    view.remove_prefix(1);
+  return view;
+}
 
-    ++i;
-  }
+static std::string_view trimRight(std::string_view view) {
+  while (!view.empty() && (view.back() == ' ' || view.back() == '\t'))
+    view.remove_suffix(1);
+  return view;
 }
 
-QString Locale::toString() {
-  QString fmt;
+Locale::Locale(std::string_view data) {
+  if (auto at = data.find('@'); at != std::string_view::npos) {
+    modifier = data.substr(at + 1);
+    data = data.substr(0, at);
+  }
 
-  if (!lang.isEmpty()) fmt += lang;
+  if (auto dot = data.find('.'); dot != std::string_view::npos) {
+    encoding = data.substr(dot + 1);
+    data = data.substr(0, dot);
+  }
 
-  if (!country.isEmpty()) {
-    fmt += "_";
-    fmt += country;
+  if (auto sep = data.find_first_of("_-"); sep != std::string_view::npos) {
+    country = data.substr(sep + 1);
+    data = data.substr(0, sep);
   }
 
-  if (!variant.isEmpty()) {
-    fmt += "-";
-    fmt += variant;
+  lang = data;
+}
+
+QString Locale::toString() const {
+  QString fmt = QString::fromUtf8(lang);
+
+  if (!country.empty()) {
+    fmt += "_";
+    fmt += QString::fromUtf8(country);
   }
 
-  if (!encoding.isEmpty()) {
+  if (!encoding.empty()) {
     fmt += ".";
-    fmt += encoding;
+    fmt += QString::fromUtf8(encoding);
   }
 
-  if (!modifier.isEmpty()) {
+  if (!modifier.empty()) {
     fmt += "@";
-    fmt += modifier;
+    fmt += QString::fromUtf8(modifier);
   }
-  struct Entry {
-    QStringView key;
-    QString value;
-    std::optional<Locale> locale;
-  };
-  return fmt;
-}
 
-XdgDesktopEntry::Parser::Parser(QStringView view) noexcept : rawLocale("C"), data(view), cursor(0) {
-  if (auto locale = std::setlocale(LC_MESSAGES, nullptr)) { rawLocale = locale; }
+  return fmt;
 }
 
-void XdgDesktopEntry::Parser::skipWS() {
-  while (cursor < data.size() && data.at(cursor).isSpace())
-    ++cursor;
+std::string XdgDesktopEntry::messagesLocale() {
+  if (auto locale = std::setlocale(LC_MESSAGES, nullptr)) return locale;
+  return "C";
 }
 
-QStringView XdgDesktopEntry::Parser::parseGroupHeader() {
-  size_t end = cursor;
+XdgDesktopEntry::XdgDesktopEntry(const QString &path) {
+  QFile file(path);
 
-  while (isGroupHeaderNameChar(data.at(end))) {
-    ++end;
+  if (!file.open(QIODevice::ReadOnly)) {
+    throw std::runtime_error("Failed to open desktop file: " + file.errorString().toStdString());
   }
 
-  QStringView view = data.sliced(cursor, end - cursor);
+  qint64 size = file.size();
 
-  if (data.at(end) != ']') throw std::runtime_error("Invalid group header");
+  if (size == 0) throw std::runtime_error("Empty desktop file");
 
-  cursor = end + 1;
+  // the mapping is released by the file when it goes out of scope, even if parsing throws
+  uchar *addr = file.map(0, size);
 
-  return view;
+  if (!addr) throw std::runtime_error("Failed to map desktop file: " + file.errorString().toStdString());
+
+  std::string locale = messagesLocale();
+  std::string_view view(reinterpret_cast<const char *>(addr), size);
+
+  *this = XdgDesktopEntry::Parser(view, locale).parse();
 }
 
-QStringView XdgDesktopEntry::Parser::parseEntryKey() {
-  size_t end = cursor;
+XdgDesktopEntry::Parser::Parser(std::string_view view, std::string_view localeName)
+    : data(view), locale(localeName) {}
 
-  while (isEntryKey(data.at(end)))
-    ++end;
+std::string_view XdgDesktopEntry::Parser::readLine() {
+  size_t end = data.find('\n', cursor);
 
-  auto key = data.sliced(cursor, end - cursor);
+  if (end == std::string_view::npos) end = data.size();
 
-  cursor = end;
+  auto line = data.substr(cursor, end - cursor);
 
-  return key;
-}
+  cursor = end + 1;
 
-QChar XdgDesktopEntry::Parser::parseEscaped() {
-  QChar c = data.at(cursor++);
-
-  switch (c.row()) {
-    // clang-format off
-	  case 's': return ' ';
-	  case 'n': return '\n';
-	  case 't': return '\t';
-	  case 'r': return '\r';
-	  default: return c;
-    // clang-format on
-  }
-}
+  if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
 
-QString XdgDesktopEntry::Parser::parseEntryValue() {
-  static const QString leadingWsSet = " \t"; // only space and tab as we don't want to skip newlines
+  return line;
+}
 
-  while (cursor < data.size() && leadingWsSet.contains(data.at(cursor))) {
-    ++cursor;
-  }
+XdgDesktopEntry::Parser::Group *XdgDesktopEntry::Parser::parseGroupHeader(std::string_view line) {
+  static constexpr std::string_view actionPrefix = "Desktop Action ";
+  size_t end = line.find(']');
 
-  QString value;
-  QChar c;
+  if (end == std::string_view::npos) throw std::runtime_error("Invalid group header");
 
-  while (cursor < data.size()) {
-    c = data.at(cursor);
+  auto name = line.substr(1, end - 1);
 
-    if (!isValueKey(c)) { break; }
+  if (name == "Desktop Entry") {
+    hasMainGroup = true;
+    return &mainGroup;
+  }
 
-    if (c == '\\') {
-      cursor++;
-      value += parseEscaped();
-    } else {
-      value += c;
-      cursor++;
-    }
+  if (name.starts_with(actionPrefix)) {
+    actionGroups.emplace_back(name.substr(actionPrefix.size()), Group{});
+    return &actionGroups.back().second;
   }
 
-  ++cursor;
+  // entries of groups we don't know about are skipped without being looked at
+  return nullptr;
+}
+
+int XdgDesktopEntry::Parser::localeScore(const Locale &keyLocale) const {
+  if (keyLocale.lang != locale.lang) return 0;
+  if (!keyLocale.country.empty() && keyLocale.country != locale.country) return 0;
+  if (!keyLocale.modifier.empty() && keyLocale.modifier != locale.modifier) return 0;
 
-  return value;
+  // lang_COUNTRY@MODIFIER > lang_COUNTRY > lang@MODIFIER > lang, as per the spec
+  return 1 + (keyLocale.country.empty() ? 0 : 2) + (keyLocale.modifier.empty() ? 0 : 1);
 }
 
-XdgDesktopEntry::Parser::Entry XdgDesktopEntry::Parser::parseEntry() {
-  Entry entry;
+void XdgDesktopEntry::Parser::parseEntry(std::string_view line, Group &group) {
+  size_t eq = line.find('=');
 
-  skipWS();
-  entry.key = parseEntryKey();
+  if (eq == std::string_view::npos) throw std::runtime_error("Invalid entry, missing '='");
 
-  if (data.at(cursor) == '[') {
-    size_t end = ++cursor;
+  auto key = trimRight(line.substr(0, eq));
+  auto value = trimLeft(line.substr(eq + 1));
+  int score = 0;
 
-    while (end < data.size() && data.at(end) != ']')
-      ++end;
+  if (size_t open = key.find('['); open != std::string_view::npos) {
+    if (key.back() != ']') throw std::runtime_error("Invalid key name");
 
-    auto view = data.sliced(cursor, end - cursor);
+    score = localeScore(Locale(key.substr(open + 1, key.size() - open - 2)));
 
-    entry.locale = {view};
-    cursor = end + 1;
+    if (score == 0) return;
+
+    key = key.substr(0, open);
   }
 
-  skipWS();
+  auto [it, inserted] = group.try_emplace(key, Value{.raw = value, .score = score});
 
-  if (cursor < data.size() && data.at(cursor) != '=') { throw std::runtime_error("Invalid key name"); }
+  if (!inserted && it->second.score < score) { it->second = Value{.raw = value, .score = score}; }
+}
 
-  cursor++;
-  entry.value = parseEntryValue();
+QString XdgDesktopEntry::Parser::unescape(std::string_view raw) {
+  if (raw.find('\\') == std::string_view::npos) return QString::fromUtf8(raw);
 
-  return entry;
-}
+  std::string value;
 
-uint XdgDesktopEntry::Parser::computeLocalePriority(Locale lhs, Locale rhs) {
-  if (lhs.lang == rhs.lang) {
-    if (lhs.country == rhs.country) {
-      if (lhs.modifier == rhs.modifier) return 3;
-      return 2;
+  value.reserve(raw.size());
+
+  for (size_t i = 0; i < raw.size(); ++i) {
+    if (raw[i] != '\\' || i + 1 == raw.size()) {
+      value += raw[i];
+      continue;
+    }
+
+    switch (char c = raw[++i]) {
+      // clang-format off
+    case 's': value += ' '; break;
+    case 'n': value += '\n'; break;
+    case 't': value += '\t'; break;
+    case 'r': value += '\r'; break;
+    default: value += c; break;
+      // clang-format on
     }
-    return 1;
   }
 
-  return 0;
+  return QString::fromStdString(value);
 }
 
-XdgDesktopEntry XdgDesktopEntry::Parser::parse() {
-  QHash<QStringView, size_t> localePriorities;
+QString XdgDesktopEntry::Parser::string(const Group &group, std::string_view key) {
+  if (auto it = group.find(key); it != group.end()) return unescape(it->second.raw);
+  return {};
+}
 
-  skipWS();
+bool XdgDesktopEntry::Parser::boolean(const Group &group, std::string_view key) {
+  auto it = group.find(key);
 
-  while (cursor < data.size()) {
-    QChar ch = data.at(cursor);
+  return it != group.end() && it->second.raw == "true";
+}
 
-    if (ch == '#') {
-      while (data.at(cursor) != '\n')
-        ++cursor;
-    }
+QStringList XdgDesktopEntry::Parser::list(const Group &group, std::string_view key) {
+  auto it = group.find(key);
 
-    else if (ch == '[') {
-      ++cursor;
-      auto groupName = parseGroupHeader();
-      auto it = groups.insert(groupName, {});
+  if (it == group.end()) return {};
 
-      currentGroup = &*it;
-      localePriorities.clear();
-    }
+  std::string_view raw = it->second.raw;
+  QStringList items;
+  size_t start = 0;
 
-    else {
-      auto entry = parseEntry();
+  // items are split before being unescaped, so that escaped semicolons are kept
+  for (size_t i = 0; i <= raw.size(); ++i) {
+    if (i < raw.size() && raw[i] == '\\') {
+      ++i;
+      continue;
+    }
 
-      auto previousScore = localePriorities.find(entry.key);
+    if (i == raw.size() || raw[i] == ';') {
+      if (i > start) items << unescape(raw.substr(start, i - start));
+      start = i + 1;
+    }
+  }
 
-      if (!entry.locale && previousScore == localePriorities.end()) {
-        localePriorities.insert(entry.key, 0);
-        currentGroup->insert(entry.key, entry.value);
-      }
+  return items;
+}
 
-      if (entry.locale) {
-        size_t score = computeLocalePriority(Locale(rawLocale), *entry.locale);
+XdgDesktopEntry XdgDesktopEntry::Parser::parse() {
+  Group *group = nullptr;
 
-        if (previousScore != localePriorities.end() && *previousScore < score) {
-          // qDebug() << "out did local score for " << entry.key << entry.locale->toString() << rawLocale;
-          *previousScore = score;
+  while (cursor < data.size()) {
+    auto line = trimLeft(readLine());
 
-          currentGroup->insert(entry.key, entry.value);
-        }
+    if (line.empty() || line.front() == '#') continue;
 
-        if (previousScore == localePriorities.end() && score > 0) {
-          localePriorities.insert(entry.key, score);
-          currentGroup->insert(entry.key, entry.value);
-        }
-      }
+    if (line.front() == '[') {
+      group = parseGroupHeader(line);
+      continue;
     }
 
-    skipWS();
+    if (group) parseEntry(line, *group);
   }
 
-  XdgDesktopEntry entry;
+  if (!hasMainGroup) throw std::runtime_error("No Desktop Entry group");
 
-  auto it = groups.find(QStringLiteral("Desktop Entry"));
-
-  if (it == groups.end()) throw std::runtime_error("No Desktop Entry group");
-
-  entry.type = (*it)[QStringLiteral("Type")];
-  entry.version = (*it)[QStringLiteral("Version")];
-  entry.name = (*it)[QStringLiteral("Name")];
-  entry.genericName = (*it)[QStringLiteral("GenericName")];
-  entry.noDisplay = (*it)[QStringLiteral("NoDisplay")] == "true";
-  entry.comment = (*it)[QStringLiteral("Comment")];
-  entry.icon = (*it)[QStringLiteral("Icon")];
-  entry.hidden = (*it)[QStringLiteral("Hidden")] == "true";
-  entry.tryExec = (*it)[QStringLiteral("TryExec")];
-  entry.exec = ExecParser::parse((*it)[QStringLiteral("Exec")]);
-
-  entry.path = (*it)[QStringLiteral("Path")];
-  entry.terminal = (*it)[QStringLiteral("Terminal")] == "true";
-  auto actions = (*it)[QStringLiteral("Actions")].split(';', Qt::SkipEmptyParts);
-  entry.mimeType = (*it)[QStringLiteral("MimeType")].split(';', Qt::SkipEmptyParts);
-  entry.categories = (*it)[QStringLiteral("Categories")].split(';', Qt::SkipEmptyParts);
-  entry.keywords = (*it)[QStringLiteral("Keywords")].split(';', Qt::SkipEmptyParts);
-  entry.startupWMClass = (*it)[QStringLiteral("StartupWMClass")];
-  entry.singleMainWindow = (*it)[QStringLiteral("SingleMainWindow")] == "true";
-
-  for (const auto &groupName : groups.keys()) {
-    auto parts = groupName.split(' ');
-
-    if (parts.size() == 3 && parts[0] == QStringLiteral("Desktop") && parts[1] == QStringLiteral("Action") &&
-        actions.contains(parts[2])) {
-
-      XdgDesktopEntry::Action action;
-
-      auto group = groups[groupName];
-
-      action.id = parts[2].toString();
-      action.name = group[QStringLiteral("Name")];
-      action.icon = group[QStringLiteral("Icon")];
-      action.exec = ExecParser::parse(group[QStringLiteral("Exec")]);
-      entry.actions.push_back(action);
-    }
+  XdgDesktopEntry entry;
+  const Group &desktopEntry = mainGroup;
+
+  entry.type = string(desktopEntry, "Type");
+  entry.version = string(desktopEntry, "Version");
+  entry.name = string(desktopEntry, "Name");
+  entry.genericName = string(desktopEntry, "GenericName");
+  entry.noDisplay = boolean(desktopEntry, "NoDisplay");
+  entry.comment = string(desktopEntry, "Comment");
+  entry.icon = string(desktopEntry, "Icon");
+  entry.hidden = boolean(desktopEntry, "Hidden");
+  entry.tryExec = string(desktopEntry, "TryExec");
+  entry.exec = ExecParser::parse(string(desktopEntry, "Exec"));
+  entry.path = string(desktopEntry, "Path");
+  entry.terminal = boolean(desktopEntry, "Terminal");
+  entry.mimeType = list(desktopEntry, "MimeType");
+  entry.categories = list(desktopEntry, "Categories");
+  entry.keywords = list(desktopEntry, "Keywords");
+  entry.startupWMClass = string(desktopEntry, "StartupWMClass");
+  entry.singleMainWindow = boolean(desktopEntry, "SingleMainWindow");
+
+  auto actions = list(desktopEntry, "Actions");
+
+  for (const auto &[id, actionGroup] : actionGroups) {
+    QString actionId = QString::fromUtf8(id);
+
+    if (!actions.contains(actionId)) continue;
+
+    XdgDesktopEntry::Action action;
+
+    action.id = actionId;
+    action.name = string(actionGroup, "Name");
+    action.icon = string(actionGroup, "Icon");
+    action.exec = ExecParser::parse(string(actionGroup, "Exec"));
+    entry.actions.push_back(action);
   }
 
   return entry;
 }
+
+QDataStream &operator<<(QDataStream &stream, const XdgDesktopEntry::Action &action) {
+  return stream << action.id << action.name << action.icon << action.exec;
+}
+
+QDataStream &operator>>(QDataStream &stream, XdgDesktopEntry::Action &action) {
+  return stream >> action.id >> action.name >> action.icon >> action.exec;
+}
+
+QDataStream &operator<<(QDataStream &stream, const XdgDesktopEntry &entry) {
+  return stream << entry.type << entry.version << entry.name << entry.genericName << entry.noDisplay
+                << entry.comment << entry.icon << entry.hidden << entry.tryExec << entry.exec << entry.path
+                << entry.terminal << entry.mimeType << entry.categories << entry.keywords
+                << entry.startupWMClass << entry.singleMainWindow << entry.actions;
+}
+
+QDataStream &operator>>(QDataStream &stream, XdgDesktopEntry &entry) {
+  return stream >> entry.type >> entry.version >> entry.name >> entry.genericName >> entry.noDisplay >>
+         entry.comment >> entry.icon >> entry.hidden >> entry.tryExec >> entry.exec >> entry.path >>
+         entry.terminal >> entry.mimeType >> entry.categories >> entry.keywords >> entry.startupWMClass >>
+         entry.singleMainWindow >> entry.actions;
+}
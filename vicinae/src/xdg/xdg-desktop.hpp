@@ -5,6 +5,7 @@
 #include <cctype>
 #include <clocale>
 #include <qcontainerfwd.h>
+#include <qdatastream.h>
 #include <qdir.h>
 #include <qhash.h>
 #include <qlocale.h>
@@ -12,16 +13,24 @@
 #include <qregularexpression.h>
 #include <qstringliteral.h>
 #include <qstringview.h>
-
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A locale as found in LC_MESSAGES or in the brackets of a localized key,
+ * e.g `lang_COUNTRY.ENCODING@MODIFIER`.
+ * Views point into the parsed string, which needs to outlive the locale.
+ */
 struct Locale {
-  QStringView lang;
-  QStringView country;
-  QStringView encoding;
-  QStringView variant;
-  QStringView modifier;
-
-  QString toString();
-  Locale(QStringView data);
+  std::string_view lang;
+  std::string_view country;
+  std::string_view encoding;
+  std::string_view modifier;
+
+  QString toString() const;
+  Locale(std::string_view data);
 };
 
 class XdgDesktopEntry {
@@ -94,63 +103,63 @@ class XdgDesktopEntry {
     }
   };
 
+  /**
+   * Single pass parser working over the raw UTF-8 buffer of a desktop file.
+   *
+   * Groups, keys and values are kept as views into the buffer: only the values that end up
+   * in the entry are unescaped and converted to QString, after all the lines have been read.
+   * Localized keys that do not match the current locale are skipped right away.
+   */
   class Parser {
-    struct Entry {
-      QStringView key;
-      QString value;
-      std::optional<Locale> locale;
+    struct Value {
+      std::string_view raw;
+      // how well the locale of the key matches the current one, 0 for unlocalized keys
+      int score = 0;
     };
 
-    QString rawLocale;
-    QStringView data;
-    size_t cursor;
+    using Group = std::unordered_map<std::string_view, Value>;
 
-    using Group = QHash<QStringView, QString>;
+    std::string_view data;
+    size_t cursor = 0;
+    Locale locale;
 
-    Group top;
-    QHash<QStringView, Group> groups;
-    Group *currentGroup = &top;
+    Group mainGroup;
+    std::vector<std::pair<std::string_view, Group>> actionGroups;
+    bool hasMainGroup = false;
 
-    QStringView parseGroupHeader();
-    QStringView parseEntryKey();
-    QChar parseEscaped();
-    QString parseEntryValue();
-    Entry parseEntry();
+    std::string_view readLine();
+    Group *parseGroupHeader(std::string_view line);
+    void parseEntry(std::string_view line, Group &group);
+    int localeScore(const Locale &keyLocale) const;
 
-    void skipWS();
-    uint computeLocalePriority(Locale lhs, Locale rhs);
+    static QString unescape(std::string_view raw);
+    static QString string(const Group &group, std::string_view key);
+    static bool boolean(const Group &group, std::string_view key);
+    static QStringList list(const Group &group, std::string_view key);
 
   public:
     XdgDesktopEntry parse();
 
-    Parser(QStringView view) noexcept;
-
-    void dump() {
-      dumpGroup(top);
-      for (const auto &entry : groups) {
-        dumpGroup(entry);
-      }
-    }
-
-    void dumpGroup(const Group &grp) {
-      for (const auto &entry : grp.keys()) {
-        qDebug() << entry << "=" << grp[entry];
-      }
-    }
+    /**
+     * `localeName` is matched against localized keys, usually the value of `messagesLocale()`.
+     * Both `view` and `localeName` need to outlive the parser.
+     */
+    Parser(std::string_view view, std::string_view localeName);
   };
 
-  XdgDesktopEntry() {}
-
 public:
-  XdgDesktopEntry(const QString &path) {
-    QFile file(path);
-
-    file.open(QIODevice::ReadOnly);
+  XdgDesktopEntry() {}
 
-    QString data = file.readAll();
+  /**
+   * The locale localized keys are resolved against, from LC_MESSAGES.
+   */
+  static std::string messagesLocale();
 
-    *this = XdgDesktopEntry::Parser(data).parse();
-  }
+  /**
+   * Parses the desktop file at `path`, which is mapped in memory rather than read.
+   * Throws if the file can't be read or is not a valid desktop entry.
+   */
+  XdgDesktopEntry(const QString &path);
 
   struct Action {
     QString id;
@@ -164,19 +173,27 @@ public:
   QString version;
   QString name;
   QString genericName;
-  bool noDisplay;
+  bool noDisplay = false;
   QString comment;
   QString icon;
-  bool hidden;
+  bool hidden = false;
   QString tryExec;
   QList<QString> exec;
   QString path;
-  bool terminal;
+  bool terminal = false;
   QList<QString> mimeType;
   QList<QString> categories;
   QList<QString> keywords;
   QString startupWMClass;
-  bool singleMainWindow;
+  bool singleMainWindow = false;
 
   QList<Action> actions;
 };
+
+/**
+ * Binary serialization, used to persist parsed entries across restarts.
+ */
+QDataStream &operator<<(QDataStream &stream, const XdgDesktopEntry::Action &action);
+QDataStream &operator>>(QDataStream &stream, XdgDesktopEntry::Action &action);
+QDataStream &operator<<(QDataStream &stream, const XdgDesktopEntry &entry);
+QDataStream &operator>>(QDataStream &stream, XdgDesktopEntry &entry);